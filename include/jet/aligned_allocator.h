@@ -0,0 +1,152 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_ALIGNED_ALLOCATOR_H_
+#define INCLUDE_JET_ALIGNED_ALLOCATOR_H_
+
+#include <jet/step_arena.h>
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+namespace jet {
+
+//! Default alignment in bytes of the array storage (a cache line).
+constexpr size_t kDefaultArrayAlignment = 64;
+
+//! Size in bytes of a transparent huge page.
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+//!
+//! \brief Allocates \p bytes of memory aligned to \p alignment.
+//!
+//! The allocation is padded to a multiple of the alignment, so vectorized
+//! loops can safely load a full packet at the end of the data. If huge pages
+//! are enabled and the allocation is at least kHugePageSize long, the memory is
+//! aligned to the huge page size and advised to be backed by transparent huge
+//! pages where the platform supports it.
+//!
+//! \param bytes        Number of bytes to allocate.
+//! \param alignment    Alignment which should be a power of two.
+//! \return Pointer to the allocated memory.
+//! \throw std::bad_alloc if the allocation fails.
+//!
+void* alignedMalloc(size_t bytes, size_t alignment);
+
+//! Frees the memory allocated by alignedMalloc.
+void alignedFree(void* ptr);
+
+//! Returns true if huge pages are used for large array allocations.
+bool isHugePagesEnabled();
+
+//!
+//! \brief Enables or disables huge pages for large array allocations.
+//!
+//! Huge pages reduce the TLB misses of the sweeps over large grids, but can
+//! increase the memory usage. The option is disabled by default and only
+//! affects the allocations made after the call.
+//!
+void setHugePagesEnabled(bool enabled);
+
+//!
+//! \brief STL-compatible allocator which aligns the storage.
+//!
+//! This allocator is the storage policy of Array1, Array2, and Array3, which
+//! makes the first element of each array start at a cache line boundary. This
+//! allows aligned vector loads in the stencil and BLAS loops without changing
+//! the contiguous memory layout that the array accessors rely on.
+//!
+//! The allocator can optionally draw the memory from a StepArena. Containers
+//! keep their allocators on copy and move assignment, so the data copied or
+//! moved into an array which persists across time-steps never points to the
+//! arena memory. The allocators are exchanged on swap.
+//!
+//! \tparam T           Type of the element.
+//! \tparam Alignment   Minimum alignment in bytes.
+//!
+template <typename T, size_t Alignment = kDefaultArrayAlignment>
+class AlignedAllocator {
+ public:
+    static_assert((Alignment & (Alignment - 1)) == 0,
+                  "Alignment should be a power of two.");
+
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    //! Alignment of the allocations in bytes.
+    static constexpr size_t kAlignment =
+        (Alignment > alignof(T)) ? Alignment : alignof(T);
+
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::false_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    //! Rebinds the allocator to another element type.
+    template <typename U>
+    struct rebind {
+        typedef AlignedAllocator<U, Alignment> other;
+    };
+
+    //! Constructs the allocator which allocates from the heap.
+    AlignedAllocator() = default;
+
+    //! Constructs the allocator which allocates from the given \p arena.
+    explicit AlignedAllocator(StepArena* arena) : _arena(arena) {}
+
+    //! Constructs the allocator from the allocator of another element type.
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>& other)
+        : _arena(other.arena()) {}
+
+    //! Returns the arena to allocate from, or nullptr for the heap.
+    StepArena* arena() const { return _arena; }
+
+    //! Allocates the storage for \p n elements.
+    T* allocate(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        if (_arena != nullptr) {
+            return static_cast<T*>(_arena->allocate(n * sizeof(T), kAlignment));
+        }
+        return static_cast<T*>(alignedMalloc(n * sizeof(T), kAlignment));
+    }
+
+    //! Deallocates the storage. The arena memory is released on reset.
+    void deallocate(T* ptr, size_t) {
+        if (_arena == nullptr) {
+            alignedFree(ptr);
+        }
+    }
+
+ private:
+    StepArena* _arena = nullptr;
+};
+
+//! Returns true if the allocators share the same memory source.
+template <typename T, typename U, size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>& a,
+                const AlignedAllocator<U, Alignment>& b) {
+    return a.arena() == b.arena();
+}
+
+//! Returns true if the allocators have different memory sources.
+template <typename T, typename U, size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>& a,
+                const AlignedAllocator<U, Alignment>& b) {
+    return !(a == b);
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_ALIGNED_ALLOCATOR_H_
@@ -47,9 +47,9 @@ class ApicSolver3 : public PicSolver3 {
     void transferFromGridsToParticles() override;
 
  private:
-    Array1<Vector3D> _cX;
-    Array1<Vector3D> _cY;
-    Array1<Vector3D> _cZ;
+    size_t _cXIdx;
+    size_t _cYIdx;
+    size_t _cZIdx;
 };
 
 //! Shared pointer type for the ApicSolver3.
@@ -7,6 +7,7 @@
 #ifndef INCLUDE_JET_ARRAY1_H_
 #define INCLUDE_JET_ARRAY1_H_
 
+#include <jet/aligned_allocator.h>
 #include <jet/array.h>
 #include <jet/array_accessor1.h>
 
@@ -23,14 +24,15 @@ namespace jet {
 //!
 //! This class represents 1-D array data structure. This class is a simple
 //! wrapper around std::vector with some additional features such as the array
-//! accessor object and parallel for-loop.
+//! accessor object and parallel for-loop. The storage is allocated with
+//! AlignedAllocator, so the first element is aligned to a cache line.
 //!
 //! \tparam T - Type to store in the array.
 //!
 template <typename T>
 class Array<T, 1> final {
  public:
-    typedef std::vector<T> ContainerType;
+    typedef std::vector<T, AlignedAllocator<T>> ContainerType;
     typedef typename ContainerType::iterator Iterator;
     typedef typename ContainerType::const_iterator ConstIterator;
 
@@ -42,6 +44,18 @@ class Array<T, 1> final {
     //! \param initVal Initial value of each array element.
     explicit Array(size_t size, const T& initVal = T());
 
+    //!
+    //! \brief Constructs 1-D array in the given step \p arena.
+    //!
+    //! The array allocates its storage from the arena, including when it is
+    //! resized. It should not outlive the time-step of the arena.
+    //!
+    //! \param size Initial size of the array.
+    //! \param initVal Initial value of each array element.
+    //! \param arena The arena to allocate from, or nullptr for the heap.
+    //!
+    Array(size_t size, const T& initVal, StepArena* arena);
+
     //!
     //! \brief Constructs 1-D array with given initializer list \p lst.
     //!
@@ -7,6 +7,7 @@
 #ifndef INCLUDE_JET_ARRAY2_H_
 #define INCLUDE_JET_ARRAY2_H_
 
+#include <jet/aligned_allocator.h>
 #include <jet/array.h>
 #include <jet/array_accessor2.h>
 #include <jet/size2.h>
@@ -41,7 +42,7 @@ namespace jet {
 template <typename T>
 class Array<T, 2> final {
  public:
-    typedef std::vector<T> ContainerType;
+    typedef std::vector<T, AlignedAllocator<T>> ContainerType;
     typedef typename ContainerType::iterator Iterator;
     typedef typename ContainerType::const_iterator ConstIterator;
 
@@ -60,6 +61,18 @@ class Array<T, 2> final {
     //! \param initVal Initial value of each array element.
     Array(size_t width, size_t height, const T& initVal = T());
 
+    //!
+    //! \brief Constructs 2-D array in the given step \p arena.
+    //!
+    //! The array allocates its storage from the arena, including when it is
+    //! resized. It should not outlive the time-step of the arena.
+    //!
+    //! \param size Initial size of the array.
+    //! \param initVal Initial value of each array element.
+    //! \param arena The arena to allocate from, or nullptr for the heap.
+    //!
+    Array(const Size2& size, const T& initVal, StepArena* arena);
+
     //!
     //! \brief Constructs 2-D array with given initializer list \p lst.
     //!
@@ -360,7 +373,7 @@ class Array<T, 2> final {
 
  private:
     Size2 _size;
-    std::vector<T> _data;
+    ContainerType _data;
 };
 
 //! Type alias for 2-D array.
@@ -7,6 +7,7 @@
 #ifndef INCLUDE_JET_ARRAY3_H_
 #define INCLUDE_JET_ARRAY3_H_
 
+#include <jet/aligned_allocator.h>
 #include <jet/array.h>
 #include <jet/array_accessor3.h>
 
@@ -42,7 +43,7 @@ namespace jet {
 template <typename T>
 class Array<T, 3> final {
  public:
-    typedef std::vector<T> ContainerType;
+    typedef std::vector<T, AlignedAllocator<T>> ContainerType;
     typedef typename ContainerType::iterator Iterator;
     typedef typename ContainerType::const_iterator ConstIterator;
 
@@ -63,6 +64,18 @@ class Array<T, 3> final {
     explicit Array(size_t width, size_t height, size_t depth,
                    const T& initVal = T());
 
+    //!
+    //! \brief Constructs 3-D array in the given step \p arena.
+    //!
+    //! The array allocates its storage from the arena, including when it is
+    //! resized. It should not outlive the time-step of the arena.
+    //!
+    //! \param size Initial size of the array.
+    //! \param initVal Initial value of each array element.
+    //! \param arena The arena to allocate from, or nullptr for the heap.
+    //!
+    Array(const Size3& size, const T& initVal, StepArena* arena);
+
     //!
     //! \brief Constructs 3-D array with given initializer list \p lst.
     //!
@@ -386,7 +399,7 @@ class Array<T, 3> final {
 
  private:
     Size3 _size;
-    std::vector<T> _data;
+    ContainerType _data;
 };
 
 //! Type alias for 3-D array.
@@ -65,6 +65,33 @@ void pcg(
     unsigned int* lastNumberOfIterations,
     double* lastResidualNorm);
 
+//!
+//! \brief Solves pre-conditioned conjugate gradient for multiple right-hand
+//!        sides sharing the matrix.
+//!
+//! Each system runs its own PCG iteration with its own step sizes, but the
+//! matrix and the preconditioner are applied to all the vectors at once. The
+//! iteration continues until all the systems converge; the converged ones
+//! stop updating. BlasType takes the per-vector scalars as std::vector<double>
+//! like FdmMultiBlas3, and the reported residual norm is the largest one.
+//!
+template <
+    typename BlasType,
+    typename PrecondType>
+void pcgMultiple(
+    const typename BlasType::MatrixType& A,
+    const typename BlasType::VectorType& b,
+    unsigned int maxNumberOfIterations,
+    double tolerance,
+    PrecondType* M,
+    typename BlasType::VectorType* x,
+    typename BlasType::VectorType* r,
+    typename BlasType::VectorType* d,
+    typename BlasType::VectorType* q,
+    typename BlasType::VectorType* s,
+    unsigned int* lastNumberOfIterations,
+    double* lastResidualNorm);
+
 }  // namespace jet
 
 #include "detail/cg-inl.h"
@@ -0,0 +1,61 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_CLOSEST_POINT_EXTRAPOLATION3_H_
+#define INCLUDE_JET_CLOSEST_POINT_EXTRAPOLATION3_H_
+
+#include <jet/array_accessor3.h>
+#include <jet/scalar_field3.h>
+#include <jet/vector3.h>
+
+namespace jet {
+
+//! Methods for extrapolating the fields outside of the valid region.
+enum class ExtrapolationType {
+    //! Propagates the values front by front from the valid region, such as
+    //! the fast marching or the iterative neighbor averaging.
+    kPropagation,
+
+    //! Samples the values at the closest points on the interface, which
+    //! processes each point independently.
+    kClosestPoint
+};
+
+//!
+//! \brief Extrapolates 3-D data to the closest points of the valid region.
+//!
+//! For each invalid point within \p maxDistance outside of the interface,
+//! this function projects the point onto the interface along the gradient
+//! of \p sdf and samples the input there using only the valid points of the
+//! trilinear stencil. The valid region is the negative side of \p sdf, and
+//! the points are processed in parallel without any front propagation. The
+//! invalid points without any valid sample are left unchanged.
+//!
+//! Only the invalid points are written and only the valid points are read,
+//! so \p input and \p output can refer to the same array.
+//!
+//! \param input        Data to extrapolate.
+//! \param valid        Set 1 if valid, else 0.
+//! \param gridSpacing  Grid spacing of the data points.
+//! \param dataOrigin   Position of the data point at (0, 0, 0).
+//! \param sdf          Signed-distance field which is negative in the valid
+//!                     region.
+//! \param maxDistance  Max range of extrapolation.
+//! \param output       Extrapolated output.
+//!
+template <typename T>
+void extrapolateToClosestPoints(const ConstArrayAccessor3<T>& input,
+                                const ConstArrayAccessor3<char>& valid,
+                                const Vector3D& gridSpacing,
+                                const Vector3D& dataOrigin,
+                                const ScalarField3& sdf, double maxDistance,
+                                ArrayAccessor3<T> output);
+
+}  // namespace jet
+
+#include "detail/closest_point_extrapolation3-inl.h"
+
+#endif  // INCLUDE_JET_CLOSEST_POINT_EXTRAPOLATION3_H_
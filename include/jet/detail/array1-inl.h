@@ -24,6 +24,12 @@ Array<T, 1>::Array(size_t size, const T& initVal) {
     resize(size, initVal);
 }
 
+template <typename T>
+Array<T, 1>::Array(size_t size, const T& initVal, StepArena* arena)
+    : _data(AlignedAllocator<T>(arena)) {
+    resize(size, initVal);
+}
+
 template <typename T>
 Array<T, 1>::Array(const std::initializer_list<T>& lst) {
     set(lst);
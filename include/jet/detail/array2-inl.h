@@ -29,6 +29,12 @@ Array<T, 2>::Array(size_t width, size_t height, const T& initVal) {
     resize(width, height, initVal);
 }
 
+template <typename T>
+Array<T, 2>::Array(const Size2& size, const T& initVal, StepArena* arena)
+    : _data(AlignedAllocator<T>(arena)) {
+    resize(size, initVal);
+}
+
 template <typename T>
 Array<T, 2>::Array(const std::initializer_list<std::initializer_list<T>>& lst) {
     set(lst);
@@ -84,18 +90,23 @@ void Array<T, 2>::clear() {
 
 template <typename T>
 void Array<T, 2>::resize(const Size2& size, const T& initVal) {
-    Array grid;
-    grid._data.resize(size.x * size.y, initVal);
-    grid._size = size;
+    // Keeps the storage if the size is the same
+    if (size == _size) {
+        return;
+    }
+
+    // Keeps the allocator so that an arena array stays in the arena
+    ContainerType data(size.x * size.y, initVal, _data.get_allocator());
     size_t iMin = std::min(size.x, _size.x);
     size_t jMin = std::min(size.y, _size.y);
     for (size_t j = 0; j < jMin; ++j) {
         for (size_t i = 0; i < iMin; ++i) {
-            grid(i, j) = at(i, j);
+            data[i + size.x * j] = at(i, j);
         }
     }
 
-    swap(grid);
+    _data.swap(data);
+    _size = size;
 }
 
 template <typename T>
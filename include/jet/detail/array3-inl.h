@@ -30,6 +30,12 @@ Array<T, 3>::Array(size_t width, size_t height, size_t depth,
     resize(width, height, depth, initVal);
 }
 
+template <typename T>
+Array<T, 3>::Array(const Size3& size, const T& initVal, StepArena* arena)
+    : _data(AlignedAllocator<T>(arena)) {
+    resize(size, initVal);
+}
+
 template <typename T>
 Array<T, 3>::Array(const std::initializer_list<
                    std::initializer_list<std::initializer_list<T>>>& lst) {
@@ -93,21 +99,27 @@ void Array<T, 3>::clear() {
 
 template <typename T>
 void Array<T, 3>::resize(const Size3& size, const T& initVal) {
-    Array grid;
-    grid._data.resize(size.x * size.y * size.z, initVal);
-    grid._size = size;
+    // Keeps the storage if the size is the same
+    if (size == _size) {
+        return;
+    }
+
+    // Keeps the allocator so that an arena array stays in the arena
+    ContainerType data(size.x * size.y * size.z, initVal,
+                       _data.get_allocator());
     size_t iMin = std::min(size.x, _size.x);
     size_t jMin = std::min(size.y, _size.y);
     size_t kMin = std::min(size.z, _size.z);
     for (size_t k = 0; k < kMin; ++k) {
         for (size_t j = 0; j < jMin; ++j) {
             for (size_t i = 0; i < iMin; ++i) {
-                grid(i, j, k) = at(i, j, k);
+                data[i + size.x * (j + size.y * k)] = at(i, j, k);
             }
         }
     }
 
-    swap(grid);
+    _data.swap(data);
+    _size = size;
 }
 
 template <typename T>
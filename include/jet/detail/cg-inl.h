@@ -8,7 +8,10 @@
 #define INCLUDE_JET_DETAIL_CG_INL_H_
 
 #include <jet/constants.h>
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <vector>
 
 namespace jet {
 
@@ -123,6 +126,116 @@ void cg(
         lastResidualNorm);
 }
 
+template <
+    typename BlasType,
+    typename PrecondType>
+void pcgMultiple(
+    const typename BlasType::MatrixType& A,
+    const typename BlasType::VectorType& b,
+    unsigned int maxNumberOfIterations,
+    double tolerance,
+    PrecondType* M,
+    typename BlasType::VectorType* x,
+    typename BlasType::VectorType* r,
+    typename BlasType::VectorType* d,
+    typename BlasType::VectorType* q,
+    typename BlasType::VectorType* s,
+    unsigned int* lastNumberOfIterations,
+    double* lastResidualNorm) {
+    typedef typename BlasType::ScalarType ScalarType;
+
+    // Clear
+    BlasType::set(0, r);
+    BlasType::set(0, d);
+    BlasType::set(0, q);
+    BlasType::set(0, s);
+
+    // r = b - Ax
+    BlasType::residual(A, *x, b, r);
+
+    // d = M^-1r
+    M->solve(*r, d);
+
+    // sigmaNew = r.d
+    ScalarType sigmaNew;
+    BlasType::dot(*r, *d, &sigmaNew);
+
+    const size_t n = sigmaNew.size();
+    ScalarType sigmaOld(n), dq(n), alpha(n), minusAlpha(n), beta(n);
+    std::vector<char> isActive(n);
+
+    unsigned int iter = 0;
+    bool trigger = false;
+    while (iter < maxNumberOfIterations) {
+        bool isConverged = true;
+        for (size_t l = 0; l < n; ++l) {
+            isActive[l] = sigmaNew[l] > square(tolerance);
+            isConverged &= !isActive[l];
+        }
+        if (isConverged) {
+            break;
+        }
+
+        // q = Ad
+        BlasType::mvm(A, *d, q);
+
+        // alpha = sigmaNew/d.q
+        BlasType::dot(*d, *q, &dq);
+        for (size_t l = 0; l < n; ++l) {
+            alpha[l] = isActive[l] ? sigmaNew[l] / dq[l] : 0.0;
+            minusAlpha[l] = -alpha[l];
+        }
+
+        // x = x + alpha*d
+        BlasType::axpy(alpha, *d, *x, x);
+
+        // if i is divisible by 50...
+        if (trigger || (iter % 50 == 0 && iter > 0)) {
+            // r = b - Ax
+            BlasType::residual(A, *x, b, r);
+            trigger = false;
+        } else {
+            // r = r - alpha*q
+            BlasType::axpy(minusAlpha, *q, *r, r);
+        }
+
+        // s = M^-1r
+        M->solve(*r, s);
+
+        // sigmaOld = sigmaNew
+        sigmaOld = sigmaNew;
+
+        // sigmaNew = r.s
+        BlasType::dot(*r, *s, &sigmaNew);
+
+        // beta = sigmaNew/sigmaOld, which restarts the converged ones
+        for (size_t l = 0; l < n; ++l) {
+            if (isActive[l]) {
+                if (sigmaNew[l] > sigmaOld[l]) {
+                    trigger = true;
+                }
+                beta[l] = sigmaNew[l] / sigmaOld[l];
+            } else {
+                beta[l] = 0.0;
+            }
+        }
+
+        // d = s + beta*d
+        BlasType::axpy(beta, *d, *s, d);
+
+        ++iter;
+    }
+
+    *lastNumberOfIterations = iter;
+
+    // std::fabs(sigmaNew) - Workaround for negative zero
+    *lastResidualNorm = 0.0;
+    for (size_t l = 0; l < n; ++l) {
+        *lastResidualNorm =
+            std::max(*lastResidualNorm, std::sqrt(std::fabs(sigmaNew[l])));
+    }
+}
+
 }  // namespace jet
 
 #endif  // INCLUDE_JET_DETAIL_CG_INL_H_
@@ -0,0 +1,115 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_CLOSEST_POINT_EXTRAPOLATION3_INL_H_
+#define INCLUDE_JET_DETAIL_CLOSEST_POINT_EXTRAPOLATION3_INL_H_
+
+#include <jet/constants.h>
+#include <jet/math_utils.h>
+#include <jet/parallel.h>
+#include <jet/type_helpers.h>
+
+#include <algorithm>
+
+namespace jet {
+
+namespace internal {
+
+// Trilinear interpolation which only takes the valid points of the stencil.
+// Returns false if none of the points is valid.
+template <typename T>
+bool sampleValidPoints(const ConstArrayAccessor3<T>& input,
+                       const ConstArrayAccessor3<char>& valid,
+                       const Vector3D& pt, T* result) {
+    const Size3 size = input.size();
+    ssize_t i, j, k;
+    double fx, fy, fz;
+    getBarycentric(pt.x, 0, static_cast<ssize_t>(size.x) - 1, &i, &fx);
+    getBarycentric(pt.y, 0, static_cast<ssize_t>(size.y) - 1, &j, &fy);
+    getBarycentric(pt.z, 0, static_cast<ssize_t>(size.z) - 1, &k, &fz);
+
+    const size_t is[2] = {static_cast<size_t>(i),
+                          std::min(static_cast<size_t>(i) + 1, size.x - 1)};
+    const size_t js[2] = {static_cast<size_t>(j),
+                          std::min(static_cast<size_t>(j) + 1, size.y - 1)};
+    const size_t ks[2] = {static_cast<size_t>(k),
+                          std::min(static_cast<size_t>(k) + 1, size.z - 1)};
+    const double wx[2] = {1.0 - fx, fx};
+    const double wy[2] = {1.0 - fy, fy};
+    const double wz[2] = {1.0 - fz, fz};
+
+    T sum = zero<T>();
+    double weightSum = 0.0;
+    for (int c = 0; c < 2; ++c) {
+        for (int b = 0; b < 2; ++b) {
+            for (int a = 0; a < 2; ++a) {
+                if (valid(is[a], js[b], ks[c])) {
+                    const double w = wx[a] * wy[b] * wz[c];
+                    sum += w * input(is[a], js[b], ks[c]);
+                    weightSum += w;
+                }
+            }
+        }
+    }
+
+    if (weightSum > kEpsilonD) {
+        *result = sum / weightSum;
+        return true;
+    }
+    return false;
+}
+
+}  // namespace internal
+
+template <typename T>
+void extrapolateToClosestPoints(const ConstArrayAccessor3<T>& input,
+                                const ConstArrayAccessor3<char>& valid,
+                                const Vector3D& gridSpacing,
+                                const Vector3D& dataOrigin,
+                                const ScalarField3& sdf, double maxDistance,
+                                ArrayAccessor3<T> output) {
+    const Size3 size = input.size();
+
+    JET_ASSERT(size == valid.size());
+    JET_ASSERT(size == output.size());
+
+    // The sample point is placed slightly inside of the interface so that
+    // the stencil is mostly covered by the valid points.
+    const double h = max3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
+    const double depth = 0.5 * h;
+
+    parallelFor(kZeroSize, size.x, kZeroSize, size.y, kZeroSize, size.z,
+                [&](size_t i, size_t j, size_t k) {
+        if (valid(i, j, k)) {
+            return;
+        }
+
+        const Vector3D x = dataOrigin + gridSpacing * Vector3D(i, j, k);
+        const double phi = sdf.sample(x);
+        if (phi < 0.0 || phi > maxDistance) {
+            return;
+        }
+
+        const Vector3D g = sdf.gradient(x);
+        const double gLength = g.length();
+        if (gLength < kEpsilonD) {
+            return;
+        }
+
+        const Vector3D closestPoint = x - (phi + depth) / gLength * g;
+
+        T value = zero<T>();
+        if (internal::sampleValidPoints(
+                input, valid, (closestPoint - dataOrigin) / gridSpacing,
+                &value)) {
+            output(i, j, k) = value;
+        }
+    });
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_CLOSEST_POINT_EXTRAPOLATION3_INL_H_
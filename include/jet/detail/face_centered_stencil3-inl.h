@@ -0,0 +1,93 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_FACE_CENTERED_STENCIL3_INL_H_
+#define INCLUDE_JET_DETAIL_FACE_CENTERED_STENCIL3_INL_H_
+
+namespace jet {
+
+template <typename Kernel>
+template <typename T>
+double FaceStencil3<Kernel>::sample(const ConstArrayAccessor3<T>& data) const {
+    double result = 0.0;
+    for (size_t c = 0; c < Kernel::kWidth; ++c) {
+        for (size_t b = 0; b < Kernel::kWidth; ++b) {
+            const double wyz = y.weights[b] * z.weights[c];
+            for (size_t a = 0; a < Kernel::kWidth; ++a) {
+                result += x.weights[a] * wyz *
+                          static_cast<double>(
+                              data(x.indices[a], y.indices[b], z.indices[c]));
+            }
+        }
+    }
+    return result;
+}
+
+template <typename Kernel>
+template <typename T>
+Vector3D FaceStencil3<Kernel>::gradient(const ConstArrayAccessor3<T>& data,
+                                        const Vector3D& invGridSpacing) const {
+    Vector3D result;
+    for (size_t c = 0; c < Kernel::kWidth; ++c) {
+        for (size_t b = 0; b < Kernel::kWidth; ++b) {
+            for (size_t a = 0; a < Kernel::kWidth; ++a) {
+                const double d = static_cast<double>(
+                    data(x.indices[a], y.indices[b], z.indices[c]));
+                result.x += x.derivatives[a] * y.weights[b] * z.weights[c] * d;
+                result.y += x.weights[a] * y.derivatives[b] * z.weights[c] * d;
+                result.z += x.weights[a] * y.weights[b] * z.derivatives[c] * d;
+            }
+        }
+    }
+    return result * invGridSpacing;
+}
+
+template <typename Kernel>
+template <typename Callback>
+void FaceStencil3<Kernel>::forEachSample(const Callback& func) const {
+    for (size_t c = 0; c < Kernel::kWidth; ++c) {
+        for (size_t b = 0; b < Kernel::kWidth; ++b) {
+            const double wyz = y.weights[b] * z.weights[c];
+            for (size_t a = 0; a < Kernel::kWidth; ++a) {
+                func(x.indices[a], y.indices[b], z.indices[c],
+                     x.weights[a] * wyz);
+            }
+        }
+    }
+}
+
+template <typename Kernel>
+FaceCenteredStencil3<Kernel>::FaceCenteredStencil3() {}
+
+template <typename Kernel>
+FaceCenteredStencil3<Kernel>::FaceCenteredStencil3(
+    const Vector3D& pt, const Vector3D& origin,
+    const Vector3D& invGridSpacing, const Size3& resolution) {
+    const Vector3D node = (pt - origin) * invGridSpacing;
+
+    const AxisStencil<Kernel> xNode(node.x, resolution.x + 1);
+    const AxisStencil<Kernel> yNode(node.y, resolution.y + 1);
+    const AxisStencil<Kernel> zNode(node.z, resolution.z + 1);
+    const AxisStencil<Kernel> xCenter(node.x - 0.5, resolution.x);
+    const AxisStencil<Kernel> yCenter(node.y - 0.5, resolution.y);
+    const AxisStencil<Kernel> zCenter(node.z - 0.5, resolution.z);
+
+    u = {xNode, yCenter, zCenter};
+    v = {xCenter, yNode, zCenter};
+    w = {xCenter, yCenter, zNode};
+}
+
+template <typename Kernel>
+template <typename T>
+Vector3D FaceCenteredStencil3<Kernel>::sample(
+    const ConstArrayAccessor3<T>& uData, const ConstArrayAccessor3<T>& vData,
+    const ConstArrayAccessor3<T>& wData) const {
+    return Vector3D(u.sample(uData), v.sample(vData), w.sample(wData));
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_FACE_CENTERED_STENCIL3_INL_H_
@@ -12,6 +12,7 @@
 #include <jet/matrix_csr.h>
 #include <jet/parallel.h>
 
+#include <algorithm>
 #include <numeric>
 
 namespace jet {
@@ -140,7 +141,8 @@ void MatrixCsr<T>::clear() {
 
 template <typename T>
 void MatrixCsr<T>::set(const T& s) {
-    std::fill(_nonZeros.begin(), _nonZeros.end(), s);
+    parallelFill(_nonZeros.begin(), _nonZeros.end(), s,
+                 executionPolicyForSize(_nonZeros.size()));
 }
 
 template <typename T>
@@ -195,26 +197,43 @@ template <typename E>
 void MatrixCsr<T>::compress(const MatrixExpression<T, E>& other, T epsilon) {
     size_t numRows = other.rows();
     size_t numCols = other.cols();
-
-    _size = {numRows, numCols};
-    _nonZeros.clear();
-    _columnIndices.clear();
+    const ExecutionPolicy policy = executionPolicyForSize(numRows * numCols);
 
     const E& expression = other();
 
-    for (size_t i = 0; i < numRows; ++i) {
-        _rowPointers.push_back(_nonZeros.size());
+    // Evaluates the rows in parallel to the row-local buffers
+    std::vector<NonZeroContainerType> rowNonZeros(numRows);
+    std::vector<IndexContainerType> rowColumnIndices(numRows);
+    parallelFor(kZeroSize, numRows,
+                [&](size_t i) {
+                    for (size_t j = 0; j < numCols; ++j) {
+                        T val = expression(i, j);
+                        if (std::fabs(val) > epsilon) {
+                            rowNonZeros[i].push_back(val);
+                            rowColumnIndices[i].push_back(j);
+                        }
+                    }
+                },
+                policy);
 
-        for (size_t j = 0; j < numCols; ++j) {
-            T val = expression(i, j);
-            if (std::fabs(val) > epsilon) {
-                _nonZeros.push_back(val);
-                _columnIndices.push_back(j);
-            }
-        }
+    _size = {numRows, numCols};
+    _rowPointers.resize(numRows + 1);
+    _rowPointers[0] = 0;
+    for (size_t i = 0; i < numRows; ++i) {
+        _rowPointers[i + 1] = _rowPointers[i] + rowNonZeros[i].size();
     }
 
-    _rowPointers.push_back(_nonZeros.size());
+    _nonZeros.resize(_rowPointers[numRows]);
+    _columnIndices.resize(_rowPointers[numRows]);
+    parallelFor(kZeroSize, numRows,
+                [&](size_t i) {
+                    std::copy(rowNonZeros[i].begin(), rowNonZeros[i].end(),
+                              _nonZeros.begin() + _rowPointers[i]);
+                    std::copy(rowColumnIndices[i].begin(),
+                              rowColumnIndices[i].end(),
+                              _columnIndices.begin() + _rowPointers[i]);
+                },
+                policy);
 }
 
 template <typename T>
@@ -477,7 +496,8 @@ template <typename T>
 MatrixCsr<T> MatrixCsr<T>::add(const T& s) const {
     MatrixCsr ret(*this);
     parallelFor(kZeroSize, ret._nonZeros.size(),
-                [&](size_t i) { ret._nonZeros[i] += s; });
+                [&](size_t i) { ret._nonZeros[i] += s; },
+                executionPolicyForSize(ret._nonZeros.size()));
     return ret;
 }
 
@@ -490,7 +510,8 @@ template <typename T>
 MatrixCsr<T> MatrixCsr<T>::sub(const T& s) const {
     MatrixCsr ret(*this);
     parallelFor(kZeroSize, ret._nonZeros.size(),
-                [&](size_t i) { ret._nonZeros[i] -= s; });
+                [&](size_t i) { ret._nonZeros[i] -= s; },
+                executionPolicyForSize(ret._nonZeros.size()));
     return ret;
 }
 
@@ -503,7 +524,8 @@ template <typename T>
 MatrixCsr<T> MatrixCsr<T>::mul(const T& s) const {
     MatrixCsr ret(*this);
     parallelFor(kZeroSize, ret._nonZeros.size(),
-                [&](size_t i) { ret._nonZeros[i] *= s; });
+                [&](size_t i) { ret._nonZeros[i] *= s; },
+                executionPolicyForSize(ret._nonZeros.size()));
     return ret;
 }
 
@@ -521,11 +543,95 @@ MatrixCsrMatrixMul<T, ME> MatrixCsr<T>::mul(
     return MatrixCsrMatrixMul<T, ME>(*this, m());
 }
 
+template <typename T>
+MatrixCsr<T> MatrixCsr<T>::mul(const MatrixCsr& m) const {
+    JET_ASSERT(cols() == m.rows());
+
+    const size_t numRows = rows();
+    const size_t numCols = m.cols();
+    const ExecutionPolicy policy =
+        executionPolicyForSize(numberOfNonZeros() + m.numberOfNonZeros());
+
+    MatrixCsr ret;
+    ret._size = Size2(numRows, numCols);
+    ret._rowPointers.assign(numRows + 1, 0);
+
+    // Symbolic phase: counts the distinct columns of each row of the product.
+    // Each chunk of rows owns a marker array which remembers the last row that
+    // visited a column.
+    parallelRangeFor(
+        kZeroSize, numRows,
+        [&](size_t begin, size_t end) {
+            std::vector<size_t> marker(numCols, kMaxSize);
+            for (size_t i = begin; i < end; ++i) {
+                size_t count = 0;
+                for (size_t kk = _rowPointers[i]; kk < _rowPointers[i + 1];
+                     ++kk) {
+                    const size_t k = _columnIndices[kk];
+                    for (size_t jj = m._rowPointers[k];
+                         jj < m._rowPointers[k + 1]; ++jj) {
+                        const size_t j = m._columnIndices[jj];
+                        if (marker[j] != i) {
+                            marker[j] = i;
+                            ++count;
+                        }
+                    }
+                }
+                ret._rowPointers[i + 1] = count;
+            }
+        },
+        policy);
+
+    std::partial_sum(ret._rowPointers.begin(), ret._rowPointers.end(),
+                     ret._rowPointers.begin());
+    ret._nonZeros.resize(ret._rowPointers[numRows]);
+    ret._columnIndices.resize(ret._rowPointers[numRows]);
+
+    // Numeric phase: accumulates the products to a dense row buffer, then
+    // writes them out in the column order.
+    parallelRangeFor(
+        kZeroSize, numRows,
+        [&](size_t begin, size_t end) {
+            std::vector<size_t> marker(numCols, kMaxSize);
+            std::vector<T> accumulator(numCols);
+            for (size_t i = begin; i < end; ++i) {
+                const size_t rowBegin = ret._rowPointers[i];
+                size_t rowEnd = rowBegin;
+                for (size_t kk = _rowPointers[i]; kk < _rowPointers[i + 1];
+                     ++kk) {
+                    const size_t k = _columnIndices[kk];
+                    const T aik = _nonZeros[kk];
+                    for (size_t jj = m._rowPointers[k];
+                         jj < m._rowPointers[k + 1]; ++jj) {
+                        const size_t j = m._columnIndices[jj];
+                        if (marker[j] != i) {
+                            marker[j] = i;
+                            accumulator[j] = aik * m._nonZeros[jj];
+                            ret._columnIndices[rowEnd++] = j;
+                        } else {
+                            accumulator[j] += aik * m._nonZeros[jj];
+                        }
+                    }
+                }
+
+                std::sort(ret._columnIndices.begin() + rowBegin,
+                          ret._columnIndices.begin() + rowEnd);
+                for (size_t jj = rowBegin; jj < rowEnd; ++jj) {
+                    ret._nonZeros[jj] = accumulator[ret._columnIndices[jj]];
+                }
+            }
+        },
+        policy);
+
+    return ret;
+}
+
 template <typename T>
 MatrixCsr<T> MatrixCsr<T>::div(const T& s) const {
     MatrixCsr ret(*this);
     parallelFor(kZeroSize, ret._nonZeros.size(),
-                [&](size_t i) { ret._nonZeros[i] /= s; });
+                [&](size_t i) { ret._nonZeros[i] /= s; },
+                executionPolicyForSize(ret._nonZeros.size()));
     return ret;
 }
 
@@ -543,7 +649,8 @@ template <typename T>
 MatrixCsr<T> MatrixCsr<T>::rsub(const T& s) const {
     MatrixCsr ret(*this);
     parallelFor(kZeroSize, ret._nonZeros.size(),
-                [&](size_t i) { ret._nonZeros[i] = s - ret._nonZeros[i]; });
+                [&](size_t i) { ret._nonZeros[i] = s - ret._nonZeros[i]; },
+                executionPolicyForSize(ret._nonZeros.size()));
     return ret;
 }
 
@@ -561,14 +668,16 @@ template <typename T>
 MatrixCsr<T> MatrixCsr<T>::rdiv(const T& s) const {
     MatrixCsr ret(*this);
     parallelFor(kZeroSize, ret._nonZeros.size(),
-                [&](size_t i) { ret._nonZeros[i] = s / ret._nonZeros[i]; });
+                [&](size_t i) { ret._nonZeros[i] = s / ret._nonZeros[i]; },
+                executionPolicyForSize(ret._nonZeros.size()));
     return ret;
 }
 
 template <typename T>
 void MatrixCsr<T>::iadd(const T& s) {
     parallelFor(kZeroSize, _nonZeros.size(),
-                [&](size_t i) { _nonZeros[i] += s; });
+                [&](size_t i) { _nonZeros[i] += s; },
+                executionPolicyForSize(_nonZeros.size()));
 }
 
 template <typename T>
@@ -579,7 +688,8 @@ void MatrixCsr<T>::iadd(const MatrixCsr& m) {
 template <typename T>
 void MatrixCsr<T>::isub(const T& s) {
     parallelFor(kZeroSize, _nonZeros.size(),
-                [&](size_t i) { _nonZeros[i] -= s; });
+                [&](size_t i) { _nonZeros[i] -= s; },
+                executionPolicyForSize(_nonZeros.size()));
 }
 
 template <typename T>
@@ -590,20 +700,22 @@ void MatrixCsr<T>::isub(const MatrixCsr& m) {
 template <typename T>
 void MatrixCsr<T>::imul(const T& s) {
     parallelFor(kZeroSize, _nonZeros.size(),
-                [&](size_t i) { _nonZeros[i] *= s; });
+                [&](size_t i) { _nonZeros[i] *= s; },
+                executionPolicyForSize(_nonZeros.size()));
 }
 
 template <typename T>
 template <typename ME>
 void MatrixCsr<T>::imul(const MatrixExpression<T, ME>& m) {
-    MatrixCsrD result = mul(m);
+    MatrixCsr result = mul(m());
     *this = std::move(result);
 }
 
 template <typename T>
 void MatrixCsr<T>::idiv(const T& s) {
     parallelFor(kZeroSize, _nonZeros.size(),
-                [&](size_t i) { _nonZeros[i] /= s; });
+                [&](size_t i) { _nonZeros[i] /= s; },
+                executionPolicyForSize(_nonZeros.size()));
 }
 
 template <typename T>
@@ -616,7 +728,8 @@ T MatrixCsr<T>::sum() const {
                               }
                               return result;
                           },
-                          std::plus<T>());
+                          std::plus<T>(),
+                          executionPolicyForSize(numberOfNonZeros()));
 }
 
 template <typename T>
@@ -636,7 +749,8 @@ T MatrixCsr<T>::min() const {
                               }
                               return result;
                           },
-                          _min);
+                          _min,
+                          executionPolicyForSize(numberOfNonZeros()));
 }
 
 template <typename T>
@@ -651,7 +765,8 @@ T MatrixCsr<T>::max() const {
                               }
                               return result;
                           },
-                          _max);
+                          _max,
+                          executionPolicyForSize(numberOfNonZeros()));
 }
 
 template <typename T>
@@ -665,7 +780,8 @@ T MatrixCsr<T>::absmin() const {
                               }
                               return result;
                           },
-                          jet::absmin<T>);
+                          jet::absmin<T>,
+                          executionPolicyForSize(numberOfNonZeros()));
 }
 
 template <typename T>
@@ -678,7 +794,8 @@ T MatrixCsr<T>::absmax() const {
                               }
                               return result;
                           },
-                          jet::absmax<T>);
+                          jet::absmax<T>,
+                          executionPolicyForSize(numberOfNonZeros()));
 }
 
 template <typename T>
@@ -692,7 +809,8 @@ T MatrixCsr<T>::trace() const {
                               }
                               return result;
                           },
-                          std::plus<T>());
+                          std::plus<T>(),
+                          executionPolicyForSize(rows()));
 }
 
 template <typename T>
@@ -705,13 +823,16 @@ MatrixCsr<U> MatrixCsr<T>::castTo() const {
     auto ci = ret.columnIndicesBegin();
     auto rp = ret.rowPointersBegin();
 
-    parallelFor(kZeroSize, _nonZeros.size(), [&](size_t i) {
-        nnz[i] = static_cast<U>(_nonZeros[i]);
-        ci[i] = _columnIndices[i];
-    });
+    parallelFor(kZeroSize, _nonZeros.size(),
+                [&](size_t i) {
+                    nnz[i] = static_cast<U>(_nonZeros[i]);
+                    ci[i] = _columnIndices[i];
+                },
+                executionPolicyForSize(_nonZeros.size()));
 
     parallelFor(kZeroSize, _rowPointers.size(),
-                [&](size_t i) { rp[i] = _rowPointers[i]; });
+                [&](size_t i) { rp[i] = _rowPointers[i]; },
+                executionPolicyForSize(_rowPointers.size()));
 
     return ret;
 }
@@ -837,43 +958,70 @@ template <typename Op>
 MatrixCsr<T> MatrixCsr<T>::binaryOp(const MatrixCsr& m, Op op) const {
     JET_ASSERT(_size == m._size);
 
-    MatrixCsr ret;
+    const size_t numRows = _size.x;
+    const ExecutionPolicy policy =
+        executionPolicyForSize(numberOfNonZeros() + m.numberOfNonZeros());
 
-    for (size_t i = 0; i < _size.x; ++i) {
-        std::vector<size_t> col;
-        std::vector<double> nnz;
-
-        auto colIterA = _columnIndices.begin() + _rowPointers[i];
-        auto colIterB = m._columnIndices.begin() + m._rowPointers[i];
-        auto colEndA = _columnIndices.begin() + _rowPointers[i + 1];
-        auto colEndB = m._columnIndices.begin() + m._rowPointers[i + 1];
-        auto nnzIterA = _nonZeros.begin() + _rowPointers[i];
-        auto nnzIterB = m._nonZeros.begin() + m._rowPointers[i];
-
-        while (colIterA != colEndA || colIterB != colEndB) {
-            if (colIterB == colEndB || *colIterA < *colIterB) {
-                col.push_back(*colIterA);
-                nnz.push_back(op(*nnzIterA, 0));
-                ++colIterA;
-                ++nnzIterA;
-            } else if (colIterA == colEndA || *colIterA > *colIterB) {
-                col.push_back(*colIterB);
-                nnz.push_back(op(0, *nnzIterB));
-                ++colIterB;
-                ++nnzIterB;
-            } else {
-                JET_ASSERT(*colIterA == *colIterB);
-                col.push_back(*colIterB);
-                nnz.push_back(op(*nnzIterA, *nnzIterB));
-                ++colIterA;
-                ++nnzIterA;
-                ++colIterB;
-                ++nnzIterB;
-            }
-        }
-
-        ret.addRow(nnz, col);
-    }
+    MatrixCsr ret;
+    ret._size = _size;
+    ret._rowPointers.assign(numRows + 1, 0);
+
+    // Counts the union of the column indices of each row
+    parallelFor(kZeroSize, numRows,
+                [&](size_t i) {
+                    size_t a = _rowPointers[i];
+                    size_t b = m._rowPointers[i];
+                    const size_t aEnd = _rowPointers[i + 1];
+                    const size_t bEnd = m._rowPointers[i + 1];
+                    size_t count = 0;
+                    while (a < aEnd && b < bEnd) {
+                        const size_t colA = _columnIndices[a];
+                        const size_t colB = m._columnIndices[b];
+                        a += (colA <= colB) ? 1 : 0;
+                        b += (colB <= colA) ? 1 : 0;
+                        ++count;
+                    }
+                    ret._rowPointers[i + 1] = count + (aEnd - a) + (bEnd - b);
+                },
+                policy);
+
+    std::partial_sum(ret._rowPointers.begin(), ret._rowPointers.end(),
+                     ret._rowPointers.begin());
+    ret._nonZeros.resize(ret._rowPointers[numRows]);
+    ret._columnIndices.resize(ret._rowPointers[numRows]);
+
+    // Merges the rows
+    parallelFor(kZeroSize, numRows,
+                [&](size_t i) {
+                    size_t a = _rowPointers[i];
+                    size_t b = m._rowPointers[i];
+                    const size_t aEnd = _rowPointers[i + 1];
+                    const size_t bEnd = m._rowPointers[i + 1];
+                    size_t k = ret._rowPointers[i];
+
+                    while (a < aEnd || b < bEnd) {
+                        const size_t colA =
+                            (a < aEnd) ? _columnIndices[a] : kMaxSize;
+                        const size_t colB =
+                            (b < bEnd) ? m._columnIndices[b] : kMaxSize;
+                        if (colA < colB) {
+                            ret._columnIndices[k] = colA;
+                            ret._nonZeros[k] = op(_nonZeros[a], T(0));
+                            ++a;
+                        } else if (colA > colB) {
+                            ret._columnIndices[k] = colB;
+                            ret._nonZeros[k] = op(T(0), m._nonZeros[b]);
+                            ++b;
+                        } else {
+                            ret._columnIndices[k] = colA;
+                            ret._nonZeros[k] = op(_nonZeros[a], m._nonZeros[b]);
+                            ++a;
+                            ++b;
+                        }
+                        ++k;
+                    }
+                },
+                policy);
 
     return ret;
 }
@@ -937,6 +1085,11 @@ MatrixCsrMatrixMul<T, ME> operator*(const MatrixCsr<T>& a,
     return a.mul(b);
 }
 
+template <typename T>
+MatrixCsr<T> operator*(const MatrixCsr<T>& a, const MatrixCsr<T>& b) {
+    return a.mul(b);
+}
+
 template <typename T>
 MatrixCsr<T> operator/(const MatrixCsr<T>& a, T b) {
     return a.div(b);
@@ -241,12 +241,20 @@ size_t MatrixVectorMul<T, ME, VE>::size() const {
 
 template <typename T, typename ME, typename VE>
 T MatrixVectorMul<T, ME, VE>::operator[](size_t i) const {
-    T sum = 0;
+    // Independent partial sums to hide the latency of the additions
+    T sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
     const size_t n = _m.cols();
-    for (size_t j = 0; j < n; ++j) {
-        sum += _m(i, j) * _v[j];
+    size_t j = 0;
+    for (; j + 4 <= n; j += 4) {
+        sum0 += _m(i, j) * _v[j];
+        sum1 += _m(i, j + 1) * _v[j + 1];
+        sum2 += _m(i, j + 2) * _v[j + 2];
+        sum3 += _m(i, j + 3) * _v[j + 3];
     }
-    return sum;
+    for (; j < n; ++j) {
+        sum0 += _m(i, j) * _v[j];
+    }
+    return (sum0 + sum1) + (sum2 + sum3);
 }
 
 // MARK: MatrixMul
@@ -282,6 +290,16 @@ T MatrixMul<T, E1, E2>::operator()(size_t i, size_t j) const {
     return sum;
 }
 
+template <typename T, typename E1, typename E2>
+const E1& MatrixMul<T, E1, E2>::lhs() const {
+    return _u;
+}
+
+template <typename T, typename E1, typename E2>
+const E2& MatrixMul<T, E1, E2>::rhs() const {
+    return _v;
+}
+
 // MARK: Operator overloadings
 
 template <typename T, typename E>
@@ -11,9 +11,103 @@
 #include <jet/math_utils.h>
 #include <jet/matrix_mxn.h>
 #include <jet/parallel.h>
+#include <jet/vector3_packet.h>
+
+#include <algorithm>
 
 namespace jet {
 
+namespace internal {
+
+// Products with fewer multiply-adds are evaluated element-wise.
+constexpr size_t kMinBlockedMatrixMulWork = 32 * 32 * 32;
+
+// Returns the row-major data of the operand, copying it to \p buffer if the
+// operand is the destination matrix.
+template <typename T>
+const T* matrixMulOperand(const MatrixMxN<T>& m, const MatrixMxN<T>* dst,
+                          MatrixMxN<T>* buffer) {
+    if (&m == dst) {
+        *buffer = m;
+        return buffer->data();
+    }
+    return m.data();
+}
+
+// Evaluates the operand expression to \p buffer and returns the data.
+template <typename T, typename E>
+const T* matrixMulOperand(const MatrixExpression<T, E>& m,
+                          const MatrixMxN<T>*, MatrixMxN<T>* buffer) {
+    buffer->set(m());
+    return buffer->data();
+}
+
+//
+// Computes c = a * b where a is m x p, b is p x n, and c is m x n matrix, all
+// in row-major order. Blocks of four rows are processed in parallel. Within a
+// block, the columns of b are traversed in panels of kBlockK x kBlockN which
+// stay in the cache while 4 x 4 tiles of c are accumulated in registers.
+//
+template <typename T>
+void blockedMatrixMul(size_t m, size_t p, size_t n, const T* a, const T* b,
+                      T* c) {
+    typedef ScalarPacket<T, 4> Packet;
+    const size_t kTileSize = 4;
+    const size_t kBlockK = 128;
+    const size_t kBlockN = 256;
+
+    parallelFor(kZeroSize, (m + kTileSize - 1) / kTileSize, [&](size_t tile) {
+        const size_t iBegin = tile * kTileSize;
+        const size_t iEnd = std::min(m, iBegin + kTileSize);
+        std::fill(c + iBegin * n, c + iEnd * n, T(0));
+
+        for (size_t kBegin = 0; kBegin < p; kBegin += kBlockK) {
+            const size_t kEnd = std::min(p, kBegin + kBlockK);
+
+            for (size_t jBegin = 0; jBegin < n; jBegin += kBlockN) {
+                const size_t jEnd = std::min(n, jBegin + kBlockN);
+                size_t jTail = jBegin;
+
+                if (iEnd - iBegin == kTileSize) {
+                    const T* a0 = a + iBegin * p;
+                    const T* a1 = a0 + p;
+                    const T* a2 = a1 + p;
+                    const T* a3 = a2 + p;
+
+                    for (; jTail + kTileSize <= jEnd; jTail += kTileSize) {
+                        Packet c0, c1, c2, c3;
+                        for (size_t k = kBegin; k < kEnd; ++k) {
+                            const Packet bk = Packet::load(b + k * n + jTail);
+                            c0 += Packet(a0[k]) * bk;
+                            c1 += Packet(a1[k]) * bk;
+                            c2 += Packet(a2[k]) * bk;
+                            c3 += Packet(a3[k]) * bk;
+                        }
+
+                        T* c0Ptr = c + iBegin * n + jTail;
+                        (Packet::load(c0Ptr) + c0).store(c0Ptr);
+                        (Packet::load(c0Ptr + n) + c1).store(c0Ptr + n);
+                        (Packet::load(c0Ptr + 2 * n) + c2).store(c0Ptr + 2 * n);
+                        (Packet::load(c0Ptr + 3 * n) + c3).store(c0Ptr + 3 * n);
+                    }
+                }
+
+                // Remaining rows and columns
+                for (size_t i = iBegin; i < iEnd; ++i) {
+                    for (size_t k = kBegin; k < kEnd; ++k) {
+                        const T aik = a[i * p + k];
+                        for (size_t j = jTail; j < jEnd; ++j) {
+                            c[i * n + j] += aik * b[k * n + j];
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
+
+}  // namespace internal
+
 // MARK: MatrixMxN
 
 template <typename T>
@@ -33,7 +127,7 @@ MatrixMxN<T>::MatrixMxN(
 template <typename T>
 template <typename E>
 MatrixMxN<T>::MatrixMxN(const MatrixExpression<T, E>& other) {
-    set(other);
+    set(other());
 }
 
 template <typename T>
@@ -79,6 +173,27 @@ void MatrixMxN<T>::set(const MatrixExpression<T, E>& other) {
         [&](size_t i, size_t j) { (*this)(i, j) = expression(i, j); });
 }
 
+template <typename T>
+template <typename E1, typename E2>
+void MatrixMxN<T>::set(const MatrixMul<T, E1, E2>& other) {
+    const size_t m = other.rows();
+    const size_t p = other.lhs().cols();
+    const size_t n = other.cols();
+
+    if (m * p * n < internal::kMinBlockedMatrixMulWork) {
+        const MatrixExpression<T, MatrixMul<T, E1, E2>>& expression = other;
+        set(expression);
+        return;
+    }
+
+    MatrixMxN lhsBuffer, rhsBuffer;
+    const T* a = internal::matrixMulOperand(other.lhs(), this, &lhsBuffer);
+    const T* b = internal::matrixMulOperand(other.rhs(), this, &rhsBuffer);
+
+    resize(m, n);
+    internal::blockedMatrixMul(m, p, n, a, b, data());
+}
+
 template <typename T>
 void MatrixMxN<T>::set(size_t m, size_t n, const T* arr) {
     resize(m, n);
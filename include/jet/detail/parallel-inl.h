@@ -13,6 +13,8 @@
 #include <algorithm>
 #include <functional>
 #include <future>
+#include <iterator>
+#include <type_traits>
 #include <vector>
 
 #ifdef JET_TASKING_TBB
@@ -190,6 +192,14 @@ void parallelFor(IndexType start, IndexType end, const Function& func,
             ? (numThreadsHint == 0u ? 8u : numThreadsHint)
             : 1;
 
+    // Runs on the calling thread if there is nothing to distribute
+    if (numThreads == 1) {
+        for (auto i = start; i < end; ++i) {
+            func(i);
+        }
+        return;
+    }
+
     // Size of a slice for the range functions
     IndexType n = end - start + 1;
     IndexType slice =
@@ -274,6 +284,12 @@ void parallelRangeFor(IndexType start, IndexType end, const Function& func,
             ? (numThreadsHint == 0u ? 8u : numThreadsHint)
             : 1;
 
+    // Runs on the calling thread if there is nothing to distribute
+    if (numThreads == 1) {
+        func(start, end);
+        return;
+    }
+
     // Size of a slice for the range functions
     IndexType n = end - start + 1;
     IndexType slice =
@@ -387,6 +403,12 @@ Value parallelReduce(IndexType start, IndexType end, const Value& identity,
             ? (numThreadsHint == 0u ? 8u : numThreadsHint)
             : 1;
 
+    // Runs on the calling thread if there is nothing to distribute
+    if (numThreads == 1) {
+        (void)reduce;
+        return func(start, end, identity);
+    }
+
     // Size of a slice for the range functions
     IndexType n = end - start + 1;
     IndexType slice =
@@ -476,6 +498,113 @@ void parallelSort(RandomIterator begin, RandomIterator end,
         policy);
 }
 
+template <typename KeyIterator, typename ValueIterator>
+void parallelRadixSort(KeyIterator keysBegin, KeyIterator keysEnd,
+                       ValueIterator valuesBegin, ExecutionPolicy policy) {
+    typedef typename std::iterator_traits<KeyIterator>::value_type KeyType;
+    typedef typename std::iterator_traits<ValueIterator>::value_type ValueType;
+    static_assert(std::is_integral<KeyType>::value &&
+                      std::is_unsigned<KeyType>::value,
+                  "Radix sort requires unsigned integer keys.");
+
+    if (keysEnd <= keysBegin) {
+        return;
+    }
+
+    const size_t size = static_cast<size_t>(keysEnd - keysBegin);
+    const unsigned int kRadixBits = 8;
+    const size_t kRadix = size_t(1) << kRadixBits;
+
+    // Only the digits up to the max key need to be sorted
+    const KeyType maxKey = parallelReduce(
+        kZeroSize, size, KeyType(0),
+        [&](size_t start, size_t end, KeyType result) {
+            for (size_t i = start; i < end; ++i) {
+                result = std::max(result, keysBegin[i]);
+            }
+            return result;
+        },
+        [](KeyType a, KeyType b) { return std::max(a, b); }, policy);
+
+    unsigned int numPasses = 0;
+    for (KeyType k = maxKey; k > 0; k >>= kRadixBits) {
+        ++numPasses;
+        if (kRadixBits * numPasses >= sizeof(KeyType) * 8) {
+            break;
+        }
+    }
+    if (numPasses == 0) {
+        return;
+    }
+
+    // Each chunk builds its own histogram, so the scatter can run without
+    // synchronization while keeping the sort stable.
+    unsigned int numThreadsHint = maxNumberOfThreads();
+    const size_t numChunks =
+        (policy == ExecutionPolicy::kParallel)
+            ? std::max<size_t>(
+                  std::min<size_t>(numThreadsHint == 0u ? 8u : numThreadsHint,
+                                   size / kRadix),
+                  1)
+            : 1;
+    const size_t chunkSize = (size + numChunks - 1) / numChunks;
+
+    std::vector<KeyType> keys[2] = {std::vector<KeyType>(size),
+                                    std::vector<KeyType>(size)};
+    std::vector<ValueType> values[2] = {std::vector<ValueType>(size),
+                                        std::vector<ValueType>(size)};
+    std::vector<size_t> offsets(numChunks * kRadix);
+
+    parallelFor(kZeroSize, size, [&](size_t i) {
+        keys[0][i] = keysBegin[i];
+        values[0][i] = valuesBegin[i];
+    }, policy);
+
+    for (unsigned int pass = 0; pass < numPasses; ++pass) {
+        const unsigned int shift = pass * kRadixBits;
+        const std::vector<KeyType>& srcKeys = keys[pass % 2];
+        const std::vector<ValueType>& srcValues = values[pass % 2];
+        std::vector<KeyType>& dstKeys = keys[(pass + 1) % 2];
+        std::vector<ValueType>& dstValues = values[(pass + 1) % 2];
+
+        // Count the digits in each chunk
+        std::fill(offsets.begin(), offsets.end(), 0);
+        parallelFor(kZeroSize, numChunks, [&](size_t c) {
+            size_t* counts = &offsets[c * kRadix];
+            const size_t end = std::min(size, (c + 1) * chunkSize);
+            for (size_t i = c * chunkSize; i < end; ++i) {
+                ++counts[(srcKeys[i] >> shift) & (kRadix - 1)];
+            }
+        }, policy);
+
+        // Exclusive scan in the (digit, chunk) order
+        size_t sum = 0;
+        for (size_t d = 0; d < kRadix; ++d) {
+            for (size_t c = 0; c < numChunks; ++c) {
+                const size_t count = offsets[c * kRadix + d];
+                offsets[c * kRadix + d] = sum;
+                sum += count;
+            }
+        }
+
+        // Scatter
+        parallelFor(kZeroSize, numChunks, [&](size_t c) {
+            size_t* dst = &offsets[c * kRadix];
+            const size_t end = std::min(size, (c + 1) * chunkSize);
+            for (size_t i = c * chunkSize; i < end; ++i) {
+                const size_t j = dst[(srcKeys[i] >> shift) & (kRadix - 1)]++;
+                dstKeys[j] = srcKeys[i];
+                dstValues[j] = srcValues[i];
+            }
+        }, policy);
+    }
+
+    parallelFor(kZeroSize, size, [&](size_t i) {
+        keysBegin[i] = keys[numPasses % 2][i];
+        valuesBegin[i] = values[numPasses % 2][i];
+    }, policy);
+}
+
 }  // namespace jet
 
 #endif  // INCLUDE_JET_DETAIL_PARALLEL_INL_H_
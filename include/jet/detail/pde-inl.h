@@ -8,6 +8,7 @@
 #define INCLUDE_JET_DETAIL_PDE_INL_H_
 
 #include <jet/math_utils.h>
+#include <jet/vector3_packet.h>
 
 namespace jet {
 
@@ -219,6 +220,146 @@ T weno5(T* v, T h, bool isDirectionPositive, T eps) {
     return (alpha1 * phix1 + alpha2 * phix2 + alpha3 * phix3) / sum;
 }
 
+template <typename T>
+void upwind1Row(const T* const* D0, size_t n, T dx, T* dfxm, T* dfxp) {
+    const T invdx = 1/dx;
+    const T* d0 = D0[0];
+    const T* d1 = D0[1];
+    const T* d2 = D0[2];
+
+    for (size_t i = 0; i < n; ++i) {
+        dfxm[i] = invdx*(d1[i] - d0[i]);
+        dfxp[i] = invdx*(d2[i] - d1[i]);
+    }
+}
+
+template <typename T>
+void eno3Row(const T* const* D0, size_t n, T dx, T* dfxm, T* dfxp) {
+    typedef NativeScalarPacket<T> Packet;
+    const size_t numberOfLanes = Packet::kNumberOfLanes;
+
+    const T invdx = 1/dx;
+    const T hinvdx = invdx/2;
+    const T tinvdx = invdx/3;
+    const Packet pinvdx(invdx), phinvdx(hinvdx), ptinvdx(tinvdx), pdx(dx);
+    const Packet one(T(1)), minusOne(T(-1)), two(T(2));
+
+    const size_t packedEnd = n - n % numberOfLanes;
+    for (size_t i = 0; i < packedEnd; i += numberOfLanes) {
+        const Packet v0 = Packet::load(D0[0] + i);
+        const Packet v1 = Packet::load(D0[1] + i);
+        const Packet v2 = Packet::load(D0[2] + i);
+        const Packet v3 = Packet::load(D0[3] + i);
+        const Packet v4 = Packet::load(D0[4] + i);
+        const Packet v5 = Packet::load(D0[5] + i);
+        const Packet v6 = Packet::load(D0[6] + i);
+
+        const Packet D1_0 = pinvdx*(v1 - v0);
+        const Packet D1_1 = pinvdx*(v2 - v1);
+        const Packet D1_2 = pinvdx*(v3 - v2);
+        const Packet D1_3 = pinvdx*(v4 - v3);
+        const Packet D1_4 = pinvdx*(v5 - v4);
+        const Packet D1_5 = pinvdx*(v6 - v5);
+
+        const Packet D2_0 = phinvdx*(D1_1 - D1_0);
+        const Packet D2_1 = phinvdx*(D1_2 - D1_1);
+        const Packet D2_2 = phinvdx*(D1_3 - D1_2);
+        const Packet D2_3 = phinvdx*(D1_4 - D1_3);
+        const Packet D2_4 = phinvdx*(D1_5 - D1_4);
+
+        const Packet D3_0 = ptinvdx*(D2_1 - D2_0);
+        const Packet D3_1 = ptinvdx*(D2_2 - D2_1);
+        const Packet D3_2 = ptinvdx*(D2_3 - D2_2);
+        const Packet D3_3 = ptinvdx*(D2_4 - D2_3);
+
+        const Packet absD2_1 = abs(D2_1);
+        const Packet absD2_2 = abs(D2_2);
+        const Packet absD2_3 = abs(D2_3);
+
+        // Minus side (K = 0). Kstar = -1 takes the first candidates.
+        {
+            const Packet c = selectLess(absD2_1, absD2_2, D2_1, D2_2);
+            const Packet D3l = selectLess(absD2_1, absD2_2, D3_0, D3_1);
+            const Packet D3r = selectLess(absD2_1, absD2_2, D3_1, D3_2);
+            const Packet cstar = selectLess(abs(D3l), abs(D3r), D3l, D3r);
+            const Packet coef = selectLess(absD2_1, absD2_2, two, minusOne);
+
+            (D1_2 + c*one*pdx + cstar*coef*pdx*pdx).store(dfxm + i);
+        }
+
+        // Plus side (K = 1). Kstar = 0 takes the first candidates.
+        {
+            const Packet c = selectLess(absD2_2, absD2_3, D2_2, D2_3);
+            const Packet D3l = selectLess(absD2_2, absD2_3, D3_1, D3_2);
+            const Packet D3r = selectLess(absD2_2, absD2_3, D3_2, D3_3);
+            const Packet cstar = selectLess(abs(D3l), abs(D3r), D3l, D3r);
+            const Packet coef = selectLess(absD2_2, absD2_3, minusOne, two);
+
+            (D1_3 + c*minusOne*pdx + cstar*coef*pdx*pdx).store(dfxp + i);
+        }
+    }
+
+    // Remaining points
+    for (size_t i = packedEnd; i < n; ++i) {
+        T v[7];
+        for (int m = 0; m < 7; ++m) {
+            v[m] = D0[m][i];
+        }
+
+        const std::array<T, 2> dfx = eno3(v, dx);
+        dfxm[i] = dfx[0];
+        dfxp[i] = dfx[1];
+    }
+}
+
+template <typename T>
+void weno5Row(const T* const* v, size_t n, T h, T* dfxm, T* dfxp, T eps) {
+    const T c_1_3 = T(1.0/3.0), c_1_4 = T(0.25), c_1_6 = T(1.0/6.0);
+    const T c_5_6 = T(5.0/6.0), c_7_6 = T(7.0/6.0), c_11_6 = T(11.0/6.0);
+    const T c_13_12 = T(13.0/12.0);
+
+    const T hInv = T(1)/h;
+
+    for (int K = 0; K < 2; ++K) {
+        T* dfx = (K == 0) ? dfxm : dfxp;
+
+        // vdev[m] = (hi[m] - lo[m]) / h in the upwind order for each side
+        const T* hi[5];
+        const T* lo[5];
+        for (int m = 0; m < 5; ++m) {
+            hi[m] = (K == 0) ? v[m+1] : v[6-m];
+            lo[m] = (K == 0) ? v[m] : v[5-m];
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            const T vdev0 = (hi[0][i] - lo[0][i]) * hInv;
+            const T vdev1 = (hi[1][i] - lo[1][i]) * hInv;
+            const T vdev2 = (hi[2][i] - lo[2][i]) * hInv;
+            const T vdev3 = (hi[3][i] - lo[3][i]) * hInv;
+            const T vdev4 = (hi[4][i] - lo[4][i]) * hInv;
+
+            const T phix1 =   vdev0 * c_1_3  - vdev1 * c_7_6 + vdev2 * c_11_6;
+            const T phix2 = - vdev1 * c_1_6  + vdev2 * c_5_6 + vdev3 * c_1_3;
+            const T phix3 =   vdev2 * c_1_3  + vdev3 * c_5_6 - vdev4 * c_1_6;
+
+            const T s1 = c_13_12 * square(vdev0 - 2*vdev1 + vdev2)
+                       + c_1_4 * square(vdev0 - 4*vdev1 + 3*vdev2);
+            const T s2 = c_13_12 * square(vdev1 - 2*vdev2 + vdev3)
+                       + c_1_4 * square(vdev1 - vdev3);
+            const T s3 = c_13_12 * square(vdev2 - 2*vdev3 + vdev4)
+                       + c_1_4 * square(3*vdev2 - 4*vdev3 + vdev4);
+
+            const T alpha1 = T(0.1 / square(s1 + eps));
+            const T alpha2 = T(0.6 / square(s2 + eps));
+            const T alpha3 = T(0.3 / square(s3 + eps));
+
+            const T sum = alpha1 + alpha2 + alpha3;
+
+            dfx[i] = (alpha1 * phix1 + alpha2 * phix2 + alpha3 * phix3) / sum;
+        }
+    }
+}
+
 }  // namespace jet
 
 #endif  // INCLUDE_JET_DETAIL_PDE_INL_H_
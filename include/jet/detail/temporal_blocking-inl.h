@@ -0,0 +1,115 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_TEMPORAL_BLOCKING_INL_H_
+#define INCLUDE_JET_DETAIL_TEMPORAL_BLOCKING_INL_H_
+
+#include <jet/constants.h>
+#include <jet/parallel.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace jet {
+
+namespace internal {
+
+// Runs the steps [stepBegin, stepBegin + depth) as a wavefront, where step
+// stepBegin + t updates the planes in range(t). Step stepBegin + t updates
+// the plane which is t planes behind the front, so every plane it reads from
+// the previous step is ready, and none of the planes the previous step still
+// needs is overwritten.
+template <typename RangeFunction, typename PlaneFunction>
+void wavefrontSweep(unsigned int stepBegin, unsigned int depth,
+                    const RangeFunction& range, const PlaneFunction& func) {
+    size_t frontBegin = kMaxSize;
+    size_t frontEnd = 0;
+    for (unsigned int t = 0; t < depth; ++t) {
+        const std::pair<size_t, size_t> planes = range(t);
+        if (planes.first < planes.second) {
+            frontBegin = std::min(frontBegin, planes.first + t);
+            frontEnd = std::max(frontEnd, planes.second + t);
+        }
+    }
+
+    for (size_t front = frontBegin; front < frontEnd; ++front) {
+        for (unsigned int t = 0; t < depth && t <= front; ++t) {
+            const std::pair<size_t, size_t> planes = range(t);
+            const size_t plane = front - t;
+            if (plane >= planes.first && plane < planes.second) {
+                func(stepBegin + t, plane);
+            }
+        }
+    }
+}
+
+}  // namespace internal
+
+template <typename PlaneFunction>
+void temporallyBlockedSweep(size_t numberOfPlanes, unsigned int numberOfSteps,
+                            unsigned int blockDepth,
+                            const PlaneFunction& func) {
+    blockDepth = std::max(blockDepth, 1u);
+
+    // Each chunk needs room for the planes it skips on both sides, so that
+    // the triangles of the second phase do not touch each other.
+    const size_t numberOfChunks = std::min(
+        static_cast<size_t>(maxNumberOfThreads()),
+        std::max(numberOfPlanes / (2 * static_cast<size_t>(blockDepth)),
+                 kOneSize));
+
+    auto chunkBegin = [&](size_t c) {
+        return c * numberOfPlanes / numberOfChunks;
+    };
+
+    for (unsigned int stepBegin = 0; stepBegin < numberOfSteps;
+         stepBegin += blockDepth) {
+        const unsigned int depth =
+            std::min(blockDepth, numberOfSteps - stepBegin);
+
+        if (numberOfChunks == 1) {
+            internal::wavefrontSweep(
+                stepBegin, depth,
+                [&](unsigned int) {
+                    return std::make_pair(kZeroSize, numberOfPlanes);
+                },
+                func);
+            continue;
+        }
+
+        // First phase: each chunk shrinks by one plane per step on the sides
+        // facing the other chunks, which leaves the dependencies within the
+        // chunk.
+        parallelFor(kZeroSize, numberOfChunks, [&](size_t c) {
+            const size_t begin = chunkBegin(c);
+            const size_t end = chunkBegin(c + 1);
+            internal::wavefrontSweep(
+                stepBegin, depth,
+                [&](unsigned int t) {
+                    return std::make_pair(
+                        (c == 0) ? begin : begin + t,
+                        (c + 1 == numberOfChunks) ? end : end - t);
+                },
+                func);
+        });
+
+        // Second phase: the planes skipped around each chunk boundary form a
+        // triangle which only reads the planes from the first phase.
+        parallelFor(kOneSize, numberOfChunks, [&](size_t c) {
+            const size_t boundary = chunkBegin(c);
+            internal::wavefrontSweep(
+                stepBegin, depth,
+                [&](unsigned int t) {
+                    return std::make_pair(boundary - t, boundary + t);
+                },
+                func);
+        });
+    }
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_TEMPORAL_BLOCKING_INL_H_
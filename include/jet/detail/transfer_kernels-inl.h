@@ -0,0 +1,112 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_TRANSFER_KERNELS_INL_H_
+#define INCLUDE_JET_DETAIL_TRANSFER_KERNELS_INL_H_
+
+#include <jet/math_utils.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace jet {
+
+// The weights are evaluated with straight-line arithmetic without
+// data-dependent branches, so the loops over the particles vectorize well.
+
+inline void LinearTransferKernel::getWeights(double x, size_t size,
+                                             size_t* indices, double* weights,
+                                             double* derivatives) {
+    // Limiting the lower index (instead of clamping the fraction) matches
+    // getBarycentric at the upper end of the axis.
+    const size_t iMax = (size > 1) ? size - 2 : 0;
+    const size_t i0 = std::min(static_cast<size_t>(x), iMax);
+    const double f = x - static_cast<double>(i0);
+
+    indices[0] = i0;
+    indices[1] = std::min(i0 + 1, size - 1);
+
+    weights[0] = 1.0 - f;
+    weights[1] = f;
+
+    derivatives[0] = -1.0;
+    derivatives[1] = 1.0;
+}
+
+inline void QuadraticBSplineTransferKernel::getWeights(
+    double x, size_t size, size_t* indices, double* weights,
+    double* derivatives) {
+    const ssize_t iMax = static_cast<ssize_t>(size) - 1;
+    const double base = std::floor(x - 0.5);
+    const ssize_t i0 = static_cast<ssize_t>(base);
+
+    // Distances to the three samples are 1 + t, t, and 1 - t
+    const double t = x - base - 1.0;
+    const double a = 0.5 - t;
+    const double c = 0.5 + t;
+
+    for (ssize_t n = 0; n < 3; ++n) {
+        indices[n] =
+            static_cast<size_t>(clamp(i0 + n, ssize_t(0), iMax));
+    }
+
+    weights[0] = 0.5 * a * a;
+    weights[1] = 0.75 - t * t;
+    weights[2] = 0.5 * c * c;
+
+    derivatives[0] = -a;
+    derivatives[1] = -2.0 * t;
+    derivatives[2] = c;
+}
+
+inline void CubicBSplineTransferKernel::getWeights(double x, size_t size,
+                                                   size_t* indices,
+                                                   double* weights,
+                                                   double* derivatives) {
+    const ssize_t iMax = static_cast<ssize_t>(size) - 1;
+    const double base = std::floor(x);
+    const ssize_t i0 = static_cast<ssize_t>(base) - 1;
+
+    const double t = x - base;
+    const double t2 = t * t;
+    const double t3 = t2 * t;
+    const double s = 1.0 - t;
+
+    for (ssize_t n = 0; n < 4; ++n) {
+        indices[n] =
+            static_cast<size_t>(clamp(i0 + n, ssize_t(0), iMax));
+    }
+
+    weights[0] = s * s * s / 6.0;
+    weights[1] = 0.5 * t3 - t2 + 2.0 / 3.0;
+    weights[2] = -0.5 * t3 + 0.5 * t2 + 0.5 * t + 1.0 / 6.0;
+    weights[3] = t3 / 6.0;
+
+    derivatives[0] = -0.5 * s * s;
+    derivatives[1] = 1.5 * t2 - 2.0 * t;
+    derivatives[2] = -1.5 * t2 + t + 0.5;
+    derivatives[3] = 0.5 * t2;
+}
+
+template <typename Kernel>
+AxisStencil<Kernel>::AxisStencil() : coordinate(0.0) {
+    indices.fill(0);
+    weights.fill(0.0);
+    derivatives.fill(0.0);
+}
+
+template <typename Kernel>
+AxisStencil<Kernel>::AxisStencil(double x, size_t size) {
+    JET_ASSERT(size > 0);
+
+    coordinate = clamp(x, 0.0, static_cast<double>(size - 1));
+    Kernel::getWeights(coordinate, size, indices.data(), weights.data(),
+                       derivatives.data());
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_TRANSFER_KERNELS_INL_H_
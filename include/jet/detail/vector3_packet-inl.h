@@ -0,0 +1,400 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_VECTOR3_PACKET_INL_H_
+#define INCLUDE_JET_DETAIL_VECTOR3_PACKET_INL_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace jet {
+
+// MARK: ScalarPacket
+
+template <typename T, size_t N>
+constexpr size_t ScalarPacket<T, N>::kNumberOfLanes;
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N>::ScalarPacket() : ScalarPacket(T(0)) {}
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N>::ScalarPacket(T s) {
+#ifdef JET_PACKET_VECTOR_EXTENSIONS
+    lanes = Lanes{} + s;
+#else
+    for (size_t i = 0; i < N; ++i) {
+        lanes[i] = s;
+    }
+#endif
+}
+
+template <typename T, size_t N>
+inline T& ScalarPacket<T, N>::operator[](size_t i) {
+    return reinterpret_cast<T*>(&lanes)[i];
+}
+
+template <typename T, size_t N>
+inline const T& ScalarPacket<T, N>::operator[](size_t i) const {
+    return reinterpret_cast<const T*>(&lanes)[i];
+}
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N> ScalarPacket<T, N>::load(const T* data) {
+    ScalarPacket result;
+    std::memcpy(&result.lanes, data, sizeof(T) * N);
+    return result;
+}
+
+template <typename T, size_t N>
+inline void ScalarPacket<T, N>::store(T* data) const {
+    std::memcpy(data, &lanes, sizeof(T) * N);
+}
+
+template <typename T, size_t N>
+inline T ScalarPacket<T, N>::sum(size_t count) const {
+    T result = 0;
+    for (size_t i = 0; i < std::min(count, N); ++i) {
+        result += (*this)[i];
+    }
+    return result;
+}
+
+template <typename T, size_t N>
+inline T ScalarPacket<T, N>::max(size_t count) const {
+    T result = (*this)[0];
+    for (size_t i = 1; i < std::min(count, N); ++i) {
+        result = std::max(result, (*this)[i]);
+    }
+    return result;
+}
+
+#ifdef JET_PACKET_VECTOR_EXTENSIONS
+#define JET_PACKET_COMPOUND_OP(op) lanes op v.lanes;
+#else
+#define JET_PACKET_COMPOUND_OP(op) \
+    for (size_t i = 0; i < N; ++i) {    \
+        lanes[i] op v.lanes[i];        \
+    }
+#endif
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N>& ScalarPacket<T, N>::operator+=(
+    const ScalarPacket& v) {
+    JET_PACKET_COMPOUND_OP(+=)
+    return *this;
+}
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N>& ScalarPacket<T, N>::operator-=(
+    const ScalarPacket& v) {
+    JET_PACKET_COMPOUND_OP(-=)
+    return *this;
+}
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N>& ScalarPacket<T, N>::operator*=(
+    const ScalarPacket& v) {
+    JET_PACKET_COMPOUND_OP(*=)
+    return *this;
+}
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N>& ScalarPacket<T, N>::operator/=(
+    const ScalarPacket& v) {
+    JET_PACKET_COMPOUND_OP(/=)
+    return *this;
+}
+
+#undef JET_PACKET_COMPOUND_OP
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N> operator+(const ScalarPacket<T, N>& a,
+                                    const ScalarPacket<T, N>& b) {
+    ScalarPacket<T, N> result(a);
+    result += b;
+    return result;
+}
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N> operator-(const ScalarPacket<T, N>& a,
+                                    const ScalarPacket<T, N>& b) {
+    ScalarPacket<T, N> result(a);
+    result -= b;
+    return result;
+}
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N> operator*(const ScalarPacket<T, N>& a,
+                                    const ScalarPacket<T, N>& b) {
+    ScalarPacket<T, N> result(a);
+    result *= b;
+    return result;
+}
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N> operator/(const ScalarPacket<T, N>& a,
+                                    const ScalarPacket<T, N>& b) {
+    ScalarPacket<T, N> result(a);
+    result /= b;
+    return result;
+}
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N> operator*(T a, const ScalarPacket<T, N>& b) {
+    return ScalarPacket<T, N>(a) * b;
+}
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N> sqrt(const ScalarPacket<T, N>& a) {
+    ScalarPacket<T, N> result;
+    for (size_t i = 0; i < N; ++i) {
+        result[i] = std::sqrt(a[i]);
+    }
+    return result;
+}
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N> min(const ScalarPacket<T, N>& a,
+                              const ScalarPacket<T, N>& b) {
+    ScalarPacket<T, N> result;
+    for (size_t i = 0; i < N; ++i) {
+        result[i] = std::min(a[i], b[i]);
+    }
+    return result;
+}
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N> max(const ScalarPacket<T, N>& a,
+                              const ScalarPacket<T, N>& b) {
+    ScalarPacket<T, N> result;
+    for (size_t i = 0; i < N; ++i) {
+        result[i] = std::max(a[i], b[i]);
+    }
+    return result;
+}
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N> abs(const ScalarPacket<T, N>& a) {
+    ScalarPacket<T, N> result;
+    for (size_t i = 0; i < N; ++i) {
+        result[i] = std::fabs(a[i]);
+    }
+    return result;
+}
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N> selectLess(const ScalarPacket<T, N>& a,
+                                     const ScalarPacket<T, N>& b,
+                                     const ScalarPacket<T, N>& x,
+                                     const ScalarPacket<T, N>& y) {
+    ScalarPacket<T, N> result;
+#ifdef JET_PACKET_VECTOR_EXTENSIONS
+    // Comparison gives all-ones lanes of the same width as T where true
+    typedef typename ScalarPacket<T, N>::Lanes Lanes;
+    typedef decltype(a.lanes < b.lanes) Mask;
+    const Mask mask = a.lanes < b.lanes;
+    result.lanes
+        = (Lanes)((mask & (Mask)x.lanes) | (~mask & (Mask)y.lanes));
+#else
+    for (size_t i = 0; i < N; ++i) {
+        result[i] = (a[i] < b[i]) ? x[i] : y[i];
+    }
+#endif
+    return result;
+}
+
+// MARK: Vector3Packet
+
+template <typename T, size_t N>
+constexpr size_t Vector3Packet<T, N>::kNumberOfLanes;
+
+template <typename T, size_t N>
+inline Vector3Packet<T, N>::Vector3Packet() {}
+
+template <typename T, size_t N>
+inline Vector3Packet<T, N>::Vector3Packet(const Vector3<T>& v)
+    : x(v.x), y(v.y), z(v.z) {}
+
+template <typename T, size_t N>
+inline Vector3Packet<T, N>::Vector3Packet(const Scalar& x_, const Scalar& y_,
+                                          const Scalar& z_)
+    : x(x_), y(y_), z(z_) {}
+
+template <typename T, size_t N>
+inline Vector3Packet<T, N> Vector3Packet<T, N>::load(
+    const ConstArrayAccessor1<Vector3<T>>& array, size_t begin) {
+    JET_ASSERT(begin <= array.size());
+    return load(array.data() + begin, std::min(N, array.size() - begin));
+}
+
+template <typename T, size_t N>
+inline Vector3Packet<T, N> Vector3Packet<T, N>::load(const Vector3<T>* data,
+                                                     size_t count) {
+    Vector3Packet result;
+    if (count >= N) {
+        // Full packet with a fixed trip count for the transposition
+        for (size_t i = 0; i < N; ++i) {
+            result.x[i] = data[i].x;
+            result.y[i] = data[i].y;
+            result.z[i] = data[i].z;
+        }
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            result.x[i] = data[i].x;
+            result.y[i] = data[i].y;
+            result.z[i] = data[i].z;
+        }
+    }
+    return result;
+}
+
+template <typename T, size_t N>
+inline void Vector3Packet<T, N>::store(ArrayAccessor1<Vector3<T>> array,
+                                       size_t begin) const {
+    JET_ASSERT(begin <= array.size());
+    store(array.data() + begin, std::min(N, array.size() - begin));
+}
+
+template <typename T, size_t N>
+inline void Vector3Packet<T, N>::store(Vector3<T>* data, size_t count) const {
+    if (count >= N) {
+        for (size_t i = 0; i < N; ++i) {
+            data[i].x = x[i];
+            data[i].y = y[i];
+            data[i].z = z[i];
+        }
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            data[i].x = x[i];
+            data[i].y = y[i];
+            data[i].z = z[i];
+        }
+    }
+}
+
+template <typename T, size_t N>
+inline Vector3<T> Vector3Packet<T, N>::lane(size_t i) const {
+    return Vector3<T>(x[i], y[i], z[i]);
+}
+
+template <typename T, size_t N>
+inline void Vector3Packet<T, N>::setLane(size_t i, const Vector3<T>& v) {
+    x[i] = v.x;
+    y[i] = v.y;
+    z[i] = v.z;
+}
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N> Vector3Packet<T, N>::dot(
+    const Vector3Packet& v) const {
+    return x * v.x + y * v.y + z * v.z;
+}
+
+template <typename T, size_t N>
+inline Vector3Packet<T, N> Vector3Packet<T, N>::cross(
+    const Vector3Packet& v) const {
+    return Vector3Packet(y * v.z - v.y * z, z * v.x - v.z * x,
+                         x * v.y - v.x * y);
+}
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N> Vector3Packet<T, N>::length() const {
+    return sqrt(lengthSquared());
+}
+
+template <typename T, size_t N>
+inline ScalarPacket<T, N> Vector3Packet<T, N>::lengthSquared() const {
+    return x * x + y * y + z * z;
+}
+
+template <typename T, size_t N>
+inline Vector3Packet<T, N>& Vector3Packet<T, N>::operator+=(
+    const Vector3Packet& v) {
+    x += v.x;
+    y += v.y;
+    z += v.z;
+    return *this;
+}
+
+template <typename T, size_t N>
+inline Vector3Packet<T, N>& Vector3Packet<T, N>::operator-=(
+    const Vector3Packet& v) {
+    x -= v.x;
+    y -= v.y;
+    z -= v.z;
+    return *this;
+}
+
+template <typename T, size_t N>
+inline Vector3Packet<T, N>& Vector3Packet<T, N>::operator*=(const Scalar& s) {
+    x *= s;
+    y *= s;
+    z *= s;
+    return *this;
+}
+
+template <typename T, size_t N>
+inline Vector3Packet<T, N> operator-(const Vector3Packet<T, N>& a) {
+    return Vector3Packet<T, N>(T(-1) * a.x, T(-1) * a.y, T(-1) * a.z);
+}
+
+template <typename T, size_t N>
+inline Vector3Packet<T, N> operator+(const Vector3Packet<T, N>& a,
+                                     const Vector3Packet<T, N>& b) {
+    return Vector3Packet<T, N>(a.x + b.x, a.y + b.y, a.z + b.z);
+}
+
+template <typename T, size_t N>
+inline Vector3Packet<T, N> operator-(const Vector3Packet<T, N>& a,
+                                     const Vector3Packet<T, N>& b) {
+    return Vector3Packet<T, N>(a.x - b.x, a.y - b.y, a.z - b.z);
+}
+
+template <typename T, size_t N>
+inline Vector3Packet<T, N> operator*(const Vector3Packet<T, N>& a,
+                                     const ScalarPacket<T, N>& b) {
+    return Vector3Packet<T, N>(a.x * b, a.y * b, a.z * b);
+}
+
+template <typename T, size_t N>
+inline Vector3Packet<T, N> operator*(const ScalarPacket<T, N>& a,
+                                     const Vector3Packet<T, N>& b) {
+    return Vector3Packet<T, N>(a * b.x, a * b.y, a * b.z);
+}
+
+template <typename T, size_t N>
+inline Vector3Packet<T, N> operator*(T a, const Vector3Packet<T, N>& b) {
+    return ScalarPacket<T, N>(a) * b;
+}
+
+template <typename T, size_t N>
+inline Vector3Packet<T, N> operator*(const Vector3Packet<T, N>& a, T b) {
+    return a * ScalarPacket<T, N>(b);
+}
+
+template <typename T, size_t N>
+inline Vector3Packet<T, N> operator/(const Vector3Packet<T, N>& a,
+                                     const ScalarPacket<T, N>& b) {
+    return Vector3Packet<T, N>(a.x / b, a.y / b, a.z / b);
+}
+
+template <typename T, size_t N>
+inline Vector3Packet<T, N> operator/(const Vector3Packet<T, N>& a, T b) {
+    return a / ScalarPacket<T, N>(b);
+}
+
+template <typename T, size_t N>
+inline Vector3Packet<T, N> operator*(const Matrix3x3<T>& m,
+                                     const Vector3Packet<T, N>& v) {
+    return Vector3Packet<T, N>(m(0, 0) * v.x + m(0, 1) * v.y + m(0, 2) * v.z,
+                               m(1, 0) * v.x + m(1, 1) * v.y + m(1, 2) * v.z,
+                               m(2, 0) * v.x + m(2, 1) * v.y + m(2, 2) * v.z);
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_VECTOR3_PACKET_INL_H_
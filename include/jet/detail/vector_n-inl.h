@@ -56,7 +56,7 @@ void VectorN<T>::clear() {
 
 template <typename T>
 void VectorN<T>::set(const T& s) {
-    parallelFill(begin(), end(), s);
+    parallelFill(begin(), end(), s, executionPolicyForSize(size()));
 }
 
 template <typename T>
@@ -70,9 +70,16 @@ template <typename E>
 void VectorN<T>::set(const VectorExpression<T, E>& other) {
     resize(other.size());
 
-    // Parallel evaluation of the expression
+    // Parallel evaluation of the expression in chunks; small vectors are
+    // evaluated on the calling thread.
     const E& expression = other();
-    parallelForEachIndex([&](size_t i) { _elements[i] = expression[i]; });
+    parallelRangeFor(kZeroSize, size(),
+                     [&](size_t begin, size_t end) {
+                         for (size_t i = begin; i < end; ++i) {
+                             _elements[i] = expression[i];
+                         }
+                     },
+                     executionPolicyForSize(size()));
 }
 
 template <typename T>
@@ -160,7 +167,7 @@ T VectorN<T>::sum() const {
                               }
                               return result;
                           },
-                          std::plus<T>());
+                          std::plus<T>(), executionPolicyForSize(size()));
 }
 
 template <typename T>
@@ -179,7 +186,7 @@ T VectorN<T>::min() const {
                               }
                               return result;
                           },
-                          _min);
+                          _min, executionPolicyForSize(size()));
 }
 
 template <typename T>
@@ -193,7 +200,7 @@ T VectorN<T>::max() const {
                               }
                               return result;
                           },
-                          _max);
+                          _max, executionPolicyForSize(size()));
 }
 
 template <typename T>
@@ -206,7 +213,7 @@ T VectorN<T>::absmin() const {
                               }
                               return result;
                           },
-                          jet::absmin<T>);
+                          jet::absmin<T>, executionPolicyForSize(size()));
 }
 
 template <typename T>
@@ -219,7 +226,7 @@ T VectorN<T>::absmax() const {
                               }
                               return result;
                           },
-                          jet::absmax<T>);
+                          jet::absmax<T>, executionPolicyForSize(size()));
 }
 
 template <typename T>
@@ -273,7 +280,7 @@ T VectorN<T>::distanceSquaredTo(const E& other) const {
                               }
                               return result;
                           },
-                          std::plus<T>());
+                          std::plus<T>(), executionPolicyForSize(size()));
 }
 
 template <typename T>
@@ -368,7 +375,7 @@ T VectorN<T>::dot(const E& v) const {
                               }
                               return result;
                           },
-                          std::plus<T>());
+                          std::plus<T>(), executionPolicyForSize(size()));
 }
 
 template <typename T>
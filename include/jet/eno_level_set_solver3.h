@@ -24,6 +24,14 @@ class EnoLevelSetSolver3 final : public IterativeLevelSetSolver3 {
                         size_t k, std::array<double, 2>* dx,
                         std::array<double, 2>* dy,
                         std::array<double, 2>* dz) const override;
+
+    //! Computes the derivatives for the points of given i-row.
+    void getRowDerivatives(ConstArrayAccessor3<double> grid,
+                           const Vector3D& gridSpacing, size_t iBegin,
+                           size_t iEnd, size_t j, size_t k,
+                           std::array<double*, 2> dx,
+                           std::array<double*, 2> dy,
+                           std::array<double*, 2> dz) const override;
 };
 
 typedef std::shared_ptr<EnoLevelSetSolver3> EnoLevelSetSolver3Ptr;
@@ -0,0 +1,99 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_FACE_CENTERED_STENCIL3_H_
+#define INCLUDE_JET_FACE_CENTERED_STENCIL3_H_
+
+#include <jet/array_accessor3.h>
+#include <jet/size3.h>
+#include <jet/transfer_kernels.h>
+#include <jet/vector3.h>
+
+namespace jet {
+
+//!
+//! \brief Transfer stencil on a single face-centered velocity component.
+//!
+//! \tparam Kernel The transfer kernel type.
+//!
+template <typename Kernel>
+struct FaceStencil3 {
+    //! Stencil along x-axis.
+    AxisStencil<Kernel> x;
+
+    //! Stencil along y-axis.
+    AxisStencil<Kernel> y;
+
+    //! Stencil along z-axis.
+    AxisStencil<Kernel> z;
+
+    //! Returns the interpolated value of the given data.
+    template <typename T>
+    double sample(const ConstArrayAccessor3<T>& data) const;
+
+    //! Returns the gradient of the interpolated value of the given data.
+    template <typename T>
+    Vector3D gradient(const ConstArrayAccessor3<T>& data,
+                      const Vector3D& invGridSpacing) const;
+
+    //!
+    //! \brief Invokes the callback function for each sample in the stencil.
+    //!
+    //! The callback function takes the index (i, j, k) of the sample and its
+    //! weight.
+    //!
+    template <typename Callback>
+    void forEachSample(const Callback& func) const;
+};
+
+//!
+//! \brief Transfer stencils of a point on the three face-centered grids.
+//!
+//! The stencils for u, v, and w share the node-aligned and the cell-center-
+//! aligned axis stencils, so a point is located only once for all three
+//! components. The same stencil can be used to sample any number of grids
+//! with the same shape, such as the velocity and its change.
+//!
+//! \tparam Kernel The transfer kernel type.
+//!
+template <typename Kernel>
+struct FaceCenteredStencil3 {
+    //! Stencil on the u-component grid.
+    FaceStencil3<Kernel> u;
+
+    //! Stencil on the v-component grid.
+    FaceStencil3<Kernel> v;
+
+    //! Stencil on the w-component grid.
+    FaceStencil3<Kernel> w;
+
+    //! Constructs an empty stencil.
+    FaceCenteredStencil3();
+
+    //!
+    //! Constructs the stencils of the given point.
+    //!
+    //! \param[in]  pt              The sample point.
+    //! \param[in]  origin          Origin of the grid (not the u/v/w origin).
+    //! \param[in]  invGridSpacing  Inverse of the grid spacing.
+    //! \param[in]  resolution      Resolution of the grid.
+    //!
+    FaceCenteredStencil3(const Vector3D& pt, const Vector3D& origin,
+                         const Vector3D& invGridSpacing,
+                         const Size3& resolution);
+
+    //! Returns the interpolated vector of the given face-centered data.
+    template <typename T>
+    Vector3D sample(const ConstArrayAccessor3<T>& uData,
+                    const ConstArrayAccessor3<T>& vData,
+                    const ConstArrayAccessor3<T>& wData) const;
+};
+
+}  // namespace jet
+
+#include "detail/face_centered_stencil3-inl.h"
+
+#endif  // INCLUDE_JET_FACE_CENTERED_STENCIL3_H_
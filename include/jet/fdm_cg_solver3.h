@@ -21,6 +21,9 @@ class FdmCgSolver3 final : public FdmLinearSystemSolver3 {
     //! Solves the given linear system.
     bool solve(FdmLinearSystem3* system) override;
 
+    //! Solves the linear systems which share the matrix in a single batch.
+    bool solveMultiple(FdmMultiLinearSystem3* system) override;
+
     //! Solves the given compressed linear system.
     bool solveCompressed(FdmCompressedLinearSystem3* system) override;
 
@@ -54,6 +57,12 @@ class FdmCgSolver3 final : public FdmLinearSystemSolver3 {
     VectorND _qComp;
     VectorND _sComp;
 
+    // Vectors for multiple right-hand sides
+    FdmMultiVector3 _rMulti;
+    FdmMultiVector3 _dMulti;
+    FdmMultiVector3 _qMulti;
+    FdmMultiVector3 _sMulti;
+
     void clearUncompressedVectors();
     void clearCompressedVectors();
 };
@@ -58,6 +58,17 @@ class FdmGaussSeidelSolver3 final : public FdmLinearSystemSolver3 {
     static void relaxRedBlack(const FdmMatrix3& A, const FdmVector3& b,
                               double sorFactor, FdmVector3* x);
 
+    //!
+    //! \brief Performs multiple Red-Black Gauss-Seidel relaxation steps.
+    //!
+    //! The red and black half steps of all the iterations are fused using
+    //! temporally blocked sweeps, so the grid is streamed from the memory
+    //! only once per a few half steps.
+    //!
+    static void relaxRedBlack(const FdmMatrix3& A, const FdmVector3& b,
+                              double sorFactor,
+                              unsigned int numberOfIterations, FdmVector3* x);
+
  private:
     unsigned int _maxNumberOfIterations;
     unsigned int _lastNumberOfIterations;
@@ -23,6 +23,32 @@ class FdmIccgSolver3 final : public FdmLinearSystemSolver3 {
     //! Solves the given linear system.
     bool solve(FdmLinearSystem3* system) override;
 
+    //!
+    //! \brief Solves the given linear system with the same matrix as the last
+    //!        solve.
+    //!
+    //! The incomplete Cholesky preconditioner is reused if it was built from
+    //! the same matrix array. Otherwise, it is rebuilt as solve() does.
+    //!
+    bool solveWithSameMatrix(FdmLinearSystem3* system) override;
+
+    //!
+    //! \brief Solves the linear systems which share the matrix.
+    //!
+    //! The preconditioner is built once, and the matrix and the preconditioner
+    //! are applied to all the right-hand sides in each sweep.
+    //!
+    bool solveMultiple(FdmMultiLinearSystem3* system) override;
+
+    //!
+    //! \brief Solves the linear systems which share the matrix from the last
+    //!        solve.
+    //!
+    //! The incomplete Cholesky preconditioner is reused if it was built from
+    //! the same matrix array. Otherwise, it is rebuilt as solveMultiple() does.
+    //!
+    bool solveMultipleWithSameMatrix(FdmMultiLinearSystem3* system) override;
+
     //! Solves the given compressed linear system.
     bool solveCompressed(FdmCompressedLinearSystem3* system) override;
 
@@ -43,10 +69,13 @@ class FdmIccgSolver3 final : public FdmLinearSystemSolver3 {
         ConstArrayAccessor3<FdmMatrixRow3> A;
         FdmVector3 d;
         FdmVector3 y;
+        FdmMultiVector3 yMulti;
 
         void build(const FdmMatrix3& matrix);
 
         void solve(const FdmVector3& b, FdmVector3* x);
+
+        void solve(const FdmMultiVector3& b, FdmMultiVector3* x);
     };
 
     struct PreconditionerCompressed final {
@@ -78,6 +107,19 @@ class FdmIccgSolver3 final : public FdmLinearSystemSolver3 {
     VectorND _sComp;
     PreconditionerCompressed _precondComp;
 
+    // Vectors for multiple right-hand sides
+    FdmMultiVector3 _rMulti;
+    FdmMultiVector3 _dMulti;
+    FdmMultiVector3 _qMulti;
+    FdmMultiVector3 _sMulti;
+
+    bool solveUncompressed(FdmLinearSystem3* system, bool buildPreconditioner);
+
+    bool solveMultipleUncompressed(FdmMultiLinearSystem3* system,
+                                   bool buildPreconditioner);
+
+    bool isPreconditionerBuilt(const FdmMatrix3& matrix) const;
+
     void clearUncompressedVectors();
     void clearCompressedVectors();
 };
@@ -40,6 +40,17 @@ class FdmJacobiSolver3 final : public FdmLinearSystemSolver3 {
     static void relax(const FdmMatrix3& A, const FdmVector3& b, FdmVector3* x,
                       FdmVector3* xTemp);
 
+    //!
+    //! \brief Performs multiple Jacobi relaxation steps.
+    //!
+    //! The steps are fused using temporally blocked sweeps, so the grid is
+    //! streamed from the memory only once per a few steps. The result is
+    //! stored in \p x, and \p xTemp should have the same size as \p x.
+    //!
+    static void relax(const FdmMatrix3& A, const FdmVector3& b,
+                      unsigned int numberOfIterations, FdmVector3* x,
+                      FdmVector3* xTemp);
+
     //! Performs single Jacobi relaxation step for compressed sys.
     static void relax(const MatrixCsrD& A, const VectorND& b, VectorND* x,
                       VectorND* xTemp);
@@ -12,6 +12,8 @@
 #include <jet/matrix_csr.h>
 #include <jet/vector_n.h>
 
+#include <vector>
+
 namespace jet {
 
 //! The row of FdmMatrix3 where row corresponds to (i, j, k) grid point.
@@ -53,6 +55,60 @@ struct FdmLinearSystem3 {
     void resize(const Size3& size);
 };
 
+//!
+//! \brief Multiple vectors for 3-D finite differencing.
+//!
+//! The values of all the vectors at a grid point are stored next to each
+//! other, so that a single sweep over the grid serves all the vectors and
+//! reads the matrix row of each grid point only once.
+//!
+struct FdmMultiVector3 {
+    //! Grid size of the vectors.
+    Size3 size;
+
+    //! Number of the vectors.
+    size_t numberOfVectors = 0;
+
+    //! Values interleaved per grid point.
+    Array1<double> data;
+
+    //! Clears all the data.
+    void clear();
+
+    //! Resizes the data with given grid size and number of vectors.
+    void resize(const Size3& size, size_t numberOfVectors);
+
+    //! Returns the value of the n-th vector at (i, j, k).
+    double& operator()(size_t i, size_t j, size_t k, size_t n);
+
+    //! Returns the value of the n-th vector at (i, j, k).
+    const double& operator()(size_t i, size_t j, size_t k, size_t n) const;
+
+    //! Copies \p v to the n-th vector.
+    void setVector(size_t n, const FdmVector3& v);
+
+    //! Copies the n-th vector to \p v.
+    void getVector(size_t n, FdmVector3* v) const;
+};
+
+//! Linear systems (Ax_n=b_n) sharing the matrix for 3-D finite differencing.
+struct FdmMultiLinearSystem3 {
+    //! System matrix.
+    FdmMatrix3 A;
+
+    //! Solution vectors.
+    FdmMultiVector3 x;
+
+    //! RHS vectors.
+    FdmMultiVector3 b;
+
+    //! Clears all the data.
+    void clear();
+
+    //! Resizes the arrays with given grid size and number of RHS vectors.
+    void resize(const Size3& size, size_t numberOfVectors);
+};
+
 //! Compressed linear system (Ax=b) for 3-D finite differencing.
 struct FdmCompressedLinearSystem3 {
     //! System matrix.
@@ -150,6 +206,39 @@ struct FdmCompressedBlas3 {
     static ScalarType lInfNorm(const VectorType& v);
 };
 
+//!
+//! \brief BLAS operator wrapper for multiple 3-D finite differencing vectors.
+//!
+//! The scalars of the operations are given per vector.
+//!
+struct FdmMultiBlas3 {
+    typedef std::vector<double> ScalarType;
+    typedef FdmMultiVector3 VectorType;
+    typedef FdmMatrix3 MatrixType;
+
+    //! Sets entire element of given vector \p result with scalar \p s.
+    static void set(double s, VectorType* result);
+
+    //! Copies entire element of given vector \p result with other vector \p v.
+    static void set(const VectorType& v, VectorType* result);
+
+    //! Performs dot products of the vectors in \p a and \p b.
+    static void dot(const VectorType& a, const VectorType& b,
+                    ScalarType* result);
+
+    //! Performs a_n x_n + y_n operation for each vector.
+    static void axpy(const ScalarType& a, const VectorType& x,
+                     const VectorType& y, VectorType* result);
+
+    //! Performs matrix-vector multiplication for all the vectors.
+    static void mvm(const MatrixType& m, const VectorType& v,
+                    VectorType* result);
+
+    //! Computes residual vectors (b - ax).
+    static void residual(const MatrixType& a, const VectorType& x,
+                         const VectorType& b, VectorType* result);
+};
+
 }  // namespace jet
 
 #endif  // INCLUDE_JET_FDM_LINEAR_SYSTEM3_H_
@@ -23,6 +23,38 @@ class FdmLinearSystemSolver3 {
     //! Solves the given linear system.
     virtual bool solve(FdmLinearSystem3* system) = 0;
 
+    //!
+    //! \brief Solves the given linear system whose matrix is the same as the
+    //!        one from the last solve.
+    //!
+    //! Solvers which build auxiliary data from the matrix, such as a
+    //! preconditioner, can skip rebuilding it when solving the same system
+    //! with a different right-hand side. By default, this is same as solve().
+    //!
+    virtual bool solveWithSameMatrix(FdmLinearSystem3* system) {
+        return solve(system);
+    }
+
+    //!
+    //! \brief Solves the linear systems which share the matrix.
+    //!
+    //! Krylov solvers can apply the matrix and the preconditioner to all the
+    //! right-hand sides in a single sweep. By default, the systems are solved
+    //! one by one using solve() and then solveWithSameMatrix().
+    //!
+    virtual bool solveMultiple(FdmMultiLinearSystem3* system);
+
+    //!
+    //! \brief Solves the linear systems which share the matrix from the last
+    //!        solve.
+    //!
+    //! This is the multi-RHS version of solveWithSameMatrix(). By default, this
+    //! is same as solveMultiple().
+    //!
+    virtual bool solveMultipleWithSameMatrix(FdmMultiLinearSystem3* system) {
+        return solveMultiple(system);
+    }
+
     //! Solves the given compressed linear system.
     virtual bool solveCompressed(FdmCompressedLinearSystem3*) { return false; }
 };
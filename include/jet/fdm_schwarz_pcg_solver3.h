@@ -0,0 +1,140 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_FDM_SCHWARZ_PCG_SOLVER3_H_
+#define INCLUDE_JET_FDM_SCHWARZ_PCG_SOLVER3_H_
+
+#include <jet/fdm_cg_solver3.h>
+
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief 3-D finite difference-type linear system solver using conjugate
+//!        gradient with domain-decomposed additive Schwarz preconditioner.
+//!
+//! The grid is split into slabs along the z-axis, and each subdomain is
+//! owned by a single thread. A subdomain keeps its own copy of the
+//! preconditioner and work buffers which covers the owned slab plus the ghost
+//! layers shared with the neighbors. The preconditioner gathers the residual
+//! over the extended slab, applies a local incomplete Cholesky solve, and then
+//! sums up the owned part with the ghost-layer results from the neighbors.
+//! Since every subdomain solves independently, the preconditioner scales with
+//! the number of subdomains unlike the global ICCG whose triangular solves
+//! are sequential.
+//!
+//! For the compressed system, the rows are split into contiguous blocks
+//! without overlap (block Jacobi).
+//!
+class FdmSchwarzPcgSolver3 final : public FdmLinearSystemSolver3 {
+ public:
+    //!
+    //! Constructs the solver with given parameters.
+    //!
+    //! \param[in]  maxNumberOfIterations   Max number of CG iterations.
+    //! \param[in]  tolerance               Max residual tolerance.
+    //! \param[in]  numberOfSubdomains      Number of subdomains. Zero uses
+    //!                                     the max number of threads.
+    //! \param[in]  numberOfGhostLayers     Number of overlapping layers on
+    //!                                     each side of a subdomain.
+    //!
+    FdmSchwarzPcgSolver3(unsigned int maxNumberOfIterations, double tolerance,
+                         unsigned int numberOfSubdomains = 0,
+                         unsigned int numberOfGhostLayers = 2);
+
+    //! Solves the given linear system.
+    bool solve(FdmLinearSystem3* system) override;
+
+    //! Solves the given compressed linear system.
+    bool solveCompressed(FdmCompressedLinearSystem3* system) override;
+
+    //! Returns the max number of CG iterations.
+    unsigned int maxNumberOfIterations() const;
+
+    //! Returns the last number of CG iterations the solver made.
+    unsigned int lastNumberOfIterations() const;
+
+    //! Returns the max residual tolerance for the CG method.
+    double tolerance() const;
+
+    //! Returns the last residual after the CG iterations.
+    double lastResidual() const;
+
+    //! Returns the requested number of subdomains.
+    unsigned int numberOfSubdomains() const;
+
+    //! Returns the number of overlapping layers of each subdomain.
+    unsigned int numberOfGhostLayers() const;
+
+ private:
+    struct Subdomain final {
+        // Owned range [ownedBegin, ownedEnd) and extended range
+        // [begin, end) including the ghost layers
+        size_t begin;
+        size_t end;
+        size_t ownedBegin;
+        size_t ownedEnd;
+
+        FdmVector3 d;
+        FdmVector3 y;
+        FdmVector3 x;
+    };
+
+    struct Preconditioner final {
+        ConstArrayAccessor3<FdmMatrixRow3> A;
+        std::vector<Subdomain> subdomains;
+
+        void build(const FdmMatrix3& matrix, size_t numberOfSubdomains,
+                   size_t numberOfGhostLayers);
+
+        void solve(const FdmVector3& b, FdmVector3* x);
+    };
+
+    struct PreconditionerCompressed final {
+        const MatrixCsrD* A;
+        std::vector<size_t> blockBegins;
+        VectorND d;
+        VectorND y;
+
+        void build(const MatrixCsrD& matrix, size_t numberOfSubdomains);
+
+        void solve(const VectorND& b, VectorND* x);
+    };
+
+    unsigned int _maxNumberOfIterations;
+    unsigned int _lastNumberOfIterations;
+    double _tolerance;
+    double _lastResidualNorm;
+    unsigned int _numberOfSubdomains;
+    unsigned int _numberOfGhostLayers;
+
+    // Uncompressed vectors and preconditioner
+    FdmVector3 _r;
+    FdmVector3 _d;
+    FdmVector3 _q;
+    FdmVector3 _s;
+    Preconditioner _precond;
+
+    // Compressed vectors and preconditioner
+    VectorND _rComp;
+    VectorND _dComp;
+    VectorND _qComp;
+    VectorND _sComp;
+    PreconditionerCompressed _precondComp;
+
+    size_t targetNumberOfSubdomains() const;
+
+    void clearUncompressedVectors();
+    void clearCompressedVectors();
+};
+
+//! Shared pointer type for the FdmSchwarzPcgSolver3.
+typedef std::shared_ptr<FdmSchwarzPcgSolver3> FdmSchwarzPcgSolver3Ptr;
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_FDM_SCHWARZ_PCG_SOLVER3_H_
@@ -53,10 +53,59 @@ class FlipSolver3 : public PicSolver3 {
     //!
     void setPicBlendingFactor(double factor);
 
+    //! Returns true if the solver is using narrow-band FLIP.
+    bool isUsingNarrowBand() const;
+
+    //!
+    //! \brief Sets whether the solver should use narrow-band FLIP.
+    //!
+    //! When enabled, the solver keeps particles only within a narrow band
+    //! below the liquid surface. The deep interior is represented by a grid
+    //! level set and grid velocities which are advected on the grid, while
+    //! particles that drift below the band are removed and cells at the band
+    //! boundary are reseeded. This drastically reduces the number of particles
+    //! (and therefore the transfer cost) for large bodies of water. The grid
+    //! level set is added to the grid system data when the mode is enabled
+    //! for the first time. Default is false.
+    //!
+    //! \see Ferstl, Florian, et al. "Narrow band FLIP for liquid simulations."
+    //!     Computer Graphics Forum. Vol. 35. No. 2. 2016.
+    //!
+    //! \param[in] onoff True to enable narrow-band FLIP.
+    //!
+    void setIsUsingNarrowBand(bool onoff);
+
+    //! Returns the width of the particle band in number of grid cells.
+    double narrowBandWidth() const;
+
+    //!
+    //! \brief Sets the width of the particle band in number of grid cells.
+    //!
+    //! This function sets the depth from the liquid surface, measured in grid
+    //! cells, within which the particles are kept when narrow-band FLIP is
+    //! enabled. The width will be clamped to be at least 2. Default is 3.
+    //!
+    //! \param[in] widthInCells The band width in grid cells.
+    //!
+    void setNarrowBandWidth(double widthInCells);
+
+    //!
+    //! \brief Returns the grid level set representing the liquid interior.
+    //!
+    //! Returns nullptr if narrow-band FLIP has never been enabled.
+    //!
+    ScalarGrid3Ptr narrowBandLevelSet() const;
+
     //! Returns builder fox FlipSolver3.
     static Builder builder();
 
  protected:
+    //! Invoked before a simulation time-step begins.
+    void onBeginAdvanceTimeStep(double timeIntervalInSeconds) override;
+
+    //! Computes the advection term of the fluid solver.
+    void computeAdvection(double timeIntervalInSeconds) override;
+
     //! Transfers velocity field from particles to grids.
     void transferFromParticlesToGrids() override;
 
@@ -68,6 +117,22 @@ class FlipSolver3 : public PicSolver3 {
     Array3<float> _uDelta;
     Array3<float> _vDelta;
     Array3<float> _wDelta;
+
+    bool _isUsingNarrowBand = false;
+    double _narrowBandWidth = 3.0;
+    size_t _narrowBandLevelSetId = kMaxSize;
+    FaceCenteredGrid3 _narrowBandVelocity;
+    unsigned int _reseedingCount = 0;
+
+    double narrowBandWidthInWorld() const;
+
+    void fillInteriorVelocityFromGrid();
+
+    void updateNarrowBandLevelSet();
+
+    void advectNarrowBandInterior(double timeIntervalInSeconds);
+
+    void reseedNarrowBandParticles();
 };
 
 //! Shared pointer type for the FlipSolver3.
@@ -26,6 +26,12 @@ namespace jet {
 //! To solve the backward Euler method, a linear system solver is used and
 //! incomplete Cholesky conjugate gradient method is used by default.
 //!
+//! The matrix of the last linear system is kept and reused as long as the
+//! solid/fluid markers and the coefficient (time interval x diffusion
+//! coefficient / grid spacing^2) stay the same, so that diffusing several
+//! fields on the same grid, or the same field over the time-steps, does not
+//! rebuild the matrix nor the preconditioner.
+//!
 class GridBackwardEulerDiffusionSolver3 final : public GridDiffusionSolver3 {
  public:
     enum BoundaryType {
@@ -97,14 +103,45 @@ class GridBackwardEulerDiffusionSolver3 final : public GridDiffusionSolver3 {
         const ScalarField3& fluidSdf
             = ConstantScalarField3(-kMaxD)) override;
 
+    //!
+    //! Solves diffusion equation for multiple scalar fields on the same grid.
+    //!
+    //! The markers and the matrix are built once, and the fields are solved
+    //! together by FdmLinearSystemSolver3::solveMultiple, which lets the
+    //! Krylov solvers sweep the matrix and the preconditioner once for all the
+    //! right-hand sides.
+    //!
+    //! \param sources Input scalar fields.
+    //! \param diffusionCoefficient Amount of diffusion.
+    //! \param timeIntervalInSeconds Small time-interval that diffusion occur.
+    //! \param dests Output scalar fields.
+    //! \param boundarySdf Shape of the solid boundary that is empty by default.
+    //! \param boundarySdf Shape of the fluid boundary that is full by default.
+    //!
+    void solveMultiple(
+        const std::vector<const ScalarGrid3*>& sources,
+        double diffusionCoefficient,
+        double timeIntervalInSeconds,
+        const std::vector<ScalarGrid3*>& dests,
+        const ScalarField3& boundarySdf
+            = ConstantScalarField3(kMaxD),
+        const ScalarField3& fluidSdf
+            = ConstantScalarField3(-kMaxD)) override;
+
+    //! Returns the linear system solver for this diffusion solver.
+    const FdmLinearSystemSolver3Ptr& linearSystemSolver() const;
+
     //! Sets the linear system solver for this diffusion solver.
     void setLinearSystemSolver(const FdmLinearSystemSolver3Ptr& solver);
 
  private:
     BoundaryType _boundaryType;
     FdmLinearSystem3 _system;
+    FdmMultiLinearSystem3 _multiSystem;
     FdmLinearSystemSolver3Ptr _systemSolver;
     Array3<char> _markers;
+    Array3<char> _matrixMarkers;
+    Vector3D _matrixCoefficients;
 
     void buildMarkers(
         const Size3& size,
@@ -116,6 +153,14 @@ class GridBackwardEulerDiffusionSolver3 final : public GridDiffusionSolver3 {
         const Size3& size,
         const Vector3D& c);
 
+    bool updateMatrix(
+        const Size3& size,
+        const Vector3D& c);
+
+    void solveSystem(bool isMatrixReused);
+
+    void solveMultipleSystems(bool isMatrixReused);
+
     void buildVectors(
         const ConstArrayAccessor3<double>& f,
         const Vector3D& c);
@@ -14,6 +14,7 @@
 #include <jet/scalar_grid3.h>
 #include <limits>
 #include <memory>
+#include <vector>
 
 namespace jet {
 
@@ -88,6 +89,29 @@ class GridDiffusionSolver3 {
         FaceCenteredGrid3* dest,
         const ScalarField3& boundarySdf = ConstantScalarField3(kMaxD),
         const ScalarField3& fluidSdf = ConstantScalarField3(-kMaxD)) = 0;
+
+    //!
+    //! Solves diffusion equation for multiple scalar fields on the same grid.
+    //!
+    //! All the sources should have the same data layout. Each dest can be the
+    //! same grid as the corresponding source. Solvers can share the work that
+    //! only depends on the grid and the boundaries, such as the linear system
+    //! matrix; the default implementation solves the fields one by one.
+    //!
+    //! \param sources Input scalar fields.
+    //! \param diffusionCoefficient Amount of diffusion.
+    //! \param timeIntervalInSeconds Small time-interval that diffusion occur.
+    //! \param dests Output scalar fields.
+    //! \param boundarySdf Shape of the solid boundary that is empty by default.
+    //! \param boundarySdf Shape of the fluid boundary that is full by default.
+    //!
+    virtual void solveMultiple(
+        const std::vector<const ScalarGrid3*>& sources,
+        double diffusionCoefficient,
+        double timeIntervalInSeconds,
+        const std::vector<ScalarGrid3*>& dests,
+        const ScalarField3& boundarySdf = ConstantScalarField3(kMaxD),
+        const ScalarField3& fluidSdf = ConstantScalarField3(-kMaxD));
 };
 
 //! Shared pointer type for the GridDiffusionSolver3.
@@ -181,6 +181,9 @@ class GridFluidSolver2 : public PhysicsAnimation {
     //! Sets the emitter.
     void setEmitter(const GridEmitter2Ptr& newEmitter);
 
+    //! Returns the number of grid cells as the problem size.
+    size_t problemSize() const override;
+
     //! Returns builder fox GridFluidSolver2.
     static Builder builder();
 
@@ -9,6 +9,7 @@
 
 #include <jet/advection_solver3.h>
 #include <jet/cell_centered_scalar_grid3.h>
+#include <jet/closest_point_extrapolation3.h>
 #include <jet/collider3.h>
 #include <jet/face_centered_grid3.h>
 #include <jet/grid_boundary_condition_solver3.h>
@@ -84,6 +85,19 @@ class GridFluidSolver3 : public PhysicsAnimation {
     //! Sets whether the solver should use compressed linear system.
     void setUseCompressedLinearSystem(bool onoff);
 
+    //! Returns the extrapolation type for the collider and air regions.
+    ExtrapolationType extrapolationType() const;
+
+    //!
+    //! \brief Sets the extrapolation type for the collider and air regions.
+    //!
+    //! With ExtrapolationType::kClosestPoint, the fields are extrapolated by
+    //! sampling at the closest points of the interface in parallel, which
+    //! replaces the front propagation of the default
+    //! ExtrapolationType::kPropagation.
+    //!
+    void setExtrapolationType(ExtrapolationType type);
+
     //! Returns the advection solver instance.
     const AdvectionSolver3Ptr& advectionSolver() const;
 
@@ -181,6 +195,9 @@ class GridFluidSolver3 : public PhysicsAnimation {
     //! Sets the emitter.
     void setEmitter(const GridEmitter3Ptr& newEmitter);
 
+    //! Returns the number of grid cells as the problem size.
+    size_t problemSize() const override;
+
     //! Returns builder fox GridFluidSolver3.
     static Builder builder();
 
@@ -270,6 +287,7 @@ class GridFluidSolver3 : public PhysicsAnimation {
     double _viscosityCoefficient = 0.0;
     double _maxCfl = 5.0;
     bool _useCompressedLinearSys = false;
+    ExtrapolationType _extrapolationType = ExtrapolationType::kPropagation;
     int _closedDomainBoundaryFlag = kDirectionAll;
 
     GridSystemData3Ptr _grids;
@@ -288,6 +306,8 @@ class GridFluidSolver3 : public PhysicsAnimation {
     void updateCollider(double timeIntervalInSeconds);
 
     void updateEmitter(double timeIntervalInSeconds);
+
+    ScalarField3Ptr outsideColliderSdf() const;
 };
 
 //! Shared pointer type for the GridFluidSolver3.
@@ -30,6 +30,20 @@ class GridForwardEulerDiffusionSolver3 final : public GridDiffusionSolver3 {
     //! Default constructor.
     GridForwardEulerDiffusionSolver3();
 
+    //! Returns the number of sub-steps per solve.
+    unsigned int numberOfSubSteps() const;
+
+    //!
+    //! \brief Sets the number of sub-steps per solve.
+    //!
+    //! Splitting the time interval into \p numberOfSubSteps steps relaxes the
+    //! stability limit of the diffusion coefficient by the same factor. The
+    //! sub-steps are fused using temporally blocked sweeps, so the grid is
+    //! streamed from the memory only once per a few sub-steps. The default is
+    //! 1.
+    //!
+    void setNumberOfSubSteps(unsigned int numberOfSubSteps);
+
     //!
     //! Solves diffusion equation for a scalar field.
     //!
@@ -91,7 +105,10 @@ class GridForwardEulerDiffusionSolver3 final : public GridDiffusionSolver3 {
             = ConstantScalarField3(-kMaxD)) override;
 
  private:
+    unsigned int _numberOfSubSteps = 1;
     Array3<char> _markers;
+    Array3<double> _scalarBuffer;
+    Array3<Vector3D> _vectorBuffer;
 
     void buildMarkers(
         const Size3& size,
@@ -9,6 +9,7 @@
 
 #include <jet/cell_centered_scalar_grid3.h>
 #include <jet/custom_vector_field3.h>
+#include <jet/face_centered_grid3.h>
 #include <jet/grid_boundary_condition_solver3.h>
 
 #include <memory>
@@ -50,7 +51,14 @@ class GridFractionalBoundaryConditionSolver3
     VectorField3Ptr colliderVelocityField() const override;
 
  protected:
-    //! Invoked when a new collider is set.
+    //!
+    //! \brief Invoked when a new collider is set.
+    //!
+    //! The open/closed state of the faces, which is derived from the
+    //! fractional face weights of the collider, is cached until this function
+    //! is called again, so the repeated constrainVelocity calls within a
+    //! time-step do not resample the collider sdf.
+    //!
     void onColliderUpdated(
         const Size3& gridSize,
         const Vector3D& gridSpacing,
@@ -59,6 +67,12 @@ class GridFractionalBoundaryConditionSolver3
  private:
     CellCenteredScalarGrid3Ptr _colliderSdf;
     CustomVectorField3Ptr _colliderVel;
+    Array3<char> _uMarker;
+    Array3<char> _vMarker;
+    Array3<char> _wMarker;
+    bool _hasFaceMarkers = false;
+
+    void updateFaceMarkers(const FaceCenteredGrid3& velocity);
 };
 
 //! Shared pointer type for the GridFractionalBoundaryConditionSolver3.
@@ -99,6 +99,28 @@ class GridFractionalSinglePhasePressureSolver3 : public GridPressureSolver3 {
     //! Returns the pressure field.
     const FdmVector3& pressure() const;
 
+    //! Returns the tolerance of the SDF changes for rebuilding the system.
+    double rebuildTolerance() const;
+
+    //!
+    //! \brief Sets the tolerance of the SDF changes for rebuilding the system.
+    //!
+    //! The face weights and the matrix rows are kept from the previous solve
+    //! where neither the boundary nor the fluid SDF have changed since then.
+    //! A sample whose change is within \p tolerance, without changing the
+    //! sign, is treated as unchanged. Zero tolerance, which is the default,
+    //! gives the same system as the full rebuild.
+    //!
+    void setRebuildTolerance(double tolerance);
+
+    //!
+    //! \brief Returns the time spent building the system in the last solve.
+    //!
+    //! The time covers building the face weights and the linear system for
+    //! all the multigrid levels, excluding the linear system solve.
+    //!
+    double lastBuildTimeInSeconds() const;
+
  private:
     FdmLinearSystem3 _system;
     FdmCompressedLinearSystem3 _compSystem;
@@ -112,6 +134,21 @@ class GridFractionalSinglePhasePressureSolver3 : public GridPressureSolver3 {
     std::vector<Array3<float>> _wWeights;
     std::vector<Array3<float>> _fluidSdf;
 
+    // Change flags of the last build for the incremental rebuild
+    Array3<double> _boundarySdf;
+    Array3<char> _boundarySdfChanged;
+    std::vector<Array3<char>> _fluidSdfFlags;
+    std::vector<Array3<char>> _uWeightsChanged;
+    std::vector<Array3<char>> _vWeightsChanged;
+    std::vector<Array3<char>> _wWeightsChanged;
+    std::vector<Array3<char>> _markers;
+    Vector3D _gridSpacing;
+    Vector3D _gridOrigin;
+    double _rebuildTolerance = 0.0;
+    double _lastBuildTimeInSeconds = 0.0;
+    bool _isFullRebuild = true;
+    bool _isDenseSystemStale = true;
+
     std::function<Vector3D(const Vector3D&)> _boundaryVel;
 
     void buildWeights(const FaceCenteredGrid3& input,
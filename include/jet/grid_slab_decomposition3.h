@@ -0,0 +1,123 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_GRID_SLAB_DECOMPOSITION3_H_
+#define INCLUDE_JET_GRID_SLAB_DECOMPOSITION3_H_
+
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/face_centered_grid3.h>
+
+#include <functional>
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief 3-D grid decomposition into z-slabs with ghost layers.
+//!
+//! The grid is split along the z-axis into subdomains. Each subdomain owns
+//! the cell layers [ownedBegin, ownedEnd) and keeps its own local grids which
+//! cover the owned layers plus the ghost layers on each side, clamped to the
+//! domain. The w-faces follow the cell below them, and the top-most face
+//! belongs to the last subdomain. A subdomain only writes its owned layers
+//! back to the global grids, and its ghost layers are filled from the local
+//! grids of the owning neighbors, so the subdomains can be processed
+//! concurrently without sharing any writable memory.
+//!
+//! The slabs are split the same way as FdmSchwarzPcgSolver3, so with the same
+//! number of subdomains, a layer has the same owner in every solver stage.
+//!
+class GridSlabDecomposition3 final {
+ public:
+    //! Local grids of a single subdomain.
+    struct Subdomain final {
+        //! First owned cell layer.
+        size_t ownedBegin = 0;
+
+        //! One past the last owned cell layer.
+        size_t ownedEnd = 0;
+
+        //! First cell layer of the local grids.
+        size_t begin = 0;
+
+        //! One past the last cell layer of the local grids.
+        size_t end = 0;
+
+        //! Local scalar grids.
+        std::vector<CellCenteredScalarGrid3Ptr> scalars;
+
+        //! Local velocity grid.
+        FaceCenteredGrid3Ptr velocity;
+    };
+
+    //! Constructs an empty decomposition.
+    GridSlabDecomposition3();
+
+    //!
+    //! \brief Resizes the decomposition.
+    //!
+    //! The local grids are reallocated only when the layout changes. The
+    //! number of subdomains is clamped to the number of cell layers.
+    //!
+    //! \param[in]  resolution          The global grid resolution.
+    //! \param[in]  gridSpacing         The grid spacing.
+    //! \param[in]  origin              The global grid origin.
+    //! \param[in]  numberOfSubdomains  The number of subdomains.
+    //! \param[in]  numberOfGhostLayers The number of ghost layers per side.
+    //! \param[in]  numberOfScalars     The number of scalar grids.
+    //!
+    void resize(const Size3& resolution, const Vector3D& gridSpacing,
+                const Vector3D& origin, size_t numberOfSubdomains,
+                size_t numberOfGhostLayers, size_t numberOfScalars);
+
+    //! Returns the global grid resolution.
+    const Size3& resolution() const;
+
+    //! Returns the number of subdomains.
+    size_t numberOfSubdomains() const;
+
+    //! Returns the number of ghost layers per side.
+    size_t numberOfGhostLayers() const;
+
+    //! Returns the subdomain at given index.
+    Subdomain& subdomain(size_t i);
+
+    //! Returns the subdomain at given index.
+    const Subdomain& subdomain(size_t i) const;
+
+    //! Returns the index of the subdomain which owns the cell layer \p k.
+    size_t ownerOf(size_t k) const;
+
+    //! Copies the owned layers of the global grids to the local grids.
+    void load(const std::vector<CellCenteredScalarGrid3Ptr>& scalars,
+              const FaceCenteredGrid3& velocity);
+
+    //! Fills the ghost layers of each subdomain from the owning neighbors.
+    void exchangeGhostLayers();
+
+    //! Copies the owned layers of the local grids back to the global grids.
+    void store(const std::vector<CellCenteredScalarGrid3Ptr>& scalars,
+               FaceCenteredGrid3* velocity) const;
+
+    //!
+    //! \brief Invokes \p func for each subdomain concurrently.
+    //!
+    //! Each subdomain runs on a single thread, so the nested parallel loops
+    //! inside \p func do not oversubscribe the threads.
+    //!
+    void forEachSubdomain(const std::function<void(Subdomain&)>& func);
+
+ private:
+    Size3 _resolution;
+    Vector3D _gridSpacing;
+    Vector3D _origin;
+    size_t _numberOfGhostLayers = 0;
+    std::vector<Subdomain> _subdomains;
+};
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_GRID_SLAB_DECOMPOSITION3_H_
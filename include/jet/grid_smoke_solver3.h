@@ -8,6 +8,7 @@
 #define INCLUDE_JET_GRID_SMOKE_SOLVER3_H_
 
 #include <jet/grid_fluid_solver3.h>
+#include <jet/grid_slab_decomposition3.h>
 
 namespace jet {
 
@@ -150,6 +151,31 @@ class GridSmokeSolver3 : public GridFluidSolver3 {
     //!
     void setTemperatureDecayFactor(double newValue);
 
+    //! Returns the number of subdomains for the domain-decomposed mode.
+    size_t numberOfSubdomains() const;
+
+    //!
+    //! \brief      Sets the number of subdomains for the domain-decomposed
+    //!     mode.
+    //!
+    //! With more than one subdomain, the grid is split into z-slabs (see
+    //! GridSlabDecomposition3) and each slab is owned by a single thread. The
+    //! advection runs on the local grids of each slab after exchanging the
+    //! ghost layers, where the number of ghost layers covers the back-trace
+    //! distance. The linear systems of the default pressure and diffusion
+    //! solvers are solved by FdmSchwarzPcgSolver3 over the same slabs.
+    //! Setting zero or one turns the mode off and puts back the linear system
+    //! solvers which were in use before the mode was turned on. A linear
+    //! system solver set while the mode is on is kept as it is.
+    //!
+    //! The advection falls back to the undecomposed path if any advectable
+    //! scalar is not cell-centered or any advectable vector other than the
+    //! velocity is added.
+    //!
+    //! \param[in]  numberOfSubdomains The number of subdomains.
+    //!
+    void setNumberOfSubdomains(size_t numberOfSubdomains);
+
     //! Returns smoke density field.
     ScalarGrid3Ptr smokeDensity() const;
 
@@ -164,6 +190,8 @@ class GridSmokeSolver3 : public GridFluidSolver3 {
 
     void computeExternalForces(double timeIntervalInSeconds) override;
 
+    void computeAdvection(double timeIntervalInSeconds) override;
+
  private:
     size_t _smokeDensityDataId;
     size_t _temperatureDataId;
@@ -173,6 +201,12 @@ class GridSmokeSolver3 : public GridFluidSolver3 {
     double _buoyancyTemperatureFactor = 5.0;
     double _smokeDecayFactor = 0.001;
     double _temperatureDecayFactor = 0.001;
+    size_t _numberOfSubdomains = 0;
+    GridSlabDecomposition3 _slabs;
+    FdmLinearSystemSolver3Ptr _schwarzPressureSystemSolver;
+    FdmLinearSystemSolver3Ptr _schwarzDiffusionSystemSolver;
+    FdmLinearSystemSolver3Ptr _prevPressureSystemSolver;
+    FdmLinearSystemSolver3Ptr _prevDiffusionSystemSolver;
 
     void computeDiffusion(double timeIntervalInSeconds);
 
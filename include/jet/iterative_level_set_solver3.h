@@ -33,6 +33,11 @@ class IterativeLevelSetSolver3 : public LevelSetSolver3 {
     //!
     //! Reinitializes given scalar field to signed-distance field.
     //!
+    //! Only the grid points whose input value is within \p maxDistance (plus
+    //! a grid cell) are updated, and the pseudo-time iteration stops early
+    //! once the max residual drops below residualTolerance(). The points
+    //! outside the band keep the input values.
+    //!
     //! \param inputSdf Input signed-distance field which can be distorted.
     //! \param maxDistance Max range of reinitialization.
     //! \param outputSdf Output signed-distance field.
@@ -87,6 +92,31 @@ class IterativeLevelSetSolver3 : public LevelSetSolver3 {
     //!
     void setMaxCfl(double newMaxCfl);
 
+    //! Returns true if the reinitialization uses 3rd-order TVD Runge-Kutta.
+    bool isTvdRungeKutta3Enabled() const;
+
+    //!
+    //! \brief Enables or disables 3rd-order TVD Runge-Kutta.
+    //!
+    //! When enabled, each pseudo-time iteration of the reinitialization takes
+    //! three Euler stages in the Shu-Osher form instead of one, which pairs
+    //! with the high-order spatial derivatives. The extrapolation always uses
+    //! the explicit Euler step.
+    //!
+    void setTvdRungeKutta3Enabled(bool enabled);
+
+    //! Returns the residual tolerance for the reinitialization.
+    double residualTolerance() const;
+
+    //!
+    //! \brief Sets the residual tolerance for the reinitialization.
+    //!
+    //! The reinitialization stops when the max change of the field per unit
+    //! pseudo-time, which is |grad phi| - 1 scaled by the smeared sign, falls
+    //! below this tolerance. The negative input will be clamped to 0.
+    //!
+    void setResidualTolerance(double newTolerance);
+
  protected:
     //! Computes the derivatives for given grid point.
     virtual void getDerivatives(ConstArrayAccessor3<double> grid,
@@ -95,8 +125,59 @@ class IterativeLevelSetSolver3 : public LevelSetSolver3 {
                                 std::array<double, 2>* dy,
                                 std::array<double, 2>* dz) const = 0;
 
+    //!
+    //! \brief Computes the derivatives for the points from \p iBegin to
+    //! \p iEnd (exclusive) of the i-row (j, k).
+    //!
+    //! The minus- and plus-side derivatives of the point i are written to
+    //! dx[0][i - iBegin] and dx[1][i - iBegin], and likewise for y and z. The
+    //! default implementation calls getDerivatives for each point. Subclasses
+    //! can override this function with a row-oriented kernel which should
+    //! give the identical results.
+    //!
+    virtual void getRowDerivatives(ConstArrayAccessor3<double> grid,
+                                   const Vector3D& gridSpacing, size_t iBegin,
+                                   size_t iEnd, size_t j, size_t k,
+                                   std::array<double*, 2> dx,
+                                   std::array<double*, 2> dy,
+                                   std::array<double*, 2> dz) const;
+
+    //!
+    //! \brief Collects the rows of the stencils along y and z axes.
+    //!
+    //! y[m] and z[m] point to the i-row starting at \p iBegin with the offset
+    //! m - halfWidth along each axis from (j, k). The offsets are clamped to
+    //! the grid, and both arrays should hold 2 * halfWidth + 1 pointers.
+    //!
+    static void getRowStencils(ConstArrayAccessor3<double> grid, size_t iBegin,
+                               size_t j, size_t k, size_t halfWidth,
+                               const double** y, const double** z);
+
+    //! Row-oriented derivative kernel such as upwind1Row, eno3Row and
+    //! weno5Row.
+    typedef void (*RowDerivativeKernel)(const double* const* D0, size_t n,
+                                        double h, double* dfxm, double* dfxp);
+
+    //!
+    //! \brief Computes the row derivatives with the given row kernel.
+    //!
+    //! The kernel reads 2 * \p halfWidth + 1 stencil rows along each axis,
+    //! and \p halfWidth should be at most 3. The stencils along y and z are
+    //! collected by getRowStencils. Along x, the points whose stencils stay
+    //! inside the grid row are computed as a single row, and the points near
+    //! the ends of the grid row are computed one by one with the clamped
+    //! stencils. The outputs are laid out as in getRowDerivatives.
+    //!
+    static void computeRowDerivatives(
+        ConstArrayAccessor3<double> grid, const Vector3D& gridSpacing,
+        size_t iBegin, size_t iEnd, size_t j, size_t k, size_t halfWidth,
+        RowDerivativeKernel kernel, std::array<double*, 2> dx,
+        std::array<double*, 2> dy, std::array<double*, 2> dz);
+
  private:
     double _maxCfl = 0.5;
+    double _residualTolerance = 1e-3;
+    bool _isTvdRungeKutta3Enabled = false;
 
     void extrapolate(const ConstArrayAccessor3<double>& input,
                      const ConstArrayAccessor3<double>& sdf,
@@ -8,6 +8,7 @@
 #define INCLUDE_JET_JET_H_
 #include <jet/advection_solver2.h>
 #include <jet/advection_solver3.h>
+#include <jet/aligned_allocator.h>
 #include <jet/animation.h>
 #include <jet/anisotropic_points_to_implicit2.h>
 #include <jet/anisotropic_points_to_implicit3.h>
@@ -40,6 +41,7 @@
 #include <jet/cell_centered_vector_grid2.h>
 #include <jet/cell_centered_vector_grid3.h>
 #include <jet/cg.h>
+#include <jet/closest_point_extrapolation3.h>
 #include <jet/collider2.h>
 #include <jet/collider3.h>
 #include <jet/collider_set2.h>
@@ -65,6 +67,7 @@
 #include <jet/eno_level_set_solver3.h>
 #include <jet/face_centered_grid2.h>
 #include <jet/face_centered_grid3.h>
+#include <jet/face_centered_stencil3.h>
 #include <jet/fcc_lattice_point_generator.h>
 #include <jet/fdm_cg_solver2.h>
 #include <jet/fdm_cg_solver3.h>
@@ -84,6 +87,7 @@
 #include <jet/fdm_mg_solver3.h>
 #include <jet/fdm_mgpcg_solver2.h>
 #include <jet/fdm_mgpcg_solver3.h>
+#include <jet/fdm_schwarz_pcg_solver3.h>
 #include <jet/fdm_utils.h>
 #include <jet/field2.h>
 #include <jet/field3.h>
@@ -120,6 +124,7 @@
 #include <jet/grid_pressure_solver3.h>
 #include <jet/grid_single_phase_pressure_solver2.h>
 #include <jet/grid_single_phase_pressure_solver3.h>
+#include <jet/grid_slab_decomposition3.h>
 #include <jet/grid_smoke_solver2.h>
 #include <jet/grid_smoke_solver3.h>
 #include <jet/grid_system_data2.h>
@@ -170,6 +175,7 @@
 #include <jet/pci_sph_solver3.h>
 #include <jet/pde.h>
 #include <jet/physics_animation.h>
+#include <jet/physics_animation_batch.h>
 #include <jet/pic_solver2.h>
 #include <jet/pic_solver3.h>
 #include <jet/plane2.h>
@@ -224,6 +230,7 @@
 #include <jet/sphere3.h>
 #include <jet/spherical_points_to_implicit2.h>
 #include <jet/spherical_points_to_implicit3.h>
+#include <jet/step_arena.h>
 #include <jet/surface2.h>
 #include <jet/surface3.h>
 #include <jet/surface_set2.h>
@@ -231,7 +238,10 @@
 #include <jet/surface_to_implicit2.h>
 #include <jet/surface_to_implicit3.h>
 #include <jet/svd.h>
+#include <jet/task_graph.h>
+#include <jet/temporal_blocking.h>
 #include <jet/timer.h>
+#include <jet/transfer_kernels.h>
 #include <jet/transform2.h>
 #include <jet/transform3.h>
 #include <jet/triangle3.h>
@@ -244,6 +254,7 @@
 #include <jet/vector.h>
 #include <jet/vector2.h>
 #include <jet/vector3.h>
+#include <jet/vector3_packet.h>
 #include <jet/vector4.h>
 #include <jet/vector_expression.h>
 #include <jet/vector_field2.h>
@@ -259,6 +270,7 @@
 #include <jet/volume_grid_emitter3.h>
 #include <jet/volume_particle_emitter2.h>
 #include <jet/volume_particle_emitter3.h>
+#include <jet/weno_level_set_solver3.h>
 #include <jet/zhu_bridson_points_to_implicit2.h>
 #include <jet/zhu_bridson_points_to_implicit3.h>
 #endif  // INCLUDE_JET_JET_H_
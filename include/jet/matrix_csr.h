@@ -340,6 +340,16 @@ class MatrixCsr final : public MatrixExpression<T, MatrixCsr<T>> {
     template <typename ME>
     MatrixCsrMatrixMul<T, ME> mul(const MatrixExpression<T, ME>& m) const;
 
+    //!
+    //! \brief Returns this matrix * input sparse matrix.
+    //!
+    //! Unlike the product with a dense matrix expression, the sparsity
+    //! pattern of the result is built row by row in parallel from the
+    //! non-zeros of both matrices (Gustavson's algorithm). The entries which
+    //! are structurally non-zero are kept even if they cancel out to zero.
+    //!
+    MatrixCsr mul(const MatrixCsr& m) const;
+
     //! Returns this matrix / input scalar.
     MatrixCsr div(const T& s) const;
 
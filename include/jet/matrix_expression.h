@@ -336,6 +336,12 @@ class MatrixMul : public MatrixExpression<T, MatrixMul<T, E1, E2>> {
     //! Returns matrix element at (i, j).
     T operator()(size_t i, size_t j) const;
 
+    //! Returns the left-hand side matrix expression.
+    const E1& lhs() const;
+
+    //! Returns the right-hand side matrix expression.
+    const E2& rhs() const;
+
  private:
     const E1& _u;
     const E2& _v;
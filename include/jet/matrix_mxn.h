@@ -108,6 +108,17 @@ class MatrixMxN final : public MatrixExpression<T, MatrixMxN<T>> {
     template <typename E>
     void set(const MatrixExpression<T, E>& other);
 
+    //!
+    //! \brief Evaluates the matrix-matrix multiplication expression.
+    //!
+    //! Large products are evaluated by a cache-blocked, parallel matrix
+    //! multiplication kernel instead of the element-wise dot products of the
+    //! expression. Operands which are not MatrixMxN or alias this matrix are
+    //! evaluated into temporary matrices first.
+    //!
+    template <typename E1, typename E2>
+    void set(const MatrixMul<T, E1, E2>& other);
+
     //! Copies from input array.
     //! \warning Ordering of the input elements is row-major.
     void set(size_t m, size_t n, const T* arr);
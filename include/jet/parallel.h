@@ -7,11 +7,35 @@
 #ifndef INCLUDE_JET_PARALLEL_H_
 #define INCLUDE_JET_PARALLEL_H_
 
+#include <cstddef>
+
 namespace jet {
 
 //! Execution policy tag.
 enum class ExecutionPolicy { kSerial, kParallel };
 
+//!
+//! \brief Minimum number of elements for the element-wise operations of the
+//!        containers to run in parallel.
+//!
+//! Launching the tasks costs tens of microseconds which is more than a loop
+//! over a few thousands of elements, so smaller loops run serially.
+//!
+constexpr size_t kMinParallelSize = 8192;
+
+//!
+//! \brief      Returns the execution policy for a loop over \p size elements.
+//!
+//! \param[in]  size  Number of elements to process.
+//!
+//! \return     kSerial if \p size is less than kMinParallelSize, kParallel
+//!             otherwise.
+//!
+inline ExecutionPolicy executionPolicyForSize(size_t size) {
+    return (size < kMinParallelSize) ? ExecutionPolicy::kSerial
+                                     : ExecutionPolicy::kParallel;
+}
+
 //!
 //! \brief      Fills from \p begin to \p end with \p value in parallel.
 //!
@@ -237,12 +261,49 @@ void parallelSort(RandomIterator begin, RandomIterator end,
                   CompareFunction compare,
                   ExecutionPolicy policy = ExecutionPolicy::kParallel);
 
+//!
+//! \brief      Sorts key/value pairs with unsigned integer keys in parallel.
+//!
+//! This function sorts the keys in ascending order and moves the values along
+//! with their keys using a least-significant-digit radix sort. Only the digits
+//! up to the largest key are processed, so a small key range takes fewer
+//! passes. The sort is stable, so the values with the same key keep their
+//! original order.
+//!
+//! \param[in]  keysBegin   The begin random access iterator of the keys.
+//! \param[in]  keysEnd     The end random access iterator of the keys.
+//! \param[in]  valuesBegin The begin random access iterator of the values.
+//! \param[in]  policy      The execution policy (parallel or serial).
+//!
+//! \tparam     KeyIterator   Key iterator type.
+//! \tparam     ValueIterator Value iterator type.
+//!
+template <typename KeyIterator, typename ValueIterator>
+void parallelRadixSort(KeyIterator keysBegin, KeyIterator keysEnd,
+                       ValueIterator valuesBegin,
+                       ExecutionPolicy policy = ExecutionPolicy::kParallel);
+
 //! Sets maximum number of threads to use.
 void setMaxNumberOfThreads(unsigned int numThreads);
 
 //! Returns maximum number of threads to use.
 unsigned int maxNumberOfThreads();
 
+//!
+//! \brief      Limits the number of threads for the calling thread.
+//!
+//! The parallel functions called from the current thread use at most the
+//! given number of threads, which is useful when running many independent
+//! jobs concurrently. Zero removes the limit. TBB and OpenMP handle nested
+//! parallelism by themselves, so this only affects the C++11 thread backend.
+//!
+//! \param[in]  numThreads The maximum number of threads for this thread.
+//!
+void setMaxNumberOfThreadsForCurrentThread(unsigned int numThreads);
+
+//! Returns the limit of the number of threads for the calling thread.
+unsigned int maxNumberOfThreadsForCurrentThread();
+
 }  // namespace jet
 
 #include "detail/parallel-inl.h"
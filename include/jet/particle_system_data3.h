@@ -128,6 +128,16 @@ class ParticleSystemData3 : public Serializable {
     //! Returns the force array (mutable).
     ArrayAccessor1<Vector3D> forces();
 
+    //!
+    //! \brief Returns the revision number of the force array.
+    //!
+    //! The number increases whenever the forces may have changed, which
+    //! includes handing out a mutable accessor to the forces and any change
+    //! of the number or order of the particles. A value derived from the
+    //! forces is up-to-date as long as the revision stays the same.
+    //!
+    size_t forcesRevision() const;
+
     //! Returns custom scalar data layer at given index (immutable).
     ConstArrayAccessor1<double> scalarDataAt(size_t idx) const;
 
@@ -179,6 +189,32 @@ class ParticleSystemData3 : public Serializable {
         const ConstArrayAccessor1<Vector3D>& newForces
             = ConstArrayAccessor1<Vector3D>());
 
+    //!
+    //! \brief      Removes particles from the data structure.
+    //!
+    //! This function will remove particles whose marker is non-zero while
+    //! keeping the order of the remaining particles. All data layers including
+    //! custom ones are compacted together. However, this will invalidate
+    //! neighbor searcher and neighbor lists. It is users responsibility to call
+    //! ParticleSystemData3::buildNeighborSearcher and
+    //! ParticleSystemData3::buildNeighborLists to refresh those data.
+    //!
+    //! \param[in]  removalMarkers Non-zero value marks a particle to remove.
+    //!
+    void removeParticles(const ConstArrayAccessor1<char>& removalMarkers);
+
+    //!
+    //! \brief      Reorders the particles with given permutation.
+    //!
+    //! After the call, the i-th particle is the particle that was at
+    //! newOrder[i]. All data layers including custom ones are reordered
+    //! together. Like ParticleSystemData3::removeParticles, this will
+    //! invalidate neighbor searcher and neighbor lists.
+    //!
+    //! \param[in]  newOrder   Old particle index for each new index.
+    //!
+    void reorderParticles(const ConstArrayAccessor1<size_t>& newOrder);
+
     //!
     //! \brief      Returns neighbor searcher.
     //!
@@ -238,6 +274,7 @@ class ParticleSystemData3 : public Serializable {
     size_t _positionIdx;
     size_t _velocityIdx;
     size_t _forceIdx;
+    size_t _forcesRevision = 0;
 
     std::vector<ScalarData> _scalarDataList;
     std::vector<VectorData> _vectorDataList;
@@ -111,6 +111,9 @@ class ParticleSystemSolver2 : public PhysicsAnimation {
     //!
     void setWind(const VectorField2Ptr& newWind);
 
+    //! Returns the number of particles as the problem size.
+    size_t problemSize() const override;
+
     //! Returns builder fox ParticleSystemSolver2.
     static Builder builder();
 
@@ -111,6 +111,9 @@ class ParticleSystemSolver3 : public PhysicsAnimation {
     //!
     void setWind(const VectorField3Ptr& newWind);
 
+    //! Returns the number of particles as the problem size.
+    size_t problemSize() const override;
+
     //! Returns builder fox ParticleSystemSolver3.
     static Builder builder();
 
@@ -142,6 +145,17 @@ class ParticleSystemSolver3 : public PhysicsAnimation {
     //! Assign a new particle system data.
     void setParticleSystemData(const ParticleSystemData3Ptr& newParticles);
 
+    //!
+    //! \brief Returns the maximum magnitude of the particle forces.
+    //!
+    //! The value is recorded while integrating the last time-step, so no extra
+    //! pass over the particles is needed between the sub-steps. If the forces
+    //! may have changed since then, which is tracked by
+    //! ParticleSystemData3::forcesRevision, the value is computed from the
+    //! current forces.
+    //!
+    double maxForceMagnitude() const;
+
  private:
     double _dragCoefficient = 1e-4;
     double _restitutionCoefficient = 0.0;
@@ -153,6 +167,8 @@ class ParticleSystemSolver3 : public PhysicsAnimation {
     Collider3Ptr _collider;
     ParticleEmitter3Ptr _emitter;
     VectorField3Ptr _wind;
+    double _maxForceMagnitude = 0.0;
+    size_t _maxForceMagnitudeRevision = kMaxSize;
 
     void beginAdvanceTimeStep(double timeStepInSeconds);
 
@@ -8,6 +8,7 @@
 #define INCLUDE_JET_PDE_H_
 
 #include <array>
+#include <cstddef>
 
 namespace jet {
 
@@ -103,6 +104,44 @@ std::array<T, 2> weno5(T* v, T h, T eps = 1.0e-8);
 template <typename T>
 T weno5(T* v, T h, bool is_velocity_positive, T eps = 1.0e-8);
 
+//!
+//! \brief Row-oriented 1-st order upwind differencing.
+//!
+//! Computes upwind1 for \p n consecutive points at once. D0[m] points to the
+//! \p n values at offset m - 1 from the points along the differencing
+//! direction, so D0[1] is the row of the origins. The minus- and plus-side
+//! solutions are written to \p dfxm and \p dfxp. The loop has no branches
+//! so that it can be vectorized, and the results are identical to upwind1.
+//!
+template <typename T>
+void upwind1Row(const T* const* D0, size_t n, T dx, T* dfxm, T* dfxp);
+
+//!
+//! \brief Row-oriented 3rd-order ENO.
+//!
+//! Computes eno3 for \p n consecutive points at once. D0[m] points to the
+//! \p n values at offset m - 3 from the points along the differencing
+//! direction, so D0[3] is the row of the origins. The minus- and plus-side
+//! solutions are written to \p dfxm and \p dfxp. The points are processed
+//! in ScalarPacket chunks with the stencil selection done by lane blending
+//! instead of branches, and the results are identical to eno3.
+//!
+template <typename T>
+void eno3Row(const T* const* D0, size_t n, T dx, T* dfxm, T* dfxp);
+
+//!
+//! \brief Row-oriented 5th-order Weno.
+//!
+//! Computes weno5 for \p n consecutive points at once. v[m] points to the
+//! \p n values at offset m - 3 from the points along the differencing
+//! direction, so v[3] is the row of the origins. The minus- and plus-side
+//! solutions are written to \p dfxm and \p dfxp, and the results are
+//! identical to weno5.
+//!
+template <typename T>
+void weno5Row(const T* const* v, size_t n, T h, T* dfxm, T* dfxp,
+              T eps = 1.0e-8);
+
 }  // namespace jet
 
 #include "detail/pde-inl.h"
@@ -8,6 +8,7 @@
 #define INCLUDE_JET_PHYSICS_ANIMATION_H_
 
 #include <jet/animation.h>
+#include <jet/step_arena.h>
 
 namespace jet {
 
@@ -76,6 +77,15 @@ class PhysicsAnimation : public Animation {
     //! Advances a single frame.
     void advanceSingleFrame();
 
+    //!
+    //! \brief      Initializes the animation if it has not been initialized.
+    //!
+    //! The animation is initialized with the first update anyway, so this
+    //! function only needs to be called to inspect the initial state, such as
+    //! problemSize(), before advancing the first frame.
+    //!
+    void initialize();
+
     //!
     //! \brief      Returns current frame.
     //!
@@ -94,6 +104,15 @@ class PhysicsAnimation : public Animation {
     //!
     double currentTimeInSeconds() const;
 
+    //!
+    //! \brief      Returns the size of the problem.
+    //!
+    //! The size is a rough measure of the work per time-step, such as the
+    //! number of particles or grid cells, and helps to decide how to run
+    //! multiple animations concurrently. Returns zero if unknown.
+    //!
+    virtual size_t problemSize() const;
+
  protected:
     //!
     //! \brief      Called when a single time-step should be advanced.
@@ -132,17 +151,25 @@ class PhysicsAnimation : public Animation {
     //!
     virtual void onInitialize();
 
+    //!
+    //! \brief      Returns the arena for the temporaries of a time-step.
+    //!
+    //! The arena is reset right after each onAdvanceTimeStep call, so the
+    //! arrays allocated in the arena should not be kept across time-steps.
+    //!
+    StepArena* stepArena();
+
  private:
     Frame _currentFrame;
     bool _isUsingFixedSubTimeSteps = true;
     unsigned int _numberOfFixedSubTimeSteps = 1;
     double _currentTime = 0.0;
+    bool _isInitialized = false;
+    StepArena _stepArena;
 
     void onUpdate(const Frame& frame) final;
 
     void advanceTimeStep(double timeIntervalInSeconds);
-
-    void initialize();
 };
 
 typedef std::shared_ptr<PhysicsAnimation> PhysicsAnimationPtr;
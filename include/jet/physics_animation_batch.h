@@ -0,0 +1,95 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_PHYSICS_ANIMATION_BATCH_H_
+#define INCLUDE_JET_PHYSICS_ANIMATION_BATCH_H_
+
+#include <jet/physics_animation.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief      Runner which advances many physics animations concurrently.
+//!
+//! This class is designed for running many independent simulations, such as
+//! parameter sweeps of small scenes, where a single simulation cannot keep
+//! all the cores busy. The animations are split into two groups based on
+//! PhysicsAnimation::problemSize. The large animations are advanced one by
+//! one so each can use all the threads (intra-simulation parallelism). The
+//! small animations are distributed over the threads, and each of them runs
+//! on a single thread (inter-simulation parallelism).
+//!
+class PhysicsAnimationBatch {
+ public:
+    //!
+    //! \brief      Callback function type for frame updates.
+    //!
+    //! The callback is invoked with the animation and the frame which was just
+    //! advanced. Callbacks of different animations can be invoked concurrently
+    //! from different threads.
+    //!
+    typedef std::function<void(const PhysicsAnimationPtr&, const Frame&)>
+        OnFrameAdvancedCallback;
+
+    //! Constructs an empty batch.
+    PhysicsAnimationBatch();
+
+    //!
+    //! \brief      Adds an animation to the batch and returns its index.
+    //!
+    //! \param[in]  animation       The animation to add.
+    //! \param[in]  onFrameAdvanced Optional callback for the output.
+    //!
+    size_t addAnimation(
+        const PhysicsAnimationPtr& animation,
+        const OnFrameAdvancedCallback& onFrameAdvanced = nullptr);
+
+    //! Returns the number of animations.
+    size_t numberOfAnimations() const;
+
+    //! Returns the animation at given index.
+    const PhysicsAnimationPtr& animationAt(size_t i) const;
+
+    //!
+    //! \brief      Returns the problem size threshold for running alone.
+    //!
+    //! Animations with the problem size greater than or equal to this
+    //! threshold are advanced one by one using all the threads.
+    //!
+    size_t intraParallelismThreshold() const;
+
+    //! Sets the problem size threshold for running alone.
+    void setIntraParallelismThreshold(size_t threshold);
+
+    //!
+    //! \brief      Advances all the animations by given number of frames.
+    //!
+    //! The animations are initialized first, and the problem sizes are
+    //! evaluated again before each frame, so an animation can move between
+    //! the groups as its problem size changes.
+    //!
+    //! \param[in]  numberOfFrames The number of frames to advance.
+    //!
+    void advance(unsigned int numberOfFrames);
+
+ private:
+    std::vector<PhysicsAnimationPtr> _animations;
+    std::vector<OnFrameAdvancedCallback> _callbacks;
+    size_t _intraParallelismThreshold = 32768;
+
+    void advanceAnimation(size_t i);
+};
+
+//! Shared pointer type for the PhysicsAnimationBatch.
+typedef std::shared_ptr<PhysicsAnimationBatch> PhysicsAnimationBatchPtr;
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_PHYSICS_ANIMATION_BATCH_H_
@@ -51,6 +51,9 @@ class PicSolver2 : public GridFluidSolver2 {
     //! Sets the particle emitter.
     void setParticleEmitter(const ParticleEmitter2Ptr& newEmitter);
 
+    //! Returns the number of grid cells and particles as the problem size.
+    size_t problemSize() const override;
+
     //! Returns builder fox PicSolver2.
     static Builder builder();
 
@@ -10,6 +10,7 @@
 #include <jet/grid_fluid_solver3.h>
 #include <jet/particle_emitter3.h>
 #include <jet/particle_system_data3.h>
+#include <jet/transfer_kernels.h>
 
 namespace jet {
 
@@ -51,6 +52,76 @@ class PicSolver3 : public GridFluidSolver3 {
     //! Sets the particle emitter.
     void setParticleEmitter(const ParticleEmitter3Ptr& newEmitter);
 
+    //! Returns the particle reseeding interval in number of time-steps.
+    unsigned int particleReseedingInterval() const;
+
+    //!
+    //! \brief Sets the particle reseeding interval in number of time-steps.
+    //!
+    //! This function sets how often the particles are resampled so that the
+    //! number of particles per cell stays within the range of
+    //! PicSolver3::minParticlesPerCell and PicSolver3::maxParticlesPerCell.
+    //! Over-populated cells lose their excess particles, while
+    //! under-populated interior cells get new particles with the grid
+    //! velocity. Setting zero disables reseeding, which is the default.
+    //!
+    //! \param[in] interval The reseeding interval in number of time-steps.
+    //!
+    void setParticleReseedingInterval(unsigned int interval);
+
+    //! Returns the minimum number of particles per cell for reseeding.
+    unsigned int minParticlesPerCell() const;
+
+    //! Sets the minimum number of particles per cell for reseeding.
+    void setMinParticlesPerCell(unsigned int newMin);
+
+    //! Returns the maximum number of particles per cell for reseeding.
+    unsigned int maxParticlesPerCell() const;
+
+    //!
+    //! \brief Sets the maximum number of particles per cell for reseeding.
+    //!
+    //! The value will be clamped to be at least 1. If the maximum is smaller
+    //! than the minimum, the minimum is used as the maximum.
+    //!
+    void setMaxParticlesPerCell(unsigned int newMax);
+
+    //! Returns the particle sorting interval in number of time-steps.
+    unsigned int particleSortingInterval() const;
+
+    //!
+    //! \brief Sets the particle sorting interval in number of time-steps.
+    //!
+    //! The particles are reordered in memory by the grid cell they belong to,
+    //! so that the particle-to-grid and grid-to-particle transfers visit the
+    //! grid coherently. Since the particles move less than a cell per
+    //! time-step, the order stays mostly coherent between the sorts. Note
+    //! that sorting changes the particle indices, so it should stay disabled
+    //! if the particles are tracked by index, or if a custom particle data
+    //! layer depends on the order. Setting zero disables sorting. The default
+    //! interval is 0.
+    //!
+    //! \param[in] interval The sorting interval in number of time-steps.
+    //!
+    void setParticleSortingInterval(unsigned int interval);
+
+    //! Returns the kernel type for the particle-grid transfers.
+    TransferKernelType transferKernelType() const;
+
+    //!
+    //! \brief Sets the kernel type for the particle-grid transfers.
+    //!
+    //! The linear kernel is the default. The quadratic and cubic B-spline
+    //! kernels cover wider ranges, which makes the transfers smoother with
+    //! fewer particles per cell at the cost of more samples per particle.
+    //!
+    //! \param[in] type The transfer kernel type.
+    //!
+    void setTransferKernelType(TransferKernelType type);
+
+    //! Returns the number of grid cells and particles as the problem size.
+    size_t problemSize() const override;
+
     //! Returns builder fox PicSolver3.
     static Builder builder();
 
@@ -80,10 +151,56 @@ class PicSolver3 : public GridFluidSolver3 {
     //! Moves particles.
     virtual void moveParticles(double timeIntervalInSeconds);
 
+    //!
+    //! \brief Resamples the particles to keep the number of particles per cell
+    //!     within the allowed range.
+    //!
+    //! Only the cells whose neighbors are all occupied receive new particles,
+    //! so the liquid surface is not inflated.
+    //!
+    virtual void reseedParticles();
+
+    //!
+    //! \brief Sorts the particles by the grid cell they belong to.
+    //!
+    //! \param[out] cellIndices   Linear cell index of each particle.
+    //! \param[out] sortedIndices Particle indices sorted by the cell index.
+    //!
+    void sortParticlesByCell(Array1<size_t>* cellIndices,
+                             Array1<size_t>* sortedIndices) const;
+
+    //! Reorders the particle data by the grid cell each particle belongs to.
+    void reorderParticlesByCell();
+
+    //!
+    //! \brief Transfers the particle velocities with affine terms to the grids.
+    //!
+    //! Each particle contributes its velocity plus the dot product between the
+    //! affine vector of the component and the offset from the particle to the
+    //! face center, as in APIC. Passing empty arrays gives the plain PIC
+    //! transfer. The particles are splatted in parallel, and the face markers
+    //! are updated as well.
+    //!
+    //! \param[in] cX Affine vectors for the u-component.
+    //! \param[in] cY Affine vectors for the v-component.
+    //! \param[in] cZ Affine vectors for the w-component.
+    //!
+    void splatParticleVelocities(const ConstArrayAccessor1<Vector3D>& cX,
+                                 const ConstArrayAccessor1<Vector3D>& cY,
+                                 const ConstArrayAccessor1<Vector3D>& cZ);
+
  private:
     size_t _signedDistanceFieldId;
     ParticleSystemData3Ptr _particles;
     ParticleEmitter3Ptr _particleEmitter;
+    unsigned int _particleReseedingInterval = 0;
+    unsigned int _minParticlesPerCell = 4;
+    unsigned int _maxParticlesPerCell = 16;
+    unsigned int _numberOfStepsSinceReseeding = 0;
+    unsigned int _numberOfReseedings = 0;
+    unsigned int _particleSortingInterval = 0;
+    unsigned int _numberOfStepsSinceSorting = 0;
+    TransferKernelType _transferKernelType = TransferKernelType::kLinear;
 
     void extrapolateVelocityToAir();
 
@@ -0,0 +1,93 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_STEP_ARENA_H_
+#define INCLUDE_JET_STEP_ARENA_H_
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief Bump allocator for the temporaries of a single time-step.
+//!
+//! Allocation only advances an offset in the current memory block and
+//! deallocation is a no-op. All the memory is released at once by calling
+//! reset(), which keeps the blocks for the next time-step. After a few steps,
+//! the arena settles to a single block which is large enough for the
+//! temporaries of a whole step, so the steady-state stepping does not call
+//! malloc/free nor touch fresh pages for the temporaries.
+//!
+//! PhysicsAnimation owns an arena and resets it after each sub-step. Arrays
+//! are constructed in the arena by passing it to their constructors, such as
+//!
+//! \code{.cpp}
+//! Array1<double> temp(numberOfParticles, 0.0, stepArena());
+//! \endcode
+//!
+//! Such arrays should not outlive the time-step, nor be swapped with the
+//! arrays that persist across the time-steps. Since the temporaries are not a
+//! part of the simulation state, copying an arena gives an empty arena.
+//!
+class StepArena final {
+ public:
+    //! Constructs an empty arena.
+    StepArena();
+
+    //! Constructs an empty arena; the allocations are not copied.
+    StepArena(const StepArena& other);
+
+    //! Destructs the arena and releases the memory blocks.
+    ~StepArena();
+
+    //!
+    //! \brief Allocates \p bytes of memory aligned to \p alignment.
+    //!
+    //! This function is thread-safe.
+    //!
+    //! \param bytes        Number of bytes to allocate.
+    //! \param alignment    Alignment which should be a power of two.
+    //! \return Pointer to the allocated memory.
+    //!
+    void* allocate(size_t bytes, size_t alignment);
+
+    //! Releases all the allocations while keeping the memory for reuse.
+    void reset();
+
+    //! Returns the number of bytes allocated since the last reset.
+    size_t bytesUsed() const;
+
+    //! Returns the total size of the memory blocks in bytes.
+    size_t capacity() const;
+
+    //! Returns the number of memory blocks.
+    size_t numberOfBlocks() const;
+
+    //! Keeps this arena as is; the allocations are not copied.
+    StepArena& operator=(const StepArena& other);
+
+ private:
+    struct Block {
+        char* data;
+        size_t size;
+    };
+
+    mutable std::mutex _mutex;
+    std::vector<Block> _blocks;
+    size_t _currentBlock = 0;
+    size_t _offset = 0;
+    size_t _bytesUsed = 0;
+
+    void addBlock(size_t minSize);
+
+    void releaseBlocks();
+};
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_STEP_ARENA_H_
@@ -0,0 +1,66 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_TASK_GRAPH_H_
+#define INCLUDE_JET_TASK_GRAPH_H_
+
+#include <jet/parallel.h>
+
+#include <functional>
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief Lightweight executor for tasks with dependencies.
+//!
+//! Each task can depend only on the tasks added before it, so the graph is
+//! always acyclic. When executed, the tasks are grouped into levels where all
+//! the dependencies of a task belong to the earlier levels. The tasks in the
+//! same level run concurrently on top of the tasking backend, and each level
+//! waits for the previous one to finish. The threads are split among the
+//! concurrent tasks, so the parallel loops inside the tasks use all the
+//! threads together without oversubscribing them. A level with a single task
+//! runs the task directly so its parallel loops can use all the threads. With
+//! OpenMP, where the nested loops run serially, the tasks of a level run one
+//! after another unless there are at least as many tasks as threads.
+//!
+class TaskGraph {
+ public:
+    //! Task function type.
+    typedef std::function<void()> Task;
+
+    //! Constructs an empty graph.
+    TaskGraph();
+
+    //!
+    //! \brief Adds a task and returns its id.
+    //!
+    //! \param[in]  task            The task function.
+    //! \param[in]  dependencies    Ids of the tasks which should finish before
+    //!                             this task starts.
+    //!
+    size_t addTask(const Task& task,
+                   const std::vector<size_t>& dependencies =
+                       std::vector<size_t>());
+
+    //! Returns the number of tasks.
+    size_t numberOfTasks() const;
+
+    //! Executes all the tasks while respecting the dependencies.
+    void execute(ExecutionPolicy policy = ExecutionPolicy::kParallel) const;
+
+    //! Removes all the tasks.
+    void clear();
+
+ private:
+    std::vector<Task> _tasks;
+    std::vector<size_t> _levels;
+};
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_TASK_GRAPH_H_
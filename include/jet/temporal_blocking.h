@@ -0,0 +1,62 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_TEMPORAL_BLOCKING_H_
+#define INCLUDE_JET_TEMPORAL_BLOCKING_H_
+
+#include <cstddef>
+
+namespace jet {
+
+//! Default max number of steps fused into a single temporally blocked sweep.
+constexpr unsigned int kDefaultTemporalBlockDepth = 4;
+
+//!
+//! \brief Runs multiple steps of a plane-wise stencil with temporal blocking.
+//!
+//! An explicit stencil sweep such as a Jacobi iteration reads and writes the
+//! whole grid for each step, so running many steps is bound by the memory
+//! bandwidth. This function instead sweeps the planes along the slowest axis
+//! as a wavefront: when step s updates plane p, step s + 1 updates plane
+//! p - 1 right after it. This way up to \p blockDepth steps are applied to a
+//! plane while it (and its neighbors) stay in the cache, and the grid is
+//! streamed from the memory only once per \p blockDepth steps.
+//!
+//! The callback function takes the step and the plane index, and it is
+//! responsible for updating the plane serially. The result is identical to
+//! the sequential sweeps as long as updating a plane at step s reads only the
+//! adjacent planes at step s - 1. This holds for both ping-pong buffers (with
+//! the buffer alternating by the parity of the step) and in-place red-black
+//! updates (with the color alternating by the parity of the step).
+//!
+//! With more than one thread, the planes are split into contiguous chunks,
+//! one per thread, and each group of steps runs in two parallel phases. In
+//! the first phase, each chunk runs its own wavefront while shrinking by one
+//! plane per step on the sides facing the other chunks. In the second phase,
+//! the triangles of planes skipped around each chunk boundary are filled in.
+//! This takes two rounds of thread launches per \p blockDepth steps, and the
+//! callback can be invoked concurrently for the planes of different chunks.
+//! A chunk has at least 2 * \p blockDepth planes, so fewer chunks are used
+//! when the planes are too few.
+//!
+//! \param[in]  numberOfPlanes  Number of planes along the sweep axis.
+//! \param[in]  numberOfSteps   Number of steps to apply.
+//! \param[in]  blockDepth      Max number of steps fused into one sweep.
+//! \param[in]  func            The plane update function which takes the
+//!                             step and the plane index.
+//!
+//! \tparam     PlaneFunction   The plane update function type.
+//!
+template <typename PlaneFunction>
+void temporallyBlockedSweep(size_t numberOfPlanes, unsigned int numberOfSteps,
+                            unsigned int blockDepth,
+                            const PlaneFunction& func);
+
+}  // namespace jet
+
+#include "detail/temporal_blocking-inl.h"
+
+#endif  // INCLUDE_JET_TEMPORAL_BLOCKING_H_
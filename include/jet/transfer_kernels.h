@@ -0,0 +1,121 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_TRANSFER_KERNELS_H_
+#define INCLUDE_JET_TRANSFER_KERNELS_H_
+
+#include <jet/macros.h>
+
+#include <array>
+#include <cstddef>
+
+namespace jet {
+
+//! Kernel types for the particle-grid transfers.
+enum class TransferKernelType {
+    //! Linear (tent) kernel which covers 2 samples per axis.
+    kLinear,
+
+    //! Quadratic B-spline kernel which covers 3 samples per axis.
+    kQuadraticBSpline,
+
+    //! Cubic B-spline kernel which covers 4 samples per axis.
+    kCubicBSpline
+};
+
+//!
+//! \brief Linear (tent) particle-grid transfer kernel.
+//!
+//! With this kernel, the transfer is identical to the trilinear sampling of
+//! LinearArraySampler3.
+//!
+struct LinearTransferKernel {
+    //! Number of samples per axis covered by the kernel.
+    static const size_t kWidth = 2;
+
+    //!
+    //! \brief Computes the sample indices and weights along an axis.
+    //!
+    //! \param[in]  x           Coordinate in units of grid spacing, which
+    //!                         should be within [0, size - 1].
+    //! \param[in]  size        Number of samples along the axis.
+    //! \param[out] indices     Sample indices, clamped to the valid range.
+    //! \param[out] weights     Weights of the samples.
+    //! \param[out] derivatives Derivatives of the weights with respect to x.
+    //!
+    static void getWeights(double x, size_t size, size_t* indices,
+                           double* weights, double* derivatives);
+};
+
+//!
+//! \brief Quadratic B-spline particle-grid transfer kernel.
+//!
+//! The kernel is C1 continuous, which reduces the noise of the transfer
+//! compared to the linear kernel, especially for APIC.
+//!
+//! \see Jiang, Chenfanfu, et al. "The affine particle-in-cell method."
+//!      ACM Transactions on Graphics (TOG) 34.4 (2015): 51.
+//!
+struct QuadraticBSplineTransferKernel {
+    //! Number of samples per axis covered by the kernel.
+    static const size_t kWidth = 3;
+
+    //! Computes the sample indices and weights along an axis.
+    static void getWeights(double x, size_t size, size_t* indices,
+                           double* weights, double* derivatives);
+};
+
+//!
+//! \brief Cubic B-spline particle-grid transfer kernel.
+//!
+//! The kernel is C2 continuous and covers the widest range among the transfer
+//! kernels.
+//!
+struct CubicBSplineTransferKernel {
+    //! Number of samples per axis covered by the kernel.
+    static const size_t kWidth = 4;
+
+    //! Computes the sample indices and weights along an axis.
+    static void getWeights(double x, size_t size, size_t* indices,
+                           double* weights, double* derivatives);
+};
+
+//!
+//! \brief Transfer weights of a point along a single grid axis.
+//!
+//! \tparam Kernel The transfer kernel type.
+//!
+template <typename Kernel>
+struct AxisStencil {
+    //! Coordinate clamped to the valid sample range in units of grid spacing.
+    double coordinate;
+
+    //! Sample indices.
+    std::array<size_t, Kernel::kWidth> indices;
+
+    //! Weights of the samples.
+    std::array<double, Kernel::kWidth> weights;
+
+    //! Derivatives of the weights with respect to the coordinate.
+    std::array<double, Kernel::kWidth> derivatives;
+
+    //! Constructs an empty stencil.
+    AxisStencil();
+
+    //!
+    //! Constructs a stencil for the given coordinate.
+    //!
+    //! \param[in]  x       Coordinate in units of grid spacing.
+    //! \param[in]  size    Number of samples along the axis.
+    //!
+    AxisStencil(double x, size_t size);
+};
+
+}  // namespace jet
+
+#include "detail/transfer_kernels-inl.h"
+
+#endif  // INCLUDE_JET_TRANSFER_KERNELS_H_
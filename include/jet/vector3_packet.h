@@ -0,0 +1,337 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_VECTOR3_PACKET_H_
+#define INCLUDE_JET_VECTOR3_PACKET_H_
+
+#include <jet/array_accessor1.h>
+#include <jet/matrix3x3.h>
+#include <jet/vector3.h>
+
+#include <cstddef>
+
+// Packets are stored in the GCC/Clang vector extension types when available so
+// that a packet maps to SIMD registers even without the ISA specific flags.
+#if defined(__GNUC__) || defined(__clang__)
+#define JET_PACKET_VECTOR_EXTENSIONS
+#endif
+
+// Passing a 32-byte vector by value changes with -mavx, which is irrelevant for
+// the inlined packet functions.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+namespace jet {
+
+//!
+//! \brief Packet of N scalars which are processed in lock-step.
+//!
+//! Each operation applies to all the lanes at once. With GCC and Clang, the
+//! lanes are stored in a vector extension type which the compiler lowers to the
+//! SIMD instructions of the target, such as 4 doubles or 8 floats for AVX, or
+//! pairs of SSE2 registers without the ISA flags. Other compilers fall back to
+//! fixed-length loops over aligned storage.
+//!
+//! \tparam T - Type of the lane.
+//! \tparam N - Number of lanes which should be a power of two.
+//!
+template <typename T, size_t N>
+class ScalarPacket final {
+ public:
+    static_assert(std::is_floating_point<T>::value,
+                  "ScalarPacket only can be instantiated with floating point "
+                  "types");
+    static_assert(N > 0 && (N & (N - 1)) == 0,
+                  "Number of lanes should be a power of two.");
+
+    //! Number of lanes.
+    static constexpr size_t kNumberOfLanes = N;
+
+#ifdef JET_PACKET_VECTOR_EXTENSIONS
+    //! Native storage type of the lanes.
+    typedef T Lanes __attribute__((vector_size(sizeof(T) * N)));
+#else
+    //! Native storage type of the lanes.
+    typedef T Lanes[N];
+#endif
+
+    //! Lanes of the packet.
+    alignas(sizeof(T) * N) Lanes lanes;
+
+    //! Constructs a packet with zero lanes.
+    ScalarPacket();
+
+    //! Constructs a packet with all the lanes set to \p s.
+    explicit ScalarPacket(T s);
+
+    //! Returns the reference to the i-th lane.
+    T& operator[](size_t i);
+
+    //! Returns the const reference to the i-th lane.
+    const T& operator[](size_t i) const;
+
+    //! Loads N scalars from the raw array which needs not to be aligned.
+    static ScalarPacket load(const T* data);
+
+    //! Stores the lanes to the raw array which needs not to be aligned.
+    void store(T* data) const;
+
+    //! Returns the sum of the first \p count lanes.
+    T sum(size_t count = N) const;
+
+    //! Returns the maximum of the first \p count lanes.
+    T max(size_t count = N) const;
+
+    //! Computes this += v.
+    ScalarPacket& operator+=(const ScalarPacket& v);
+
+    //! Computes this -= v.
+    ScalarPacket& operator-=(const ScalarPacket& v);
+
+    //! Computes this *= v.
+    ScalarPacket& operator*=(const ScalarPacket& v);
+
+    //! Computes this /= v.
+    ScalarPacket& operator/=(const ScalarPacket& v);
+};
+
+//!
+//! \brief Packet of N 3-D vectors in the structure-of-arrays layout.
+//!
+//! Vector3D is stored as an array of structures, so a loop over the particles
+//! with per-element Vector3D arithmetic rarely vectorizes. This class holds N
+//! vectors with the x, y, and z components in separate packets so that a
+//! particle kernel can be written in a batched form. The vectors are loaded
+//! from and stored to arrays of Vector3 using load() and store().
+//!
+//! \code{.cpp}
+//! for (size_t i = 0; i < n; i += Vector3x4D::kNumberOfLanes) {
+//!     auto x = Vector3x4D::load(positions, i);
+//!     auto v = Vector3x4D::load(velocities, i);
+//!     (x + dt * v).store(positions, i);
+//! }
+//! \endcode
+//!
+//! \tparam T - Type of the element.
+//! \tparam N - Number of lanes which should be a power of two.
+//!
+template <typename T, size_t N>
+class Vector3Packet final {
+ public:
+    //! Packet type of each component.
+    typedef ScalarPacket<T, N> Scalar;
+
+    //! Number of lanes.
+    static constexpr size_t kNumberOfLanes = N;
+
+    //! X components.
+    Scalar x;
+
+    //! Y components.
+    Scalar y;
+
+    //! Z components.
+    Scalar z;
+
+    //! Constructs a packet of zero vectors.
+    Vector3Packet();
+
+    //! Constructs a packet with all the lanes set to \p v.
+    explicit Vector3Packet(const Vector3<T>& v);
+
+    //! Constructs a packet from the component packets.
+    Vector3Packet(const Scalar& x, const Scalar& y, const Scalar& z);
+
+    //!
+    //! \brief Loads the vectors from the array starting at \p begin.
+    //!
+    //! If less than N vectors are left in the array, the rest of the lanes are
+    //! set to zero.
+    //!
+    static Vector3Packet load(const ConstArrayAccessor1<Vector3<T>>& array,
+                              size_t begin);
+
+    //! Loads \p count vectors from the raw array, zeroing the rest of lanes.
+    static Vector3Packet load(const Vector3<T>* data, size_t count = N);
+
+    //!
+    //! \brief Stores the vectors to the array starting at \p begin.
+    //!
+    //! If less than N vectors are left in the array, only the leading lanes
+    //! are stored.
+    //!
+    void store(ArrayAccessor1<Vector3<T>> array, size_t begin) const;
+
+    //! Stores the first \p count vectors to the raw array.
+    void store(Vector3<T>* data, size_t count = N) const;
+
+    //! Returns the vector of the i-th lane.
+    Vector3<T> lane(size_t i) const;
+
+    //! Sets the vector of the i-th lane.
+    void setLane(size_t i, const Vector3<T>& v);
+
+    //! Computes the dot products.
+    Scalar dot(const Vector3Packet& v) const;
+
+    //! Computes the cross products.
+    Vector3Packet cross(const Vector3Packet& v) const;
+
+    //! Returns the lengths of the vectors.
+    Scalar length() const;
+
+    //! Returns the squared lengths of the vectors.
+    Scalar lengthSquared() const;
+
+    //! Computes this += v.
+    Vector3Packet& operator+=(const Vector3Packet& v);
+
+    //! Computes this -= v.
+    Vector3Packet& operator-=(const Vector3Packet& v);
+
+    //! Computes this *= s per lane.
+    Vector3Packet& operator*=(const Scalar& s);
+};
+
+// MARK: Scalar packet operators
+
+//! Returns a + b per lane.
+template <typename T, size_t N>
+ScalarPacket<T, N> operator+(const ScalarPacket<T, N>& a,
+                             const ScalarPacket<T, N>& b);
+
+//! Returns a - b per lane.
+template <typename T, size_t N>
+ScalarPacket<T, N> operator-(const ScalarPacket<T, N>& a,
+                             const ScalarPacket<T, N>& b);
+
+//! Returns a * b per lane.
+template <typename T, size_t N>
+ScalarPacket<T, N> operator*(const ScalarPacket<T, N>& a,
+                             const ScalarPacket<T, N>& b);
+
+//! Returns a / b per lane.
+template <typename T, size_t N>
+ScalarPacket<T, N> operator/(const ScalarPacket<T, N>& a,
+                             const ScalarPacket<T, N>& b);
+
+//! Returns a * b per lane.
+template <typename T, size_t N>
+ScalarPacket<T, N> operator*(T a, const ScalarPacket<T, N>& b);
+
+//! Returns the lane-wise square root.
+template <typename T, size_t N>
+ScalarPacket<T, N> sqrt(const ScalarPacket<T, N>& a);
+
+//! Returns the lane-wise minimum.
+template <typename T, size_t N>
+ScalarPacket<T, N> min(const ScalarPacket<T, N>& a,
+                       const ScalarPacket<T, N>& b);
+
+//! Returns the lane-wise maximum.
+template <typename T, size_t N>
+ScalarPacket<T, N> max(const ScalarPacket<T, N>& a,
+                       const ScalarPacket<T, N>& b);
+
+//! Returns the lane-wise absolute value.
+template <typename T, size_t N>
+ScalarPacket<T, N> abs(const ScalarPacket<T, N>& a);
+
+//!
+//! \brief Returns \p x for the lanes where a < b and \p y for the rest.
+//!
+//! The lanes are blended with the comparison mask, so a kernel can pick
+//! between the candidates without branches.
+//!
+template <typename T, size_t N>
+ScalarPacket<T, N> selectLess(const ScalarPacket<T, N>& a,
+                              const ScalarPacket<T, N>& b,
+                              const ScalarPacket<T, N>& x,
+                              const ScalarPacket<T, N>& y);
+
+// MARK: Vector packet operators
+
+//! Returns the negated vectors.
+template <typename T, size_t N>
+Vector3Packet<T, N> operator-(const Vector3Packet<T, N>& a);
+
+//! Returns a + b per lane.
+template <typename T, size_t N>
+Vector3Packet<T, N> operator+(const Vector3Packet<T, N>& a,
+                              const Vector3Packet<T, N>& b);
+
+//! Returns a - b per lane.
+template <typename T, size_t N>
+Vector3Packet<T, N> operator-(const Vector3Packet<T, N>& a,
+                              const Vector3Packet<T, N>& b);
+
+//! Returns a * b per lane.
+template <typename T, size_t N>
+Vector3Packet<T, N> operator*(const Vector3Packet<T, N>& a,
+                              const ScalarPacket<T, N>& b);
+
+//! Returns a * b per lane.
+template <typename T, size_t N>
+Vector3Packet<T, N> operator*(const ScalarPacket<T, N>& a,
+                              const Vector3Packet<T, N>& b);
+
+//! Returns a * b for all the lanes.
+template <typename T, size_t N>
+Vector3Packet<T, N> operator*(T a, const Vector3Packet<T, N>& b);
+
+//! Returns a * b for all the lanes.
+template <typename T, size_t N>
+Vector3Packet<T, N> operator*(const Vector3Packet<T, N>& a, T b);
+
+//! Returns a / b per lane.
+template <typename T, size_t N>
+Vector3Packet<T, N> operator/(const Vector3Packet<T, N>& a,
+                              const ScalarPacket<T, N>& b);
+
+//! Returns a / b for all the lanes.
+template <typename T, size_t N>
+Vector3Packet<T, N> operator/(const Vector3Packet<T, N>& a, T b);
+
+//! Returns m * v for all the lanes.
+template <typename T, size_t N>
+Vector3Packet<T, N> operator*(const Matrix3x3<T>& m,
+                              const Vector3Packet<T, N>& v);
+
+#if defined(__AVX__)
+//! Size of the native SIMD registers in bytes.
+constexpr size_t kNativePacketBytes = 32;
+#else
+//! Size of the native SIMD registers in bytes.
+constexpr size_t kNativePacketBytes = 16;
+#endif
+
+//! Packet which fits in a native SIMD register of the target.
+template <typename T>
+using NativeScalarPacket = ScalarPacket<T, kNativePacketBytes / sizeof(T)>;
+
+//! Packet of 4 doubles.
+typedef ScalarPacket<double, 4> ScalarPacket4D;
+
+//! Packet of 8 floats.
+typedef ScalarPacket<float, 8> ScalarPacket8F;
+
+//! Packet of 4 double-type 3-D vectors.
+typedef Vector3Packet<double, 4> Vector3x4D;
+
+//! Packet of 8 float-type 3-D vectors.
+typedef Vector3Packet<float, 8> Vector3x8F;
+
+}  // namespace jet
+
+#include "detail/vector3_packet-inl.h"
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif  // INCLUDE_JET_VECTOR3_PACKET_H_
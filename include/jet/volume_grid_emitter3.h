@@ -19,6 +19,12 @@ namespace jet {
 //!
 //! \brief 3-D grid-based volumetric emitter.
 //!
+//! When the source region is bounded, the emitter only queries the
+//! signed-distance field near the bounding box of the region, so the cost of
+//! an emission is proportional to the footprint of the source rather than to
+//! the size of the target grids. Unbounded sources such as planes or surfaces
+//! with flipped normals are evaluated over the whole grid.
+//!
 class VolumeGridEmitter3 final : public GridEmitter3 {
  public:
     class Builder;
@@ -39,12 +45,24 @@ class VolumeGridEmitter3 final : public GridEmitter3 {
     //! Destructor.
     virtual ~VolumeGridEmitter3();
 
-    //! Adds signed-distance target to the scalar grid.
+    //!
+    //! \brief      Adds signed-distance target to the scalar grid.
+    //!
+    //! The target is updated with min(old, sdf). Outside of the bounding box
+    //! of the source, the signed-distance is only queried for the points whose
+    //! old value is larger than the distance to the box.
+    //!
+    //! \param[in]  scalarGridTarget The scalar grid target.
+    //!
     void addSignedDistanceTarget(const ScalarGrid3Ptr& scalarGridTarget);
 
     //!
     //! \brief      Adds step function target to the scalar grid.
     //!
+    //! The step is smeared over 1.5 grid spacing around the surface. Beyond
+    //! that band, the target is clamped to \p minValue from below without
+    //! querying the signed-distance.
+    //!
     //! \param[in]  scalarGridTarget The scalar grid target.
     //! \param[in]  minValue         The minimum value of the step function.
     //! \param[in]  maxValue         The maximum value of the step function.
@@ -65,6 +83,9 @@ class VolumeGridEmitter3 final : public GridEmitter3 {
     //! how to blend the old value from the target grid and the new value from
     //! the mapper function.
     //!
+    //! Since the mapper may depend on the signed-distance at any distance, the
+    //! custom scalar targets are evaluated over the whole grid.
+    //!
     //! \param[in]  scalarGridTarget The scalar grid target
     //! \param[in]  customMapper     The custom mapper.
     //!
@@ -83,6 +104,10 @@ class VolumeGridEmitter3 final : public GridEmitter3 {
     //! how to blend the old value from the target grid and the new value from
     //! the mapper function.
     //!
+    //! The mapper is only applied to the points inside the source region. For
+    //! face-centered grids, each face gets the corresponding component of the
+    //! mapped vector.
+    //!
     //! \param[in]  scalarGridTarget The vector grid target
     //! \param[in]  customMapper     The custom mapper.
     //!
@@ -100,7 +125,12 @@ class VolumeGridEmitter3 final : public GridEmitter3 {
     static Builder builder();
 
  private:
-    typedef std::tuple<ScalarGrid3Ptr, ScalarMapper> ScalarTarget;
+    enum class ScalarTargetType { kCustom, kSignedDistance, kStepFunction };
+
+    //! Target grid, mapper, type of the target, and width of the transition
+    //! band for the step function targets.
+    typedef std::tuple<ScalarGrid3Ptr, ScalarMapper, ScalarTargetType, double>
+        ScalarTarget;
     typedef std::tuple<VectorGrid3Ptr, VectorMapper> VectorTarget;
 
     ImplicitSurface3Ptr _sourceRegion;
@@ -0,0 +1,48 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_WENO_LEVEL_SET_SOLVER3_H_
+#define INCLUDE_JET_WENO_LEVEL_SET_SOLVER3_H_
+
+#include <jet/iterative_level_set_solver3.h>
+
+namespace jet {
+
+//!
+//! \brief Three-dimensional fifth-order WENO-based iterative level set solver.
+//!
+//! The reinitialization takes the 5th-order WENO derivatives with 3rd-order
+//! TVD Runge-Kutta time integration, which keeps the interface more accurate
+//! than EnoLevelSetSolver3 at the same grid resolution and allows a larger
+//! pseudo-time step.
+//!
+class WenoLevelSetSolver3 final : public IterativeLevelSetSolver3 {
+ public:
+    //! Default constructor.
+    WenoLevelSetSolver3();
+
+ protected:
+    //! Computes the derivatives for given grid point.
+    void getDerivatives(ConstArrayAccessor3<double> grid,
+                        const Vector3D& gridSpacing, size_t i, size_t j,
+                        size_t k, std::array<double, 2>* dx,
+                        std::array<double, 2>* dy,
+                        std::array<double, 2>* dz) const override;
+
+    //! Computes the derivatives for the points of given i-row.
+    void getRowDerivatives(ConstArrayAccessor3<double> grid,
+                           const Vector3D& gridSpacing, size_t iBegin,
+                           size_t iEnd, size_t j, size_t k,
+                           std::array<double*, 2> dx,
+                           std::array<double*, 2> dy,
+                           std::array<double*, 2> dz) const override;
+};
+
+typedef std::shared_ptr<WenoLevelSetSolver3> WenoLevelSetSolver3Ptr;
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_WENO_LEVEL_SET_SOLVER3_H_
@@ -0,0 +1,80 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <jet/aligned_allocator.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+
+#if defined(JET_WINDOWS)
+#include <malloc.h>
+#elif defined(JET_LINUX)
+#include <sys/mman.h>
+#endif
+
+static std::atomic<bool> sHugePagesEnabled(false);
+
+namespace jet {
+
+void* alignedMalloc(size_t bytes, size_t alignment) {
+    JET_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    alignment = std::max(alignment, sizeof(void*));
+
+    const bool useHugePages =
+        sHugePagesEnabled.load(std::memory_order_relaxed) &&
+        bytes >= kHugePageSize;
+    if (useHugePages) {
+        alignment = std::max(alignment, kHugePageSize);
+    }
+
+    // Pads the allocation to a multiple of the alignment
+    bytes = std::max(bytes, size_t(1));
+    bytes = (bytes + alignment - 1) & ~(alignment - 1);
+
+    void* ptr = nullptr;
+#if defined(JET_WINDOWS)
+    ptr = _aligned_malloc(bytes, alignment);
+#else
+    if (posix_memalign(&ptr, alignment, bytes) != 0) {
+        ptr = nullptr;
+    }
+#endif
+
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+
+#if defined(JET_LINUX) && defined(MADV_HUGEPAGE)
+    if (useHugePages) {
+        // Only a hint; failures are harmless.
+        madvise(ptr, bytes, MADV_HUGEPAGE);
+    }
+#endif
+
+    return ptr;
+}
+
+void alignedFree(void* ptr) {
+#if defined(JET_WINDOWS)
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+bool isHugePagesEnabled() {
+    return sHugePagesEnabled.load(std::memory_order_relaxed);
+}
+
+void setHugePagesEnabled(bool enabled) {
+    sHugePagesEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+}  // namespace jet
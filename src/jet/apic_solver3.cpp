@@ -6,9 +6,35 @@
 
 #include <pch.h>
 #include <jet/apic_solver3.h>
+#include <jet/face_centered_stencil3.h>
 
 using namespace jet;
 
+template <typename Kernel>
+static void sampleVelocitiesAndGradients(
+    const FaceCenteredGrid3& flow,
+    const ConstArrayAccessor1<Vector3D>& positions,
+    ArrayAccessor1<Vector3D> velocities, ArrayAccessor1<Vector3D> cX,
+    ArrayAccessor1<Vector3D> cY, ArrayAccessor1<Vector3D> cZ) {
+    const Vector3D origin = flow.origin();
+    const Vector3D invH = 1.0 / flow.gridSpacing();
+    const Size3 res = flow.resolution();
+    const auto u = flow.uConstAccessor();
+    const auto v = flow.vConstAccessor();
+    const auto w = flow.wConstAccessor();
+
+    // The stencil clamps the positions to the sample range of each component
+    parallelFor(kZeroSize, positions.size(), [&](size_t i) {
+        const FaceCenteredStencil3<Kernel> stencil(positions[i], origin, invH,
+                                                   res);
+
+        velocities[i] = stencil.sample(u, v, w);
+        cX[i] = stencil.u.gradient(u, invH);
+        cY[i] = stencil.v.gradient(v, invH);
+        cZ[i] = stencil.w.gradient(w, invH);
+    });
+}
+
 ApicSolver3::ApicSolver3()
 : ApicSolver3({1, 1, 1}, {1, 1, 1}, {0, 0, 0}) {
 }
@@ -18,131 +44,22 @@ ApicSolver3::ApicSolver3(
     const Vector3D& gridSpacing,
     const Vector3D& gridOrigin)
 : PicSolver3(resolution, gridSpacing, gridOrigin) {
+    // Store the affine velocity as particle layers so that they follow the
+    // particles when they are reseeded.
+    auto particles = particleSystemData();
+    _cXIdx = particles->addVectorData();
+    _cYIdx = particles->addVectorData();
+    _cZIdx = particles->addVectorData();
 }
 
 ApicSolver3::~ApicSolver3() {
 }
 
 void ApicSolver3::transferFromParticlesToGrids() {
-    auto flow = gridSystemData()->velocity();
     const auto particles = particleSystemData();
-    const auto positions = particles->positions();
-    auto velocities = particles->velocities();
-    const size_t numberOfParticles = particles->numberOfParticles();
-    const auto hh = flow->gridSpacing() / 2.0;
-    const auto bbox = flow->boundingBox();
-
-    // Allocate buffers
-    _cX.resize(numberOfParticles);
-    _cY.resize(numberOfParticles);
-    _cZ.resize(numberOfParticles);
-
-    // Clear velocity to zero
-    flow->fill(Vector3D());
-
-    // Weighted-average velocity
-    auto u = flow->uAccessor();
-    auto v = flow->vAccessor();
-    auto w = flow->wAccessor();
-    const auto uPos = flow->uPosition();
-    const auto vPos = flow->vPosition();
-    const auto wPos = flow->wPosition();
-    Array3<double> uWeight(u.size());
-    Array3<double> vWeight(v.size());
-    Array3<double> wWeight(w.size());
-    _uMarkers.resize(u.size());
-    _vMarkers.resize(v.size());
-    _wMarkers.resize(w.size());
-    _uMarkers.set(0);
-    _vMarkers.set(0);
-    _wMarkers.set(0);
-    LinearArraySampler3<double, double> uSampler(
-        flow->uConstAccessor(),
-        flow->gridSpacing(),
-        flow->uOrigin());
-    LinearArraySampler3<double, double> vSampler(
-        flow->vConstAccessor(),
-        flow->gridSpacing(),
-        flow->vOrigin());
-    LinearArraySampler3<double, double> wSampler(
-        flow->wConstAccessor(),
-        flow->gridSpacing(),
-        flow->wOrigin());
-
-    for (size_t i = 0; i < numberOfParticles; ++i) {
-        std::array<Point3UI, 8> indices;
-        std::array<double, 8> weights;
-
-        auto uPosClamped = positions[i];
-        uPosClamped.y = clamp(
-            uPosClamped.y,
-            bbox.lowerCorner.y + hh.y,
-            bbox.upperCorner.y - hh.y);
-        uPosClamped.z = clamp(
-            uPosClamped.z,
-            bbox.lowerCorner.z + hh.z,
-            bbox.upperCorner.z - hh.z);
-        uSampler.getCoordinatesAndWeights(uPosClamped, &indices, &weights);
-        for (int j = 0; j < 8; ++j) {
-            Vector3D gridPos = uPos(indices[j].x, indices[j].y, indices[j].z);
-            double apicTerm = _cX[i].dot(gridPos - uPosClamped);
-            u(indices[j]) += weights[j] * (velocities[i].x + apicTerm);
-            uWeight(indices[j]) += weights[j];
-            _uMarkers(indices[j]) = 1;
-        }
-
-        auto vPosClamped = positions[i];
-        vPosClamped.x = clamp(
-            vPosClamped.x,
-            bbox.lowerCorner.x + hh.x,
-            bbox.upperCorner.x - hh.x);
-        vPosClamped.z = clamp(
-            vPosClamped.z,
-            bbox.lowerCorner.z + hh.z,
-            bbox.upperCorner.z - hh.z);
-        vSampler.getCoordinatesAndWeights(vPosClamped, &indices, &weights);
-        for (int j = 0; j < 8; ++j) {
-            Vector3D gridPos = vPos(indices[j].x, indices[j].y, indices[j].z);
-            double apicTerm = _cY[i].dot(gridPos - vPosClamped);
-            v(indices[j]) += weights[j] * (velocities[i].y + apicTerm);
-            vWeight(indices[j]) += weights[j];
-            _vMarkers(indices[j]) = 1;
-        }
-
-        auto wPosClamped = positions[i];
-        wPosClamped.x = clamp(
-            wPosClamped.x,
-            bbox.lowerCorner.x + hh.x,
-            bbox.upperCorner.x - hh.x);
-        wPosClamped.y = clamp(
-            wPosClamped.y,
-            bbox.lowerCorner.y + hh.y,
-            bbox.upperCorner.y - hh.y);
-        wSampler.getCoordinatesAndWeights(wPosClamped, &indices, &weights);
-        for (int j = 0; j < 8; ++j) {
-            Vector3D gridPos = wPos(indices[j].x, indices[j].y, indices[j].z);
-            double apicTerm = _cZ[i].dot(gridPos - wPosClamped);
-            w(indices[j]) += weights[j] * (velocities[i].z + apicTerm);
-            wWeight(indices[j]) += weights[j];
-            _wMarkers(indices[j]) = 1;
-        }
-    }
-
-    uWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (uWeight(i, j, k) > 0.0) {
-            u(i, j, k) /= uWeight(i, j, k);
-        }
-    });
-    vWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (vWeight(i, j, k) > 0.0) {
-            v(i, j, k) /= vWeight(i, j, k);
-        }
-    });
-    wWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (wWeight(i, j, k) > 0.0) {
-            w(i, j, k) /= wWeight(i, j, k);
-        }
-    });
+    splatParticleVelocities(particles->vectorDataAt(_cXIdx),
+                            particles->vectorDataAt(_cYIdx),
+                            particles->vectorDataAt(_cZIdx));
 }
 
 void ApicSolver3::transferFromGridsToParticles() {
@@ -150,82 +67,24 @@ void ApicSolver3::transferFromGridsToParticles() {
     const auto particles = particleSystemData();
     auto positions = particles->positions();
     auto velocities = particles->velocities();
-    const size_t numberOfParticles = particles->numberOfParticles();
-    const auto hh = flow->gridSpacing() / 2.0;
-    const auto bbox = flow->boundingBox();
-
-    // Allocate buffers
-    _cX.resize(numberOfParticles);
-    _cY.resize(numberOfParticles);
-    _cZ.resize(numberOfParticles);
-    _cX.set(Vector3D());
-    _cY.set(Vector3D());
-    _cZ.set(Vector3D());
-
-    auto u = flow->uAccessor();
-    auto v = flow->vAccessor();
-    auto w = flow->wAccessor();
-    LinearArraySampler3<double, double> uSampler(
-        u, flow->gridSpacing(), flow->uOrigin());
-    LinearArraySampler3<double, double> vSampler(
-        v, flow->gridSpacing(), flow->vOrigin());
-    LinearArraySampler3<double, double> wSampler(
-        w, flow->gridSpacing(), flow->wOrigin());
-
-    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
-        velocities[i] = flow->sample(positions[i]);
-
-        std::array<Point3UI, 8> indices;
-        std::array<Vector3D, 8> gradWeights;
-
-        // x
-        auto uPosClamped = positions[i];
-        uPosClamped.y = clamp(
-            uPosClamped.y,
-            bbox.lowerCorner.y + hh.y,
-            bbox.upperCorner.y - hh.y);
-        uPosClamped.z = clamp(
-            uPosClamped.z,
-            bbox.lowerCorner.z + hh.z,
-            bbox.upperCorner.z - hh.z);
-        uSampler.getCoordinatesAndGradientWeights(
-            uPosClamped, &indices, &gradWeights);
-        for (int j = 0; j < 8; ++j) {
-            _cX[i] += gradWeights[j] * u(indices[j]);
-        }
-
-        // y
-        auto vPosClamped = positions[i];
-        vPosClamped.x = clamp(
-            vPosClamped.x,
-            bbox.lowerCorner.x + hh.x,
-            bbox.upperCorner.x - hh.x);
-        vPosClamped.z = clamp(
-            vPosClamped.z,
-            bbox.lowerCorner.z + hh.z,
-            bbox.upperCorner.z - hh.z);
-        vSampler.getCoordinatesAndGradientWeights(
-            vPosClamped, &indices, &gradWeights);
-        for (int j = 0; j < 8; ++j) {
-            _cY[i] += gradWeights[j] * v(indices[j]);
-        }
-
-        // z
-        auto wPosClamped = positions[i];
-        wPosClamped.x = clamp(
-            wPosClamped.x,
-            bbox.lowerCorner.x + hh.x,
-            bbox.upperCorner.x - hh.x);
-        wPosClamped.y = clamp(
-            wPosClamped.y,
-            bbox.lowerCorner.y + hh.y,
-            bbox.upperCorner.y - hh.y);
-        wSampler.getCoordinatesAndGradientWeights(
-            wPosClamped, &indices, &gradWeights);
-        for (int j = 0; j < 8; ++j) {
-            _cZ[i] += gradWeights[j] * w(indices[j]);
-        }
-    });
+    auto cX = particles->vectorDataAt(_cXIdx);
+    auto cY = particles->vectorDataAt(_cYIdx);
+    auto cZ = particles->vectorDataAt(_cZIdx);
+
+    switch (transferKernelType()) {
+        case TransferKernelType::kQuadraticBSpline:
+            sampleVelocitiesAndGradients<QuadraticBSplineTransferKernel>(
+                *flow, positions, velocities, cX, cY, cZ);
+            break;
+        case TransferKernelType::kCubicBSpline:
+            sampleVelocitiesAndGradients<CubicBSplineTransferKernel>(
+                *flow, positions, velocities, cX, cY, cZ);
+            break;
+        default:
+            sampleVelocitiesAndGradients<LinearTransferKernel>(
+                *flow, positions, velocities, cX, cY, cZ);
+            break;
+    }
 }
 
 ApicSolver3::Builder ApicSolver3::builder() {
@@ -74,3 +74,17 @@ void EnoLevelSetSolver3::getDerivatives(
     D0[6] = grid(i, j, kp3);
     *dz = eno3(D0, gridSpacing.z);
 }
+
+void EnoLevelSetSolver3::getRowDerivatives(
+    ConstArrayAccessor3<double> grid,
+    const Vector3D& gridSpacing,
+    size_t iBegin,
+    size_t iEnd,
+    size_t j,
+    size_t k,
+    std::array<double*, 2> dx,
+    std::array<double*, 2> dy,
+    std::array<double*, 2> dz) const {
+    computeRowDerivatives(grid, gridSpacing, iBegin, iEnd, j, k, 3,
+                          eno3Row<double>, dx, dy, dz);
+}
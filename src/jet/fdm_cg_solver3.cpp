@@ -46,6 +46,33 @@ bool FdmCgSolver3::solve(FdmLinearSystem3* system) {
            _lastNumberOfIterations < _maxNumberOfIterations;
 }
 
+bool FdmCgSolver3::solveMultiple(FdmMultiLinearSystem3* system) {
+    FdmMatrix3& matrix = system->A;
+    FdmMultiVector3& solution = system->x;
+    FdmMultiVector3& rhs = system->b;
+
+    JET_ASSERT(matrix.size() == rhs.size);
+
+    const Size3 size = matrix.size();
+    const size_t n = rhs.numberOfVectors;
+    solution.resize(size, n);
+    _rMulti.resize(size, n);
+    _dMulti.resize(size, n);
+    _qMulti.resize(size, n);
+    _sMulti.resize(size, n);
+
+    solution.data.set(0.0);
+
+    NullCgPreconditioner<FdmMultiBlas3> precond;
+    pcgMultiple<FdmMultiBlas3, NullCgPreconditioner<FdmMultiBlas3>>(
+        matrix, rhs, _maxNumberOfIterations, _tolerance, &precond, &solution,
+        &_rMulti, &_dMulti, &_qMulti, &_sMulti, &_lastNumberOfIterations,
+        &_lastResidual);
+
+    return _lastResidual <= _tolerance ||
+           _lastNumberOfIterations < _maxNumberOfIterations;
+}
+
 bool FdmCgSolver3::solveCompressed(FdmCompressedLinearSystem3* system) {
     MatrixCsrD& matrix = system->A;
     VectorND& solution = system->x;
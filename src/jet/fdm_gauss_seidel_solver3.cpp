@@ -8,6 +8,7 @@
 
 #include <jet/constants.h>
 #include <jet/fdm_gauss_seidel_solver3.h>
+#include <jet/temporal_blocking.h>
 
 using namespace jet;
 
@@ -149,72 +150,43 @@ void FdmGaussSeidelSolver3::relax(const MatrixCsrD& A, const VectorND& b,
 
 void FdmGaussSeidelSolver3::relaxRedBlack(const FdmMatrix3& A,
                                           const FdmVector3& b, double sorFactor,
+                                          FdmVector3* x) {
+    relaxRedBlack(A, b, sorFactor, 1, x);
+}
+
+void FdmGaussSeidelSolver3::relaxRedBlack(const FdmMatrix3& A,
+                                          const FdmVector3& b, double sorFactor,
+                                          unsigned int numberOfIterations,
                                           FdmVector3* x_) {
     Size3 size = A.size();
     FdmVector3& x = *x_;
 
-    // Red update
-    parallelRangeFor(
-        kZeroSize, size.x, kZeroSize, size.y, kZeroSize, size.z,
-        [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
-            size_t kBegin, size_t kEnd) {
-            for (size_t k = kBegin; k < kEnd; ++k) {
-                for (size_t j = jBegin; j < jEnd; ++j) {
-                    size_t i = (j + k) % 2 + iBegin;  // i.e. (0, 0, 0)
-                    for (; i < iEnd; i += 2) {
-                        double r =
-                            ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k)
-                                     : 0.0) +
-                            ((i + 1 < size.x)
-                                 ? A(i, j, k).right * x(i + 1, j, k)
+    // Even steps update the red cells (i + j + k is even), and odd steps
+    // update the black cells. Each half step only reads the other color, so
+    // a plane only depends on the adjacent planes of the previous half step.
+    temporallyBlockedSweep(
+        size.z, 2 * numberOfIterations, kDefaultTemporalBlockDepth,
+        [&](unsigned int step, size_t k) {
+            const size_t color = step % 2;
+
+            for (size_t j = 0; j < size.y; ++j) {
+                for (size_t i = (j + k + color) % 2; i < size.x; i += 2) {
+                    double r =
+                        ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k)
                                  : 0.0) +
-                            ((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k)
-                                     : 0.0) +
-                            ((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k)
-                                              : 0.0) +
-                            ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1)
-                                     : 0.0) +
-                            ((k + 1 < size.z)
-                                 ? A(i, j, k).front * x(i, j, k + 1)
-                                 : 0.0);
-
-                        x(i, j, k) =
-                            (1.0 - sorFactor) * x(i, j, k) +
-                            sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
-                    }
-                }
-            }
-        });
-
-    // Black update
-    parallelRangeFor(
-        kZeroSize, size.x, kZeroSize, size.y, kZeroSize, size.z,
-        [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
-            size_t kBegin, size_t kEnd) {
-            for (size_t k = kBegin; k < kEnd; ++k) {
-                for (size_t j = jBegin; j < jEnd; ++j) {
-                    size_t i = 1 - (j + k) % 2 + iBegin;  // i.e. (1, 1, 1)
-                    for (; i < iEnd; i += 2) {
-                        double r =
-                            ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k)
-                                     : 0.0) +
-                            ((i + 1 < size.x)
-                                 ? A(i, j, k).right * x(i + 1, j, k)
+                        ((i + 1 < size.x) ? A(i, j, k).right * x(i + 1, j, k)
+                                          : 0.0) +
+                        ((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k) : 0.0) +
+                        ((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k)
+                                          : 0.0) +
+                        ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1)
                                  : 0.0) +
-                            ((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k)
-                                     : 0.0) +
-                            ((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k)
-                                              : 0.0) +
-                            ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1)
-                                     : 0.0) +
-                            ((k + 1 < size.z)
-                                 ? A(i, j, k).front * x(i, j, k + 1)
-                                 : 0.0);
-
-                        x(i, j, k) =
-                            (1.0 - sorFactor) * x(i, j, k) +
-                            sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
-                    }
+                        ((k + 1 < size.z) ? A(i, j, k).front * x(i, j, k + 1)
+                                          : 0.0);
+
+                    x(i, j, k) =
+                        (1.0 - sorFactor) * x(i, j, k) +
+                        sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
                 }
             }
         });
@@ -65,6 +65,63 @@ void FdmIccgSolver3::Preconditioner::solve(const FdmVector3& b, FdmVector3* x) {
     }
 }
 
+void FdmIccgSolver3::Preconditioner::solve(const FdmMultiVector3& b,
+                                           FdmMultiVector3* x) {
+    const Size3 size = b.size;
+    const size_t n = b.numberOfVectors;
+    const size_t strideY = size.x * n;
+    const size_t strideZ = size.x * size.y * n;
+
+    yMulti.resize(size, n);
+
+    // Same as the single vector version, but each matrix row is read once
+    // for all the vectors.
+    for (size_t k = 0; k < size.z; ++k) {
+        for (size_t j = 0; j < size.y; ++j) {
+            for (size_t i = 0; i < size.x; ++i) {
+                const size_t c = ((k * size.y + j) * size.x + i) * n;
+                const double cl = (i > 0) ? A(i - 1, j, k).right : 0.0;
+                const double cd = (j > 0) ? A(i, j - 1, k).up : 0.0;
+                const double cb = (k > 0) ? A(i, j, k - 1).front : 0.0;
+                const double* yc = &yMulti.data[c];
+                const double* yl = (i > 0) ? yc - n : yc;
+                const double* yd = (j > 0) ? yc - strideY : yc;
+                const double* yb = (k > 0) ? yc - strideZ : yc;
+                const double dc = d(i, j, k);
+
+                for (size_t l = 0; l < n; ++l) {
+                    yMulti.data[c + l] = (b.data[c + l] - cl * yl[l] -
+                                          cd * yd[l] - cb * yb[l]) *
+                                         dc;
+                }
+            }
+        }
+    }
+
+    for (size_t k = size.z; k-- > 0;) {
+        for (size_t j = size.y; j-- > 0;) {
+            for (size_t i = size.x; i-- > 0;) {
+                const size_t c = ((k * size.y + j) * size.x + i) * n;
+                const FdmMatrixRow3& row = A(i, j, k);
+                const double cr = (i + 1 < size.x) ? row.right : 0.0;
+                const double cu = (j + 1 < size.y) ? row.up : 0.0;
+                const double cf = (k + 1 < size.z) ? row.front : 0.0;
+                const double* xc = &x->data[c];
+                const double* xr = (i + 1 < size.x) ? xc + n : xc;
+                const double* xu = (j + 1 < size.y) ? xc + strideY : xc;
+                const double* xf = (k + 1 < size.z) ? xc + strideZ : xc;
+                const double dc = d(i, j, k);
+
+                for (size_t l = 0; l < n; ++l) {
+                    x->data[c + l] = (yMulti.data[c + l] - cr * xr[l] -
+                                      cu * xu[l] - cf * xf[l]) *
+                                     dc;
+                }
+            }
+        }
+    }
+}
+
 //
 
 void FdmIccgSolver3::PreconditionerCompressed::build(const MatrixCsrD& matrix) {
@@ -152,6 +209,58 @@ FdmIccgSolver3::FdmIccgSolver3(unsigned int maxNumberOfIterations,
       _lastResidualNorm(kMaxD) {}
 
 bool FdmIccgSolver3::solve(FdmLinearSystem3* system) {
+    return solveUncompressed(system, true);
+}
+
+bool FdmIccgSolver3::solveWithSameMatrix(FdmLinearSystem3* system) {
+    return solveUncompressed(system, !isPreconditionerBuilt(system->A));
+}
+
+bool FdmIccgSolver3::solveMultiple(FdmMultiLinearSystem3* system) {
+    return solveMultipleUncompressed(system, true);
+}
+
+bool FdmIccgSolver3::solveMultipleWithSameMatrix(
+    FdmMultiLinearSystem3* system) {
+    return solveMultipleUncompressed(system,
+                                     !isPreconditionerBuilt(system->A));
+}
+
+bool FdmIccgSolver3::solveCompressed(FdmCompressedLinearSystem3* system) {
+    MatrixCsrD& matrix = system->A;
+    VectorND& solution = system->x;
+    VectorND& rhs = system->b;
+
+    clearUncompressedVectors();
+
+    size_t size = solution.size();
+    _rComp.resize(size);
+    _dComp.resize(size);
+    _qComp.resize(size);
+    _sComp.resize(size);
+
+    system->x.set(0.0);
+    _rComp.set(0.0);
+    _dComp.set(0.0);
+    _qComp.set(0.0);
+    _sComp.set(0.0);
+
+    _precondComp.build(matrix);
+
+    pcg<FdmCompressedBlas3, PreconditionerCompressed>(
+        matrix, rhs, _maxNumberOfIterations, _tolerance, &_precondComp,
+        &solution, &_rComp, &_dComp, &_qComp, &_sComp, &_lastNumberOfIterations,
+        &_lastResidualNorm);
+
+    JET_INFO << "Residual after solving ICCG: " << _lastResidualNorm
+             << " Number of ICCG iterations: " << _lastNumberOfIterations;
+
+    return _lastResidualNorm <= _tolerance ||
+           _lastNumberOfIterations < _maxNumberOfIterations;
+}
+
+bool FdmIccgSolver3::solveUncompressed(FdmLinearSystem3* system,
+                                       bool buildPreconditioner) {
     FdmMatrix3& matrix = system->A;
     FdmVector3& solution = system->x;
     FdmVector3& rhs = system->b;
@@ -173,7 +282,9 @@ bool FdmIccgSolver3::solve(FdmLinearSystem3* system) {
     _q.set(0.0);
     _s.set(0.0);
 
-    _precond.build(matrix);
+    if (buildPreconditioner) {
+        _precond.build(matrix);
+    }
 
     pcg<FdmBlas3, Preconditioner>(
         matrix, rhs, _maxNumberOfIterations, _tolerance, &_precond, &solution,
@@ -186,39 +297,48 @@ bool FdmIccgSolver3::solve(FdmLinearSystem3* system) {
            _lastNumberOfIterations < _maxNumberOfIterations;
 }
 
-bool FdmIccgSolver3::solveCompressed(FdmCompressedLinearSystem3* system) {
-    MatrixCsrD& matrix = system->A;
-    VectorND& solution = system->x;
-    VectorND& rhs = system->b;
+bool FdmIccgSolver3::solveMultipleUncompressed(FdmMultiLinearSystem3* system,
+                                               bool buildPreconditioner) {
+    FdmMatrix3& matrix = system->A;
+    FdmMultiVector3& solution = system->x;
+    FdmMultiVector3& rhs = system->b;
 
-    clearUncompressedVectors();
+    JET_ASSERT(matrix.size() == rhs.size);
 
-    size_t size = solution.size();
-    _rComp.resize(size);
-    _dComp.resize(size);
-    _qComp.resize(size);
-    _sComp.resize(size);
+    const Size3 size = matrix.size();
+    const size_t n = rhs.numberOfVectors;
+    solution.resize(size, n);
+    _rMulti.resize(size, n);
+    _dMulti.resize(size, n);
+    _qMulti.resize(size, n);
+    _sMulti.resize(size, n);
 
-    system->x.set(0.0);
-    _rComp.set(0.0);
-    _dComp.set(0.0);
-    _qComp.set(0.0);
-    _sComp.set(0.0);
+    solution.data.set(0.0);
 
-    _precondComp.build(matrix);
+    if (buildPreconditioner) {
+        _precond.build(matrix);
+    }
 
-    pcg<FdmCompressedBlas3, PreconditionerCompressed>(
-        matrix, rhs, _maxNumberOfIterations, _tolerance, &_precondComp,
-        &solution, &_rComp, &_dComp, &_qComp, &_sComp, &_lastNumberOfIterations,
+    pcgMultiple<FdmMultiBlas3, Preconditioner>(
+        matrix, rhs, _maxNumberOfIterations, _tolerance, &_precond, &solution,
+        &_rMulti, &_dMulti, &_qMulti, &_sMulti, &_lastNumberOfIterations,
         &_lastResidualNorm);
 
-    JET_INFO << "Residual after solving ICCG: " << _lastResidualNorm
+    JET_INFO << "Residual norm after solving ICCG for " << n
+             << " right-hand sides: " << _lastResidualNorm
              << " Number of ICCG iterations: " << _lastNumberOfIterations;
 
     return _lastResidualNorm <= _tolerance ||
            _lastNumberOfIterations < _maxNumberOfIterations;
 }
 
+bool FdmIccgSolver3::isPreconditionerBuilt(const FdmMatrix3& matrix) const {
+    // The preconditioner refers to the matrix, so it is only reusable if the
+    // last one was built from the same matrix array.
+    return _precond.A.data() != nullptr && _precond.A.data() == matrix.data() &&
+           _precond.A.size() == matrix.size();
+}
+
 unsigned int FdmIccgSolver3::maxNumberOfIterations() const {
     return _maxNumberOfIterations;
 }
@@ -238,8 +358,8 @@ void FdmIccgSolver3::clearUncompressedVectors() {
     _s.clear();
 }
 void FdmIccgSolver3::clearCompressedVectors() {
-    _r.clear();
-    _d.clear();
-    _q.clear();
-    _s.clear();
+    _rComp.clear();
+    _dComp.clear();
+    _qComp.clear();
+    _sComp.clear();
 }
\ No newline at end of file
@@ -8,6 +8,10 @@
 
 #include <jet/constants.h>
 #include <jet/fdm_jacobi_solver3.h>
+#include <jet/parallel.h>
+#include <jet/temporal_blocking.h>
+
+#include <algorithm>
 
 using namespace jet;
 
@@ -28,16 +32,24 @@ bool FdmJacobiSolver3::solve(FdmLinearSystem3* system) {
 
     _lastNumberOfIterations = _maxNumberOfIterations;
 
-    for (unsigned int iter = 0; iter < _maxNumberOfIterations; ++iter) {
-        relax(system->A, system->b, &system->x, &_xTemp);
+    // Relax until the next residual check at once so the iterations in
+    // between can be fused
+    unsigned int iter = 0;
+    while (iter < _maxNumberOfIterations) {
+        const unsigned int nextCheck = (iter == 0)
+                                           ? _residualCheckInterval + 1
+                                           : iter + _residualCheckInterval;
+        const unsigned int numberOfIterations =
+            std::min(nextCheck, _maxNumberOfIterations) - iter;
 
-        _xTemp.swap(system->x);
+        relax(system->A, system->b, numberOfIterations, &system->x, &_xTemp);
+        iter += numberOfIterations;
 
-        if (iter != 0 && iter % _residualCheckInterval == 0) {
+        if (iter == nextCheck) {
             FdmBlas3::residual(system->A, system->x, system->b, &_residual);
 
             if (FdmBlas3::l2Norm(_residual) < _tolerance) {
-                _lastNumberOfIterations = iter + 1;
+                _lastNumberOfIterations = iter;
                 break;
             }
         }
@@ -111,6 +123,45 @@ void FdmJacobiSolver3::relax(const FdmMatrix3& A, const FdmVector3& b,
     });
 }
 
+void FdmJacobiSolver3::relax(const FdmMatrix3& A, const FdmVector3& b,
+                             unsigned int numberOfIterations, FdmVector3* x_,
+                             FdmVector3* xTemp_) {
+    Size3 size = A.size();
+    FdmVector3* buffers[2] = {x_, xTemp_};
+
+    JET_ASSERT(x_->size() == size && xTemp_->size() == size);
+
+    temporallyBlockedSweep(
+        size.z, numberOfIterations, kDefaultTemporalBlockDepth,
+        [&](unsigned int step, size_t k) {
+            const FdmVector3& x = *buffers[step % 2];
+            FdmVector3& xTemp = *buffers[(step + 1) % 2];
+
+            for (size_t j = 0; j < size.y; ++j) {
+                for (size_t i = 0; i < size.x; ++i) {
+                    double r =
+                        ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k)
+                                 : 0.0) +
+                        ((i + 1 < size.x) ? A(i, j, k).right * x(i + 1, j, k)
+                                          : 0.0) +
+                        ((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k) : 0.0) +
+                        ((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k)
+                                          : 0.0) +
+                        ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1)
+                                 : 0.0) +
+                        ((k + 1 < size.z) ? A(i, j, k).front * x(i, j, k + 1)
+                                          : 0.0);
+
+                    xTemp(i, j, k) = (b(i, j, k) - r) / A(i, j, k).center;
+                }
+            }
+        });
+
+    if (numberOfIterations % 2 == 1) {
+        x_->swap(*xTemp_);
+    }
+}
+
 void FdmJacobiSolver3::relax(const MatrixCsrD& A, const VectorND& b,
                              VectorND* x_, VectorND* xTemp_) {
     const auto rp = A.rowPointersBegin();
@@ -26,6 +26,60 @@ void FdmLinearSystem3::resize(const Size3& size) {
 
 //
 
+void FdmMultiVector3::clear() {
+    size = Size3();
+    numberOfVectors = 0;
+    data.clear();
+}
+
+void FdmMultiVector3::resize(const Size3& newSize, size_t newNumberOfVectors) {
+    size = newSize;
+    numberOfVectors = newNumberOfVectors;
+    data.resize(size.x * size.y * size.z * numberOfVectors);
+}
+
+double& FdmMultiVector3::operator()(size_t i, size_t j, size_t k, size_t n) {
+    JET_ASSERT(i < size.x && j < size.y && k < size.z && n < numberOfVectors);
+    return data[((k * size.y + j) * size.x + i) * numberOfVectors + n];
+}
+
+const double& FdmMultiVector3::operator()(size_t i, size_t j, size_t k,
+                                          size_t n) const {
+    JET_ASSERT(i < size.x && j < size.y && k < size.z && n < numberOfVectors);
+    return data[((k * size.y + j) * size.x + i) * numberOfVectors + n];
+}
+
+void FdmMultiVector3::setVector(size_t n, const FdmVector3& v) {
+    JET_THROW_INVALID_ARG_IF(size != v.size() || n >= numberOfVectors);
+
+    v.parallelForEachIndex(
+        [&](size_t i, size_t j, size_t k) { (*this)(i, j, k, n) = v(i, j, k); });
+}
+
+void FdmMultiVector3::getVector(size_t n, FdmVector3* v) const {
+    JET_THROW_INVALID_ARG_IF(n >= numberOfVectors);
+
+    v->resize(size);
+    v->parallelForEachIndex(
+        [&](size_t i, size_t j, size_t k) { (*v)(i, j, k) = (*this)(i, j, k, n); });
+}
+
+//
+
+void FdmMultiLinearSystem3::clear() {
+    A.clear();
+    x.clear();
+    b.clear();
+}
+
+void FdmMultiLinearSystem3::resize(const Size3& size, size_t numberOfVectors) {
+    A.resize(size);
+    x.resize(size, numberOfVectors);
+    b.resize(size, numberOfVectors);
+}
+
+//
+
 void FdmCompressedLinearSystem3::clear() {
     A.clear();
     x.clear();
@@ -205,3 +259,113 @@ double FdmCompressedBlas3::l2Norm(const VectorND& v) {
 double FdmCompressedBlas3::lInfNorm(const VectorND& v) {
     return std::fabs(v.absmax());
 }
+
+//
+
+void FdmMultiBlas3::set(double s, FdmMultiVector3* result) {
+    result->data.set(s);
+}
+
+void FdmMultiBlas3::set(const FdmMultiVector3& v, FdmMultiVector3* result) {
+    result->size = v.size;
+    result->numberOfVectors = v.numberOfVectors;
+    result->data.set(v.data);
+}
+
+void FdmMultiBlas3::dot(const FdmMultiVector3& a, const FdmMultiVector3& b,
+                        std::vector<double>* result) {
+    JET_THROW_INVALID_ARG_IF(a.size != b.size);
+    JET_THROW_INVALID_ARG_IF(a.numberOfVectors != b.numberOfVectors);
+
+    const size_t n = a.numberOfVectors;
+    const size_t length = a.data.size();
+
+    result->assign(n, 0.0);
+
+    for (size_t i = 0; i < length; i += n) {
+        for (size_t l = 0; l < n; ++l) {
+            (*result)[l] += a.data[i + l] * b.data[i + l];
+        }
+    }
+}
+
+void FdmMultiBlas3::axpy(const std::vector<double>& a, const FdmMultiVector3& x,
+                         const FdmMultiVector3& y, FdmMultiVector3* result) {
+    JET_THROW_INVALID_ARG_IF(x.size != y.size);
+    JET_THROW_INVALID_ARG_IF(x.size != result->size);
+    JET_THROW_INVALID_ARG_IF(a.size() != x.numberOfVectors);
+
+    const size_t n = x.numberOfVectors;
+    const Size3 size = x.size;
+
+    parallelFor(kZeroSize, size.x * size.y * size.z, [&](size_t c) {
+        const double* xc = &x.data[c * n];
+        const double* yc = &y.data[c * n];
+        double* rc = &result->data[c * n];
+        for (size_t l = 0; l < n; ++l) {
+            rc[l] = a[l] * xc[l] + yc[l];
+        }
+    });
+}
+
+// Computes sign * (A v) + b for all the vectors where b can be null.
+static void multiplyMultiVector(const FdmMatrix3& m, const FdmMultiVector3& v,
+                                const FdmMultiVector3* b, double sign,
+                                FdmMultiVector3* result) {
+    const Size3 size = m.size();
+    const size_t n = v.numberOfVectors;
+    const size_t strideY = size.x * n;
+    const size_t strideZ = size.x * size.y * n;
+
+    parallelFor(kZeroSize, size.z, [&](size_t k) {
+        for (size_t j = 0; j < size.y; ++j) {
+            for (size_t i = 0; i < size.x; ++i) {
+                const FdmMatrixRow3& row = m(i, j, k);
+                const size_t c = ((k * size.y + j) * size.x + i) * n;
+                const double* vc = &v.data[c];
+
+                // Coefficients and values of the neighbors; the ones outside
+                // of the grid point to the center with zero coefficients.
+                const double cl = (i > 0) ? m(i - 1, j, k).right : 0.0;
+                const double cr = (i + 1 < size.x) ? row.right : 0.0;
+                const double cd = (j > 0) ? m(i, j - 1, k).up : 0.0;
+                const double cu = (j + 1 < size.y) ? row.up : 0.0;
+                const double cb = (k > 0) ? m(i, j, k - 1).front : 0.0;
+                const double cf = (k + 1 < size.z) ? row.front : 0.0;
+                const double* vl = (i > 0) ? vc - n : vc;
+                const double* vr = (i + 1 < size.x) ? vc + n : vc;
+                const double* vd = (j > 0) ? vc - strideY : vc;
+                const double* vu = (j + 1 < size.y) ? vc + strideY : vc;
+                const double* vb = (k > 0) ? vc - strideZ : vc;
+                const double* vf = (k + 1 < size.z) ? vc + strideZ : vc;
+
+                double* rc = &result->data[c];
+                for (size_t l = 0; l < n; ++l) {
+                    const double av = row.center * vc[l] + cl * vl[l] +
+                                      cr * vr[l] + cd * vd[l] + cu * vu[l] +
+                                      cb * vb[l] + cf * vf[l];
+                    rc[l] = (b != nullptr) ? b->data[c + l] + sign * av
+                                           : sign * av;
+                }
+            }
+        }
+    });
+}
+
+void FdmMultiBlas3::mvm(const FdmMatrix3& m, const FdmMultiVector3& v,
+                        FdmMultiVector3* result) {
+    JET_THROW_INVALID_ARG_IF(m.size() != v.size);
+    JET_THROW_INVALID_ARG_IF(m.size() != result->size);
+
+    multiplyMultiVector(m, v, nullptr, 1.0, result);
+}
+
+void FdmMultiBlas3::residual(const FdmMatrix3& a, const FdmMultiVector3& x,
+                             const FdmMultiVector3& b,
+                             FdmMultiVector3* result) {
+    JET_THROW_INVALID_ARG_IF(a.size() != x.size);
+    JET_THROW_INVALID_ARG_IF(a.size() != b.size);
+    JET_THROW_INVALID_ARG_IF(a.size() != result->size);
+
+    multiplyMultiVector(a, x, &b, -1.0, result);
+}
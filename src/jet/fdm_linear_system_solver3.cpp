@@ -0,0 +1,38 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <jet/fdm_linear_system_solver3.h>
+
+using namespace jet;
+
+bool FdmLinearSystemSolver3::solveMultiple(FdmMultiLinearSystem3* system) {
+    const size_t numberOfVectors = system->b.numberOfVectors;
+    system->x.resize(system->A.size(), numberOfVectors);
+
+    // Borrows the matrix without copying
+    FdmLinearSystem3 single;
+    single.A.swap(system->A);
+
+    bool isConverged = true;
+    for (size_t n = 0; n < numberOfVectors; ++n) {
+        system->b.getVector(n, &single.b);
+        system->x.getVector(n, &single.x);
+
+        if (n == 0) {
+            isConverged &= solve(&single);
+        } else {
+            isConverged &= solveWithSameMatrix(&single);
+        }
+
+        system->x.setVector(n, single.x);
+    }
+
+    single.A.swap(system->A);
+
+    return isConverged;
+}
@@ -31,9 +31,8 @@ FdmMgSolver3::FdmMgSolver3(size_t maxNumberOfLevels,
             UNUSED_VARIABLE(buffer);
             UNUSED_VARIABLE(maxTolerance);
 
-            for (unsigned int iter = 0; iter < numberOfIterations; ++iter) {
-                FdmGaussSeidelSolver3::relaxRedBlack(A, b, sorFactor, x);
-            }
+            FdmGaussSeidelSolver3::relaxRedBlack(A, b, sorFactor,
+                                                 numberOfIterations, x);
         };
     } else {
         _mgParams.relaxFunc = [sorFactor](
@@ -0,0 +1,369 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <jet/cg.h>
+#include <jet/constants.h>
+#include <jet/fdm_schwarz_pcg_solver3.h>
+#include <jet/parallel.h>
+
+#include <algorithm>
+
+using namespace jet;
+
+void FdmSchwarzPcgSolver3::Preconditioner::build(const FdmMatrix3& matrix,
+                                                 size_t numberOfSubdomains,
+                                                 size_t numberOfGhostLayers) {
+    const Size3 size = matrix.size();
+    A = matrix.constAccessor();
+
+    // Owned slabs should be at least as thick as the ghost layers so that
+    // only the adjacent subdomains overlap.
+    const size_t nz = size.z;
+    const size_t g = numberOfGhostLayers;
+    const size_t n = std::max(
+        std::min(numberOfSubdomains, nz / std::max(g, kOneSize)), kOneSize);
+    subdomains.resize(n);
+
+    parallelFor(kZeroSize, n, [&](size_t s) {
+        Subdomain& sub = subdomains[s];
+        sub.ownedBegin = s * nz / n;
+        sub.ownedEnd = (s + 1) * nz / n;
+        sub.begin = (sub.ownedBegin > g) ? sub.ownedBegin - g : 0;
+        sub.end = std::min(sub.ownedEnd + g, nz);
+
+        const Size3 localSize(size.x, size.y, sub.end - sub.begin);
+        sub.d.resize(localSize, 0.0);
+        sub.y.resize(localSize, 0.0);
+        sub.x.resize(localSize, 0.0);
+
+        // Incomplete Cholesky of the extended slab where the couplings to the
+        // outside of the slab are dropped
+        auto& d = sub.d;
+        for (size_t k = 0; k < localSize.z; ++k) {
+            const size_t kk = sub.begin + k;
+            for (size_t j = 0; j < localSize.y; ++j) {
+                for (size_t i = 0; i < localSize.x; ++i) {
+                    double denom =
+                        A(i, j, kk).center -
+                        ((i > 0) ? square(A(i - 1, j, kk).right) *
+                                       d(i - 1, j, k)
+                                 : 0.0) -
+                        ((j > 0) ? square(A(i, j - 1, kk).up) * d(i, j - 1, k)
+                                 : 0.0) -
+                        ((k > 0) ? square(A(i, j, kk - 1).front) *
+                                       d(i, j, k - 1)
+                                 : 0.0);
+
+                    if (std::fabs(denom) > 0.0) {
+                        d(i, j, k) = 1.0 / denom;
+                    } else {
+                        d(i, j, k) = 0.0;
+                    }
+                }
+            }
+        }
+    });
+}
+
+void FdmSchwarzPcgSolver3::Preconditioner::solve(const FdmVector3& b,
+                                                 FdmVector3* x) {
+    const size_t n = subdomains.size();
+
+    // Local solves on the extended slabs
+    parallelFor(kZeroSize, n, [&](size_t s) {
+        Subdomain& sub = subdomains[s];
+        const Size3 localSize = sub.d.size();
+        const ssize_t sx = static_cast<ssize_t>(localSize.x);
+        const ssize_t sy = static_cast<ssize_t>(localSize.y);
+        const ssize_t sz = static_cast<ssize_t>(localSize.z);
+        auto& d = sub.d;
+        auto& y = sub.y;
+        auto& xl = sub.x;
+
+        for (ssize_t k = 0; k < sz; ++k) {
+            const ssize_t kk = static_cast<ssize_t>(sub.begin) + k;
+            for (ssize_t j = 0; j < sy; ++j) {
+                for (ssize_t i = 0; i < sx; ++i) {
+                    y(i, j, k) =
+                        (b(i, j, kk) -
+                         ((i > 0) ? A(i - 1, j, kk).right * y(i - 1, j, k)
+                                  : 0.0) -
+                         ((j > 0) ? A(i, j - 1, kk).up * y(i, j - 1, k)
+                                  : 0.0) -
+                         ((k > 0) ? A(i, j, kk - 1).front * y(i, j, k - 1)
+                                  : 0.0)) *
+                        d(i, j, k);
+                }
+            }
+        }
+
+        for (ssize_t k = sz - 1; k >= 0; --k) {
+            const ssize_t kk = static_cast<ssize_t>(sub.begin) + k;
+            for (ssize_t j = sy - 1; j >= 0; --j) {
+                for (ssize_t i = sx - 1; i >= 0; --i) {
+                    xl(i, j, k) =
+                        (y(i, j, k) -
+                         ((i + 1 < sx) ? A(i, j, kk).right * xl(i + 1, j, k)
+                                       : 0.0) -
+                         ((j + 1 < sy) ? A(i, j, kk).up * xl(i, j + 1, k)
+                                       : 0.0) -
+                         ((k + 1 < sz) ? A(i, j, kk).front * xl(i, j, k + 1)
+                                       : 0.0)) *
+                        d(i, j, k);
+                }
+            }
+        }
+    });
+
+    // Each subdomain writes its owned slab, adding the ghost layers of the
+    // neighbors which overlap with it.
+    parallelFor(kZeroSize, n, [&](size_t s) {
+        const Subdomain& sub = subdomains[s];
+        const Subdomain* prev = (s > 0) ? &subdomains[s - 1] : nullptr;
+        const Subdomain* next = (s + 1 < n) ? &subdomains[s + 1] : nullptr;
+        const Size3 localSize = sub.d.size();
+
+        for (size_t kk = sub.ownedBegin; kk < sub.ownedEnd; ++kk) {
+            const bool hasPrev = prev != nullptr && kk < prev->end;
+            const bool hasNext = next != nullptr && kk >= next->begin;
+            for (size_t j = 0; j < localSize.y; ++j) {
+                for (size_t i = 0; i < localSize.x; ++i) {
+                    double sum = sub.x(i, j, kk - sub.begin);
+                    if (hasPrev) {
+                        sum += prev->x(i, j, kk - prev->begin);
+                    }
+                    if (hasNext) {
+                        sum += next->x(i, j, kk - next->begin);
+                    }
+                    (*x)(i, j, kk) = sum;
+                }
+            }
+        }
+    });
+}
+
+//
+
+void FdmSchwarzPcgSolver3::PreconditionerCompressed::build(
+    const MatrixCsrD& matrix, size_t numberOfSubdomains) {
+    const size_t size = matrix.cols();
+    A = &matrix;
+
+    d.resize(size, 0.0);
+    y.resize(size, 0.0);
+
+    const size_t n =
+        std::max(std::min(numberOfSubdomains, size), kOneSize);
+    blockBegins.resize(n + 1);
+    for (size_t s = 0; s <= n; ++s) {
+        blockBegins[s] = s * size / n;
+    }
+
+    const auto rp = A->rowPointersBegin();
+    const auto ci = A->columnIndicesBegin();
+    const auto nnz = A->nonZeroBegin();
+
+    parallelFor(kZeroSize, n, [&](size_t s) {
+        const size_t lo = blockBegins[s];
+        const size_t hi = blockBegins[s + 1];
+        for (size_t i = lo; i < hi; ++i) {
+            const size_t rowBegin = rp[i];
+            const size_t rowEnd = rp[i + 1];
+
+            double denom = 0.0;
+            for (size_t jj = rowBegin; jj < rowEnd; ++jj) {
+                size_t j = ci[jj];
+
+                if (j == i) {
+                    denom += nnz[jj];
+                } else if (j < i && j >= lo) {
+                    denom -= square(nnz[jj]) * d[j];
+                }
+            }
+
+            if (std::fabs(denom) > 0.0) {
+                d[i] = 1.0 / denom;
+            } else {
+                d[i] = 0.0;
+            }
+        }
+    });
+}
+
+void FdmSchwarzPcgSolver3::PreconditionerCompressed::solve(const VectorND& b,
+                                                           VectorND* x) {
+    const size_t n = blockBegins.size() - 1;
+
+    const auto rp = A->rowPointersBegin();
+    const auto ci = A->columnIndicesBegin();
+    const auto nnz = A->nonZeroBegin();
+
+    parallelFor(kZeroSize, n, [&](size_t s) {
+        const ssize_t lo = static_cast<ssize_t>(blockBegins[s]);
+        const ssize_t hi = static_cast<ssize_t>(blockBegins[s + 1]);
+
+        for (ssize_t i = lo; i < hi; ++i) {
+            const size_t rowBegin = rp[i];
+            const size_t rowEnd = rp[i + 1];
+
+            double sum = b[i];
+            for (size_t jj = rowBegin; jj < rowEnd; ++jj) {
+                ssize_t j = static_cast<ssize_t>(ci[jj]);
+
+                if (j < i && j >= lo) {
+                    sum -= nnz[jj] * y[j];
+                }
+            }
+
+            y[i] = sum * d[i];
+        }
+
+        for (ssize_t i = hi - 1; i >= lo; --i) {
+            const size_t rowBegin = rp[i];
+            const size_t rowEnd = rp[i + 1];
+
+            double sum = y[i];
+            for (size_t jj = rowBegin; jj < rowEnd; ++jj) {
+                ssize_t j = static_cast<ssize_t>(ci[jj]);
+
+                if (j > i && j < hi) {
+                    sum -= nnz[jj] * (*x)[j];
+                }
+            }
+
+            (*x)[i] = sum * d[i];
+        }
+    });
+}
+
+//
+
+FdmSchwarzPcgSolver3::FdmSchwarzPcgSolver3(unsigned int maxNumberOfIterations,
+                                           double tolerance,
+                                           unsigned int numberOfSubdomains,
+                                           unsigned int numberOfGhostLayers)
+    : _maxNumberOfIterations(maxNumberOfIterations),
+      _lastNumberOfIterations(0),
+      _tolerance(tolerance),
+      _lastResidualNorm(kMaxD),
+      _numberOfSubdomains(numberOfSubdomains),
+      _numberOfGhostLayers(numberOfGhostLayers) {}
+
+bool FdmSchwarzPcgSolver3::solve(FdmLinearSystem3* system) {
+    FdmMatrix3& matrix = system->A;
+    FdmVector3& solution = system->x;
+    FdmVector3& rhs = system->b;
+
+    JET_ASSERT(matrix.size() == rhs.size());
+    JET_ASSERT(matrix.size() == solution.size());
+
+    clearCompressedVectors();
+
+    Size3 size = matrix.size();
+    _r.resize(size);
+    _d.resize(size);
+    _q.resize(size);
+    _s.resize(size);
+
+    system->x.set(0.0);
+    _r.set(0.0);
+    _d.set(0.0);
+    _q.set(0.0);
+    _s.set(0.0);
+
+    _precond.build(matrix, targetNumberOfSubdomains(), _numberOfGhostLayers);
+
+    pcg<FdmBlas3, Preconditioner>(
+        matrix, rhs, _maxNumberOfIterations, _tolerance, &_precond, &solution,
+        &_r, &_d, &_q, &_s, &_lastNumberOfIterations, &_lastResidualNorm);
+
+    JET_INFO << "Residual norm after solving Schwarz PCG: "
+             << _lastResidualNorm
+             << " Number of Schwarz PCG iterations: "
+             << _lastNumberOfIterations
+             << " Number of subdomains: " << _precond.subdomains.size();
+
+    return _lastResidualNorm <= _tolerance ||
+           _lastNumberOfIterations < _maxNumberOfIterations;
+}
+
+bool FdmSchwarzPcgSolver3::solveCompressed(
+    FdmCompressedLinearSystem3* system) {
+    MatrixCsrD& matrix = system->A;
+    VectorND& solution = system->x;
+    VectorND& rhs = system->b;
+
+    clearUncompressedVectors();
+
+    size_t size = solution.size();
+    _rComp.resize(size);
+    _dComp.resize(size);
+    _qComp.resize(size);
+    _sComp.resize(size);
+
+    system->x.set(0.0);
+    _rComp.set(0.0);
+    _dComp.set(0.0);
+    _qComp.set(0.0);
+    _sComp.set(0.0);
+
+    _precondComp.build(matrix, targetNumberOfSubdomains());
+
+    pcg<FdmCompressedBlas3, PreconditionerCompressed>(
+        matrix, rhs, _maxNumberOfIterations, _tolerance, &_precondComp,
+        &solution, &_rComp, &_dComp, &_qComp, &_sComp, &_lastNumberOfIterations,
+        &_lastResidualNorm);
+
+    JET_INFO << "Residual after solving Schwarz PCG: " << _lastResidualNorm
+             << " Number of Schwarz PCG iterations: "
+             << _lastNumberOfIterations;
+
+    return _lastResidualNorm <= _tolerance ||
+           _lastNumberOfIterations < _maxNumberOfIterations;
+}
+
+unsigned int FdmSchwarzPcgSolver3::maxNumberOfIterations() const {
+    return _maxNumberOfIterations;
+}
+
+unsigned int FdmSchwarzPcgSolver3::lastNumberOfIterations() const {
+    return _lastNumberOfIterations;
+}
+
+double FdmSchwarzPcgSolver3::tolerance() const { return _tolerance; }
+
+double FdmSchwarzPcgSolver3::lastResidual() const { return _lastResidualNorm; }
+
+unsigned int FdmSchwarzPcgSolver3::numberOfSubdomains() const {
+    return _numberOfSubdomains;
+}
+
+unsigned int FdmSchwarzPcgSolver3::numberOfGhostLayers() const {
+    return _numberOfGhostLayers;
+}
+
+size_t FdmSchwarzPcgSolver3::targetNumberOfSubdomains() const {
+    if (_numberOfSubdomains > 0) {
+        return _numberOfSubdomains;
+    }
+    return std::max(maxNumberOfThreads(), 1u);
+}
+
+void FdmSchwarzPcgSolver3::clearUncompressedVectors() {
+    _r.clear();
+    _d.clear();
+    _q.clear();
+    _s.clear();
+}
+
+void FdmSchwarzPcgSolver3::clearCompressedVectors() {
+    _rComp.clear();
+    _dComp.clear();
+    _qComp.clear();
+    _sComp.clear();
+}
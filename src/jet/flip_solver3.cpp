@@ -4,17 +4,57 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <jet/face_centered_stencil3.h>
 #include <jet/flip_solver3.h>
+#include <jet/fmm_level_set_solver3.h>
+#include <jet/level_set_utils.h>
+#include <jet/timer.h>
 #include <pch.h>
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 using namespace jet;
 
+static const unsigned int kNarrowBandParticlesPerCell = 8;
+static const unsigned int kNarrowBandMinParticlesPerCell = 4;
+
+template <typename Kernel>
+static void transferDeltaToParticles(
+    const FaceCenteredGrid3& flow, const Array3<float>& uDelta,
+    const Array3<float>& vDelta, const Array3<float>& wDelta,
+    double picBlendingFactor, const ConstArrayAccessor1<Vector3D>& positions,
+    ArrayAccessor1<Vector3D> velocities) {
+    const Vector3D origin = flow.origin();
+    const Vector3D invH = 1.0 / flow.gridSpacing();
+    const Size3 res = flow.resolution();
+    const auto u = flow.uConstAccessor();
+    const auto v = flow.vConstAccessor();
+    const auto w = flow.wConstAccessor();
+    const auto du = uDelta.constAccessor();
+    const auto dv = vDelta.constAccessor();
+    const auto dw = wDelta.constAccessor();
+
+    // The velocity and its change are sampled with the same stencil
+    parallelFor(kZeroSize, positions.size(), [&](size_t i) {
+        const FaceCenteredStencil3<Kernel> stencil(positions[i], origin, invH,
+                                                   res);
+
+        Vector3D flipVel = velocities[i] + stencil.sample(du, dv, dw);
+        if (picBlendingFactor > 0.0) {
+            Vector3D picVel = stencil.sample(u, v, w);
+            flipVel = lerp(flipVel, picVel, picBlendingFactor);
+        }
+        velocities[i] = flipVel;
+    });
+}
+
 FlipSolver3::FlipSolver3() : FlipSolver3({1, 1, 1}, {1, 1, 1}, {0, 0, 0}) {}
 
 FlipSolver3::FlipSolver3(const Size3& resolution, const Vector3D& gridSpacing,
                          const Vector3D& gridOrigin)
-    : PicSolver3(resolution, gridSpacing, gridOrigin) {
-}
+    : PicSolver3(resolution, gridSpacing, gridOrigin) {}
 
 FlipSolver3::~FlipSolver3() {}
 
@@ -24,9 +64,65 @@ void FlipSolver3::setPicBlendingFactor(double factor) {
     _picBlendingFactor = clamp(factor, 0.0, 1.0);
 }
 
+bool FlipSolver3::isUsingNarrowBand() const { return _isUsingNarrowBand; }
+
+void FlipSolver3::setIsUsingNarrowBand(bool onoff) {
+    _isUsingNarrowBand = onoff;
+
+    // Solvers without the narrow band don't pay for the extra grid
+    if (_isUsingNarrowBand && _narrowBandLevelSetId == kMaxSize) {
+        _narrowBandLevelSetId = gridSystemData()->addScalarData(
+            std::make_shared<CellCenteredScalarGrid3::Builder>(), kMaxD);
+    }
+}
+
+double FlipSolver3::narrowBandWidth() const { return _narrowBandWidth; }
+
+void FlipSolver3::setNarrowBandWidth(double widthInCells) {
+    _narrowBandWidth = std::max(widthInCells, 2.0);
+}
+
+ScalarGrid3Ptr FlipSolver3::narrowBandLevelSet() const {
+    if (_narrowBandLevelSetId == kMaxSize) {
+        return nullptr;
+    }
+    return gridSystemData()->scalarDataAt(_narrowBandLevelSetId);
+}
+
+void FlipSolver3::onBeginAdvanceTimeStep(double timeIntervalInSeconds) {
+    PicSolver3::onBeginAdvanceTimeStep(timeIntervalInSeconds);
+
+    if (_isUsingNarrowBand) {
+        Timer timer;
+        updateNarrowBandLevelSet();
+        JET_INFO << "updateNarrowBandLevelSet took "
+                 << timer.durationInSeconds() << " seconds";
+    }
+}
+
+void FlipSolver3::computeAdvection(double timeIntervalInSeconds) {
+    PicSolver3::computeAdvection(timeIntervalInSeconds);
+
+    if (_isUsingNarrowBand) {
+        Timer timer;
+        advectNarrowBandInterior(timeIntervalInSeconds);
+        JET_INFO << "advectNarrowBandInterior took "
+                 << timer.durationInSeconds() << " seconds";
+
+        timer.reset();
+        reseedNarrowBandParticles();
+        JET_INFO << "reseedNarrowBandParticles took "
+                 << timer.durationInSeconds() << " seconds";
+    }
+}
+
 void FlipSolver3::transferFromParticlesToGrids() {
     PicSolver3::transferFromParticlesToGrids();
 
+    if (_isUsingNarrowBand) {
+        fillInteriorVelocityFromGrid();
+    }
+
     // Store snapshot
     auto vel = gridSystemData()->velocity();
     auto u = gridSystemData()->velocity()->uConstAccessor();
@@ -51,7 +147,6 @@ void FlipSolver3::transferFromGridsToParticles() {
     auto flow = gridSystemData()->velocity();
     auto positions = particleSystemData()->positions();
     auto velocities = particleSystemData()->velocities();
-    size_t numberOfParticles = particleSystemData()->numberOfParticles();
 
     // Compute delta
     flow->parallelForEachUIndex([&](size_t i, size_t j, size_t k) {
@@ -69,33 +164,234 @@ void FlipSolver3::transferFromGridsToParticles() {
             static_cast<float>(flow->w(i, j, k)) - _wDelta(i, j, k);
     });
 
-    LinearArraySampler3<float, float> uSampler(
-        _uDelta.constAccessor(), flow->gridSpacing().castTo<float>(),
-        flow->uOrigin().castTo<float>());
-    LinearArraySampler3<float, float> vSampler(
-        _vDelta.constAccessor(), flow->gridSpacing().castTo<float>(),
-        flow->vOrigin().castTo<float>());
-    LinearArraySampler3<float, float> wSampler(
-        _wDelta.constAccessor(), flow->gridSpacing().castTo<float>(),
-        flow->wOrigin().castTo<float>());
-
-    auto sampler = [uSampler, vSampler, wSampler](const Vector3D& x) {
-        const auto xf = x.castTo<float>();
-        double u = uSampler(xf);
-        double v = vSampler(xf);
-        double w = wSampler(xf);
-        return Vector3D(u, v, w);
-    };
-
-    // Transfer delta to the particles
+    switch (transferKernelType()) {
+        case TransferKernelType::kQuadraticBSpline:
+            transferDeltaToParticles<QuadraticBSplineTransferKernel>(
+                *flow, _uDelta, _vDelta, _wDelta, _picBlendingFactor,
+                positions, velocities);
+            break;
+        case TransferKernelType::kCubicBSpline:
+            transferDeltaToParticles<CubicBSplineTransferKernel>(
+                *flow, _uDelta, _vDelta, _wDelta, _picBlendingFactor,
+                positions, velocities);
+            break;
+        default:
+            transferDeltaToParticles<LinearTransferKernel>(
+                *flow, _uDelta, _vDelta, _wDelta, _picBlendingFactor,
+                positions, velocities);
+            break;
+    }
+}
+
+double FlipSolver3::narrowBandWidthInWorld() const {
+    const Vector3D h = gridSpacing();
+    return _narrowBandWidth * max3(h.x, h.y, h.z);
+}
+
+void FlipSolver3::fillInteriorVelocityFromGrid() {
+    auto flow = gridSystemData()->velocity();
+    if (!_narrowBandVelocity.hasSameShape(*flow)) {
+        return;
+    }
+
+    // Faces in the deep interior are not covered by the particles anymore.
+    // Use the grid-advected velocity from the previous step instead.
+    auto phi = narrowBandLevelSet();
+    const double interiorDepth = 0.5 * narrowBandWidthInWorld();
+    auto u = flow->uAccessor();
+    auto v = flow->vAccessor();
+    auto w = flow->wAccessor();
+    const auto u0 = _narrowBandVelocity.uConstAccessor();
+    const auto v0 = _narrowBandVelocity.vConstAccessor();
+    const auto w0 = _narrowBandVelocity.wConstAccessor();
+    const auto uPos = flow->uPosition();
+    const auto vPos = flow->vPosition();
+    const auto wPos = flow->wPosition();
+
+    flow->parallelForEachUIndex([&](size_t i, size_t j, size_t k) {
+        if (!_uMarkers(i, j, k) &&
+            phi->sample(uPos(i, j, k)) < -interiorDepth) {
+            u(i, j, k) = u0(i, j, k);
+            _uMarkers(i, j, k) = 1;
+        }
+    });
+    flow->parallelForEachVIndex([&](size_t i, size_t j, size_t k) {
+        if (!_vMarkers(i, j, k) &&
+            phi->sample(vPos(i, j, k)) < -interiorDepth) {
+            v(i, j, k) = v0(i, j, k);
+            _vMarkers(i, j, k) = 1;
+        }
+    });
+    flow->parallelForEachWIndex([&](size_t i, size_t j, size_t k) {
+        if (!_wMarkers(i, j, k) &&
+            phi->sample(wPos(i, j, k)) < -interiorDepth) {
+            w(i, j, k) = w0(i, j, k);
+            _wMarkers(i, j, k) = 1;
+        }
+    });
+}
+
+void FlipSolver3::updateNarrowBandLevelSet() {
+    auto sdf = signedDistanceField();
+    auto phi = narrowBandLevelSet();
+    const double bandWidth = narrowBandWidthInWorld();
+    const double interiorDepth = 0.5 * bandWidth;
+    const double maxDistance = 2.0 * bandWidth;
+    const Size3 size = sdf->dataSize();
+
+    // Particles only cover the band, so take the interior from the grid
+    auto combined = sdf->clone();
+    combined->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        const double phiGrid = (*phi)(i, j, k);
+        if (phiGrid < -interiorDepth) {
+            (*combined)(i, j, k) = std::min((*sdf)(i, j, k), phiGrid);
+        }
+    });
+
+    // Clamp the cells away from the interface so that the ones beyond the
+    // reinitialization range still carry the right sign and depth.
+    auto c = combined->constDataAccessor();
+    phi->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        const bool inside = isInsideSdf(c(i, j, k));
+        const bool nearInterface =
+            (i > 0 && isInsideSdf(c(i - 1, j, k)) != inside) ||
+            (i + 1 < size.x && isInsideSdf(c(i + 1, j, k)) != inside) ||
+            (j > 0 && isInsideSdf(c(i, j - 1, k)) != inside) ||
+            (j + 1 < size.y && isInsideSdf(c(i, j + 1, k)) != inside) ||
+            (k > 0 && isInsideSdf(c(i, j, k - 1)) != inside) ||
+            (k + 1 < size.z && isInsideSdf(c(i, j, k + 1)) != inside);
+        if (nearInterface) {
+            (*phi)(i, j, k) = c(i, j, k);
+        } else {
+            (*phi)(i, j, k) = inside ? -maxDistance : maxDistance;
+        }
+    });
+
+    FmmLevelSetSolver3 fmmSolver;
+    fmmSolver.reinitialize(*phi, maxDistance, sdf.get());
+    extrapolateIntoCollider(sdf.get());
+
+    phi->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        (*phi)(i, j, k) = (*sdf)(i, j, k);
+    });
+}
+
+void FlipSolver3::advectNarrowBandInterior(double timeIntervalInSeconds) {
+    auto solver = advectionSolver();
+    if (solver == nullptr) {
+        return;
+    }
+
+    auto flow = gridSystemData()->velocity();
+    auto phi = narrowBandLevelSet();
+    auto boundarySdf = colliderSdf();
+
+    auto phi0 = phi->clone();
+    solver->advect(*phi0, *flow, timeIntervalInSeconds, phi.get(),
+                   *boundarySdf);
+
+    _narrowBandVelocity.set(*flow);
+    solver->advect(*flow, *flow, timeIntervalInSeconds, &_narrowBandVelocity,
+                   *boundarySdf);
+}
+
+void FlipSolver3::reseedNarrowBandParticles() {
+    auto particles = particleSystemData();
+    auto phi = narrowBandLevelSet();
+    auto boundarySdf = colliderSdf();
+    const double bandWidth = narrowBandWidthInWorld();
+    const Vector3D h = phi->gridSpacing();
+    const Vector3D origin = phi->origin();
+    const Size3 res = phi->resolution();
+    const double maxH = max3(h.x, h.y, h.z);
+
+    // Remove particles that sank below the band
+    const size_t oldNumberOfParticles = particles->numberOfParticles();
+    auto positions = particles->positions();
+    Array1<char> removalMarkers(oldNumberOfParticles, 0, stepArena());
+    parallelFor(kZeroSize, oldNumberOfParticles, [&](size_t i) {
+        removalMarkers[i] = (phi->sample(positions[i]) < -bandWidth) ? 1 : 0;
+    });
+    particles->removeParticles(removalMarkers.constAccessor());
+
+    // Count particles per cell by sorting the particles by their cells, so
+    // each cell is written by a single thread.
+    const size_t numberOfParticles = particles->numberOfParticles();
+    Array1<size_t> cellIndices;
+    Array1<size_t> sortedIndices;
+    sortParticlesByCell(&cellIndices, &sortedIndices);
+
+    Array3<unsigned int> counts(res, 0u, stepArena());
+    unsigned int* countsData = counts.data();
     parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
-        Vector3D flipVel = velocities[i] + sampler(positions[i]);
-        if (_picBlendingFactor > 0.0) {
-            Vector3D picVel = flow->sample(positions[i]);
-            flipVel = lerp(flipVel, picVel, _picBlendingFactor);
+        const size_t cell = cellIndices[sortedIndices[i]];
+        if (i > 0 && cellIndices[sortedIndices[i - 1]] == cell) {
+            return;
         }
-        velocities[i] = flipVel;
+        size_t end = i + 1;
+        while (end < numberOfParticles &&
+               cellIndices[sortedIndices[end]] == cell) {
+            ++end;
+        }
+        countsData[cell] = static_cast<unsigned int>(end - i);
     });
+
+    // Reseed the band cells which ran out of particles, using the velocity
+    // field the interior will be initialized from in the next step. Each
+    // cell draws from its own random stream seeded by the cell index and the
+    // pass count, and each z-layer collects its own particles, so the result
+    // does not depend on the number of threads.
+    const unsigned int reseedingCount = _reseedingCount++;
+    std::vector<Array1<Vector3D>> layerPositions(res.z);
+    std::vector<Array1<Vector3D>> layerVelocities(res.z);
+    parallelFor(kZeroSize, res.z, [&](size_t k) {
+        std::uniform_real_distribution<> d(0.0, 1.0);
+        for (size_t j = 0; j < res.y; ++j) {
+            for (size_t i = 0; i < res.x; ++i) {
+                const double phiCell = (*phi)(i, j, k);
+                if (phiCell >= -maxH || phiCell < -bandWidth ||
+                    counts(i, j, k) >= kNarrowBandMinParticlesPerCell) {
+                    continue;
+                }
+
+                const size_t cellIndex = i + res.x * (j + res.y * k);
+                std::seed_seq seed{
+                    static_cast<unsigned int>(cellIndex),
+                    static_cast<unsigned int>(cellIndex >> 32),
+                    reseedingCount};
+                std::minstd_rand rng(seed);
+
+                for (unsigned int n = counts(i, j, k);
+                     n < kNarrowBandParticlesPerCell; ++n) {
+                    const double rx = d(rng);
+                    const double ry = d(rng);
+                    const double rz = d(rng);
+                    const Vector3D pt =
+                        origin + h * Vector3D(i + rx, j + ry, k + rz);
+                    if (isInsideSdf(boundarySdf->sample(pt))) {
+                        continue;
+                    }
+
+                    layerPositions[k].append(pt);
+                    layerVelocities[k].append(_narrowBandVelocity.sample(pt));
+                }
+            }
+        }
+    });
+
+    Array1<Vector3D> newPositions;
+    Array1<Vector3D> newVelocities;
+    for (size_t k = 0; k < res.z; ++k) {
+        newPositions.append(layerPositions[k]);
+        newVelocities.append(layerVelocities[k]);
+    }
+
+    particles->addParticles(newPositions.constAccessor(),
+                            newVelocities.constAccessor());
+
+    JET_INFO << "Number of narrow-band particles removed: "
+             << oldNumberOfParticles - numberOfParticles
+             << ", reseeded: " << newPositions.size();
 }
 
 FlipSolver3::Builder FlipSolver3::builder() { return Builder(); }
@@ -11,6 +11,8 @@
 #include <jet/fdm_utils.h>
 #include <jet/level_set_utils.h>
 
+#include <algorithm>
+
 using namespace jet;
 
 const char kFluid = 0;
@@ -29,23 +31,70 @@ void GridBackwardEulerDiffusionSolver3::solve(
     ScalarGrid3* dest,
     const ScalarField3& boundarySdf,
     const ScalarField3& fluidSdf) {
-    auto pos = source.dataPosition();
-    Vector3D h = source.gridSpacing();
+    solveMultiple({&source}, diffusionCoefficient, timeIntervalInSeconds,
+                  {dest}, boundarySdf, fluidSdf);
+}
+
+void GridBackwardEulerDiffusionSolver3::solveMultiple(
+    const std::vector<const ScalarGrid3*>& sources,
+    double diffusionCoefficient,
+    double timeIntervalInSeconds,
+    const std::vector<ScalarGrid3*>& dests,
+    const ScalarField3& boundarySdf,
+    const ScalarField3& fluidSdf) {
+    JET_THROW_INVALID_ARG_IF(sources.size() != dests.size());
+
+    if (sources.empty()) {
+        return;
+    }
+
+    const ScalarGrid3& first = *sources[0];
+    for (const ScalarGrid3* source : sources) {
+        JET_THROW_INVALID_ARG_IF(source->dataSize() != first.dataSize());
+    }
+
+    auto pos = first.dataPosition();
+    Vector3D h = first.gridSpacing();
     Vector3D c = timeIntervalInSeconds * diffusionCoefficient / (h * h);
 
-    buildMarkers(source.dataSize(), pos, boundarySdf, fluidSdf);
-    buildMatrix(source.dataSize(), c);
-    buildVectors(source.constDataAccessor(), c);
+    buildMarkers(first.dataSize(), pos, boundarySdf, fluidSdf);
+    const bool isMatrixReused = updateMatrix(first.dataSize(), c);
 
-    if (_systemSolver != nullptr) {
-        // Solve the system
-        _systemSolver->solve(&_system);
+    if (sources.size() == 1) {
+        buildVectors(first.constDataAccessor(), c);
 
-        // Assign the solution
-        source.parallelForEachDataPointIndex(
-            [&](size_t i, size_t j, size_t k) {
-                (*dest)(i, j, k) = _system.x(i, j, k);
-            });
+        if (_systemSolver != nullptr) {
+            // Solve the system
+            solveSystem(isMatrixReused);
+
+            // Assign the solution
+            ScalarGrid3* dest = dests[0];
+            dest->parallelForEachDataPointIndex(
+                [&](size_t i, size_t j, size_t k) {
+                    (*dest)(i, j, k) = _system.x(i, j, k);
+                });
+        }
+        return;
+    }
+
+    _multiSystem.b.resize(first.dataSize(), sources.size());
+    for (size_t n = 0; n < sources.size(); ++n) {
+        buildVectors(sources[n]->constDataAccessor(), c);
+        _multiSystem.b.setVector(n, _system.b);
+    }
+
+    if (_systemSolver != nullptr) {
+        // Solve the systems
+        solveMultipleSystems(isMatrixReused);
+
+        // Assign the solutions
+        for (size_t n = 0; n < dests.size(); ++n) {
+            ScalarGrid3* dest = dests[n];
+            dest->parallelForEachDataPointIndex(
+                [&](size_t i, size_t j, size_t k) {
+                    (*dest)(i, j, k) = _multiSystem.x(i, j, k, n);
+                });
+        }
     }
 }
 
@@ -61,47 +110,25 @@ void GridBackwardEulerDiffusionSolver3::solve(
     Vector3D c = timeIntervalInSeconds * diffusionCoefficient / (h * h);
 
     buildMarkers(source.dataSize(), pos, boundarySdf, fluidSdf);
-    buildMatrix(source.dataSize(), c);
-
-    // u
-    buildVectors(source.constDataAccessor(), c, 0);
+    const bool isMatrixReused = updateMatrix(source.dataSize(), c);
 
-    if (_systemSolver != nullptr) {
-        // Solve the system
-        _systemSolver->solve(&_system);
-
-        // Assign the solution
-        source.parallelForEachDataPointIndex(
-            [&](size_t i, size_t j, size_t k) {
-                (*dest)(i, j, k).x = _system.x(i, j, k);
-            });
+    // Solves u, v, and w at once
+    _multiSystem.b.resize(source.dataSize(), 3);
+    for (size_t n = 0; n < 3; ++n) {
+        buildVectors(source.constDataAccessor(), c, n);
+        _multiSystem.b.setVector(n, _system.b);
     }
 
-    // v
-    buildVectors(source.constDataAccessor(), c, 1);
-
     if (_systemSolver != nullptr) {
-        // Solve the system
-        _systemSolver->solve(&_system);
+        // Solve the systems
+        solveMultipleSystems(isMatrixReused);
 
-        // Assign the solution
-        source.parallelForEachDataPointIndex(
-            [&](size_t i, size_t j, size_t k) {
-                (*dest)(i, j, k).y = _system.x(i, j, k);
-            });
-    }
-
-    // w
-    buildVectors(source.constDataAccessor(), c, 2);
-
-    if (_systemSolver != nullptr) {
-        // Solve the system
-        _systemSolver->solve(&_system);
-
-        // Assign the solution
+        // Assign the solutions
         source.parallelForEachDataPointIndex(
             [&](size_t i, size_t j, size_t k) {
-                (*dest)(i, j, k).z = _system.x(i, j, k);
+                (*dest)(i, j, k) = Vector3D(_multiSystem.x(i, j, k, 0),
+                                            _multiSystem.x(i, j, k, 1),
+                                            _multiSystem.x(i, j, k, 2));
             });
     }
 }
@@ -119,12 +146,12 @@ void GridBackwardEulerDiffusionSolver3::solve(
     // u
     auto uPos = source.uPosition();
     buildMarkers(source.uSize(), uPos, boundarySdf, fluidSdf);
-    buildMatrix(source.uSize(), c);
+    bool isMatrixReused = updateMatrix(source.uSize(), c);
     buildVectors(source.uConstAccessor(), c);
 
     if (_systemSolver != nullptr) {
         // Solve the system
-        _systemSolver->solve(&_system);
+        solveSystem(isMatrixReused);
 
         // Assign the solution
         source.parallelForEachUIndex(
@@ -136,12 +163,12 @@ void GridBackwardEulerDiffusionSolver3::solve(
     // v
     auto vPos = source.vPosition();
     buildMarkers(source.vSize(), vPos, boundarySdf, fluidSdf);
-    buildMatrix(source.vSize(), c);
+    isMatrixReused = updateMatrix(source.vSize(), c);
     buildVectors(source.vConstAccessor(), c);
 
     if (_systemSolver != nullptr) {
         // Solve the system
-        _systemSolver->solve(&_system);
+        solveSystem(isMatrixReused);
 
         // Assign the solution
         source.parallelForEachVIndex(
@@ -153,12 +180,12 @@ void GridBackwardEulerDiffusionSolver3::solve(
     // w
     auto wPos = source.wPosition();
     buildMarkers(source.wSize(), wPos, boundarySdf, fluidSdf);
-    buildMatrix(source.wSize(), c);
+    isMatrixReused = updateMatrix(source.wSize(), c);
     buildVectors(source.wConstAccessor(), c);
 
     if (_systemSolver != nullptr) {
         // Solve the system
-        _systemSolver->solve(&_system);
+        solveSystem(isMatrixReused);
 
         // Assign the solution
         source.parallelForEachWIndex(
@@ -168,6 +195,11 @@ void GridBackwardEulerDiffusionSolver3::solve(
     }
 }
 
+const FdmLinearSystemSolver3Ptr&
+GridBackwardEulerDiffusionSolver3::linearSystemSolver() const {
+    return _systemSolver;
+}
+
 void GridBackwardEulerDiffusionSolver3::setLinearSystemSolver(
     const FdmLinearSystemSolver3Ptr& solver) {
     _systemSolver = solver;
@@ -191,6 +223,44 @@ void GridBackwardEulerDiffusionSolver3::buildMarkers(
     });
 }
 
+bool GridBackwardEulerDiffusionSolver3::updateMatrix(
+    const Size3& size,
+    const Vector3D& c) {
+    // The matrix only depends on the markers and the coefficients. Compares
+    // the markers directly since it costs the same as hashing them.
+    if (_system.A.size() == size && _matrixMarkers.size() == size
+        && _matrixCoefficients == c
+        && std::equal(_markers.begin(), _markers.end(),
+                      _matrixMarkers.begin())) {
+        return true;
+    }
+
+    buildMatrix(size, c);
+    _matrixMarkers.set(_markers);
+    _matrixCoefficients = c;
+    return false;
+}
+
+void GridBackwardEulerDiffusionSolver3::solveSystem(bool isMatrixReused) {
+    if (isMatrixReused) {
+        _systemSolver->solveWithSameMatrix(&_system);
+    } else {
+        _systemSolver->solve(&_system);
+    }
+}
+
+void GridBackwardEulerDiffusionSolver3::solveMultipleSystems(
+    bool isMatrixReused) {
+    // Lends the matrix to the multi-RHS system without copying
+    _multiSystem.A.swap(_system.A);
+    if (isMatrixReused) {
+        _systemSolver->solveMultipleWithSameMatrix(&_multiSystem);
+    } else {
+        _systemSolver->solveMultiple(&_multiSystem);
+    }
+    _multiSystem.A.swap(_system.A);
+}
+
 void GridBackwardEulerDiffusionSolver3::buildMatrix(
     const Size3& size,
     const Vector3D& c) {
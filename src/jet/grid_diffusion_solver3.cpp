@@ -14,3 +14,18 @@ GridDiffusionSolver3::GridDiffusionSolver3() {
 
 GridDiffusionSolver3::~GridDiffusionSolver3() {
 }
+
+void GridDiffusionSolver3::solveMultiple(
+    const std::vector<const ScalarGrid3*>& sources,
+    double diffusionCoefficient,
+    double timeIntervalInSeconds,
+    const std::vector<ScalarGrid3*>& dests,
+    const ScalarField3& boundarySdf,
+    const ScalarField3& fluidSdf) {
+    JET_THROW_INVALID_ARG_IF(sources.size() != dests.size());
+
+    for (size_t n = 0; n < sources.size(); ++n) {
+        solve(*sources[n], diffusionCoefficient, timeIntervalInSeconds,
+              dests[n], boundarySdf, fluidSdf);
+    }
+}
@@ -457,4 +457,9 @@ void GridFluidSolver2::updateEmitter(double timeIntervalInSeconds) {
     }
 }
 
+size_t GridFluidSolver2::problemSize() const {
+    const Size2 res = _grids->resolution();
+    return res.x * res.y;
+}
+
 GridFluidSolver2::Builder GridFluidSolver2::builder() { return Builder(); }
@@ -10,12 +10,15 @@
 #include <jet/constant_scalar_field3.h>
 #include <jet/constants.h>
 #include <jet/cubic_semi_lagrangian3.h>
+#include <jet/custom_scalar_field3.h>
 #include <jet/grid_backward_euler_diffusion_solver3.h>
 #include <jet/grid_blocked_boundary_condition_solver3.h>
 #include <jet/grid_fluid_solver3.h>
 #include <jet/grid_fractional_single_phase_pressure_solver3.h>
 #include <jet/level_set_utils.h>
+#include <jet/parallel.h>
 #include <jet/surface_to_implicit3.h>
+#include <jet/task_graph.h>
 #include <jet/timer.h>
 
 #include <algorithm>
@@ -56,14 +59,27 @@ void GridFluidSolver3::setViscosityCoefficient(double newValue) {
 
 double GridFluidSolver3::cfl(double timeIntervalInSeconds) const {
     auto vel = _grids->velocity();
-    double maxVel = 0.0;
-    vel->forEachCellIndex([&](size_t i, size_t j, size_t k) {
-        Vector3D v =
-            vel->valueAtCellCenter(i, j, k) + timeIntervalInSeconds * _gravity;
-        maxVel = std::max(maxVel, v.x);
-        maxVel = std::max(maxVel, v.y);
-        maxVel = std::max(maxVel, v.z);
-    });
+    const Size3 res = vel->resolution();
+    const Vector3D gravityDelta = timeIntervalInSeconds * _gravity;
+
+    // Reduce over z-slices so that each task scans contiguous memory
+    double maxVel = parallelReduce(
+        kZeroSize, res.z, 0.0,
+        [&](size_t kBegin, size_t kEnd, double result) {
+            for (size_t k = kBegin; k < kEnd; ++k) {
+                for (size_t j = 0; j < res.y; ++j) {
+                    for (size_t i = 0; i < res.x; ++i) {
+                        Vector3D v =
+                            vel->valueAtCellCenter(i, j, k) + gravityDelta;
+                        result = std::max(result, v.x);
+                        result = std::max(result, v.y);
+                        result = std::max(result, v.z);
+                    }
+                }
+            }
+            return result;
+        },
+        [](double a, double b) { return std::max(a, b); });
 
     Vector3D gridSpacing = _grids->gridSpacing();
     double minGridSize = min3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
@@ -85,6 +101,14 @@ void GridFluidSolver3::setUseCompressedLinearSystem(bool onoff) {
     _useCompressedLinearSys = onoff;
 }
 
+ExtrapolationType GridFluidSolver3::extrapolationType() const {
+    return _extrapolationType;
+}
+
+void GridFluidSolver3::setExtrapolationType(ExtrapolationType type) {
+    _extrapolationType = type;
+}
+
 const AdvectionSolver3Ptr& GridFluidSolver3::advectionSolver() const {
     return _advectionSolver;
 }
@@ -255,14 +279,22 @@ void GridFluidSolver3::computePressure(double timeIntervalInSeconds) {
 void GridFluidSolver3::computeAdvection(double timeIntervalInSeconds) {
     auto vel = velocity();
     if (_advectionSolver != nullptr) {
+        // All the layers are advected by the velocity at the beginning of the
+        // advection, so they are independent of each other and can be
+        // advected concurrently.
+        auto vel0 = std::dynamic_pointer_cast<FaceCenteredGrid3>(vel->clone());
+        TaskGraph tasks;
+
         // Solve advections for custom scalar fields
         size_t n = _grids->numberOfAdvectableScalarData();
         for (size_t i = 0; i < n; ++i) {
             auto grid = _grids->advectableScalarDataAt(i);
-            auto grid0 = grid->clone();
-            _advectionSolver->advect(*grid0, *vel, timeIntervalInSeconds,
-                                     grid.get(), *colliderSdf());
-            extrapolateIntoCollider(grid.get());
+            tasks.addTask([this, grid, vel0, timeIntervalInSeconds]() {
+                auto grid0 = grid->clone();
+                _advectionSolver->advect(*grid0, *vel0, timeIntervalInSeconds,
+                                         grid.get(), *colliderSdf());
+                extrapolateIntoCollider(grid.get());
+            });
         }
 
         // Solve advections for custom vector fields
@@ -275,38 +307,43 @@ void GridFluidSolver3::computeAdvection(double timeIntervalInSeconds) {
             }
 
             auto grid = _grids->advectableVectorDataAt(i);
-            auto grid0 = grid->clone();
-
-            auto collocated =
-                std::dynamic_pointer_cast<CollocatedVectorGrid3>(grid);
-            auto collocated0 =
-                std::dynamic_pointer_cast<CollocatedVectorGrid3>(grid0);
-            if (collocated != nullptr) {
-                _advectionSolver->advect(*collocated0, *vel,
-                                         timeIntervalInSeconds,
-                                         collocated.get(), *colliderSdf());
-                extrapolateIntoCollider(collocated.get());
-                continue;
-            }
-
-            auto faceCentered =
-                std::dynamic_pointer_cast<FaceCenteredGrid3>(grid);
-            auto faceCentered0 =
-                std::dynamic_pointer_cast<FaceCenteredGrid3>(grid0);
-            if (faceCentered != nullptr && faceCentered0 != nullptr) {
-                _advectionSolver->advect(*faceCentered0, *vel,
-                                         timeIntervalInSeconds,
-                                         faceCentered.get(), *colliderSdf());
-                extrapolateIntoCollider(faceCentered.get());
-                continue;
-            }
+            tasks.addTask([this, grid, vel0, timeIntervalInSeconds]() {
+                auto grid0 = grid->clone();
+
+                auto collocated =
+                    std::dynamic_pointer_cast<CollocatedVectorGrid3>(grid);
+                auto collocated0 =
+                    std::dynamic_pointer_cast<CollocatedVectorGrid3>(grid0);
+                if (collocated != nullptr) {
+                    _advectionSolver->advect(*collocated0, *vel0,
+                                             timeIntervalInSeconds,
+                                             collocated.get(), *colliderSdf());
+                    extrapolateIntoCollider(collocated.get());
+                    return;
+                }
+
+                auto faceCentered =
+                    std::dynamic_pointer_cast<FaceCenteredGrid3>(grid);
+                auto faceCentered0 =
+                    std::dynamic_pointer_cast<FaceCenteredGrid3>(grid0);
+                if (faceCentered != nullptr && faceCentered0 != nullptr) {
+                    _advectionSolver->advect(*faceCentered0, *vel0,
+                                             timeIntervalInSeconds,
+                                             faceCentered.get(),
+                                             *colliderSdf());
+                    extrapolateIntoCollider(faceCentered.get());
+                }
+            });
         }
 
         // Solve velocity advection
-        auto vel0 = std::dynamic_pointer_cast<FaceCenteredGrid3>(vel->clone());
-        _advectionSolver->advect(*vel0, *vel0, timeIntervalInSeconds, vel.get(),
-                                 *colliderSdf());
-        applyBoundaryCondition();
+        tasks.addTask([this, vel, vel0, timeIntervalInSeconds]() {
+            _advectionSolver->advect(*vel0, *vel0, timeIntervalInSeconds,
+                                     vel.get(), *colliderSdf());
+            applyBoundaryCondition();
+        });
+
+        tasks.execute();
     }
 }
 
@@ -353,7 +390,7 @@ void GridFluidSolver3::applyBoundaryCondition() {
 }
 
 void GridFluidSolver3::extrapolateIntoCollider(ScalarGrid3* grid) {
-    Array3<char> marker(grid->dataSize());
+    Array3<char> marker(grid->dataSize(), 0, stepArena());
     auto pos = grid->dataPosition();
     marker.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
         if (isInsideSdf(colliderSdf()->sample(pos(i, j, k)))) {
@@ -364,12 +401,21 @@ void GridFluidSolver3::extrapolateIntoCollider(ScalarGrid3* grid) {
     });
 
     unsigned int depth = static_cast<unsigned int>(std::ceil(_maxCfl));
-    extrapolateToRegion(grid->constDataAccessor(), marker, depth,
-                        grid->dataAccessor());
+    if (_extrapolationType == ExtrapolationType::kClosestPoint) {
+        const Vector3D gridSpacing = grid->gridSpacing();
+        extrapolateToClosestPoints(
+            grid->constDataAccessor(), marker, gridSpacing, pos(0, 0, 0),
+            *outsideColliderSdf(),
+            depth * max3(gridSpacing.x, gridSpacing.y, gridSpacing.z),
+            grid->dataAccessor());
+    } else {
+        extrapolateToRegion(grid->constDataAccessor(), marker, depth,
+                            grid->dataAccessor());
+    }
 }
 
 void GridFluidSolver3::extrapolateIntoCollider(CollocatedVectorGrid3* grid) {
-    Array3<char> marker(grid->dataSize());
+    Array3<char> marker(grid->dataSize(), 0, stepArena());
     auto pos = grid->dataPosition();
     marker.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
         if (isInsideSdf(colliderSdf()->sample(pos(i, j, k)))) {
@@ -380,8 +426,17 @@ void GridFluidSolver3::extrapolateIntoCollider(CollocatedVectorGrid3* grid) {
     });
 
     unsigned int depth = static_cast<unsigned int>(std::ceil(_maxCfl));
-    extrapolateToRegion(grid->constDataAccessor(), marker, depth,
-                        grid->dataAccessor());
+    if (_extrapolationType == ExtrapolationType::kClosestPoint) {
+        const Vector3D gridSpacing = grid->gridSpacing();
+        extrapolateToClosestPoints(
+            grid->constDataAccessor(), marker, gridSpacing, pos(0, 0, 0),
+            *outsideColliderSdf(),
+            depth * max3(gridSpacing.x, gridSpacing.y, gridSpacing.z),
+            grid->dataAccessor());
+    } else {
+        extrapolateToRegion(grid->constDataAccessor(), marker, depth,
+                            grid->dataAccessor());
+    }
 }
 
 void GridFluidSolver3::extrapolateIntoCollider(FaceCenteredGrid3* grid) {
@@ -392,9 +447,9 @@ void GridFluidSolver3::extrapolateIntoCollider(FaceCenteredGrid3* grid) {
     auto vPos = grid->vPosition();
     auto wPos = grid->wPosition();
 
-    Array3<char> uMarker(u.size());
-    Array3<char> vMarker(v.size());
-    Array3<char> wMarker(w.size());
+    Array3<char> uMarker(u.size(), 0, stepArena());
+    Array3<char> vMarker(v.size(), 0, stepArena());
+    Array3<char> wMarker(w.size(), 0, stepArena());
 
     uMarker.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
         if (isInsideSdf(colliderSdf()->sample(uPos(i, j, k)))) {
@@ -421,15 +476,39 @@ void GridFluidSolver3::extrapolateIntoCollider(FaceCenteredGrid3* grid) {
     });
 
     unsigned int depth = static_cast<unsigned int>(std::ceil(_maxCfl));
-    extrapolateToRegion(grid->uConstAccessor(), uMarker, depth, u);
-    extrapolateToRegion(grid->vConstAccessor(), vMarker, depth, v);
-    extrapolateToRegion(grid->wConstAccessor(), wMarker, depth, w);
+    if (_extrapolationType == ExtrapolationType::kClosestPoint) {
+        const Vector3D gridSpacing = grid->gridSpacing();
+        const double maxDist =
+            depth * max3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
+        const auto sdf = outsideColliderSdf();
+        extrapolateToClosestPoints(grid->uConstAccessor(), uMarker,
+                                   gridSpacing, grid->uOrigin(), *sdf,
+                                   maxDist, u);
+        extrapolateToClosestPoints(grid->vConstAccessor(), vMarker,
+                                   gridSpacing, grid->vOrigin(), *sdf,
+                                   maxDist, v);
+        extrapolateToClosestPoints(grid->wConstAccessor(), wMarker,
+                                   gridSpacing, grid->wOrigin(), *sdf,
+                                   maxDist, w);
+    } else {
+        extrapolateToRegion(grid->uConstAccessor(), uMarker, depth, u);
+        extrapolateToRegion(grid->vConstAccessor(), vMarker, depth, v);
+        extrapolateToRegion(grid->wConstAccessor(), wMarker, depth, w);
+    }
 }
 
 ScalarField3Ptr GridFluidSolver3::colliderSdf() const {
     return _boundaryConditionSolver->colliderSdf();
 }
 
+ScalarField3Ptr GridFluidSolver3::outsideColliderSdf() const {
+    // Flips the sign so that the region outside of the collider is negative
+    const ScalarField3Ptr sdf = colliderSdf();
+    return std::make_shared<CustomScalarField3>(
+        [sdf](const Vector3D& x) { return -sdf->sample(x); },
+        [sdf](const Vector3D& x) { return -sdf->gradient(x); });
+}
+
 VectorField3Ptr GridFluidSolver3::colliderVelocityField() const {
     return _boundaryConditionSolver->colliderVelocityField();
 }
@@ -478,4 +557,9 @@ void GridFluidSolver3::updateEmitter(double timeIntervalInSeconds) {
     }
 }
 
+size_t GridFluidSolver3::problemSize() const {
+    const Size3 res = _grids->resolution();
+    return res.x * res.y * res.z;
+}
+
 GridFluidSolver3::Builder GridFluidSolver3::builder() { return Builder(); }
@@ -8,6 +8,9 @@
 #include <jet/fdm_utils.h>
 #include <jet/grid_forward_euler_diffusion_solver3.h>
 #include <jet/level_set_utils.h>
+#include <jet/temporal_blocking.h>
+
+#include <algorithm>
 
 using namespace jet;
 
@@ -61,9 +64,50 @@ T laplacian(
         + (dfront - dback) / square(gridSpacing.z);
 }
 
+// Runs the forward Euler sub-steps from src to dst, alternating between dst
+// and the buffer so that the last sub-step writes to dst.
+template <typename T, typename Stencil>
+void integrate(
+    const ConstArrayAccessor3<T>& src,
+    unsigned int numberOfSubSteps,
+    ArrayAccessor3<T> dst,
+    Array3<T>* buffer,
+    const Stencil& stencil) {
+    const Size3 size = src.size();
+    if (numberOfSubSteps > 1) {
+        buffer->resize(size);
+    }
+
+    ArrayAccessor3<T> targets[2] = {dst, buffer->accessor()};
+
+    temporallyBlockedSweep(
+        size.z, numberOfSubSteps, kDefaultTemporalBlockDepth,
+        [&](unsigned int step, size_t k) {
+            const unsigned int remaining = numberOfSubSteps - 1 - step;
+            ArrayAccessor3<T> out = targets[remaining % 2];
+            const ConstArrayAccessor3<T> in =
+                (step == 0) ? src : targets[(remaining + 1) % 2];
+
+            for (size_t j = 0; j < size.y; ++j) {
+                for (size_t i = 0; i < size.x; ++i) {
+                    out(i, j, k) = stencil(in, i, j, k);
+                }
+            }
+        });
+}
+
 GridForwardEulerDiffusionSolver3::GridForwardEulerDiffusionSolver3() {
 }
 
+unsigned int GridForwardEulerDiffusionSolver3::numberOfSubSteps() const {
+    return _numberOfSubSteps;
+}
+
+void GridForwardEulerDiffusionSolver3::setNumberOfSubSteps(
+    unsigned int numberOfSubSteps) {
+    _numberOfSubSteps = std::max(numberOfSubSteps, 1u);
+}
+
 void GridForwardEulerDiffusionSolver3::solve(
     const ScalarGrid3& source,
     double diffusionCoefficient,
@@ -74,19 +118,20 @@ void GridForwardEulerDiffusionSolver3::solve(
     auto src = source.constDataAccessor();
     Vector3D h = source.gridSpacing();
     auto pos = source.dataPosition();
+    const double dt = timeIntervalInSeconds / _numberOfSubSteps;
 
     buildMarkers(source.resolution(), pos, boundarySdf, fluidSdf);
 
-    source.parallelForEachDataPointIndex(
-        [&](size_t i, size_t j, size_t k) {
+    integrate(src, _numberOfSubSteps, dest->dataAccessor(), &_scalarBuffer,
+        [&](const ConstArrayAccessor3<double>& data,
+            size_t i, size_t j, size_t k) {
             if (_markers(i, j, k) == kFluid) {
-                (*dest)(i, j, k)
-                    = source(i, j, k)
+                return data(i, j, k)
                     + diffusionCoefficient
-                    * timeIntervalInSeconds
-                    * laplacian(src, _markers, h, i, j, k);
+                    * dt
+                    * laplacian(data, _markers, h, i, j, k);
             } else {
-                (*dest)(i, j, k) = source(i, j, k);
+                return data(i, j, k);
             }
         });
 }
@@ -101,19 +146,20 @@ void GridForwardEulerDiffusionSolver3::solve(
     auto src = source.constDataAccessor();
     Vector3D h = source.gridSpacing();
     auto pos = source.dataPosition();
+    const double dt = timeIntervalInSeconds / _numberOfSubSteps;
 
     buildMarkers(source.resolution(), pos, boundarySdf, fluidSdf);
 
-    source.parallelForEachDataPointIndex(
-        [&](size_t i, size_t j, size_t k) {
+    integrate(src, _numberOfSubSteps, dest->dataAccessor(), &_vectorBuffer,
+        [&](const ConstArrayAccessor3<Vector3D>& data,
+            size_t i, size_t j, size_t k) {
             if (_markers(i, j, k) == kFluid) {
-                (*dest)(i, j, k)
-                    = src(i, j, k)
+                return data(i, j, k)
                     + diffusionCoefficient
-                    * timeIntervalInSeconds
-                    * laplacian(src, _markers, h, i, j, k);
+                    * dt
+                    * laplacian(data, _markers, h, i, j, k);
             } else {
-                (*dest)(i, j, k) = source(i, j, k);
+                return data(i, j, k);
             }
         });
 }
@@ -125,55 +171,36 @@ void GridForwardEulerDiffusionSolver3::solve(
     FaceCenteredGrid3* dest,
     const ScalarField3& boundarySdf,
     const ScalarField3& fluidSdf) {
-    auto uSrc = source.uConstAccessor();
-    auto vSrc = source.vConstAccessor();
-    auto wSrc = source.wConstAccessor();
-    auto u = dest->uAccessor();
-    auto v = dest->vAccessor();
-    auto w = dest->wAccessor();
     auto uPos = source.uPosition();
     auto vPos = source.vPosition();
     auto wPos = source.wPosition();
     Vector3D h = source.gridSpacing();
+    const double dt = timeIntervalInSeconds / _numberOfSubSteps;
+
+    // Points inside the boundary keep the source values
+    auto stencil = [&](const ConstArrayAccessor3<double>& data,
+                       size_t i, size_t j, size_t k) {
+        if (_markers(i, j, k) != kBoundary) {
+            return data(i, j, k)
+                + diffusionCoefficient
+                * dt
+                * laplacian3(data, h, i, j, k);
+        } else {
+            return data(i, j, k);
+        }
+    };
 
     buildMarkers(source.uSize(), uPos, boundarySdf, fluidSdf);
-
-    source.parallelForEachUIndex(
-        [&](size_t i, size_t j, size_t k) {
-            if (!isInsideSdf(boundarySdf.sample(uPos(i, j, k)))) {
-                u(i, j, k)
-                    = uSrc(i, j, k)
-                    + diffusionCoefficient
-                    * timeIntervalInSeconds
-                    * laplacian3(uSrc, h, i, j, k);
-            }
-        });
+    integrate(source.uConstAccessor(), _numberOfSubSteps, dest->uAccessor(),
+              &_scalarBuffer, stencil);
 
     buildMarkers(source.vSize(), vPos, boundarySdf, fluidSdf);
-
-    source.parallelForEachVIndex(
-        [&](size_t i, size_t j, size_t k) {
-            if (!isInsideSdf(boundarySdf.sample(vPos(i, j, k)))) {
-                v(i, j, k)
-                    = vSrc(i, j, k)
-                    + diffusionCoefficient
-                    * timeIntervalInSeconds
-                    * laplacian3(vSrc, h, i, j, k);
-            }
-        });
+    integrate(source.vConstAccessor(), _numberOfSubSteps, dest->vAccessor(),
+              &_scalarBuffer, stencil);
 
     buildMarkers(source.wSize(), wPos, boundarySdf, fluidSdf);
-
-    source.parallelForEachUIndex(
-        [&](size_t i, size_t j, size_t k) {
-            if (!isInsideSdf(boundarySdf.sample(wPos(i, j, k)))) {
-                w(i, j, k)
-                    = wSrc(i, j, k)
-                    + diffusionCoefficient
-                    * timeIntervalInSeconds
-                    * laplacian3(wSrc, h, i, j, k);
-            }
-        });
+    integrate(source.wConstAccessor(), _numberOfSubSteps, dest->wAccessor(),
+              &_scalarBuffer, stencil);
 }
 
 void GridForwardEulerDiffusionSolver3::buildMarkers(
@@ -10,6 +10,7 @@
 #include <jet/cell_centered_scalar_grid3.h>
 #include <jet/grid_fractional_boundary_condition_solver3.h>
 #include <jet/level_set_utils.h>
+#include <jet/parallel.h>
 #include <jet/surface_to_implicit3.h>
 #include <algorithm>
 
@@ -45,68 +46,38 @@ void GridFractionalBoundaryConditionSolver3::constrainVelocity(
     Array3<double> uTemp(u.size());
     Array3<double> vTemp(v.size());
     Array3<double> wTemp(w.size());
-    Array3<char> uMarker(u.size(), 1);
-    Array3<char> vMarker(v.size(), 1);
-    Array3<char> wMarker(w.size(), 1);
 
-    Vector3D h = velocity->gridSpacing();
+    if (!_hasFaceMarkers || _uMarker.size() != u.size()
+        || _vMarker.size() != v.size() || _wMarker.size() != w.size()) {
+        updateFaceMarkers(*velocity);
+    }
 
-    // Assign collider's velocity first and initialize markers
+    // Assign collider's velocity first
     velocity->parallelForEachUIndex([&](size_t i, size_t j, size_t k) {
-        Vector3D pt = uPos(i, j, k);
-        double phi0 = _colliderSdf->sample(pt - Vector3D(0.5 * h.x, 0.0, 0.0));
-        double phi1 = _colliderSdf->sample(pt + Vector3D(0.5 * h.x, 0.0, 0.0));
-        double frac = fractionInsideSdf(phi0, phi1);
-        frac = 1.0 - clamp(frac, 0.0, 1.0);
-
-        if (frac > 0.0) {
-            uMarker(i, j, k) = 1;
-        } else {
-            Vector3D colliderVel = collider()->velocityAt(pt);
-            u(i, j, k) = colliderVel.x;
-            uMarker(i, j, k) = 0;
+        if (!_uMarker(i, j, k)) {
+            u(i, j, k) = collider()->velocityAt(uPos(i, j, k)).x;
         }
     });
 
     velocity->parallelForEachVIndex([&](size_t i, size_t j, size_t k) {
-        Vector3D pt = vPos(i, j, k);
-        double phi0 = _colliderSdf->sample(pt - Vector3D(0.0, 0.5 * h.y, 0.0));
-        double phi1 = _colliderSdf->sample(pt + Vector3D(0.0, 0.5 * h.y, 0.0));
-        double frac = fractionInsideSdf(phi0, phi1);
-        frac = 1.0 - clamp(frac, 0.0, 1.0);
-
-        if (frac > 0.0) {
-            vMarker(i, j, k) = 1;
-        } else {
-            Vector3D colliderVel = collider()->velocityAt(pt);
-            v(i, j, k) = colliderVel.y;
-            vMarker(i, j, k) = 0;
+        if (!_vMarker(i, j, k)) {
+            v(i, j, k) = collider()->velocityAt(vPos(i, j, k)).y;
         }
     });
 
     velocity->parallelForEachWIndex([&](size_t i, size_t j, size_t k) {
-        Vector3D pt = wPos(i, j, k);
-        double phi0 = _colliderSdf->sample(pt - Vector3D(0.0, 0.0, 0.5 * h.z));
-        double phi1 = _colliderSdf->sample(pt + Vector3D(0.0, 0.0, 0.5 * h.z));
-        double frac = fractionInsideSdf(phi0, phi1);
-        frac = 1.0 - clamp(frac, 0.0, 1.0);
-
-        if (frac > 0.0) {
-            wMarker(i, j, k) = 1;
-        } else {
-            Vector3D colliderVel = collider()->velocityAt(pt);
-            w(i, j, k) = colliderVel.z;
-            wMarker(i, j, k) = 0;
+        if (!_wMarker(i, j, k)) {
+            w(i, j, k) = collider()->velocityAt(wPos(i, j, k)).z;
         }
     });
 
     // Free-slip: Extrapolate fluid velocity into the collider
     extrapolateToRegion(
-        velocity->uConstAccessor(), uMarker, extrapolationDepth, u);
+        velocity->uConstAccessor(), _uMarker, extrapolationDepth, u);
     extrapolateToRegion(
-        velocity->vConstAccessor(), vMarker, extrapolationDepth, v);
+        velocity->vConstAccessor(), _vMarker, extrapolationDepth, v);
     extrapolateToRegion(
-        velocity->wConstAccessor(), wMarker, extrapolationDepth, w);
+        velocity->wConstAccessor(), _wMarker, extrapolationDepth, w);
 
     // No-flux: project the extrapolated velocity to the collider's surface
     // normal
@@ -189,46 +160,46 @@ void GridFractionalBoundaryConditionSolver3::constrainVelocity(
 
     // No-flux: Project velocity on the domain boundary if closed
     if (closedDomainBoundaryFlag() & kDirectionLeft) {
-        for (size_t k = 0; k < u.size().z; ++k) {
+        parallelFor(kZeroSize, u.size().z, [&](size_t k) {
             for (size_t j = 0; j < u.size().y; ++j) {
                 u(0, j, k) = 0;
             }
-        }
+        });
     }
     if (closedDomainBoundaryFlag() & kDirectionRight) {
-        for (size_t k = 0; k < u.size().z; ++k) {
+        parallelFor(kZeroSize, u.size().z, [&](size_t k) {
             for (size_t j = 0; j < u.size().y; ++j) {
                 u(u.size().x - 1, j, k) = 0;
             }
-        }
+        });
     }
     if (closedDomainBoundaryFlag() & kDirectionDown) {
-        for (size_t k = 0; k < v.size().z; ++k) {
+        parallelFor(kZeroSize, v.size().z, [&](size_t k) {
             for (size_t i = 0; i < v.size().x; ++i) {
                 v(i, 0, k) = 0;
             }
-        }
+        });
     }
     if (closedDomainBoundaryFlag() & kDirectionUp) {
-        for (size_t k = 0; k < v.size().z; ++k) {
+        parallelFor(kZeroSize, v.size().z, [&](size_t k) {
             for (size_t i = 0; i < v.size().x; ++i) {
                 v(i, v.size().y - 1, k) = 0;
             }
-        }
+        });
     }
     if (closedDomainBoundaryFlag() & kDirectionBack) {
-        for (size_t j = 0; j < w.size().y; ++j) {
+        parallelFor(kZeroSize, w.size().y, [&](size_t j) {
             for (size_t i = 0; i < w.size().x; ++i) {
                 w(i, j, 0) = 0;
             }
-        }
+        });
     }
     if (closedDomainBoundaryFlag() & kDirectionFront) {
-        for (size_t j = 0; j < w.size().y; ++j) {
+        parallelFor(kZeroSize, w.size().y, [&](size_t j) {
             for (size_t i = 0; i < w.size().x; ++i) {
                 w(i, j, w.size().z - 1) = 0;
             }
-        }
+        });
     }
 }
 
@@ -250,6 +221,9 @@ void GridFractionalBoundaryConditionSolver3::onColliderUpdated(
     }
     _colliderSdf->resize(gridSize, gridSpacing, gridOrigin);
 
+    // Face markers are rebuilt from the new sdf by the next constrainVelocity
+    _hasFaceMarkers = false;
+
     if (collider() != nullptr) {
         Surface3Ptr surface = collider()->surface();
         ImplicitSurface3Ptr implicitSurface
@@ -279,3 +253,42 @@ void GridFractionalBoundaryConditionSolver3::onColliderUpdated(
             .makeShared();
     }
 }
+
+void GridFractionalBoundaryConditionSolver3::updateFaceMarkers(
+    const FaceCenteredGrid3& velocity) {
+    auto uPos = velocity.uPosition();
+    auto vPos = velocity.vPosition();
+    auto wPos = velocity.wPosition();
+    Vector3D h = velocity.gridSpacing();
+
+    _uMarker.resize(velocity.uSize());
+    _vMarker.resize(velocity.vSize());
+    _wMarker.resize(velocity.wSize());
+
+    // A face is open if any fraction of it is outside the collider
+    velocity.parallelForEachUIndex([&](size_t i, size_t j, size_t k) {
+        Vector3D pt = uPos(i, j, k);
+        double phi0 = _colliderSdf->sample(pt - Vector3D(0.5 * h.x, 0.0, 0.0));
+        double phi1 = _colliderSdf->sample(pt + Vector3D(0.5 * h.x, 0.0, 0.0));
+        double frac = 1.0 - clamp(fractionInsideSdf(phi0, phi1), 0.0, 1.0);
+        _uMarker(i, j, k) = (frac > 0.0) ? 1 : 0;
+    });
+
+    velocity.parallelForEachVIndex([&](size_t i, size_t j, size_t k) {
+        Vector3D pt = vPos(i, j, k);
+        double phi0 = _colliderSdf->sample(pt - Vector3D(0.0, 0.5 * h.y, 0.0));
+        double phi1 = _colliderSdf->sample(pt + Vector3D(0.0, 0.5 * h.y, 0.0));
+        double frac = 1.0 - clamp(fractionInsideSdf(phi0, phi1), 0.0, 1.0);
+        _vMarker(i, j, k) = (frac > 0.0) ? 1 : 0;
+    });
+
+    velocity.parallelForEachWIndex([&](size_t i, size_t j, size_t k) {
+        Vector3D pt = wPos(i, j, k);
+        double phi0 = _colliderSdf->sample(pt - Vector3D(0.0, 0.0, 0.5 * h.z));
+        double phi1 = _colliderSdf->sample(pt + Vector3D(0.0, 0.0, 0.5 * h.z));
+        double frac = 1.0 - clamp(fractionInsideSdf(phi0, phi1), 0.0, 1.0);
+        _wMarker(i, j, k) = (frac > 0.0) ? 1 : 0;
+    });
+
+    _hasFaceMarkers = true;
+}
@@ -18,6 +18,7 @@
 #include <jet/grid_fractional_boundary_condition_solver3.h>
 #include <jet/grid_fractional_single_phase_pressure_solver3.h>
 #include <jet/level_set_utils.h>
+#include <jet/timer.h>
 
 using namespace jet;
 
@@ -26,7 +27,28 @@ const double kMinWeight = 0.01;
 
 namespace {
 
-void restrict(const Array3<float>& finer, Array3<float>* coarser) {
+// Flags of the SDF samples since the last build
+const char kSdfUpdated = 1;
+const char kSdfFlipped = 2;
+const char kSdfChanged = 4;
+
+// Markers of the matrix rows
+const char kAirRow = 0;
+const char kFluidRow = 1;
+const char kBlockedRow = 2;
+
+bool isChanged(double phi0, double phi1, double tolerance) {
+    return std::fabs(phi1 - phi0) > tolerance ||
+           isInsideSdf(phi0) != isInsideSdf(phi1);
+}
+
+// Restriction kernel from the finer to the coarser grid along each axis.
+struct RestrictionKernel {
+    std::array<int, 3> size;
+    std::array<std::array<float, 4>, 3> weights;
+};
+
+RestrictionKernel restrictionKernel(const Size3& finer, const Size3& coarser) {
     // --*--|--*--|--*--|--*--
     //  1/8   3/8   3/8   1/8
     //           to
@@ -40,102 +62,162 @@ void restrict(const Array3<float>& finer, Array3<float>* coarser) {
     // -|---------|---------|-
     static const std::array<float, 4> staggeredKernel = {{0.f, 1.f, 0.f, 0.f}};
 
-    std::array<int, 3> kernelSize;
-    kernelSize[0] = finer.size().x != 2 * coarser->size().x ? 3 : 4;
-    kernelSize[1] = finer.size().y != 2 * coarser->size().y ? 3 : 4;
-    kernelSize[2] = finer.size().z != 2 * coarser->size().z ? 3 : 4;
+    RestrictionKernel kernel;
+    kernel.size[0] = finer.x != 2 * coarser.x ? 3 : 4;
+    kernel.size[1] = finer.y != 2 * coarser.y ? 3 : 4;
+    kernel.size[2] = finer.z != 2 * coarser.z ? 3 : 4;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        kernel.weights[axis] =
+            (kernel.size[axis] == 3) ? staggeredKernel : centeredKernel;
+    }
+    return kernel;
+}
 
-    std::array<std::array<float, 4>, 3> kernels;
-    kernels[0] = (kernelSize[0] == 3) ? staggeredKernel : centeredKernel;
-    kernels[1] = (kernelSize[1] == 3) ? staggeredKernel : centeredKernel;
-    kernels[2] = (kernelSize[2] == 3) ? staggeredKernel : centeredKernel;
+// Finer indices of the kernel support for the coarser index i.
+void restrictionIndices(size_t i, size_t n, int kernelSize,
+                        std::array<size_t, 4>* indices) {
+    if (kernelSize == 3) {
+        (*indices)[0] = (i > 0) ? 2 * i - 1 : 2 * i;
+        (*indices)[1] = 2 * i;
+        (*indices)[2] = (i + 1 < n) ? 2 * i + 1 : 2 * i;
+    } else {
+        (*indices)[0] = (i > 0) ? 2 * i - 1 : 2 * i;
+        (*indices)[1] = 2 * i;
+        (*indices)[2] = 2 * i + 1;
+        (*indices)[3] = (i + 1 < n) ? 2 * i + 2 : 2 * i + 1;
+    }
+}
 
+// Restricts the finer grid to (i, j, k) of the coarser grid and flags the
+// sample if it has changed.
+void restrictSample(const Array3<float>& finer,
+                    const RestrictionKernel& kernel, size_t i, size_t j,
+                    size_t k, Array3<float>* coarser, Array3<char>* flags) {
     const Size3 n = coarser->size();
-    parallelRangeFor(
-        kZeroSize, n.x, kZeroSize, n.y, kZeroSize, n.z,
-        [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
-            size_t kBegin, size_t kEnd) {
-            std::array<size_t, 4> kIndices;
-
-            for (size_t k = kBegin; k < kEnd; ++k) {
-                if (kernelSize[2] == 3) {
-                    kIndices[0] = (k > 0) ? 2 * k - 1 : 2 * k;
-                    kIndices[1] = 2 * k;
-                    kIndices[2] = (k + 1 < n.z) ? 2 * k + 1 : 2 * k;
-                } else {
-                    kIndices[0] = (k > 0) ? 2 * k - 1 : 2 * k;
-                    kIndices[1] = 2 * k;
-                    kIndices[2] = 2 * k + 1;
-                    kIndices[3] = (k + 1 < n.z) ? 2 * k + 2 : 2 * k + 1;
-                }
+    std::array<size_t, 4> iIndices, jIndices, kIndices;
+    restrictionIndices(i, n.x, kernel.size[0], &iIndices);
+    restrictionIndices(j, n.y, kernel.size[1], &jIndices);
+    restrictionIndices(k, n.z, kernel.size[2], &kIndices);
+
+    float sum = 0.0f;
+    for (int z = 0; z < kernel.size[2]; ++z) {
+        for (int y = 0; y < kernel.size[1]; ++y) {
+            for (int x = 0; x < kernel.size[0]; ++x) {
+                float w = kernel.weights[0][x] * kernel.weights[1][y] *
+                          kernel.weights[2][z];
+                sum += w * finer(iIndices[x], jIndices[y], kIndices[z]);
+            }
+        }
+    }
 
-                std::array<size_t, 4> jIndices;
-
-                for (size_t j = jBegin; j < jEnd; ++j) {
-                    if (kernelSize[1] == 3) {
-                        jIndices[0] = (j > 0) ? 2 * j - 1 : 2 * j;
-                        jIndices[1] = 2 * j;
-                        jIndices[2] = (j + 1 < n.y) ? 2 * j + 1 : 2 * j;
-                    } else {
-                        jIndices[0] = (j > 0) ? 2 * j - 1 : 2 * j;
-                        jIndices[1] = 2 * j;
-                        jIndices[2] = 2 * j + 1;
-                        jIndices[3] = (j + 1 < n.y) ? 2 * j + 2 : 2 * j + 1;
-                    }
-
-                    std::array<size_t, 4> iIndices;
-                    for (size_t i = iBegin; i < iEnd; ++i) {
-                        if (kernelSize[0] == 3) {
-                            iIndices[0] = (i > 0) ? 2 * i - 1 : 2 * i;
-                            iIndices[1] = 2 * i;
-                            iIndices[2] = (i + 1 < n.x) ? 2 * i + 1 : 2 * i;
-                        } else {
-                            iIndices[0] = (i > 0) ? 2 * i - 1 : 2 * i;
-                            iIndices[1] = 2 * i;
-                            iIndices[2] = 2 * i + 1;
-                            iIndices[3] = (i + 1 < n.x) ? 2 * i + 2 : 2 * i + 1;
-                        }
-
-                        float sum = 0.0f;
-                        for (int z = 0; z < kernelSize[2]; ++z) {
-                            for (int y = 0; y < kernelSize[1]; ++y) {
-                                for (int x = 0; x < kernelSize[0]; ++x) {
-                                    float w = kernels[0][x] * kernels[1][y] *
-                                              kernels[2][z];
-                                    sum += w * finer(iIndices[x], jIndices[y],
-                                                     kIndices[z]);
-                                }
-                            }
-                        }
-                        (*coarser)(i, j, k) = sum;
-                    }
-                }
+    const float old = (*coarser)(i, j, k);
+    char flag = 0;
+    if (sum != old) {
+        flag = kSdfUpdated;
+        if (isInsideSdf(sum) != isInsideSdf(old)) {
+            flag |= kSdfFlipped;
+        }
+    }
+    (*flags)(i, j, k) = flag;
+    (*coarser)(i, j, k) = sum;
+}
+
+// Restricts the fluid SDF and the face weights of a level to the next coarser
+// level in a single parallel pass, flagging the changed samples. The first
+// field is the cell-centered SDF and the others are the face weights, each of
+// which is one sample larger along its own axis.
+void restrictLevel(const std::array<const Array3<float>*, 4>& finer,
+                   const std::array<Array3<float>*, 4>& coarser,
+                   const std::array<Array3<char>*, 4>& flags) {
+    std::array<RestrictionKernel, 4> kernels;
+    for (size_t f = 0; f < 4; ++f) {
+        kernels[f] = restrictionKernel(finer[f]->size(), coarser[f]->size());
+    }
+
+    const Size3 n = coarser[0]->size() + Size3(1, 1, 1);
+    parallelFor(kZeroSize, n.x, kZeroSize, n.y, kZeroSize, n.z,
+                [&](size_t i, size_t j, size_t k) {
+        for (size_t f = 0; f < 4; ++f) {
+            const Size3 size = coarser[f]->size();
+            if (i < size.x && j < size.y && k < size.z) {
+                restrictSample(*finer[f], kernels[f], i, j, k, coarser[f],
+                               flags[f]);
+            }
+        }
+    });
+}
+
+// Flags the samples whose changes affect the neighboring rows, which are the
+// sign flips and the updates next to the interface.
+void markChangedCells(const Array3<float>& fluidSdf, Array3<char>* flags) {
+    const Size3 size = fluidSdf.size();
+
+    flags->parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        char& flag = (*flags)(i, j, k);
+        if (flag & kSdfFlipped) {
+            flag |= kSdfChanged;
+        } else if (flag & kSdfUpdated) {
+            const bool inside = isInsideSdf(fluidSdf(i, j, k));
+            if ((i > 0 && isInsideSdf(fluidSdf(i - 1, j, k)) != inside) ||
+                (i + 1 < size.x &&
+                 isInsideSdf(fluidSdf(i + 1, j, k)) != inside) ||
+                (j > 0 && isInsideSdf(fluidSdf(i, j - 1, k)) != inside) ||
+                (j + 1 < size.y &&
+                 isInsideSdf(fluidSdf(i, j + 1, k)) != inside) ||
+                (k > 0 && isInsideSdf(fluidSdf(i, j, k - 1)) != inside) ||
+                (k + 1 < size.z &&
+                 isInsideSdf(fluidSdf(i, j, k + 1)) != inside)) {
+                flag |= kSdfChanged;
             }
-        });
+        }
+    });
 }
 
-void buildSingleSystem(FdmMatrix3* A, FdmVector3* b,
+// Returns (1 - weight) * velocity of the boundary at the face, skipping the
+// boundary velocity sampling for the open faces.
+double boundaryFlux(float weight, const Vector3D& pt, size_t axis,
+                    const std::function<Vector3D(const Vector3D&)>& vel) {
+    return (weight < 1.0f) ? (1.0 - weight) * vel(pt)[axis] : 0.0;
+}
+
+void buildSingleMatrix(FdmMatrix3* A, Array3<char>* markers,
                        const Array3<float>& fluidSdf,
                        const Array3<float>& uWeights,
                        const Array3<float>& vWeights,
                        const Array3<float>& wWeights,
-                       std::function<Vector3D(const Vector3D&)> boundaryVel,
-                       const FaceCenteredGrid3& input) {
-    const Size3 size = input.resolution();
-    const auto uPos = input.uPosition();
-    const auto vPos = input.vPosition();
-    const auto wPos = input.wPosition();
-
-    const Vector3D invH = 1.0 / input.gridSpacing();
+                       const Array3<char>& fluidSdfFlags,
+                       const Array3<char>& uWeightsChanged,
+                       const Array3<char>& vWeightsChanged,
+                       const Array3<char>& wWeightsChanged,
+                       const Vector3D& gridSpacing, bool rebuildAll) {
+    const Size3 size = fluidSdf.size();
+    const Vector3D invH = 1.0 / gridSpacing;
     const Vector3D invHSqr = invH * invH;
 
-    // Build linear system
+    // A row depends on the SDF of the cell and its neighbors and the weights
+    // of the faces of the cell.
+    auto isDirty = [&](size_t i, size_t j, size_t k) {
+        return (fluidSdfFlags(i, j, k) & kSdfChanged) ||
+               (i > 0 && (fluidSdfFlags(i - 1, j, k) & kSdfChanged)) ||
+               (i + 1 < size.x && (fluidSdfFlags(i + 1, j, k) & kSdfChanged)) ||
+               (j > 0 && (fluidSdfFlags(i, j - 1, k) & kSdfChanged)) ||
+               (j + 1 < size.y && (fluidSdfFlags(i, j + 1, k) & kSdfChanged)) ||
+               (k > 0 && (fluidSdfFlags(i, j, k - 1) & kSdfChanged)) ||
+               (k + 1 < size.z && (fluidSdfFlags(i, j, k + 1) & kSdfChanged)) ||
+               uWeightsChanged(i, j, k) || uWeightsChanged(i + 1, j, k) ||
+               vWeightsChanged(i, j, k) || vWeightsChanged(i, j + 1, k) ||
+               wWeightsChanged(i, j, k) || wWeightsChanged(i, j, k + 1);
+    };
+
     A->parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (!rebuildAll && !isDirty(i, j, k)) {
+            return;
+        }
+
         auto& row = (*A)(i, j, k);
 
         // initialize
         row.center = row.right = row.up = row.front = 0.0;
-        (*b)(i, j, k) = 0.0;
 
         double centerPhi = fluidSdf(i, j, k);
 
@@ -153,10 +235,6 @@ void buildSingleSystem(FdmMatrix3* A, FdmVector3* b,
                     theta = std::max(theta, 0.01);
                     row.center += term / theta;
                 }
-                (*b)(i, j, k) +=
-                    uWeights(i + 1, j, k) * input.u(i + 1, j, k) * invH.x;
-            } else {
-                (*b)(i, j, k) += input.u(i + 1, j, k) * invH.x;
             }
 
             if (i > 0) {
@@ -169,9 +247,6 @@ void buildSingleSystem(FdmMatrix3* A, FdmVector3* b,
                     theta = std::max(theta, 0.01);
                     row.center += term / theta;
                 }
-                (*b)(i, j, k) -= uWeights(i, j, k) * input.u(i, j, k) * invH.x;
-            } else {
-                (*b)(i, j, k) -= input.u(i, j, k) * invH.x;
             }
 
             if (j + 1 < size.y) {
@@ -185,10 +260,6 @@ void buildSingleSystem(FdmMatrix3* A, FdmVector3* b,
                     theta = std::max(theta, 0.01);
                     row.center += term / theta;
                 }
-                (*b)(i, j, k) +=
-                    vWeights(i, j + 1, k) * input.v(i, j + 1, k) * invH.y;
-            } else {
-                (*b)(i, j, k) += input.v(i, j + 1, k) * invH.y;
             }
 
             if (j > 0) {
@@ -201,9 +272,6 @@ void buildSingleSystem(FdmMatrix3* A, FdmVector3* b,
                     theta = std::max(theta, 0.01);
                     row.center += term / theta;
                 }
-                (*b)(i, j, k) -= vWeights(i, j, k) * input.v(i, j, k) * invH.y;
-            } else {
-                (*b)(i, j, k) -= input.v(i, j, k) * invH.y;
             }
 
             if (k + 1 < size.z) {
@@ -217,10 +285,6 @@ void buildSingleSystem(FdmMatrix3* A, FdmVector3* b,
                     theta = std::max(theta, 0.01);
                     row.center += term / theta;
                 }
-                (*b)(i, j, k) +=
-                    wWeights(i, j, k + 1) * input.w(i, j, k + 1) * invH.z;
-            } else {
-                (*b)(i, j, k) += input.w(i, j, k + 1) * invH.z;
             }
 
             if (k > 0) {
@@ -233,36 +297,94 @@ void buildSingleSystem(FdmMatrix3* A, FdmVector3* b,
                     theta = std::max(theta, 0.01);
                     row.center += term / theta;
                 }
-                (*b)(i, j, k) -= wWeights(i, j, k) * input.w(i, j, k) * invH.z;
-            } else {
-                (*b)(i, j, k) -= input.w(i, j, k) * invH.z;
             }
 
-            // Accumulate contributions from the moving boundary
-            double boundaryContribution =
-                (1.0 - uWeights(i + 1, j, k)) *
-                    boundaryVel(uPos(i + 1, j, k)).x * invH.x -
-                (1.0 - uWeights(i, j, k)) * boundaryVel(uPos(i, j, k)).x *
-                    invH.x +
-                (1.0 - vWeights(i, j + 1, k)) *
-                    boundaryVel(vPos(i, j + 1, k)).y * invH.y -
-                (1.0 - vWeights(i, j, k)) * boundaryVel(vPos(i, j, k)).y *
-                    invH.y +
-                (1.0 - wWeights(i, j, k + 1)) *
-                    boundaryVel(wPos(i, j, k + 1)).z * invH.z -
-                (1.0 - wWeights(i, j, k)) * boundaryVel(wPos(i, j, k)).z *
-                    invH.z;
-            (*b)(i, j, k) += boundaryContribution;
-
             // If row.center is near-zero, the cell is likely inside a solid
             // boundary.
             if (row.center < kEpsilonD) {
                 row.center = 1.0;
-                (*b)(i, j, k) = 0.0;
+                (*markers)(i, j, k) = kBlockedRow;
+            } else {
+                (*markers)(i, j, k) = kFluidRow;
             }
         } else {
             row.center = 1.0;
+            (*markers)(i, j, k) = kAirRow;
+        }
+    });
+}
+
+void buildSingleRhs(FdmVector3* b, const Array3<char>& markers,
+                    const Array3<float>& uWeights,
+                    const Array3<float>& vWeights,
+                    const Array3<float>& wWeights,
+                    const std::function<Vector3D(const Vector3D&)>& boundaryVel,
+                    const FaceCenteredGrid3& input) {
+    const Size3 size = input.resolution();
+    const auto uPos = input.uPosition();
+    const auto vPos = input.vPosition();
+    const auto wPos = input.wPosition();
+
+    const Vector3D invH = 1.0 / input.gridSpacing();
+
+    b->parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        double bijk = 0.0;
+
+        if (markers(i, j, k) == kFluidRow) {
+            if (i + 1 < size.x) {
+                bijk += uWeights(i + 1, j, k) * input.u(i + 1, j, k) * invH.x;
+            } else {
+                bijk += input.u(i + 1, j, k) * invH.x;
+            }
+
+            if (i > 0) {
+                bijk -= uWeights(i, j, k) * input.u(i, j, k) * invH.x;
+            } else {
+                bijk -= input.u(i, j, k) * invH.x;
+            }
+
+            if (j + 1 < size.y) {
+                bijk += vWeights(i, j + 1, k) * input.v(i, j + 1, k) * invH.y;
+            } else {
+                bijk += input.v(i, j + 1, k) * invH.y;
+            }
+
+            if (j > 0) {
+                bijk -= vWeights(i, j, k) * input.v(i, j, k) * invH.y;
+            } else {
+                bijk -= input.v(i, j, k) * invH.y;
+            }
+
+            if (k + 1 < size.z) {
+                bijk += wWeights(i, j, k + 1) * input.w(i, j, k + 1) * invH.z;
+            } else {
+                bijk += input.w(i, j, k + 1) * invH.z;
+            }
+
+            if (k > 0) {
+                bijk -= wWeights(i, j, k) * input.w(i, j, k) * invH.z;
+            } else {
+                bijk -= input.w(i, j, k) * invH.z;
+            }
+
+            // Accumulate contributions from the moving boundary
+            double boundaryContribution =
+                boundaryFlux(uWeights(i + 1, j, k), uPos(i + 1, j, k), 0,
+                             boundaryVel) * invH.x -
+                boundaryFlux(uWeights(i, j, k), uPos(i, j, k), 0,
+                             boundaryVel) * invH.x +
+                boundaryFlux(vWeights(i, j + 1, k), vPos(i, j + 1, k), 1,
+                             boundaryVel) * invH.y -
+                boundaryFlux(vWeights(i, j, k), vPos(i, j, k), 1,
+                             boundaryVel) * invH.y +
+                boundaryFlux(wWeights(i, j, k + 1), wPos(i, j, k + 1), 2,
+                             boundaryVel) * invH.z -
+                boundaryFlux(wWeights(i, j, k), wPos(i, j, k), 2,
+                             boundaryVel) * invH.z;
+            bijk += boundaryContribution;
         }
+
+        (*b)(i, j, k) = bijk;
     });
 }
 
@@ -414,18 +536,18 @@ void buildSingleSystem(MatrixCsrD* A, VectorND* x, VectorND* b,
 
             // Accumulate contributions from the moving boundary
             double boundaryContribution =
-                (1.0 - uWeights(i + 1, j, k)) *
-                    boundaryVel(uPos(i + 1, j, k)).x * invH.x -
-                (1.0 - uWeights(i, j, k)) * boundaryVel(uPos(i, j, k)).x *
-                    invH.x +
-                (1.0 - vWeights(i, j + 1, k)) *
-                    boundaryVel(vPos(i, j + 1, k)).y * invH.y -
-                (1.0 - vWeights(i, j, k)) * boundaryVel(vPos(i, j, k)).y *
-                    invH.y +
-                (1.0 - wWeights(i, j, k + 1)) *
-                    boundaryVel(wPos(i, j, k + 1)).z * invH.z -
-                (1.0 - wWeights(i, j, k)) * boundaryVel(wPos(i, j, k)).z *
-                    invH.z;
+                boundaryFlux(uWeights(i + 1, j, k), uPos(i + 1, j, k), 0,
+                             boundaryVel) * invH.x -
+                boundaryFlux(uWeights(i, j, k), uPos(i, j, k), 0,
+                             boundaryVel) * invH.x +
+                boundaryFlux(vWeights(i, j + 1, k), vPos(i, j + 1, k), 1,
+                             boundaryVel) * invH.y -
+                boundaryFlux(vWeights(i, j, k), vPos(i, j, k), 1,
+                             boundaryVel) * invH.y +
+                boundaryFlux(wWeights(i, j, k + 1), wPos(i, j, k + 1), 2,
+                             boundaryVel) * invH.z -
+                boundaryFlux(wWeights(i, j, k), wPos(i, j, k), 2,
+                             boundaryVel) * invH.z;
             bijk += boundaryContribution;
 
             // If row.center is near-zero, the cell is likely inside a solid
@@ -460,8 +582,12 @@ void GridFractionalSinglePhasePressureSolver3::solve(
     bool useCompressed) {
     UNUSED_VARIABLE(timeIntervalInSeconds);
 
+    Timer timer;
     buildWeights(input, boundarySdf, boundaryVelocity, fluidSdf);
     buildSystem(input, useCompressed);
+    _lastBuildTimeInSeconds = timer.durationInSeconds();
+    JET_INFO << "Building pressure system took " << _lastBuildTimeInSeconds
+             << " seconds";
 
     if (_systemSolver != nullptr) {
         // Solve the system
@@ -517,10 +643,26 @@ const FdmVector3& GridFractionalSinglePhasePressureSolver3::pressure() const {
     }
 }
 
+double GridFractionalSinglePhasePressureSolver3::rebuildTolerance() const {
+    return _rebuildTolerance;
+}
+
+void GridFractionalSinglePhasePressureSolver3::setRebuildTolerance(
+    double tolerance) {
+    _rebuildTolerance = std::max(tolerance, 0.0);
+}
+
+double GridFractionalSinglePhasePressureSolver3::lastBuildTimeInSeconds()
+    const {
+    return _lastBuildTimeInSeconds;
+}
+
 void GridFractionalSinglePhasePressureSolver3::buildWeights(
     const FaceCenteredGrid3& input, const ScalarField3& boundarySdf,
     const VectorField3& boundaryVelocity, const ScalarField3& fluidSdf) {
     auto size = input.resolution();
+    const size_t prevNumLevels = _fluidSdf.size();
+    const Size3 prevSize = _fluidSdf.empty() ? Size3() : _fluidSdf[0].size();
 
     // Build levels
     size_t maxLevels = 1;
@@ -528,110 +670,124 @@ void GridFractionalSinglePhasePressureSolver3::buildWeights(
         maxLevels = _mgSystemSolver->params().maxNumberOfLevels;
     }
     FdmMgUtils3::resizeArrayWithFinest(size, maxLevels, &_fluidSdf);
+    FdmMgUtils3::resizeArrayWithFinest(size, maxLevels, &_fluidSdfFlags);
+    FdmMgUtils3::resizeArrayWithFinest(size, maxLevels, &_markers);
     _uWeights.resize(_fluidSdf.size());
     _vWeights.resize(_fluidSdf.size());
     _wWeights.resize(_fluidSdf.size());
+    _uWeightsChanged.resize(_fluidSdf.size());
+    _vWeightsChanged.resize(_fluidSdf.size());
+    _wWeightsChanged.resize(_fluidSdf.size());
     for (size_t l = 0; l < _fluidSdf.size(); ++l) {
         _uWeights[l].resize(_fluidSdf[l].size() + Size3(1, 0, 0));
         _vWeights[l].resize(_fluidSdf[l].size() + Size3(0, 1, 0));
         _wWeights[l].resize(_fluidSdf[l].size() + Size3(0, 0, 1));
+        _uWeightsChanged[l].resize(_uWeights[l].size());
+        _vWeightsChanged[l].resize(_vWeights[l].size());
+        _wWeightsChanged[l].resize(_wWeights[l].size());
     }
+    _boundarySdf.resize(size + Size3(1, 1, 1));
+    _boundarySdfChanged.resize(_boundarySdf.size());
+
+    // Everything is rebuilt if the grid has changed
+    Vector3D h = input.gridSpacing();
+    _isFullRebuild = _isFullRebuild || prevNumLevels != _fluidSdf.size() ||
+                     prevSize != size || h != _gridSpacing ||
+                     input.origin() != _gridOrigin;
+    _gridSpacing = h;
+    _gridOrigin = input.origin();
+    const bool rebuildAll = _isFullRebuild;
+    const double tolerance = _rebuildTolerance;
 
     // Build top-level grids
     auto cellPos = input.cellCenterPosition();
-    auto uPos = input.uPosition();
-    auto vPos = input.vPosition();
-    auto wPos = input.wPosition();
     _boundaryVel = boundaryVelocity.sampler();
-    Vector3D h = input.gridSpacing();
 
     _fluidSdf[0].parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        _fluidSdf[0](i, j, k) =
+        const float phi =
             static_cast<float>(fluidSdf.sample(cellPos(i, j, k)));
-    });
-
-    _uWeights[0].parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        Vector3D pt = uPos(i, j, k);
-        double phi0 =
-            boundarySdf.sample(pt + Vector3D(0.0, -0.5 * h.y, -0.5 * h.z));
-        double phi1 =
-            boundarySdf.sample(pt + Vector3D(0.0, 0.5 * h.y, -0.5 * h.z));
-        double phi2 =
-            boundarySdf.sample(pt + Vector3D(0.0, -0.5 * h.y, 0.5 * h.z));
-        double phi3 =
-            boundarySdf.sample(pt + Vector3D(0.0, 0.5 * h.y, 0.5 * h.z));
-        double frac = fractionInside(phi0, phi1, phi2, phi3);
-        double weight = clamp(1.0 - frac, 0.0, 1.0);
+        const float oldPhi = _fluidSdf[0](i, j, k);
 
-        // Clamp non-zero weight to kMinWeight. Having nearly-zero element
-        // in the matrix can be an issue.
-        if (weight < kMinWeight && weight > 0.0) {
-            weight = kMinWeight;
+        char flag = 0;
+        if (rebuildAll || isChanged(oldPhi, phi, tolerance)) {
+            flag = kSdfUpdated;
+            if (rebuildAll || isInsideSdf(oldPhi) != isInsideSdf(phi)) {
+                flag |= kSdfFlipped;
+            }
+            _fluidSdf[0](i, j, k) = phi;
         }
+        _fluidSdfFlags[0](i, j, k) = flag;
+    });
 
-        _uWeights[0](i, j, k) = static_cast<float>(weight);
+    // The corners of the faces are the cell corners, so the boundary SDF is
+    // sampled once per corner instead of four times per face.
+    const Vector3D origin = input.origin();
+    _boundarySdf.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        const double phi = boundarySdf.sample(origin + h * Vector3D(i, j, k));
+        if (rebuildAll || isChanged(_boundarySdf(i, j, k), phi, tolerance)) {
+            _boundarySdf(i, j, k) = phi;
+            _boundarySdfChanged(i, j, k) = 1;
+        } else {
+            _boundarySdfChanged(i, j, k) = 0;
+        }
     });
 
-    _vWeights[0].parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        Vector3D pt = vPos(i, j, k);
-        double phi0 =
-            boundarySdf.sample(pt + Vector3D(-0.5 * h.x, 0.0, -0.5 * h.z));
-        double phi1 =
-            boundarySdf.sample(pt + Vector3D(-0.5 * h.x, 0.0, 0.5 * h.z));
-        double phi2 =
-            boundarySdf.sample(pt + Vector3D(0.5 * h.x, 0.0, -0.5 * h.z));
-        double phi3 =
-            boundarySdf.sample(pt + Vector3D(0.5 * h.x, 0.0, 0.5 * h.z));
-        double frac = fractionInside(phi0, phi1, phi2, phi3);
-        double weight = clamp(1.0 - frac, 0.0, 1.0);
+    // Recomputes the weight of a face whose corners have changed and flags the
+    // face if the weight has changed.
+    auto updateWeight = [&](size_t i0, size_t j0, size_t k0, size_t i1,
+                            size_t j1, size_t k1, size_t i2, size_t j2,
+                            size_t k2, size_t i3, size_t j3, size_t k3,
+                            float* weight, char* changed) {
+        if (!rebuildAll && !_boundarySdfChanged(i0, j0, k0) &&
+            !_boundarySdfChanged(i1, j1, k1) &&
+            !_boundarySdfChanged(i2, j2, k2) &&
+            !_boundarySdfChanged(i3, j3, k3)) {
+            *changed = 0;
+            return;
+        }
+
+        double frac = fractionInside(
+            _boundarySdf(i0, j0, k0), _boundarySdf(i1, j1, k1),
+            _boundarySdf(i2, j2, k2), _boundarySdf(i3, j3, k3));
+        double newWeight = clamp(1.0 - frac, 0.0, 1.0);
 
         // Clamp non-zero weight to kMinWeight. Having nearly-zero element
         // in the matrix can be an issue.
-        if (weight < kMinWeight && weight > 0.0) {
-            weight = kMinWeight;
+        if (newWeight < kMinWeight && newWeight > 0.0) {
+            newWeight = kMinWeight;
         }
 
-        _vWeights[0](i, j, k) = static_cast<float>(weight);
-    });
+        const float w = static_cast<float>(newWeight);
+        *changed = rebuildAll || w != *weight;
+        *weight = w;
+    };
 
-    _wWeights[0].parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        Vector3D pt = wPos(i, j, k);
-        double phi0 =
-            boundarySdf.sample(pt + Vector3D(-0.5 * h.x, -0.5 * h.y, 0.0));
-        double phi1 =
-            boundarySdf.sample(pt + Vector3D(-0.5 * h.x, 0.5 * h.y, 0.0));
-        double phi2 =
-            boundarySdf.sample(pt + Vector3D(0.5 * h.x, -0.5 * h.y, 0.0));
-        double phi3 =
-            boundarySdf.sample(pt + Vector3D(0.5 * h.x, 0.5 * h.y, 0.0));
-        double frac = fractionInside(phi0, phi1, phi2, phi3);
-        double weight = clamp(1.0 - frac, 0.0, 1.0);
+    _uWeights[0].parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        updateWeight(i, j, k, i, j + 1, k, i, j, k + 1, i, j + 1, k + 1,
+                     &_uWeights[0](i, j, k), &_uWeightsChanged[0](i, j, k));
+    });
 
-        // Clamp non-zero weight to kMinWeight. Having nearly-zero element
-        // in the matrix can be an issue.
-        if (weight < kMinWeight && weight > 0.0) {
-            weight = kMinWeight;
-        }
+    _vWeights[0].parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        updateWeight(i, j, k, i, j, k + 1, i + 1, j, k, i + 1, j, k + 1,
+                     &_vWeights[0](i, j, k), &_vWeightsChanged[0](i, j, k));
+    });
 
-        _wWeights[0](i, j, k) = static_cast<float>(weight);
+    _wWeights[0].parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        updateWeight(i, j, k, i, j + 1, k, i + 1, j, k, i + 1, j + 1, k,
+                     &_wWeights[0](i, j, k), &_wWeightsChanged[0](i, j, k));
     });
 
+    markChangedCells(_fluidSdf[0], &_fluidSdfFlags[0]);
+
     // Build sub-levels
     for (size_t l = 1; l < _fluidSdf.size(); ++l) {
-        const auto& finerFluidSdf = _fluidSdf[l - 1];
-        auto& coarserFluidSdf = _fluidSdf[l];
-        const auto& finerUWeight = _uWeights[l - 1];
-        auto& coarserUWeight = _uWeights[l];
-        const auto& finerVWeight = _vWeights[l - 1];
-        auto& coarserVWeight = _vWeights[l];
-        const auto& finerWWeight = _wWeights[l - 1];
-        auto& coarserWWeight = _wWeights[l];
-
-        // Fluid SDF
-        restrict(finerFluidSdf, &coarserFluidSdf);
-        restrict(finerUWeight, &coarserUWeight);
-        restrict(finerVWeight, &coarserVWeight);
-        restrict(finerWWeight, &coarserWWeight);
+        restrictLevel({{&_fluidSdf[l - 1], &_uWeights[l - 1],
+                        &_vWeights[l - 1], &_wWeights[l - 1]}},
+                      {{&_fluidSdf[l], &_uWeights[l], &_vWeights[l],
+                        &_wWeights[l]}},
+                      {{&_fluidSdfFlags[l], &_uWeightsChanged[l],
+                        &_vWeightsChanged[l], &_wWeightsChanged[l]}});
+        markChangedCells(_fluidSdf[l], &_fluidSdfFlags[l]);
     }
 }
 
@@ -653,13 +809,22 @@ void GridFractionalSinglePhasePressureSolver3::buildSystem(
     Size3 size = input.resolution();
     size_t numLevels = 1;
 
+    // Rebuilds all the rows of the matrices which are not from the last build
+    bool rebuildAll = _isFullRebuild;
+    _isFullRebuild = false;
+
     if (_mgSystemSolver == nullptr) {
         if (!useCompressed) {
+            rebuildAll = rebuildAll || _isDenseSystemStale ||
+                         _system.A.size() != size;
+            _isDenseSystemStale = false;
             _system.resize(size);
         }
     } else {
         // Build levels
         size_t maxLevels = _mgSystemSolver->params().maxNumberOfLevels;
+        rebuildAll = rebuildAll || _mgSystem.A.levels.empty() ||
+                     _mgSystem.A.levels.front().size() != size;
         FdmMgUtils3::resizeArrayWithFinest(size, maxLevels,
                                            &_mgSystem.A.levels);
         FdmMgUtils3::resizeArrayWithFinest(size, maxLevels,
@@ -671,44 +836,45 @@ void GridFractionalSinglePhasePressureSolver3::buildSystem(
     }
 
     // Build top level
-    const FaceCenteredGrid3* finer = &input;
     if (_mgSystemSolver == nullptr) {
         if (useCompressed) {
             buildSingleSystem(&_compSystem.A, &_compSystem.x, &_compSystem.b,
                               _fluidSdf[0], _uWeights[0], _vWeights[0],
-                              _wWeights[0], _boundaryVel, *finer);
+                              _wWeights[0], _boundaryVel, input);
+
+            // Only the dense matrix misses the changes of this build. The
+            // weights and the SDFs are still tracked incrementally.
+            _isDenseSystemStale = true;
         } else {
-            buildSingleSystem(&_system.A, &_system.b, _fluidSdf[0],
+            buildSingleMatrix(&_system.A, &_markers[0], _fluidSdf[0],
                               _uWeights[0], _vWeights[0], _wWeights[0],
-                              _boundaryVel, *finer);
+                              _fluidSdfFlags[0], _uWeightsChanged[0],
+                              _vWeightsChanged[0], _wWeightsChanged[0],
+                              input.gridSpacing(), rebuildAll);
+            buildSingleRhs(&_system.b, _markers[0], _uWeights[0],
+                           _vWeights[0], _wWeights[0], _boundaryVel, input);
         }
     } else {
-        buildSingleSystem(&_mgSystem.A.levels.front(),
-                          &_mgSystem.b.levels.front(), _fluidSdf[0],
-                          _uWeights[0], _vWeights[0], _wWeights[0],
-                          _boundaryVel, *finer);
+        buildSingleMatrix(&_mgSystem.A.levels.front(), &_markers[0],
+                          _fluidSdf[0], _uWeights[0], _vWeights[0],
+                          _wWeights[0], _fluidSdfFlags[0], _uWeightsChanged[0],
+                          _vWeightsChanged[0], _wWeightsChanged[0],
+                          input.gridSpacing(), rebuildAll);
+        buildSingleRhs(&_mgSystem.b.levels.front(), _markers[0], _uWeights[0],
+                       _vWeights[0], _wWeights[0], _boundaryVel, input);
     }
 
-    // Build sub-levels
-    FaceCenteredGrid3 coarser;
+    // Build sub-levels. Only the matrices are needed since the multigrid
+    // cycle overwrites the coarser right-hand sides with the restricted
+    // residuals.
+    Vector3D h = input.gridSpacing();
     for (size_t l = 1; l < numLevels; ++l) {
-        auto res = finer->resolution();
-        auto h = finer->gridSpacing();
-        auto o = finer->origin();
-        res.x = res.x >> 1;
-        res.y = res.y >> 1;
-        res.z = res.z >> 1;
         h *= 2.0;
-
-        // Down sample
-        coarser.resize(res, h, o);
-        coarser.fill(finer->sampler());
-
-        buildSingleSystem(&_mgSystem.A.levels[l], &_mgSystem.b.levels[l],
-                          _fluidSdf[l], _uWeights[l], _vWeights[l],
-                          _wWeights[l], _boundaryVel, coarser);
-
-        finer = &coarser;
+        buildSingleMatrix(&_mgSystem.A.levels[l], &_markers[l], _fluidSdf[l],
+                          _uWeights[l], _vWeights[l], _wWeights[l],
+                          _fluidSdfFlags[l], _uWeightsChanged[l],
+                          _vWeightsChanged[l], _wWeightsChanged[l], h,
+                          rebuildAll);
     }
 }
 
@@ -0,0 +1,221 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <jet/grid_slab_decomposition3.h>
+#include <jet/parallel.h>
+
+#include <algorithm>
+
+using namespace jet;
+
+namespace {
+
+// Copies count z-layers starting from srcFirst to the layers starting from
+// dstFirst. A z-layer is contiguous in memory.
+void copyLayers(const ConstArrayAccessor3<double>& src, size_t srcFirst,
+                const ArrayAccessor3<double>& dst, size_t dstFirst,
+                size_t count) {
+    const size_t layerSize = src.width() * src.height();
+    JET_ASSERT(layerSize == dst.width() * dst.height());
+
+    std::copy(src.data() + srcFirst * layerSize,
+              src.data() + (srcFirst + count) * layerSize,
+              dst.data() + dstFirst * layerSize);
+}
+
+}  // namespace
+
+GridSlabDecomposition3::GridSlabDecomposition3() {}
+
+void GridSlabDecomposition3::resize(const Size3& resolution,
+                                    const Vector3D& gridSpacing,
+                                    const Vector3D& origin,
+                                    size_t numberOfSubdomains,
+                                    size_t numberOfGhostLayers,
+                                    size_t numberOfScalars) {
+    const size_t nz = resolution.z;
+    numberOfSubdomains =
+        std::max(std::min(numberOfSubdomains, nz), kOneSize);
+    numberOfGhostLayers = std::min(numberOfGhostLayers, nz);
+
+    if (!_subdomains.empty() && resolution == _resolution &&
+        gridSpacing == _gridSpacing && origin == _origin &&
+        numberOfSubdomains == _subdomains.size() &&
+        numberOfGhostLayers == _numberOfGhostLayers &&
+        numberOfScalars == _subdomains.front().scalars.size()) {
+        return;
+    }
+
+    _resolution = resolution;
+    _gridSpacing = gridSpacing;
+    _origin = origin;
+    _numberOfGhostLayers = numberOfGhostLayers;
+    _subdomains.clear();
+    _subdomains.resize(numberOfSubdomains);
+
+    for (size_t s = 0; s < numberOfSubdomains; ++s) {
+        Subdomain& sub = _subdomains[s];
+        sub.ownedBegin = s * nz / numberOfSubdomains;
+        sub.ownedEnd = (s + 1) * nz / numberOfSubdomains;
+        sub.begin = (sub.ownedBegin > numberOfGhostLayers)
+                        ? sub.ownedBegin - numberOfGhostLayers
+                        : 0;
+        sub.end = std::min(sub.ownedEnd + numberOfGhostLayers, nz);
+
+        const Size3 localResolution(resolution.x, resolution.y,
+                                    sub.end - sub.begin);
+        const Vector3D localOrigin =
+            origin + Vector3D(0, 0, sub.begin * gridSpacing.z);
+
+        sub.scalars.resize(numberOfScalars);
+        for (auto& grid : sub.scalars) {
+            grid = std::make_shared<CellCenteredScalarGrid3>(
+                localResolution, gridSpacing, localOrigin);
+        }
+        sub.velocity = std::make_shared<FaceCenteredGrid3>(
+            localResolution, gridSpacing, localOrigin);
+    }
+}
+
+const Size3& GridSlabDecomposition3::resolution() const { return _resolution; }
+
+size_t GridSlabDecomposition3::numberOfSubdomains() const {
+    return _subdomains.size();
+}
+
+size_t GridSlabDecomposition3::numberOfGhostLayers() const {
+    return _numberOfGhostLayers;
+}
+
+GridSlabDecomposition3::Subdomain& GridSlabDecomposition3::subdomain(
+    size_t i) {
+    return _subdomains[i];
+}
+
+const GridSlabDecomposition3::Subdomain& GridSlabDecomposition3::subdomain(
+    size_t i) const {
+    return _subdomains[i];
+}
+
+size_t GridSlabDecomposition3::ownerOf(size_t k) const {
+    auto iter = std::upper_bound(
+        _subdomains.begin(), _subdomains.end(), k,
+        [](size_t layer, const Subdomain& sub) {
+            return layer < sub.ownedBegin;
+        });
+    return static_cast<size_t>(iter - _subdomains.begin()) - 1;
+}
+
+void GridSlabDecomposition3::load(
+    const std::vector<CellCenteredScalarGrid3Ptr>& scalars,
+    const FaceCenteredGrid3& velocity) {
+    JET_ASSERT(velocity.resolution() == _resolution);
+
+    parallelFor(kZeroSize, _subdomains.size(), [&](size_t s) {
+        Subdomain& sub = _subdomains[s];
+        JET_ASSERT(scalars.size() == sub.scalars.size());
+
+        const size_t count = sub.ownedEnd - sub.ownedBegin;
+        const size_t offset = sub.ownedBegin - sub.begin;
+        for (size_t i = 0; i < scalars.size(); ++i) {
+            copyLayers(scalars[i]->constDataAccessor(), sub.ownedBegin,
+                       sub.scalars[i]->dataAccessor(), offset, count);
+        }
+        copyLayers(velocity.uConstAccessor(), sub.ownedBegin,
+                   sub.velocity->uAccessor(), offset, count);
+        copyLayers(velocity.vConstAccessor(), sub.ownedBegin,
+                   sub.velocity->vAccessor(), offset, count);
+
+        // The top-most w-face belongs to the last subdomain
+        const size_t wCount =
+            (sub.ownedEnd == _resolution.z) ? count + 1 : count;
+        copyLayers(velocity.wConstAccessor(), sub.ownedBegin,
+                   sub.velocity->wAccessor(), offset, wCount);
+    });
+}
+
+void GridSlabDecomposition3::exchangeGhostLayers() {
+    // Each subdomain only writes its own ghost layers and only reads the
+    // owned layers of the others.
+    parallelFor(kZeroSize, _subdomains.size(), [&](size_t s) {
+        Subdomain& sub = _subdomains[s];
+
+        auto copyGhostLayer = [&](size_t k, bool isWFaceOnly) {
+            const Subdomain& owner = _subdomains[ownerOf(k)];
+            const size_t srcLayer = k - owner.begin;
+            const size_t dstLayer = k - sub.begin;
+
+            copyLayers(owner.velocity->wConstAccessor(), srcLayer,
+                       sub.velocity->wAccessor(), dstLayer, 1);
+            if (isWFaceOnly) {
+                return;
+            }
+
+            for (size_t i = 0; i < sub.scalars.size(); ++i) {
+                copyLayers(owner.scalars[i]->constDataAccessor(), srcLayer,
+                           sub.scalars[i]->dataAccessor(), dstLayer, 1);
+            }
+            copyLayers(owner.velocity->uConstAccessor(), srcLayer,
+                       sub.velocity->uAccessor(), dstLayer, 1);
+            copyLayers(owner.velocity->vConstAccessor(), srcLayer,
+                       sub.velocity->vAccessor(), dstLayer, 1);
+        };
+
+        for (size_t k = sub.begin; k < sub.ownedBegin; ++k) {
+            copyGhostLayer(k, false);
+        }
+        for (size_t k = sub.ownedEnd; k < sub.end; ++k) {
+            copyGhostLayer(k, false);
+        }
+
+        // The w-face on top of the local grids is a ghost unless it is the
+        // top-most face of the domain.
+        if (sub.end < _resolution.z) {
+            copyGhostLayer(sub.end, true);
+        }
+    });
+}
+
+void GridSlabDecomposition3::store(
+    const std::vector<CellCenteredScalarGrid3Ptr>& scalars,
+    FaceCenteredGrid3* velocity) const {
+    JET_ASSERT(velocity->resolution() == _resolution);
+
+    parallelFor(kZeroSize, _subdomains.size(), [&](size_t s) {
+        const Subdomain& sub = _subdomains[s];
+        JET_ASSERT(scalars.size() == sub.scalars.size());
+
+        const size_t count = sub.ownedEnd - sub.ownedBegin;
+        const size_t offset = sub.ownedBegin - sub.begin;
+        for (size_t i = 0; i < scalars.size(); ++i) {
+            copyLayers(sub.scalars[i]->constDataAccessor(), offset,
+                       scalars[i]->dataAccessor(), sub.ownedBegin, count);
+        }
+        copyLayers(sub.velocity->uConstAccessor(), offset,
+                   velocity->uAccessor(), sub.ownedBegin, count);
+        copyLayers(sub.velocity->vConstAccessor(), offset,
+                   velocity->vAccessor(), sub.ownedBegin, count);
+
+        const size_t wCount =
+            (sub.ownedEnd == _resolution.z) ? count + 1 : count;
+        copyLayers(sub.velocity->wConstAccessor(), offset,
+                   velocity->wAccessor(), sub.ownedBegin, wCount);
+    });
+}
+
+void GridSlabDecomposition3::forEachSubdomain(
+    const std::function<void(Subdomain&)>& func) {
+    parallelFor(kZeroSize, _subdomains.size(), [&](size_t s) {
+        // A single subdomain runs on the calling thread, so its limit is
+        // restored
+        const unsigned int prevLimit = maxNumberOfThreadsForCurrentThread();
+        setMaxNumberOfThreadsForCurrentThread(1);
+        func(_subdomains[s]);
+        setMaxNumberOfThreadsForCurrentThread(prevLimit);
+    });
+}
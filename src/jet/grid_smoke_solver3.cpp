@@ -6,12 +6,109 @@
 
 #include <pch.h>
 
+#include <jet/fdm_schwarz_pcg_solver3.h>
+#include <jet/grid_backward_euler_diffusion_solver3.h>
+#include <jet/grid_fractional_single_phase_pressure_solver3.h>
+#include <jet/grid_single_phase_pressure_solver3.h>
 #include <jet/grid_smoke_solver3.h>
 
 #include <algorithm>
 
 using namespace jet;
 
+namespace {
+
+// Same as the defaults of the pressure and diffusion solvers
+const unsigned int kMaxNumberOfIterations = 100;
+const double kPressureTolerance = 1e-6;
+const double kDiffusionTolerance = kEpsilonD;
+
+// Cubic sampler stencil reaches two more layers, plus one for the rounding
+const size_t kNumberOfExtraGhostLayers = 3;
+
+FdmLinearSystemSolver3Ptr linearSystemSolverOf(
+    const GridPressureSolver3Ptr& solver) {
+    auto fractionalSolver =
+        std::dynamic_pointer_cast<GridFractionalSinglePhasePressureSolver3>(
+            solver);
+    if (fractionalSolver != nullptr) {
+        return fractionalSolver->linearSystemSolver();
+    }
+
+    auto singlePhaseSolver =
+        std::dynamic_pointer_cast<GridSinglePhasePressureSolver3>(solver);
+    if (singlePhaseSolver != nullptr) {
+        return singlePhaseSolver->linearSystemSolver();
+    }
+    return nullptr;
+}
+
+void setLinearSystemSolverOf(const GridPressureSolver3Ptr& solver,
+                             const FdmLinearSystemSolver3Ptr& systemSolver) {
+    auto fractionalSolver =
+        std::dynamic_pointer_cast<GridFractionalSinglePhasePressureSolver3>(
+            solver);
+    if (fractionalSolver != nullptr) {
+        fractionalSolver->setLinearSystemSolver(systemSolver);
+    }
+
+    auto singlePhaseSolver =
+        std::dynamic_pointer_cast<GridSinglePhasePressureSolver3>(solver);
+    if (singlePhaseSolver != nullptr) {
+        singlePhaseSolver->setLinearSystemSolver(systemSolver);
+    }
+}
+
+FdmLinearSystemSolver3Ptr linearSystemSolverOf(
+    const GridDiffusionSolver3Ptr& solver) {
+    auto backwardEulerSolver =
+        std::dynamic_pointer_cast<GridBackwardEulerDiffusionSolver3>(solver);
+    if (backwardEulerSolver != nullptr) {
+        return backwardEulerSolver->linearSystemSolver();
+    }
+    return nullptr;
+}
+
+void setLinearSystemSolverOf(const GridDiffusionSolver3Ptr& solver,
+                             const FdmLinearSystemSolver3Ptr& systemSolver) {
+    auto backwardEulerSolver =
+        std::dynamic_pointer_cast<GridBackwardEulerDiffusionSolver3>(solver);
+    if (backwardEulerSolver != nullptr) {
+        backwardEulerSolver->setLinearSystemSolver(systemSolver);
+    }
+}
+
+// Installs the Schwarz solver when the mode turns on or when the installed
+// one is still in use, and puts the previous solver back when the mode turns
+// off. A solver set by the user in the meantime is left as it is.
+template <typename SolverPtr>
+void updateLinearSystemSolver(const SolverPtr& solver, bool wasDecomposed,
+                              size_t numberOfSubdomains, double tolerance,
+                              FdmLinearSystemSolver3Ptr* installed,
+                              FdmLinearSystemSolver3Ptr* previous) {
+    const FdmLinearSystemSolver3Ptr current = linearSystemSolverOf(solver);
+
+    if (numberOfSubdomains > 1) {
+        if (!wasDecomposed) {
+            *previous = current;
+        }
+        if (!wasDecomposed || current == *installed) {
+            *installed = std::make_shared<FdmSchwarzPcgSolver3>(
+                kMaxNumberOfIterations, tolerance,
+                static_cast<unsigned int>(numberOfSubdomains));
+            setLinearSystemSolverOf(solver, *installed);
+        }
+    } else if (wasDecomposed) {
+        if (current == *installed) {
+            setLinearSystemSolverOf(solver, *previous);
+        }
+        *installed = nullptr;
+        *previous = nullptr;
+    }
+}
+
+}  // namespace
+
 GridSmokeSolver3::GridSmokeSolver3()
     : GridSmokeSolver3({1, 1, 1}, {1, 1, 1}, {0, 0, 0}) {}
 
@@ -74,6 +171,24 @@ void GridSmokeSolver3::setTemperatureDecayFactor(double newValue) {
     _temperatureDecayFactor = clamp(newValue, 0.0, 1.0);
 }
 
+size_t GridSmokeSolver3::numberOfSubdomains() const {
+    return _numberOfSubdomains;
+}
+
+void GridSmokeSolver3::setNumberOfSubdomains(size_t numberOfSubdomains) {
+    const bool wasDecomposed = _numberOfSubdomains > 1;
+    _numberOfSubdomains = numberOfSubdomains;
+
+    updateLinearSystemSolver(pressureSolver(), wasDecomposed,
+                             _numberOfSubdomains, kPressureTolerance,
+                             &_schwarzPressureSystemSolver,
+                             &_prevPressureSystemSolver);
+    updateLinearSystemSolver(diffusionSolver(), wasDecomposed,
+                             _numberOfSubdomains, kDiffusionTolerance,
+                             &_schwarzDiffusionSystemSolver,
+                             &_prevDiffusionSystemSolver);
+}
+
 ScalarGrid3Ptr GridSmokeSolver3::smokeDensity() const {
     return gridSystemData()->advectableScalarDataAt(_smokeDensityDataId);
 }
@@ -90,36 +205,124 @@ void GridSmokeSolver3::computeExternalForces(double timeIntervalInSeconds) {
     computeBuoyancyForce(timeIntervalInSeconds);
 }
 
-void GridSmokeSolver3::computeDiffusion(double timeIntervalInSeconds) {
-    if (diffusionSolver() != nullptr) {
-        if (_smokeDiffusionCoefficient > kEpsilonD) {
-            auto den = smokeDensity();
-            auto den0 = std::dynamic_pointer_cast<CellCenteredScalarGrid3>(
-                den->clone());
-
-            diffusionSolver()->solve(*den0, _smokeDiffusionCoefficient,
-                                     timeIntervalInSeconds, den.get(),
-                                     *colliderSdf());
-            extrapolateIntoCollider(den.get());
+void GridSmokeSolver3::computeAdvection(double timeIntervalInSeconds) {
+    auto grids = gridSystemData();
+    auto vel = velocity();
+    const Size3 res = resolution();
+
+    std::vector<CellCenteredScalarGrid3Ptr> scalars;
+    bool isDecomposable = _numberOfSubdomains > 1 && res.z > 1 &&
+                          advectionSolver() != nullptr &&
+                          grids->numberOfAdvectableVectorData() == 1;
+    for (size_t i = 0; isDecomposable &&
+                       i < grids->numberOfAdvectableScalarData();
+         ++i) {
+        auto grid = std::dynamic_pointer_cast<CellCenteredScalarGrid3>(
+            grids->advectableScalarDataAt(i));
+        isDecomposable = grid != nullptr;
+        scalars.push_back(grid);
+    }
+
+    if (!isDecomposable) {
+        GridFluidSolver3::computeAdvection(timeIntervalInSeconds);
+        return;
+    }
+
+    // The ghost layers should cover the z-distance of the back-trace. The
+    // number only grows so the local grids are not reallocated every step.
+    auto w = vel->wConstAccessor();
+    const Size3 wSize = w.size();
+    const double maxW = parallelReduce(
+        kZeroSize, wSize.z, 0.0,
+        [&](size_t kBegin, size_t kEnd, double result) {
+            for (size_t k = kBegin; k < kEnd; ++k) {
+                for (size_t j = 0; j < wSize.y; ++j) {
+                    for (size_t i = 0; i < wSize.x; ++i) {
+                        result = std::max(result, std::fabs(w(i, j, k)));
+                    }
+                }
+            }
+            return result;
+        },
+        [](double a, double b) { return std::max(a, b); });
+    const size_t numberOfGhostLayers = std::max(
+        static_cast<size_t>(
+            std::ceil(maxW * timeIntervalInSeconds / gridSpacing().z)) +
+            kNumberOfExtraGhostLayers,
+        _slabs.numberOfGhostLayers());
+
+    _slabs.resize(res, gridSpacing(), gridOrigin(), _numberOfSubdomains,
+                  numberOfGhostLayers, scalars.size());
+    _slabs.load(scalars, *vel);
+    _slabs.exchangeGhostLayers();
+
+    const AdvectionSolver3Ptr& solver = advectionSolver();
+    ScalarField3Ptr boundarySdf = colliderSdf();
+    _slabs.forEachSubdomain([&](GridSlabDecomposition3::Subdomain& sub) {
+        // Scalars first, since they are advected by the velocity at the
+        // beginning of the advection
+        for (auto& grid : sub.scalars) {
+            auto grid0 = grid->clone();
+            solver->advect(*grid0, *sub.velocity, timeIntervalInSeconds,
+                           grid.get(), *boundarySdf);
         }
 
-        if (_temperatureDiffusionCoefficient > kEpsilonD) {
-            auto temp = smokeDensity();
-            auto temp0 = std::dynamic_pointer_cast<CellCenteredScalarGrid3>(
-                temp->clone());
+        auto vel0 =
+            std::dynamic_pointer_cast<FaceCenteredGrid3>(sub.velocity->clone());
+        solver->advect(*vel0, *vel0, timeIntervalInSeconds,
+                       sub.velocity.get(), *boundarySdf);
+    });
 
-            diffusionSolver()->solve(*temp0, _temperatureDiffusionCoefficient,
-                                     timeIntervalInSeconds, temp.get(),
-                                     *colliderSdf());
+    _slabs.store(scalars, vel.get());
+
+    for (auto& grid : scalars) {
+        extrapolateIntoCollider(grid.get());
+    }
+    applyBoundaryCondition();
+}
+
+void GridSmokeSolver3::computeDiffusion(double timeIntervalInSeconds) {
+    auto den = smokeDensity();
+    auto temp = temperature();
+
+    if (diffusionSolver() != nullptr) {
+        if (_smokeDiffusionCoefficient > kEpsilonD &&
+            _smokeDiffusionCoefficient == _temperatureDiffusionCoefficient) {
+            // Both fields share the same linear system
+            auto den0 = den->clone();
+            auto temp0 = temp->clone();
+
+            diffusionSolver()->solveMultiple(
+                {den0.get(), temp0.get()}, _smokeDiffusionCoefficient,
+                timeIntervalInSeconds, {den.get(), temp.get()},
+                *colliderSdf());
+            extrapolateIntoCollider(den.get());
             extrapolateIntoCollider(temp.get());
+        } else {
+            if (_smokeDiffusionCoefficient > kEpsilonD) {
+                auto den0 = den->clone();
+
+                diffusionSolver()->solve(*den0, _smokeDiffusionCoefficient,
+                                         timeIntervalInSeconds, den.get(),
+                                         *colliderSdf());
+                extrapolateIntoCollider(den.get());
+            }
+
+            if (_temperatureDiffusionCoefficient > kEpsilonD) {
+                auto temp0 = temp->clone();
+
+                diffusionSolver()->solve(*temp0,
+                                         _temperatureDiffusionCoefficient,
+                                         timeIntervalInSeconds, temp.get(),
+                                         *colliderSdf());
+                extrapolateIntoCollider(temp.get());
+            }
         }
     }
 
-    auto den = smokeDensity();
     den->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
         (*den)(i, j, k) *= 1.0 - _smokeDecayFactor;
     });
-    auto temp = temperature();
     temp->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
         (*temp)(i, j, k) *= 1.0 - _temperatureDecayFactor;
     });
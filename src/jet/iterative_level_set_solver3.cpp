@@ -8,14 +8,71 @@
 #include <jet/array_utils.h>
 #include <jet/fdm_utils.h>
 #include <jet/iterative_level_set_solver3.h>
+#include <jet/level_set_utils.h>
 #include <jet/parallel.h>
 
 #include <algorithm>
 #include <limits>
 #include <utility>  // just make cpplint happy..
+#include <vector>
 
 using namespace jet;
 
+namespace {
+
+const size_t kMaxRowStencilHalfWidth = 3;
+
+struct BandRow {
+    size_t iBegin;
+    size_t iEnd;
+    size_t j;
+    size_t k;
+};
+
+// Marks the points along the given axis which are within radius points from
+// a marked input point.
+void dilateAlongAxis(const Array3<char>& input, size_t axis, size_t radius,
+                     Array3<char>* output) {
+    const Size3 size = input.size();
+    const size_t n = size[axis];
+    const size_t uAxis = (axis + 1) % 3;
+    const size_t vAxis = (axis + 2) % 3;
+    const size_t nu = size[uAxis];
+    const size_t nv = size[vAxis];
+    const size_t stride = (axis == 0) ? 1 : (axis == 1) ? size.x
+                                                        : size.x * size.y;
+
+    parallelFor(kZeroSize, nu * nv, [&](size_t line) {
+        Size3 pt;
+        pt[axis] = 0;
+        pt[uAxis] = line % nu;
+        pt[vAxis] = line / nu;
+        const size_t first = pt.x + size.x * (pt.y + size.y * pt.z);
+        const char* in = input.data() + first;
+        char* out = output->data() + first;
+
+        // Distances to the closest marked points on each side
+        size_t last = kMaxSize;
+        for (size_t t = 0; t < n; ++t) {
+            if (in[t * stride]) {
+                last = t;
+            }
+            out[t * stride] = (last != kMaxSize && t - last <= radius);
+        }
+        last = kMaxSize;
+        for (size_t t = n; t-- > 0;) {
+            if (in[t * stride]) {
+                last = t;
+            }
+            if (last != kMaxSize && last - t <= radius) {
+                out[t * stride] = 1;
+            }
+        }
+    });
+}
+
+}  // namespace
+
 IterativeLevelSetSolver3::IterativeLevelSetSolver3() {
 }
 
@@ -32,54 +89,191 @@ void IterativeLevelSetSolver3::reinitialize(
     JET_THROW_INVALID_ARG_IF(!inputSdf.hasSameShape(*outputSdf));
 
     ArrayAccessor3<double> outputAcc = outputSdf->dataAccessor();
+    ConstArrayAccessor3<double> inputAcc = inputSdf.constDataAccessor();
 
-    const double dtau = pseudoTimeStep(
-        inputSdf.constDataAccessor(), gridSpacing);
+    const double dtau = pseudoTimeStep(inputAcc, gridSpacing);
     const unsigned int numberOfIterations
         = distanceToNumberOfIterations(maxDistance, dtau);
 
-    copyRange3(
-        inputSdf.constDataAccessor(), size.x, size.y, size.z, &outputAcc);
+    copyRange3(inputAcc, size.x, size.y, size.z, &outputAcc);
+
+    // Only the points within the requested distance from the interface (plus
+    // a grid cell so that the band boundary sees the updated neighbors) are
+    // iterated. The rest keep the input values. The input values are not
+    // distances before the reinitialization, so the band is found by dilating
+    // the points next to a sign change. The band is stored as runs along the
+    // i-rows.
+    Array3<char> marks(size), buffer(size);
+    marks.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        const bool inside = isInsideSdf(inputAcc(i, j, k));
+        marks(i, j, k)
+            = inputAcc(i, j, k) == 0.0
+            || (i > 0 && isInsideSdf(inputAcc(i - 1, j, k)) != inside)
+            || (i + 1 < size.x && isInsideSdf(inputAcc(i + 1, j, k)) != inside)
+            || (j > 0 && isInsideSdf(inputAcc(i, j - 1, k)) != inside)
+            || (j + 1 < size.y && isInsideSdf(inputAcc(i, j + 1, k)) != inside)
+            || (k > 0 && isInsideSdf(inputAcc(i, j, k - 1)) != inside)
+            || (k + 1 < size.z && isInsideSdf(inputAcc(i, j, k + 1)) != inside);
+    });
+    for (size_t axis = 0; axis < 3; ++axis) {
+        const double cells = std::ceil(maxDistance / gridSpacing[axis]) + 1.0;
+        const size_t radius = (cells < static_cast<double>(size[axis]))
+                                  ? static_cast<size_t>(cells)
+                                  : size[axis];
+        dilateAlongAxis(marks, axis, radius, &buffer);
+        marks.swap(buffer);
+    }
+
+    std::vector<BandRow> band;
+    size_t bandSize = 0;
+    for (size_t k = 0; k < size.z; ++k) {
+        for (size_t j = 0; j < size.y; ++j) {
+            size_t i = 0;
+            while (i < size.x) {
+                if (!marks(i, j, k)) {
+                    ++i;
+                    continue;
+                }
+
+                BandRow row;
+                row.iBegin = i;
+                row.j = j;
+                row.k = k;
+                while (i < size.x && marks(i, j, k)) {
+                    ++i;
+                }
+                row.iEnd = i;
+                band.push_back(row);
+                bandSize += row.iEnd - row.iBegin;
+            }
+        }
+    }
 
+    // The two buffers share the values outside the band, so each iteration
+    // only writes the band points of the other buffer.
     Array3<double> temp(size);
     ArrayAccessor3<double> tempAcc = temp.accessor();
+    copyRange3(inputAcc, size.x, size.y, size.z, &tempAcc);
 
     JET_INFO << "Reinitializing with pseudoTimeStep: " << dtau
-             << " numberOfIterations: " << numberOfIterations;
+             << " maxNumberOfIterations: " << numberOfIterations
+             << " bandSize: " << bandSize;
+
+    // Computes next = prev - dtau * s * (|grad prev| - 1) for the band and
+    // returns the max residual
+    auto eulerStep = [&](ConstArrayAccessor3<double> prevAcc,
+                         ArrayAccessor3<double> nextAcc) {
+        return parallelReduce(
+            kZeroSize, band.size(), 0.0,
+            [&](size_t begin, size_t end, double residual) {
+                // Minus- and plus-side derivatives of a row for each axis
+                std::vector<double> derivatives(6 * size.x);
+                double* dxm = derivatives.data();
+                double* dxp = dxm + size.x;
+                double* dym = dxp + size.x;
+                double* dyp = dym + size.x;
+                double* dzm = dyp + size.x;
+                double* dzp = dzm + size.x;
+
+                for (size_t b = begin; b < end; ++b) {
+                    const BandRow& row = band[b];
+                    const size_t j = row.j;
+                    const size_t k = row.k;
+
+                    getRowDerivatives(
+                        prevAcc, gridSpacing, row.iBegin, row.iEnd, j, k,
+                        {{dxm, dxp}}, {{dym, dyp}}, {{dzm, dzp}});
+
+                    for (size_t i = row.iBegin; i < row.iEnd; ++i) {
+                        const size_t r = i - row.iBegin;
+                        double s = sign(prevAcc, gridSpacing, i, j, k);
+
+                        double delta
+                            = std::max(s, 0.0)
+                                * (std::sqrt(square(std::max(dxm[r], 0.0))
+                                           + square(std::min(dxp[r], 0.0))
+                                           + square(std::max(dym[r], 0.0))
+                                           + square(std::min(dyp[r], 0.0))
+                                           + square(std::max(dzm[r], 0.0))
+                                           + square(std::min(dzp[r], 0.0)))
+                                   - 1.0)
+                            + std::min(s, 0.0)
+                                * (std::sqrt(square(std::min(dxm[r], 0.0))
+                                           + square(std::max(dxp[r], 0.0))
+                                           + square(std::min(dym[r], 0.0))
+                                           + square(std::max(dyp[r], 0.0))
+                                           + square(std::min(dzm[r], 0.0))
+                                           + square(std::max(dzp[r], 0.0)))
+                                   - 1.0);
+                        nextAcc(i, j, k) = prevAcc(i, j, k) - dtau * delta;
+
+                        residual = std::max(residual, std::fabs(delta));
+                    }
+                }
+                return residual;
+            },
+            [](double a, double b) { return std::max(a, b); });
+    };
+
+    // Computes out = a * u + b * v for the band
+    auto combine = [&](double a, ConstArrayAccessor3<double> u, double b,
+                       ConstArrayAccessor3<double> v,
+                       ArrayAccessor3<double> out) {
+        parallelFor(kZeroSize, band.size(), [&](size_t r) {
+            const BandRow& row = band[r];
+            for (size_t i = row.iBegin; i < row.iEnd; ++i) {
+                out(i, row.j, row.k)
+                    = a * u(i, row.j, row.k) + b * v(i, row.j, row.k);
+            }
+        });
+    };
+
+    // Third buffer for the intermediate stages of TVD Runge-Kutta
+    Array3<double> stage;
+    ArrayAccessor3<double> stageAcc;
+    if (_isTvdRungeKutta3Enabled) {
+        stage.resize(size);
+        stageAcc = stage.accessor();
+        copyRange3(inputAcc, size.x, size.y, size.z, &stageAcc);
+    }
 
-    for (unsigned int n = 0; n < numberOfIterations; ++n) {
-        inputSdf.parallelForEachDataPointIndex(
-            [&](size_t i, size_t j, size_t k) {
-                double s = sign(outputAcc, gridSpacing, i, j, k);
-
-                std::array<double, 2> dx, dy, dz;
-
-                getDerivatives(outputAcc, gridSpacing, i, j, k, &dx, &dy, &dz);
-
-                // Explicit Euler step
-                double val = outputAcc(i, j, k)
-                    - dtau * std::max(s, 0.0)
-                        * (std::sqrt(square(std::max(dx[0], 0.0))
-                                   + square(std::min(dx[1], 0.0))
-                                   + square(std::max(dy[0], 0.0))
-                                   + square(std::min(dy[1], 0.0))
-                                   + square(std::max(dz[0], 0.0))
-                                   + square(std::min(dz[1], 0.0))) - 1.0)
-                    - dtau * std::min(s, 0.0)
-                        * (std::sqrt(square(std::min(dx[0], 0.0))
-                                   + square(std::max(dx[1], 0.0))
-                                   + square(std::min(dy[0], 0.0))
-                                   + square(std::max(dy[1], 0.0))
-                                   + square(std::min(dz[0], 0.0))
-                                   + square(std::max(dz[1], 0.0))) - 1.0);
-                tempAcc(i, j, k) = val;
-            });
+    ArrayAccessor3<double> prevAcc = outputAcc;
+    ArrayAccessor3<double> nextAcc = tempAcc;
+
+    unsigned int n = 0;
+    while (n < numberOfIterations) {
+        double maxResidual;
+
+        if (_isTvdRungeKutta3Enabled) {
+            // Shu-Osher form which keeps the result in prevAcc
+            maxResidual = eulerStep(prevAcc, nextAcc);
+            eulerStep(nextAcc, stageAcc);
+            combine(0.75, prevAcc, 0.25, stageAcc, nextAcc);
+            eulerStep(nextAcc, stageAcc);
+            combine(1.0 / 3.0, prevAcc, 2.0 / 3.0, stageAcc, prevAcc);
+        } else {
+            // Explicit Euler step
+            maxResidual = eulerStep(prevAcc, nextAcc);
+            std::swap(prevAcc, nextAcc);
+        }
+        ++n;
 
-        std::swap(tempAcc, outputAcc);
+        if (maxResidual <= _residualTolerance) {
+            break;
+        }
     }
 
-    auto outputSdfAcc = outputSdf->dataAccessor();
-    copyRange3(outputAcc, size.x, size.y, size.z, &outputSdfAcc);
+    JET_INFO << "Reinitialization finished after " << n << " iterations";
+
+    // Copies the band back if the last iteration ended up in the temp buffer
+    if (prevAcc.data() != outputAcc.data()) {
+        parallelFor(kZeroSize, band.size(), [&](size_t b) {
+            const BandRow& row = band[b];
+            for (size_t i = row.iBegin; i < row.iEnd; ++i) {
+                outputAcc(i, row.j, row.k) = prevAcc(i, row.j, row.k);
+            }
+        });
+    }
 }
 
 void IterativeLevelSetSolver3::extrapolate(
@@ -231,27 +425,42 @@ void IterativeLevelSetSolver3::extrapolate(
     ArrayAccessor3<double> tempAcc = temp.accessor();
 
     for (unsigned int n = 0; n < numberOfIterations; ++n) {
-        parallelFor(
-            kZeroSize, size.x, kZeroSize, size.y, kZeroSize, size.z,
-            [&](size_t i, size_t j, size_t k) {
-                if (sdf(i, j, k) >= 0) {
-                    std::array<double, 2> dx, dy, dz;
-                    Vector3D grad = gradient3(sdf, gridSpacing, i, j, k);
-
-                    getDerivatives(
-                        outputAcc, gridSpacing, i, j, k, &dx, &dy, &dz);
-
-                    tempAcc(i, j, k) = outputAcc(i, j, k)
-                        - dtau * (std::max(grad.x, 0.0) * dx[0]
-                                + std::min(grad.x, 0.0) * dx[1]
-                                + std::max(grad.y, 0.0) * dy[0]
-                                + std::min(grad.y, 0.0) * dy[1]
-                                + std::max(grad.z, 0.0) * dz[0]
-                                + std::min(grad.z, 0.0) * dz[1]);
-                } else {
-                    tempAcc(i, j, k) = outputAcc(i, j, k);
+        parallelRangeFor(
+            kZeroSize, size.y, kZeroSize, size.z,
+            [&](size_t jBegin, size_t jEnd, size_t kBegin, size_t kEnd) {
+                std::vector<double> derivatives(6 * size.x);
+                double* dxm = derivatives.data();
+                double* dxp = dxm + size.x;
+                double* dym = dxp + size.x;
+                double* dyp = dym + size.x;
+                double* dzm = dyp + size.x;
+                double* dzp = dzm + size.x;
+
+                for (size_t k = kBegin; k < kEnd; ++k) {
+                    for (size_t j = jBegin; j < jEnd; ++j) {
+                        getRowDerivatives(
+                            outputAcc, gridSpacing, 0, size.x, j, k,
+                            {{dxm, dxp}}, {{dym, dyp}}, {{dzm, dzp}});
+
+                        for (size_t i = 0; i < size.x; ++i) {
+                            if (sdf(i, j, k) >= 0) {
+                                Vector3D grad
+                                    = gradient3(sdf, gridSpacing, i, j, k);
+
+                                tempAcc(i, j, k) = outputAcc(i, j, k)
+                                    - dtau * (std::max(grad.x, 0.0) * dxm[i]
+                                            + std::min(grad.x, 0.0) * dxp[i]
+                                            + std::max(grad.y, 0.0) * dym[i]
+                                            + std::min(grad.y, 0.0) * dyp[i]
+                                            + std::max(grad.z, 0.0) * dzm[i]
+                                            + std::min(grad.z, 0.0) * dzp[i]);
+                            } else {
+                                tempAcc(i, j, k) = outputAcc(i, j, k);
+                            }
+                        }
+                    }
                 }
-          });
+            });
 
         std::swap(tempAcc, outputAcc);
     }
@@ -259,6 +468,113 @@ void IterativeLevelSetSolver3::extrapolate(
     copyRange3(outputAcc, size.x, size.y, size.z, &output);
 }
 
+void IterativeLevelSetSolver3::getRowDerivatives(
+    ConstArrayAccessor3<double> grid,
+    const Vector3D& gridSpacing,
+    size_t iBegin,
+    size_t iEnd,
+    size_t j,
+    size_t k,
+    std::array<double*, 2> dx,
+    std::array<double*, 2> dy,
+    std::array<double*, 2> dz) const {
+    for (size_t i = iBegin; i < iEnd; ++i) {
+        std::array<double, 2> dxi, dyi, dzi;
+        getDerivatives(grid, gridSpacing, i, j, k, &dxi, &dyi, &dzi);
+
+        const size_t r = i - iBegin;
+        dx[0][r] = dxi[0];
+        dx[1][r] = dxi[1];
+        dy[0][r] = dyi[0];
+        dy[1][r] = dyi[1];
+        dz[0][r] = dzi[0];
+        dz[1][r] = dzi[1];
+    }
+}
+
+void IterativeLevelSetSolver3::getRowStencils(
+    ConstArrayAccessor3<double> grid,
+    size_t iBegin,
+    size_t j,
+    size_t k,
+    size_t halfWidth,
+    const double** y,
+    const double** z) {
+    const Size3 size = grid.size();
+
+    for (size_t m = 0; m <= 2 * halfWidth; ++m) {
+        const size_t jm = (j + m < halfWidth)
+            ? 0 : std::min(j + m - halfWidth, size.y - 1);
+        const size_t km = (k + m < halfWidth)
+            ? 0 : std::min(k + m - halfWidth, size.z - 1);
+        y[m] = &grid(iBegin, jm, k);
+        z[m] = &grid(iBegin, j, km);
+    }
+}
+
+void IterativeLevelSetSolver3::computeRowDerivatives(
+    ConstArrayAccessor3<double> grid,
+    const Vector3D& gridSpacing,
+    size_t iBegin,
+    size_t iEnd,
+    size_t j,
+    size_t k,
+    size_t halfWidth,
+    RowDerivativeKernel kernel,
+    std::array<double*, 2> dx,
+    std::array<double*, 2> dy,
+    std::array<double*, 2> dz) {
+    JET_ASSERT(halfWidth <= kMaxRowStencilHalfWidth);
+
+    const Size3 size = grid.size();
+    const size_t n = iEnd - iBegin;
+    const size_t width = 2 * halfWidth + 1;
+
+    const double* D0y[2 * kMaxRowStencilHalfWidth + 1];
+    const double* D0z[2 * kMaxRowStencilHalfWidth + 1];
+    getRowStencils(grid, iBegin, j, k, halfWidth, D0y, D0z);
+
+    kernel(D0y, n, gridSpacing.y, dy[0], dy[1]);
+    kernel(D0z, n, gridSpacing.z, dz[0], dz[1]);
+
+    // The stencils along x are clamped only near the ends of the grid row
+    const size_t iInnerBegin = std::min(std::max(iBegin, halfWidth), iEnd);
+    const size_t iInnerEnd = (size.x > halfWidth)
+        ? std::max(std::min(iEnd, size.x - halfWidth), iInnerBegin)
+        : iInnerBegin;
+
+    const double* D0x[2 * kMaxRowStencilHalfWidth + 1];
+    if (iInnerBegin < iInnerEnd) {
+        for (size_t m = 0; m < width; ++m) {
+            D0x[m] = &grid(iInnerBegin + m - halfWidth, j, k);
+        }
+
+        const size_t r = iInnerBegin - iBegin;
+        kernel(D0x, iInnerEnd - iInnerBegin, gridSpacing.x, dx[0] + r,
+               dx[1] + r);
+    }
+
+    double D0[2 * kMaxRowStencilHalfWidth + 1];
+    for (size_t m = 0; m < width; ++m) {
+        D0x[m] = &D0[m];
+    }
+
+    for (size_t i = iBegin; i < iEnd; ++i) {
+        if (i >= iInnerBegin && i < iInnerEnd) {
+            continue;
+        }
+
+        for (size_t m = 0; m < width; ++m) {
+            const size_t im = (i + m < halfWidth)
+                ? 0 : std::min(i + m - halfWidth, size.x - 1);
+            D0[m] = grid(im, j, k);
+        }
+
+        const size_t r = i - iBegin;
+        kernel(D0x, 1, gridSpacing.x, dx[0] + r, dx[1] + r);
+    }
+}
+
 double IterativeLevelSetSolver3::maxCfl() const {
     return _maxCfl;
 }
@@ -267,6 +583,22 @@ void IterativeLevelSetSolver3::setMaxCfl(double newMaxCfl) {
     _maxCfl = std::max(newMaxCfl, 0.0);
 }
 
+bool IterativeLevelSetSolver3::isTvdRungeKutta3Enabled() const {
+    return _isTvdRungeKutta3Enabled;
+}
+
+void IterativeLevelSetSolver3::setTvdRungeKutta3Enabled(bool enabled) {
+    _isTvdRungeKutta3Enabled = enabled;
+}
+
+double IterativeLevelSetSolver3::residualTolerance() const {
+    return _residualTolerance;
+}
+
+void IterativeLevelSetSolver3::setResidualTolerance(double newTolerance) {
+    _residualTolerance = std::max(newTolerance, 0.0);
+}
+
 unsigned int IterativeLevelSetSolver3::distanceToNumberOfIterations(
     double distance,
     double dtau) {
@@ -145,9 +145,9 @@ void LevelSetLiquidSolver3::extrapolateVelocityToAir(double currentCfl) {
     auto vPos = vel->vPosition();
     auto wPos = vel->wPosition();
 
-    Array3<char> uMarker(u.size());
-    Array3<char> vMarker(v.size());
-    Array3<char> wMarker(w.size());
+    Array3<char> uMarker(u.size(), 0, stepArena());
+    Array3<char> vMarker(v.size(), 0, stepArena());
+    Array3<char> wMarker(w.size(), 0, stepArena());
 
     uMarker.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
         if (isInsideSdf(sdf->sample(uPos(i, j, k)))) {
@@ -183,8 +183,17 @@ void LevelSetLiquidSolver3::extrapolateVelocityToAir(double currentCfl) {
 
     JET_INFO << "Max velocity extrapolation distance: " << maxDist;
 
-    FmmLevelSetSolver3 fmmSolver;
-    fmmSolver.extrapolate(*vel, *sdf, maxDist, vel.get());
+    if (extrapolationType() == ExtrapolationType::kClosestPoint) {
+        extrapolateToClosestPoints(vel->uConstAccessor(), uMarker, gridSpacing,
+                                   vel->uOrigin(), *sdf, maxDist, u);
+        extrapolateToClosestPoints(vel->vConstAccessor(), vMarker, gridSpacing,
+                                   vel->vOrigin(), *sdf, maxDist, v);
+        extrapolateToClosestPoints(vel->wConstAccessor(), wMarker, gridSpacing,
+                                   vel->wOrigin(), *sdf, maxDist, w);
+    } else {
+        FmmLevelSetSolver3 fmmSolver;
+        fmmSolver.extrapolate(*vel, *sdf, maxDist, vel.get());
+    }
 
     applyBoundaryCondition();
 }
@@ -6,6 +6,7 @@
 
 #include <jet/parallel.h>
 
+#include <algorithm>
 #include <memory>
 #include <thread>
 
@@ -17,6 +18,7 @@
 #endif
 
 static unsigned int sMaxNumberOfThreads = std::thread::hardware_concurrency();
+static thread_local unsigned int sMaxNumberOfThreadsForCurrentThread = 0;
 
 namespace jet {
 
@@ -35,6 +37,20 @@ void setMaxNumberOfThreads(unsigned int numThreads) {
     sMaxNumberOfThreads = std::max(numThreads, 1u);
 }
 
-unsigned int maxNumberOfThreads() { return sMaxNumberOfThreads; }
+unsigned int maxNumberOfThreads() {
+    if (sMaxNumberOfThreadsForCurrentThread > 0) {
+        return std::min(sMaxNumberOfThreads,
+                        sMaxNumberOfThreadsForCurrentThread);
+    }
+    return sMaxNumberOfThreads;
+}
+
+void setMaxNumberOfThreadsForCurrentThread(unsigned int numThreads) {
+    sMaxNumberOfThreadsForCurrentThread = numThreads;
+}
+
+unsigned int maxNumberOfThreadsForCurrentThread() {
+    return sMaxNumberOfThreadsForCurrentThread;
+}
 
 }  // namespace jet
@@ -54,6 +54,7 @@ ParticleSystemData3::~ParticleSystemData3() {
 
 void ParticleSystemData3::resize(size_t newNumberOfParticles) {
     _numberOfParticles = newNumberOfParticles;
+    ++_forcesRevision;
 
     for (auto& attr : _scalarDataList) {
         attr.resize(newNumberOfParticles, 0.0);
@@ -120,6 +121,10 @@ ArrayAccessor1<Vector3D> ParticleSystemData3::forces() {
     return vectorDataAt(_forceIdx);
 }
 
+size_t ParticleSystemData3::forcesRevision() const {
+    return _forcesRevision;
+}
+
 ConstArrayAccessor1<double> ParticleSystemData3::scalarDataAt(
     size_t idx) const {
     return _scalarDataList[idx].constAccessor();
@@ -135,6 +140,9 @@ ConstArrayAccessor1<Vector3D> ParticleSystemData3::vectorDataAt(
 }
 
 ArrayAccessor1<Vector3D> ParticleSystemData3::vectorDataAt(size_t idx) {
+    if (idx == _forceIdx) {
+        ++_forcesRevision;
+    }
     return _vectorDataList[idx].accessor();
 }
 
@@ -191,6 +199,66 @@ void ParticleSystemData3::addParticles(
     }
 }
 
+void ParticleSystemData3::removeParticles(
+    const ConstArrayAccessor1<char>& removalMarkers) {
+    JET_THROW_INVALID_ARG_IF(removalMarkers.size() != numberOfParticles());
+
+    // Build old-to-new index map while keeping the order
+    Array1<size_t> newIndices(numberOfParticles());
+    size_t newNumberOfParticles = 0;
+    for (size_t i = 0; i < numberOfParticles(); ++i) {
+        newIndices[i] = newNumberOfParticles;
+        if (!removalMarkers[i]) {
+            ++newNumberOfParticles;
+        }
+    }
+
+    if (newNumberOfParticles == numberOfParticles()) {
+        return;
+    }
+
+    // Compact each layer. Since newIndices[i] <= i, moving forward is safe.
+    for (auto& attr : _scalarDataList) {
+        for (size_t i = 0; i < numberOfParticles(); ++i) {
+            if (!removalMarkers[i]) {
+                attr[newIndices[i]] = attr[i];
+            }
+        }
+    }
+
+    for (auto& attr : _vectorDataList) {
+        for (size_t i = 0; i < numberOfParticles(); ++i) {
+            if (!removalMarkers[i]) {
+                attr[newIndices[i]] = attr[i];
+            }
+        }
+    }
+
+    resize(newNumberOfParticles);
+}
+
+void ParticleSystemData3::reorderParticles(
+    const ConstArrayAccessor1<size_t>& newOrder) {
+    JET_THROW_INVALID_ARG_IF(newOrder.size() != numberOfParticles());
+    ++_forcesRevision;
+
+    Array1<double> scalarBuffer(numberOfParticles());
+    for (auto& attr : _scalarDataList) {
+        parallelFor(kZeroSize, numberOfParticles(), [&](size_t i) {
+            scalarBuffer[i] = attr[newOrder[i]];
+        });
+        attr.swap(scalarBuffer);
+    }
+
+    Array1<Vector3D> vectorBuffer(numberOfParticles());
+    for (auto& attr : _vectorDataList) {
+        parallelFor(kZeroSize, numberOfParticles(), [&](size_t i) {
+            vectorBuffer[i] = attr[newOrder[i]];
+        });
+        attr.swap(vectorBuffer);
+    }
+}
+
 const PointNeighborSearcher3Ptr& ParticleSystemData3::neighborSearcher() const {
     return _neighborSearcher;
 }
@@ -274,6 +342,7 @@ void ParticleSystemData3::set(const ParticleSystemData3& other) {
     _velocityIdx = other._velocityIdx;
     _forceIdx = other._forceIdx;
     _numberOfParticles = other._numberOfParticles;
+    ++_forcesRevision;
 
     for (auto& attr : other._scalarDataList) {
         _scalarDataList.emplace_back(attr);
@@ -365,6 +434,7 @@ void ParticleSystemData3::deserializeParticleSystemData(
     const fbs::ParticleSystemData3* fbsParticleSystemData) {
     _scalarDataList.clear();
     _vectorDataList.clear();
+    ++_forcesRevision;
 
     // Copy scalars
     _radius = fbsParticleSystemData->radius();
@@ -266,6 +266,10 @@ void ParticleSystemSolver2::updateEmitter(double timeStepInSeconds) {
     }
 }
 
+size_t ParticleSystemSolver2::problemSize() const {
+    return _particleSystemData->numberOfParticles();
+}
+
 ParticleSystemSolver2::Builder ParticleSystemSolver2::builder() {
     return Builder();
 }
@@ -90,6 +90,8 @@ void ParticleSystemSolver3::setWind(const VectorField3Ptr& newWind) {
 }
 
 void ParticleSystemSolver3::onInitialize() {
+    _maxForceMagnitudeRevision = kMaxSize;
+
     // When initializing the solver, update the collider and emitter state as
     // well since they also affects the initial condition of the simulation.
     Timer timer;
@@ -135,6 +137,7 @@ void ParticleSystemSolver3::beginAdvanceTimeStep(double timeStepInSeconds) {
     // Clear forces
     auto forces = _particleSystemData->forces();
     setRange1(forces.size(), Vector3D(), &forces);
+    _maxForceMagnitudeRevision = kMaxSize;
 
     // Update collider and emitter
     Timer timer;
@@ -208,6 +211,7 @@ void ParticleSystemSolver3::resolveCollision(
 void ParticleSystemSolver3::setParticleSystemData(
     const ParticleSystemData3Ptr& newParticles) {
     _particleSystemData = newParticles;
+    _maxForceMagnitudeRevision = kMaxSize;
 }
 
 void ParticleSystemSolver3::accumulateExternalForces() {
@@ -239,19 +243,51 @@ void ParticleSystemSolver3::timeIntegration(double timeStepInSeconds) {
     auto positions = _particleSystemData->positions();
     const double mass = _particleSystemData->mass();
 
-    parallelFor(
+    // Record the max force magnitude for the next sub-step size estimation
+    const double maxForceSquared = parallelReduce(
         kZeroSize,
         n,
-        [&] (size_t i) {
-            // Integrate velocity first
-            Vector3D& newVelocity = _newVelocities[i];
-            newVelocity = velocities[i]
-                + timeStepInSeconds * forces[i] / mass;
-
-            // Integrate position.
-            Vector3D& newPosition = _newPositions[i];
-            newPosition = positions[i] + timeStepInSeconds * newVelocity;
-        });
+        0.0,
+        [&] (size_t begin, size_t end, double maxForce) {
+            for (size_t i = begin; i < end; ++i) {
+                // Integrate velocity first
+                Vector3D& newVelocity = _newVelocities[i];
+                newVelocity = velocities[i]
+                    + timeStepInSeconds * forces[i] / mass;
+
+                // Integrate position.
+                Vector3D& newPosition = _newPositions[i];
+                newPosition = positions[i] + timeStepInSeconds * newVelocity;
+
+                maxForce = std::max(maxForce, forces[i].lengthSquared());
+            }
+            return maxForce;
+        },
+        [] (double a, double b) { return std::max(a, b); });
+    _maxForceMagnitude = std::sqrt(maxForceSquared);
+    _maxForceMagnitudeRevision = _particleSystemData->forcesRevision();
+}
+
+double ParticleSystemSolver3::maxForceMagnitude() const {
+    const ParticleSystemData3& particles = *_particleSystemData;
+    if (_maxForceMagnitudeRevision == particles.forcesRevision()) {
+        return _maxForceMagnitude;
+    }
+
+    const size_t n = particles.numberOfParticles();
+    auto forces = particles.forces();
+    const double maxForceSquared = parallelReduce(
+        kZeroSize,
+        n,
+        0.0,
+        [&] (size_t begin, size_t end, double maxForce) {
+            for (size_t i = begin; i < end; ++i) {
+                maxForce = std::max(maxForce, forces[i].lengthSquared());
+            }
+            return maxForce;
+        },
+        [] (double a, double b) { return std::max(a, b); });
+    return std::sqrt(maxForceSquared);
 }
 
 void ParticleSystemSolver3::updateCollider(double timeStepInSeconds) {
@@ -266,6 +302,10 @@ void ParticleSystemSolver3::updateEmitter(double timeStepInSeconds) {
     }
 }
 
+size_t ParticleSystemSolver3::problemSize() const {
+    return _particleSystemData->numberOfParticles();
+}
+
 ParticleSystemSolver3::Builder ParticleSystemSolver3::builder() {
     return Builder();
 }
@@ -63,7 +63,7 @@ void PciSphSolver3::accumulatePressureForce(
     auto f = particles->forces();
 
     // Predicted density ds
-    Array1<double> ds(numberOfParticles, 0.0);
+    Array1<double> ds(numberOfParticles, 0.0, stepArena());
 
     SphStdKernel3 kernel(particles->kernelRadius());
 
@@ -79,7 +79,7 @@ void PciSphSolver3::accumulatePressureForce(
         });
 
     unsigned int maxNumIter = 0;
-    double maxDensityError;
+    double maxDensityError = 0.0;
     double densityErrorRatio = 0.0;
 
     for (unsigned int k = 0; k < _maxNumberOfIterations; ++k) {
@@ -101,46 +101,47 @@ void PciSphSolver3::accumulatePressureForce(
             _tempPositions,
             _tempVelocities);
 
-        // Compute pressure from density error
-        parallelFor(
+        // Compute pressure from density error, and the max density error
+        // along the way
+        maxDensityError = parallelReduce(
             kZeroSize,
             numberOfParticles,
-            [&] (size_t i) {
-                double weightSum = 0.0;
-                const auto& neighbors = particles->neighborLists()[i];
-
-                for (size_t j : neighbors) {
-                    double dist
-                        = _tempPositions[j].distanceTo(_tempPositions[i]);
-                    weightSum += kernel(dist);
-                }
-                weightSum += kernel(0);
-
-                double density = mass * weightSum;
-                double densityError = (density - targetDensity);
-                double pressure = delta * densityError;
-
-                if (pressure < 0.0) {
-                    pressure *= negativePressureScale();
-                    densityError *= negativePressureScale();
+            0.0,
+            [&] (size_t begin, size_t end, double maxError) {
+                for (size_t i = begin; i < end; ++i) {
+                    double weightSum = 0.0;
+                    const auto& neighbors = particles->neighborLists()[i];
+
+                    for (size_t j : neighbors) {
+                        double dist
+                            = _tempPositions[j].distanceTo(_tempPositions[i]);
+                        weightSum += kernel(dist);
+                    }
+                    weightSum += kernel(0);
+
+                    double density = mass * weightSum;
+                    double densityError = (density - targetDensity);
+                    double pressure = delta * densityError;
+
+                    if (pressure < 0.0) {
+                        pressure *= negativePressureScale();
+                        densityError *= negativePressureScale();
+                    }
+
+                    p[i] += pressure;
+                    ds[i] = density;
+                    _densityErrors[i] = densityError;
+                    maxError = absmax(maxError, densityError);
                 }
-
-                p[i] += pressure;
-                ds[i] = density;
-                _densityErrors[i] = densityError;
-            });
+                return maxError;
+            },
+            [] (double a, double b) { return absmax(a, b); });
 
         // Compute pressure gradient force
         _pressureForces.set(Vector3D());
         SphSolver3::accumulatePressureForce(
             x, ds.constAccessor(), p, _pressureForces.accessor());
 
-        // Compute max density error
-        maxDensityError = 0.0;
-        for (size_t i = 0; i < numberOfParticles; ++i) {
-            maxDensityError = absmax(maxDensityError, _densityErrors[i]);
-        }
-
         densityErrorRatio = maxDensityError / targetDensity;
         maxNumIter = k + 1;
 
@@ -48,6 +48,8 @@ void PhysicsAnimation::setCurrentFrame(const Frame& frame) {
 
 double PhysicsAnimation::currentTimeInSeconds() const { return _currentTime; }
 
+size_t PhysicsAnimation::problemSize() const { return 0; }
+
 unsigned int PhysicsAnimation::numberOfSubTimeSteps(
     double timeIntervalInSeconds) const {
     UNUSED_VARIABLE(timeIntervalInSeconds);
@@ -89,6 +91,7 @@ void PhysicsAnimation::advanceTimeStep(double timeIntervalInSeconds) {
 
             Timer timer;
             onAdvanceTimeStep(actualTimeInterval);
+            _stepArena.reset();
 
             JET_INFO << "End onAdvanceTimeStep (took "
                      << timer.durationInSeconds() << " seconds)";
@@ -112,6 +115,7 @@ void PhysicsAnimation::advanceTimeStep(double timeIntervalInSeconds) {
 
             Timer timer;
             onAdvanceTimeStep(actualTimeInterval);
+            _stepArena.reset();
 
             JET_INFO << "End onAdvanceTimeStep (took "
                      << timer.durationInSeconds() << " seconds)";
@@ -122,7 +126,14 @@ void PhysicsAnimation::advanceTimeStep(double timeIntervalInSeconds) {
     }
 }
 
-void PhysicsAnimation::initialize() { onInitialize(); }
+void PhysicsAnimation::initialize() {
+    if (!_isInitialized) {
+        onInitialize();
+        _isInitialized = true;
+    }
+}
+
+StepArena* PhysicsAnimation::stepArena() { return &_stepArena; }
 
 void PhysicsAnimation::onInitialize() {
     // Do nothing
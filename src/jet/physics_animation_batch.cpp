@@ -0,0 +1,106 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <jet/parallel.h>
+#include <jet/physics_animation_batch.h>
+#include <jet/timer.h>
+
+#include <algorithm>
+#include <atomic>
+
+using namespace jet;
+
+PhysicsAnimationBatch::PhysicsAnimationBatch() {}
+
+size_t PhysicsAnimationBatch::addAnimation(
+    const PhysicsAnimationPtr& animation,
+    const OnFrameAdvancedCallback& onFrameAdvanced) {
+    JET_THROW_INVALID_ARG_IF(animation == nullptr);
+
+    _animations.push_back(animation);
+    _callbacks.push_back(onFrameAdvanced);
+    return _animations.size() - 1;
+}
+
+size_t PhysicsAnimationBatch::numberOfAnimations() const {
+    return _animations.size();
+}
+
+const PhysicsAnimationPtr& PhysicsAnimationBatch::animationAt(size_t i) const {
+    return _animations[i];
+}
+
+size_t PhysicsAnimationBatch::intraParallelismThreshold() const {
+    return _intraParallelismThreshold;
+}
+
+void PhysicsAnimationBatch::setIntraParallelismThreshold(size_t threshold) {
+    _intraParallelismThreshold = threshold;
+}
+
+void PhysicsAnimationBatch::advance(unsigned int numberOfFrames) {
+    Timer timer;
+
+    // The problem size is only known after the initialization, such as the
+    // number of particles emitted by a PIC solver.
+    for (const auto& animation : _animations) {
+        animation->initialize();
+    }
+
+    // The problem sizes change over time, so the animations are split again
+    // for every frame.
+    std::vector<size_t> smallAnimations;
+    std::vector<size_t> largeAnimations;
+    for (unsigned int f = 0; f < numberOfFrames; ++f) {
+        smallAnimations.clear();
+        largeAnimations.clear();
+        for (size_t i = 0; i < _animations.size(); ++i) {
+            if (_animations[i]->problemSize() >= _intraParallelismThreshold) {
+                largeAnimations.push_back(i);
+            } else {
+                smallAnimations.push_back(i);
+            }
+        }
+
+        // Large animations use all the threads within each time-step
+        for (size_t i : largeAnimations) {
+            advanceAnimation(i);
+        }
+
+        // Small animations are pulled by the workers one at a time, so a few
+        // slow animations do not hold up the others.
+        const size_t numberOfWorkers =
+            std::min<size_t>(std::max(maxNumberOfThreads(), 1u),
+                             smallAnimations.size());
+        std::atomic<size_t> next(0);
+        parallelFor(kZeroSize, numberOfWorkers, [&](size_t) {
+            // A single worker runs on the calling thread, so its limit is
+            // restored
+            const unsigned int prevLimit =
+                maxNumberOfThreadsForCurrentThread();
+            setMaxNumberOfThreadsForCurrentThread(1);
+            for (size_t n = next++; n < smallAnimations.size(); n = next++) {
+                advanceAnimation(smallAnimations[n]);
+            }
+            setMaxNumberOfThreadsForCurrentThread(prevLimit);
+        });
+    }
+
+    JET_INFO << "Advancing " << _animations.size() << " animations ("
+             << largeAnimations.size() << " large, " << smallAnimations.size()
+             << " small in the last frame) took " << timer.durationInSeconds()
+             << " seconds";
+}
+
+void PhysicsAnimationBatch::advanceAnimation(size_t i) {
+    const PhysicsAnimationPtr& animation = _animations[i];
+    animation->advanceSingleFrame();
+    if (_callbacks[i]) {
+        _callbacks[i](animation, animation->currentFrame());
+    }
+}
@@ -285,6 +285,10 @@ void PicSolver2::updateParticleEmitter(double timeIntervalInSeconds) {
     }
 }
 
+size_t PicSolver2::problemSize() const {
+    return GridFluidSolver2::problemSize() + _particles->numberOfParticles();
+}
+
 PicSolver2::Builder PicSolver2::builder() {
     return Builder();
 }
@@ -10,13 +10,147 @@
 
 #include <pch.h>
 #include <jet/array_utils.h>
+#include <jet/face_centered_stencil3.h>
 #include <jet/level_set_utils.h>
 #include <jet/pic_solver3.h>
 #include <jet/timer.h>
 #include <algorithm>
+#include <random>
 
 using namespace jet;
 
+template <typename Kernel>
+static void splatParticles(const ConstArrayAccessor1<Vector3D>& positions,
+                           const ConstArrayAccessor1<Vector3D>& velocities,
+                           const ConstArrayAccessor1<Vector3D>& cX,
+                           const ConstArrayAccessor1<Vector3D>& cY,
+                           const ConstArrayAccessor1<Vector3D>& cZ,
+                           FaceCenteredGrid3* flow,
+                           ArrayAccessor3<char> uMarkers,
+                           ArrayAccessor3<char> vMarkers,
+                           ArrayAccessor3<char> wMarkers,
+                           StepArena* arena) {
+    const size_t numberOfParticles = positions.size();
+    const bool hasAffineTerms = (cX.size() == numberOfParticles &&
+                                 cY.size() == numberOfParticles &&
+                                 cZ.size() == numberOfParticles);
+    const Size3 res = flow->resolution();
+    const Vector3D h = flow->gridSpacing();
+    const Vector3D invH = 1.0 / h;
+    const Vector3D origin = flow->origin();
+
+    auto u = flow->uAccessor();
+    auto v = flow->vAccessor();
+    auto w = flow->wAccessor();
+    Array3<double> uWeight(u.size(), 0.0, arena);
+    Array3<double> vWeight(v.size(), 0.0, arena);
+    Array3<double> wWeight(w.size(), 0.0, arena);
+    auto uw = uWeight.accessor();
+    auto vw = vWeight.accessor();
+    auto ww = wWeight.accessor();
+
+    // Group the particles by z-slabs which are wider than the kernel support.
+    // Two slabs of the same parity never touch the same samples, so the slabs
+    // of each parity can be splatted in parallel.
+    const size_t slabWidth = Kernel::kWidth + 1;
+    const size_t numberOfSlabs = (res.z + slabWidth - 1) / slabWidth;
+    Array1<size_t> slabIndices(numberOfParticles, 0, arena);
+    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
+        const double z = (positions[i].z - origin.z) * invH.z;
+        const size_t k = static_cast<size_t>(clamp(z, 0.0, res.z - 1.0));
+        slabIndices[i] = k / slabWidth;
+    });
+
+    Array1<size_t> slabStarts(numberOfSlabs + 1, 0, arena);
+    for (size_t i = 0; i < numberOfParticles; ++i) {
+        ++slabStarts[slabIndices[i] + 1];
+    }
+    for (size_t s = 1; s <= numberOfSlabs; ++s) {
+        slabStarts[s] += slabStarts[s - 1];
+    }
+
+    Array1<size_t> offsets(numberOfSlabs + 1, 0, arena);
+    offsets.set(slabStarts);
+    Array1<size_t> sortedIndices(numberOfParticles, 0, arena);
+    for (size_t i = 0; i < numberOfParticles; ++i) {
+        sortedIndices[offsets[slabIndices[i]]++] = i;
+    }
+
+    auto splatComponent = [&](const FaceStencil3<Kernel>& stencil,
+                              double velocity, const Vector3D* c,
+                              ArrayAccessor3<double>& data,
+                              ArrayAccessor3<double>& weights,
+                              ArrayAccessor3<char>& markers) {
+        const Vector3D pt(stencil.x.coordinate, stencil.y.coordinate,
+                          stencil.z.coordinate);
+        stencil.forEachSample(
+            [&](size_t i, size_t j, size_t k, double weight) {
+                double value = velocity;
+                if (c != nullptr) {
+                    value += c->dot((Vector3D(i, j, k) - pt) * h);
+                }
+                data(i, j, k) += weight * value;
+                weights(i, j, k) += weight;
+                markers(i, j, k) = 1;
+            });
+    };
+
+    for (size_t parity = 0; parity < 2; ++parity) {
+        parallelFor(kZeroSize, (numberOfSlabs + 1 - parity) / 2, [&](size_t n) {
+            const size_t slab = 2 * n + parity;
+            for (size_t m = slabStarts[slab]; m < slabStarts[slab + 1]; ++m) {
+                const size_t i = sortedIndices[m];
+                const FaceCenteredStencil3<Kernel> stencil(positions[i], origin,
+                                                           invH, res);
+                const Vector3D& vel = velocities[i];
+                splatComponent(stencil.u, vel.x,
+                               hasAffineTerms ? &cX[i] : nullptr, u, uw,
+                               uMarkers);
+                splatComponent(stencil.v, vel.y,
+                               hasAffineTerms ? &cY[i] : nullptr, v, vw,
+                               vMarkers);
+                splatComponent(stencil.w, vel.z,
+                               hasAffineTerms ? &cZ[i] : nullptr, w, ww,
+                               wMarkers);
+            }
+        });
+    }
+
+    uWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (uWeight(i, j, k) > 0.0) {
+            u(i, j, k) /= uWeight(i, j, k);
+        }
+    });
+    vWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (vWeight(i, j, k) > 0.0) {
+            v(i, j, k) /= vWeight(i, j, k);
+        }
+    });
+    wWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (wWeight(i, j, k) > 0.0) {
+            w(i, j, k) /= wWeight(i, j, k);
+        }
+    });
+}
+
+template <typename Kernel>
+static void sampleGridVelocities(const FaceCenteredGrid3& flow,
+                                 const ConstArrayAccessor1<Vector3D>& positions,
+                                 ArrayAccessor1<Vector3D> velocities) {
+    const Vector3D origin = flow.origin();
+    const Vector3D invH = 1.0 / flow.gridSpacing();
+    const Size3 res = flow.resolution();
+    const auto u = flow.uConstAccessor();
+    const auto v = flow.vConstAccessor();
+    const auto w = flow.wConstAccessor();
+
+    parallelFor(kZeroSize, positions.size(), [&](size_t i) {
+        const FaceCenteredStencil3<Kernel> stencil(positions[i], origin, invH,
+                                                   res);
+        velocities[i] = stencil.sample(u, v, w);
+    });
+}
+
 PicSolver3::PicSolver3() : PicSolver3({1, 1, 1}, {1, 1, 1}, {0, 0, 0}) {
 }
 
@@ -51,6 +185,46 @@ void PicSolver3::setParticleEmitter(const ParticleEmitter3Ptr& newEmitter) {
     newEmitter->setTarget(_particles);
 }
 
+unsigned int PicSolver3::particleReseedingInterval() const {
+    return _particleReseedingInterval;
+}
+
+void PicSolver3::setParticleReseedingInterval(unsigned int interval) {
+    _particleReseedingInterval = interval;
+}
+
+unsigned int PicSolver3::minParticlesPerCell() const {
+    return _minParticlesPerCell;
+}
+
+void PicSolver3::setMinParticlesPerCell(unsigned int newMin) {
+    _minParticlesPerCell = newMin;
+}
+
+unsigned int PicSolver3::maxParticlesPerCell() const {
+    return _maxParticlesPerCell;
+}
+
+void PicSolver3::setMaxParticlesPerCell(unsigned int newMax) {
+    _maxParticlesPerCell = std::max(newMax, 1u);
+}
+
+unsigned int PicSolver3::particleSortingInterval() const {
+    return _particleSortingInterval;
+}
+
+void PicSolver3::setParticleSortingInterval(unsigned int interval) {
+    _particleSortingInterval = interval;
+}
+
+TransferKernelType PicSolver3::transferKernelType() const {
+    return _transferKernelType;
+}
+
+void PicSolver3::setTransferKernelType(TransferKernelType type) {
+    _transferKernelType = type;
+}
+
 void PicSolver3::onInitialize() {
     GridFluidSolver3::onInitialize();
 
@@ -74,6 +248,16 @@ void PicSolver3::onBeginAdvanceTimeStep(double timeIntervalInSeconds) {
     JET_INFO << "Number of PIC-type particles: "
              << _particles->numberOfParticles();
 
+    if (_particleSortingInterval > 0 &&
+        ++_numberOfStepsSinceSorting >= _particleSortingInterval) {
+        _numberOfStepsSinceSorting = 0;
+
+        timer.reset();
+        reorderParticlesByCell();
+        JET_INFO << "reorderParticlesByCell took "
+                 << timer.durationInSeconds() << " seconds";
+    }
+
     timer.reset();
     transferFromParticlesToGrids();
     JET_INFO << "transferFromParticlesToGrids took "
@@ -90,6 +274,16 @@ void PicSolver3::onBeginAdvanceTimeStep(double timeIntervalInSeconds) {
              << timer.durationInSeconds() << " seconds";
 
     applyBoundaryCondition();
+
+    if (_particleReseedingInterval > 0 &&
+        ++_numberOfStepsSinceReseeding >= _particleReseedingInterval) {
+        _numberOfStepsSinceReseeding = 0;
+
+        timer.reset();
+        reseedParticles();
+        JET_INFO << "reseedParticles took "
+                 << timer.durationInSeconds() << " seconds";
+    }
 }
 
 void PicSolver3::computeAdvection(double timeIntervalInSeconds) {
@@ -116,91 +310,30 @@ ScalarField3Ptr PicSolver3::fluidSdf() const {
 }
 
 void PicSolver3::transferFromParticlesToGrids() {
-    auto flow = gridSystemData()->velocity();
-    auto positions = _particles->positions();
-    auto velocities = _particles->velocities();
-    size_t numberOfParticles = _particles->numberOfParticles();
-
-    // Clear velocity to zero
-    flow->fill(Vector3D());
-
-    // Weighted-average velocity
-    auto u = flow->uAccessor();
-    auto v = flow->vAccessor();
-    auto w = flow->wAccessor();
-    Array3<double> uWeight(u.size());
-    Array3<double> vWeight(v.size());
-    Array3<double> wWeight(w.size());
-    _uMarkers.resize(u.size());
-    _vMarkers.resize(v.size());
-    _wMarkers.resize(w.size());
-    _uMarkers.set(0);
-    _vMarkers.set(0);
-    _wMarkers.set(0);
-    LinearArraySampler3<double, double> uSampler(
-        flow->uConstAccessor(),
-        flow->gridSpacing(),
-        flow->uOrigin());
-    LinearArraySampler3<double, double> vSampler(
-        flow->vConstAccessor(),
-        flow->gridSpacing(),
-        flow->vOrigin());
-    LinearArraySampler3<double, double> wSampler(
-        flow->wConstAccessor(),
-        flow->gridSpacing(),
-        flow->wOrigin());
-    for (size_t i = 0; i < numberOfParticles; ++i) {
-        std::array<Point3UI, 8> indices;
-        std::array<double, 8> weights;
-
-        uSampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
-        for (int j = 0; j < 8; ++j) {
-            u(indices[j]) += velocities[i].x * weights[j];
-            uWeight(indices[j]) += weights[j];
-            _uMarkers(indices[j]) = 1;
-        }
-
-        vSampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
-        for (int j = 0; j < 8; ++j) {
-            v(indices[j]) += velocities[i].y * weights[j];
-            vWeight(indices[j]) += weights[j];
-            _vMarkers(indices[j]) = 1;
-        }
-
-        wSampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
-        for (int j = 0; j < 8; ++j) {
-            w(indices[j]) += velocities[i].z * weights[j];
-            wWeight(indices[j]) += weights[j];
-            _wMarkers(indices[j]) = 1;
-        }
-    }
-
-    uWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (uWeight(i, j, k) > 0.0) {
-            u(i, j, k) /= uWeight(i, j, k);
-        }
-    });
-    vWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (vWeight(i, j, k) > 0.0) {
-            v(i, j, k) /= vWeight(i, j, k);
-        }
-    });
-    wWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (wWeight(i, j, k) > 0.0) {
-            w(i, j, k) /= wWeight(i, j, k);
-        }
-    });
+    splatParticleVelocities(ConstArrayAccessor1<Vector3D>(),
+                            ConstArrayAccessor1<Vector3D>(),
+                            ConstArrayAccessor1<Vector3D>());
 }
 
 void PicSolver3::transferFromGridsToParticles() {
     auto flow = gridSystemData()->velocity();
     auto positions = _particles->positions();
     auto velocities = _particles->velocities();
-    size_t numberOfParticles = _particles->numberOfParticles();
 
-    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
-        velocities[i] = flow->sample(positions[i]);
-    });
+    switch (_transferKernelType) {
+        case TransferKernelType::kQuadraticBSpline:
+            sampleGridVelocities<QuadraticBSplineTransferKernel>(
+                *flow, positions, velocities);
+            break;
+        case TransferKernelType::kCubicBSpline:
+            sampleGridVelocities<CubicBSplineTransferKernel>(
+                *flow, positions, velocities);
+            break;
+        default:
+            sampleGridVelocities<LinearTransferKernel>(*flow, positions,
+                                                       velocities);
+            break;
+    }
 }
 
 void PicSolver3::moveParticles(double timeIntervalInSeconds) {
@@ -281,6 +414,145 @@ void PicSolver3::moveParticles(double timeIntervalInSeconds) {
     }
 }
 
+void PicSolver3::reseedParticles() {
+    auto flow = gridSystemData()->velocity();
+    const Size3 res = resolution();
+    const Vector3D h = gridSpacing();
+    const Vector3D origin = gridOrigin();
+    const size_t numberOfParticles = _particles->numberOfParticles();
+    const unsigned int minCount = _minParticlesPerCell;
+    const unsigned int maxCount =
+        std::max(_maxParticlesPerCell, _minParticlesPerCell);
+
+    Array1<size_t> cellIndices;
+    Array1<size_t> sortedIndices;
+    sortParticlesByCell(&cellIndices, &sortedIndices);
+
+    // Find the range of the sorted particles for each occupied cell
+    Array1<size_t> cellStarts;
+    for (size_t i = 0; i < numberOfParticles; ++i) {
+        if (i == 0 || cellIndices[sortedIndices[i]] !=
+                          cellIndices[sortedIndices[i - 1]]) {
+            cellStarts.append(i);
+        }
+    }
+    const size_t numberOfCells = cellStarts.size();
+    cellStarts.append(numberOfParticles);
+
+    Array3<unsigned int> counts(res, 0u, stepArena());
+    parallelFor(kZeroSize, numberOfCells, [&](size_t c) {
+        counts[cellIndices[sortedIndices[cellStarts[c]]]] =
+            static_cast<unsigned int>(cellStarts[c + 1] - cellStarts[c]);
+    });
+
+    // Mark the excess particles and count the particles to add
+    Array1<char> removalMarkers(numberOfParticles, 0, stepArena());
+    Array1<size_t> numberOfNewParticles(numberOfCells, 0, stepArena());
+    parallelFor(kZeroSize, numberOfCells, [&](size_t c) {
+        const size_t begin = cellStarts[c];
+        const size_t end = cellStarts[c + 1];
+        const size_t count = end - begin;
+
+        if (count > maxCount) {
+            for (size_t n = begin + maxCount; n < end; ++n) {
+                removalMarkers[sortedIndices[n]] = 1;
+            }
+        } else if (count < minCount) {
+            const size_t cell = cellIndices[sortedIndices[begin]];
+            const size_t i = cell % res.x;
+            const size_t j = (cell / res.x) % res.y;
+            const size_t k = cell / (res.x * res.y);
+
+            // Cells next to the air are left alone to keep the surface intact
+            if ((i > 0 && counts(i - 1, j, k) == 0) ||
+                (i + 1 < res.x && counts(i + 1, j, k) == 0) ||
+                (j > 0 && counts(i, j - 1, k) == 0) ||
+                (j + 1 < res.y && counts(i, j + 1, k) == 0) ||
+                (k > 0 && counts(i, j, k - 1) == 0) ||
+                (k + 1 < res.z && counts(i, j, k + 1) == 0)) {
+                return;
+            }
+
+            numberOfNewParticles[c] = minCount - count;
+        }
+    });
+
+    Array1<size_t> newParticleOffsets(numberOfCells + 1, 0, stepArena());
+    for (size_t c = 0; c < numberOfCells; ++c) {
+        newParticleOffsets[c + 1] =
+            newParticleOffsets[c] + numberOfNewParticles[c];
+    }
+
+    // Jitter new particles within the cell and take the grid velocity
+    const unsigned int seed = _numberOfReseedings++;
+    Array1<Vector3D> newPositions(newParticleOffsets[numberOfCells],
+                                  Vector3D(), stepArena());
+    Array1<Vector3D> newVelocities(newParticleOffsets[numberOfCells],
+                                   Vector3D(), stepArena());
+    parallelFor(kZeroSize, numberOfCells, [&](size_t c) {
+        if (numberOfNewParticles[c] == 0) {
+            return;
+        }
+
+        const size_t cell = cellIndices[sortedIndices[cellStarts[c]]];
+        const Vector3D cellLowerCorner =
+            origin + h * Vector3D(static_cast<double>(cell % res.x),
+                                  static_cast<double>((cell / res.x) % res.y),
+                                  static_cast<double>(cell / (res.x * res.y)));
+
+        std::minstd_rand rng(static_cast<unsigned int>(cell) * 2654435761u +
+                             seed);
+        std::uniform_real_distribution<> d(0.0, 1.0);
+        for (size_t n = newParticleOffsets[c]; n < newParticleOffsets[c + 1];
+             ++n) {
+            const double rx = d(rng);
+            const double ry = d(rng);
+            const double rz = d(rng);
+            newPositions[n] = cellLowerCorner + h * Vector3D(rx, ry, rz);
+            newVelocities[n] = flow->sample(newPositions[n]);
+        }
+    });
+
+    _particles->removeParticles(removalMarkers.constAccessor());
+    _particles->addParticles(newPositions.constAccessor(),
+                             newVelocities.constAccessor());
+
+    JET_INFO << "Number of reseeded particles: " << newPositions.size()
+             << ", removed: "
+             << numberOfParticles + newPositions.size() -
+                    _particles->numberOfParticles();
+}
+
+void PicSolver3::sortParticlesByCell(Array1<size_t>* cellIndices,
+                                     Array1<size_t>* sortedIndices) const {
+    const Size3 res = resolution();
+    const Vector3D h = gridSpacing();
+    const Vector3D origin = gridOrigin();
+    const auto positions = _particles->positions();
+    const size_t numberOfParticles = _particles->numberOfParticles();
+
+    cellIndices->resize(numberOfParticles);
+    sortedIndices->resize(numberOfParticles);
+
+    auto& keys = *cellIndices;
+    auto& order = *sortedIndices;
+    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
+        const Vector3D x = (positions[i] - origin) / h;
+        const size_t ci = static_cast<size_t>(clamp(x.x, 0.0, res.x - 1.0));
+        const size_t cj = static_cast<size_t>(clamp(x.y, 0.0, res.y - 1.0));
+        const size_t ck = static_cast<size_t>(clamp(x.z, 0.0, res.z - 1.0));
+        keys[i] = ci + res.x * (cj + res.y * ck);
+    });
+
+    // Radix sort is stable, so the original order is kept within each cell
+    Array1<size_t> sortedKeys(numberOfParticles);
+    parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
+        sortedKeys[i] = keys[i];
+        order[i] = i;
+    });
+    parallelRadixSort(sortedKeys.begin(), sortedKeys.end(), order.begin());
+}
+
 void PicSolver3::extrapolateVelocityToAir() {
     auto vel = gridSystemData()->velocity();
     auto u = vel->uAccessor();
@@ -322,6 +594,10 @@ void PicSolver3::updateParticleEmitter(double timeIntervalInSeconds) {
     }
 }
 
+size_t PicSolver3::problemSize() const {
+    return GridFluidSolver3::problemSize() + _particles->numberOfParticles();
+}
+
 PicSolver3::Builder PicSolver3::builder() {
     return Builder();
 }
@@ -341,3 +617,51 @@ PicSolver3Ptr PicSolver3::Builder::makeShared() const {
             delete obj;
         });
 }
+
+void PicSolver3::reorderParticlesByCell() {
+    Array1<size_t> cellIndices;
+    Array1<size_t> sortedIndices;
+    sortParticlesByCell(&cellIndices, &sortedIndices);
+
+    _particles->reorderParticles(sortedIndices.constAccessor());
+}
+
+void PicSolver3::splatParticleVelocities(
+    const ConstArrayAccessor1<Vector3D>& cX,
+    const ConstArrayAccessor1<Vector3D>& cY,
+    const ConstArrayAccessor1<Vector3D>& cZ) {
+    auto flow = gridSystemData()->velocity();
+    auto positions = _particles->positions();
+    auto velocities = _particles->velocities();
+
+    // Clear velocity to zero
+    flow->fill(Vector3D());
+
+    _uMarkers.resize(flow->uSize());
+    _vMarkers.resize(flow->vSize());
+    _wMarkers.resize(flow->wSize());
+    _uMarkers.set(0);
+    _vMarkers.set(0);
+    _wMarkers.set(0);
+
+    switch (_transferKernelType) {
+        case TransferKernelType::kQuadraticBSpline:
+            splatParticles<QuadraticBSplineTransferKernel>(
+                positions, velocities, cX, cY, cZ, flow.get(),
+                _uMarkers.accessor(), _vMarkers.accessor(),
+                _wMarkers.accessor(), stepArena());
+            break;
+        case TransferKernelType::kCubicBSpline:
+            splatParticles<CubicBSplineTransferKernel>(
+                positions, velocities, cX, cY, cZ, flow.get(),
+                _uMarkers.accessor(), _vMarkers.accessor(),
+                _wMarkers.accessor(), stepArena());
+            break;
+        default:
+            splatParticles<LinearTransferKernel>(
+                positions, velocities, cX, cY, cZ, flow.get(),
+                _uMarkers.accessor(), _vMarkers.accessor(),
+                _wMarkers.accessor(), stepArena());
+            break;
+    }
+}
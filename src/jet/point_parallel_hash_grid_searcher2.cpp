@@ -78,13 +78,12 @@ void PointParallelHashGridSearcher2::build(
             tempKeys[i] = getHashKeyFromPosition(points[i]);
         });
 
-    // Sort indices based on hash key
-    parallelSort(
-        _sortedIndices.begin(),
-        _sortedIndices.end(),
-        [&tempKeys](size_t indexA, size_t indexB) {
-            return tempKeys[indexA] < tempKeys[indexB];
-        });
+    // Sort indices based on hash key. Hash keys are bounded by the number of
+    // buckets, so radix sort only needs a few passes.
+    parallelRadixSort(
+        tempKeys.begin(),
+        tempKeys.end(),
+        _sortedIndices.begin());
 
     // Re-order point and key arrays
     parallelFor(
@@ -92,7 +91,7 @@ void PointParallelHashGridSearcher2::build(
         numberOfPoints,
         [&](size_t i) {
             _points[i] = points[_sortedIndices[i]];
-            _keys[i] = tempKeys[_sortedIndices[i]];
+            _keys[i] = tempKeys[i];
         });
 
     // Now _points and _keys are sorted by points' hash key values.
@@ -96,23 +96,18 @@ SphSystemData3Ptr SphSolver3::sphSystemData() const {
 unsigned int SphSolver3::numberOfSubTimeSteps(
     double timeIntervalInSeconds) const {
     auto particles = sphSystemData();
-    size_t numberOfParticles = particles->numberOfParticles();
-    auto f = particles->forces();
 
     const double kernelRadius = particles->kernelRadius();
     const double mass = particles->mass();
 
-    double maxForceMagnitude = 0.0;
-
-    for (size_t i = 0; i < numberOfParticles; ++i) {
-        maxForceMagnitude = std::max(maxForceMagnitude, f[i].length());
-    }
+    // Recorded during the last time integration; no extra pass is needed
+    const double maxForce = maxForceMagnitude();
 
     double timeStepLimitBySpeed
         = kTimeStepLimitBySpeedFactor * kernelRadius / _speedOfSound;
     double timeStepLimitByForce
         = kTimeStepLimitByForceFactor
-        * std::sqrt(kernelRadius * mass / maxForceMagnitude);
+        * std::sqrt(kernelRadius * mass / maxForce);
 
     double desiredTimeStep
         = _timeStepLimitScale
@@ -149,10 +144,17 @@ void SphSolver3::onEndAdvanceTimeStep(double timeStepInSeconds) {
     size_t numberOfParticles = particles->numberOfParticles();
     auto densities = particles->densities();
 
-    double maxDensity = 0.0;
-    for (size_t i = 0; i < numberOfParticles; ++i) {
-        maxDensity = std::max(maxDensity, densities[i]);
-    }
+    double maxDensity = parallelReduce(
+        kZeroSize,
+        numberOfParticles,
+        0.0,
+        [&] (size_t begin, size_t end, double result) {
+            for (size_t i = begin; i < end; ++i) {
+                result = std::max(result, densities[i]);
+            }
+            return result;
+        },
+        [] (double a, double b) { return std::max(a, b); });
 
     JET_INFO << "Max density: " << maxDensity << " "
              << "Max density / target density ratio: "
@@ -269,7 +271,8 @@ void SphSolver3::computePseudoViscosity(double timeStepInSeconds) {
     const double mass = particles->mass();
     const SphSpikyKernel3 kernel(particles->kernelRadius());
 
-    Array1<Vector3D> smoothedVelocities(numberOfParticles);
+    Array1<Vector3D> smoothedVelocities(numberOfParticles, Vector3D(),
+                                        stepArena());
 
     parallelFor(
         kZeroSize,
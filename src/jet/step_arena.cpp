@@ -0,0 +1,118 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <jet/aligned_allocator.h>
+#include <jet/step_arena.h>
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace jet;
+
+static const size_t kMinBlockSize = 64 * 1024;
+
+StepArena::StepArena() {}
+
+StepArena::StepArena(const StepArena&) {}
+
+StepArena::~StepArena() { releaseBlocks(); }
+
+void* StepArena::allocate(size_t bytes, size_t alignment) {
+    JET_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    bytes = std::max(bytes, size_t(1));
+
+    while (true) {
+        if (_currentBlock < _blocks.size()) {
+            const Block& block = _blocks[_currentBlock];
+            const uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+            const uintptr_t begin =
+                (base + _offset + alignment - 1) & ~(uintptr_t(alignment) - 1);
+            const size_t end = static_cast<size_t>(begin - base) + bytes;
+
+            if (end <= block.size) {
+                _offset = end;
+                _bytesUsed += bytes;
+                return reinterpret_cast<void*>(begin);
+            }
+
+            // Moves on to the next block if there is any
+            if (_currentBlock + 1 < _blocks.size()) {
+                ++_currentBlock;
+                _offset = 0;
+                continue;
+            }
+        }
+
+        addBlock(bytes + alignment);
+    }
+}
+
+void StepArena::reset() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Coalesces the blocks so that the next step fits in a single block
+    if (_blocks.size() > 1) {
+        size_t totalSize = 0;
+        for (const Block& block : _blocks) {
+            totalSize += block.size;
+        }
+        releaseBlocks();
+        addBlock(totalSize);
+    }
+
+    _currentBlock = 0;
+    _offset = 0;
+    _bytesUsed = 0;
+}
+
+size_t StepArena::bytesUsed() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _bytesUsed;
+}
+
+size_t StepArena::capacity() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    size_t totalSize = 0;
+    for (const Block& block : _blocks) {
+        totalSize += block.size;
+    }
+    return totalSize;
+}
+
+size_t StepArena::numberOfBlocks() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _blocks.size();
+}
+
+StepArena& StepArena::operator=(const StepArena&) { return *this; }
+
+void StepArena::addBlock(size_t minSize) {
+    size_t size = kMinBlockSize;
+    if (!_blocks.empty()) {
+        size = std::max(size, 2 * _blocks.back().size);
+    }
+    size = std::max(size, minSize);
+
+    Block block;
+    block.data = static_cast<char*>(alignedMalloc(size, kDefaultArrayAlignment));
+    block.size = size;
+    _blocks.push_back(block);
+
+    _currentBlock = _blocks.size() - 1;
+    _offset = 0;
+}
+
+void StepArena::releaseBlocks() {
+    for (const Block& block : _blocks) {
+        alignedFree(block.data);
+    }
+    _blocks.clear();
+}
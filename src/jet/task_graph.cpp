@@ -0,0 +1,96 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <jet/task_graph.h>
+
+#include <algorithm>
+
+using namespace jet;
+
+TaskGraph::TaskGraph() {}
+
+size_t TaskGraph::addTask(const Task& task,
+                          const std::vector<size_t>& dependencies) {
+    size_t level = 0;
+    for (size_t dependency : dependencies) {
+        JET_THROW_INVALID_ARG_IF(dependency >= _tasks.size());
+        level = std::max(level, _levels[dependency] + 1);
+    }
+
+    _tasks.push_back(task);
+    _levels.push_back(level);
+    return _tasks.size() - 1;
+}
+
+size_t TaskGraph::numberOfTasks() const { return _tasks.size(); }
+
+void TaskGraph::execute(ExecutionPolicy policy) const {
+    if (_tasks.empty()) {
+        return;
+    }
+
+    // Bucket the tasks by level while keeping the order of insertion
+    const size_t numberOfLevels =
+        *std::max_element(_levels.begin(), _levels.end()) + 1;
+    std::vector<size_t> levelStart(numberOfLevels + 1, 0);
+    for (size_t level : _levels) {
+        ++levelStart[level + 1];
+    }
+    for (size_t l = 0; l < numberOfLevels; ++l) {
+        levelStart[l + 1] += levelStart[l];
+    }
+
+    std::vector<size_t> order(_tasks.size());
+    std::vector<size_t> cursor(levelStart.begin(), levelStart.end() - 1);
+    for (size_t i = 0; i < _tasks.size(); ++i) {
+        order[cursor[_levels[i]]++] = i;
+    }
+
+    const unsigned int numThreads = maxNumberOfThreads();
+    for (size_t l = 0; l < numberOfLevels; ++l) {
+        const size_t begin = levelStart[l];
+        const size_t end = levelStart[l + 1];
+        const size_t numberOfTasks = end - begin;
+
+#ifdef JET_TASKING_OPENMP
+        // Nested OpenMP loops run serially, so running fewer tasks than the
+        // threads concurrently would leave the rest of the threads idle.
+        const bool isConcurrent = policy == ExecutionPolicy::kParallel &&
+                                  numberOfTasks >= numThreads;
+#else
+        const bool isConcurrent = policy == ExecutionPolicy::kParallel &&
+                                  numberOfTasks > 1 && numThreads > 1;
+#endif
+
+        if (!isConcurrent) {
+            for (size_t i = begin; i < end; ++i) {
+                _tasks[order[i]]();
+            }
+            continue;
+        }
+
+        // Split the threads among the tasks, so the parallel loops inside
+        // the tasks use all the threads together without oversubscribing.
+        parallelFor(begin, end, [&](size_t i) {
+            const size_t n = i - begin;
+            const unsigned int share = static_cast<unsigned int>(
+                numThreads / numberOfTasks +
+                (n < numThreads % numberOfTasks ? 1 : 0));
+
+            const unsigned int prevLimit = maxNumberOfThreadsForCurrentThread();
+            setMaxNumberOfThreadsForCurrentThread(std::max(share, 1u));
+            _tasks[order[i]]();
+            setMaxNumberOfThreadsForCurrentThread(prevLimit);
+        });
+    }
+}
+
+void TaskGraph::clear() {
+    _tasks.clear();
+    _levels.clear();
+}
@@ -50,3 +50,17 @@ void UpwindLevelSetSolver3::getDerivatives(
     D0[2] = grid(i, j, kp1);
     *dz = upwind1(D0, gridSpacing.z);
 }
+
+void UpwindLevelSetSolver3::getRowDerivatives(
+    ConstArrayAccessor3<double> grid,
+    const Vector3D& gridSpacing,
+    size_t iBegin,
+    size_t iEnd,
+    size_t j,
+    size_t k,
+    std::array<double*, 2> dx,
+    std::array<double*, 2> dy,
+    std::array<double*, 2> dz) const {
+    computeRowDerivatives(grid, gridSpacing, iBegin, iEnd, j, k, 1,
+                          upwind1Row<double>, dx, dy, dz);
+}
@@ -16,6 +16,73 @@
 
 using namespace jet;
 
+// Returns true if the region inside the surface is enclosed by its bounding
+// box. Planes have infinite boxes and the inside of a surface with flipped
+// normal lies outside of its box, so neither of them is bounded.
+static bool isBoundedRegion(const ImplicitSurface3& surface,
+                            BoundingBox3D* box) {
+    *box = surface.boundingBox();
+    for (size_t i = 0; i < 3; ++i) {
+        const double extent = box->upperCorner[i] - box->lowerCorner[i];
+        if (!(extent >= 0.0 && extent < kMaxD)) {
+            return false;
+        }
+    }
+
+    const Vector3D probe =
+        box->upperCorner +
+        std::max(box->diagonalLength(), 1.0) * Vector3D(1.0, 1.0, 1.0);
+    return !isInsideSdf(surface.signedDistance(probe));
+}
+
+// Computes the range [begin, end) of the data points which covers the box.
+static void dataIndexRange(const BoundingBox3D& box, const Vector3D& origin,
+                           const Vector3D& gridSpacing, const Size3& size,
+                           Size3* begin, Size3* end) {
+    for (size_t i = 0; i < 3; ++i) {
+        const double n = static_cast<double>(size[i]);
+        const double lower =
+            std::floor((box.lowerCorner[i] - origin[i]) / gridSpacing[i]);
+        const double upper =
+            std::ceil((box.upperCorner[i] - origin[i]) / gridSpacing[i]) + 1.0;
+        (*begin)[i] = static_cast<size_t>(clamp(lower, 0.0, n));
+        (*end)[i] = static_cast<size_t>(clamp(upper, 0.0, n));
+    }
+}
+
+static double distanceToBox(const BoundingBox3D& box, const Vector3D& pt) {
+    Vector3D delta;
+    for (size_t i = 0; i < 3; ++i) {
+        delta[i] = std::max({box.lowerCorner[i] - pt[i],
+                             pt[i] - box.upperCorner[i], 0.0});
+    }
+    return delta.length();
+}
+
+// Averages the face values over the block (i..i+di, j..j+dj, k..k+dk) with
+// the indices clamped to the array, which is the linear interpolation of the
+// face values at the faces of the other directions.
+static double averageFaceValues(const ConstArrayAccessor3<double>& data,
+                                ssize_t i, ssize_t j, ssize_t k, ssize_t di,
+                                ssize_t dj, ssize_t dk) {
+    const Size3 size = data.size();
+    double sum = 0.0;
+    for (ssize_t c = 0; c <= dk; ++c) {
+        for (ssize_t b = 0; b <= dj; ++b) {
+            for (ssize_t a = 0; a <= di; ++a) {
+                const ssize_t ii = std::min(std::max(i + a, kZeroSSize),
+                                            static_cast<ssize_t>(size.x) - 1);
+                const ssize_t jj = std::min(std::max(j + b, kZeroSSize),
+                                            static_cast<ssize_t>(size.y) - 1);
+                const ssize_t kk = std::min(std::max(k + c, kZeroSSize),
+                                            static_cast<ssize_t>(size.z) - 1);
+                sum += data(ii, jj, kk);
+            }
+        }
+    }
+    return sum / static_cast<double>((di + 1) * (dj + 1) * (dk + 1));
+}
+
 VolumeGridEmitter3::VolumeGridEmitter3(const ImplicitSurface3Ptr& sourceRegion,
                                        bool isOneShot)
     : _sourceRegion(sourceRegion), _isOneShot(isOneShot) {}
@@ -27,7 +94,8 @@ void VolumeGridEmitter3::addSignedDistanceTarget(
     auto mapper = [](double sdf, const Vector3D&, double oldVal) {
         return std::min(oldVal, sdf);
     };
-    addTarget(scalarGridTarget, mapper);
+    _customScalarTargets.emplace_back(scalarGridTarget, mapper,
+                                      ScalarTargetType::kSignedDistance, 0.0);
 }
 
 void VolumeGridEmitter3::addStepFunctionTarget(
@@ -38,12 +106,18 @@ void VolumeGridEmitter3::addStepFunctionTarget(
         double step = 1.0 - smearedHeavisideSdf(sdf / smoothingWidth);
         return std::max(oldVal, (maxValue - minValue) * step + minValue);
     };
-    addTarget(scalarGridTarget, mapper);
+
+    // The step vanishes beyond 1.5 smoothing width from the surface. Leaves
+    // some margin for the round-off of sdf / smoothingWidth.
+    _customScalarTargets.emplace_back(scalarGridTarget, mapper,
+                                      ScalarTargetType::kStepFunction,
+                                      2.0 * smoothingWidth);
 }
 
 void VolumeGridEmitter3::addTarget(const ScalarGrid3Ptr& scalarGridTarget,
                                    const ScalarMapper& customMapper) {
-    _customScalarTargets.emplace_back(scalarGridTarget, customMapper);
+    _customScalarTargets.emplace_back(scalarGridTarget, customMapper,
+                                      ScalarTargetType::kCustom, 0.0);
 }
 
 void VolumeGridEmitter3::addTarget(const VectorGrid3Ptr& vectorGridTarget,
@@ -77,16 +151,63 @@ void VolumeGridEmitter3::emit() {
 
     _sourceRegion->updateQueryEngine();
 
+    BoundingBox3D bound;
+    const bool isBounded = isBoundedRegion(*_sourceRegion, &bound);
+
+    // Range of the data points which can be inside the source region
+    auto sourceIndexRange = [&](const Vector3D& origin,
+                                const Vector3D& gridSpacing, const Size3& size,
+                                Size3* begin, Size3* end) {
+        if (isBounded) {
+            dataIndexRange(bound, origin, gridSpacing, size, begin, end);
+        } else {
+            *begin = Size3();
+            *end = size;
+        }
+    };
+
     for (const auto& target : _customScalarTargets) {
         const auto& grid = std::get<0>(target);
         const auto& mapper = std::get<1>(target);
+        const ScalarTargetType type = std::get<2>(target);
+        const double bandWidth = std::get<3>(target);
 
         auto pos = grid->dataPosition();
-        grid->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        auto emitAt = [&](size_t i, size_t j, size_t k) {
             Vector3D gx = pos(i, j, k);
             double sdf = sourceRegion()->signedDistance(gx);
             (*grid)(i, j, k) = mapper(sdf, gx, (*grid)(i, j, k));
-        });
+        };
+
+        if (!isBounded || type == ScalarTargetType::kCustom) {
+            grid->parallelForEachDataPointIndex(emitAt);
+        } else if (type == ScalarTargetType::kSignedDistance) {
+            // Outside of the box, the distance to the box is a lower bound of
+            // the sdf, so min(old, sdf) keeps the old value if it is not
+            // larger than that.
+            grid->parallelForEachDataPointIndex(
+                [&](size_t i, size_t j, size_t k) {
+                    Vector3D gx = pos(i, j, k);
+                    if (bound.contains(gx) ||
+                        (*grid)(i, j, k) > distanceToBox(bound, gx)) {
+                        emitAt(i, j, k);
+                    }
+                });
+        } else {
+            // Beyond the transition band, the mapper does not depend on the
+            // sdf as long as it is far enough.
+            BoundingBox3D band = bound;
+            band.expand(bandWidth);
+            grid->parallelForEachDataPointIndex(
+                [&](size_t i, size_t j, size_t k) {
+                    Vector3D gx = pos(i, j, k);
+                    if (band.contains(gx)) {
+                        emitAt(i, j, k);
+                    } else {
+                        (*grid)(i, j, k) = mapper(kMaxD, gx, (*grid)(i, j, k));
+                    }
+                });
+        }
     }
 
     for (const auto& target : _customVectorTargets) {
@@ -96,8 +217,14 @@ void VolumeGridEmitter3::emit() {
         CollocatedVectorGrid3Ptr collocated =
             std::dynamic_pointer_cast<CollocatedVectorGrid3>(grid);
         if (collocated != nullptr) {
+            Size3 begin, end;
+            sourceIndexRange(collocated->dataOrigin(),
+                             collocated->gridSpacing(), collocated->dataSize(),
+                             &begin, &end);
+
             auto pos = collocated->dataPosition();
-            collocated->parallelForEachDataPointIndex(
+            parallelFor(
+                begin.x, end.x, begin.y, end.y, begin.z, end.z,
                 [&](size_t i, size_t j, size_t k) {
                     Vector3D gx = pos(i, j, k);
                     double sdf = sourceRegion()->signedDistance(gx);
@@ -112,33 +239,73 @@ void VolumeGridEmitter3::emit() {
         FaceCenteredGrid3Ptr faceCentered =
             std::dynamic_pointer_cast<FaceCenteredGrid3>(grid);
         if (faceCentered != nullptr) {
+            const Vector3D& h = faceCentered->gridSpacing();
+            auto u = faceCentered->uConstAccessor();
+            auto v = faceCentered->vConstAccessor();
+            auto w = faceCentered->wConstAccessor();
             auto uPos = faceCentered->uPosition();
             auto vPos = faceCentered->vPosition();
             auto wPos = faceCentered->wPosition();
 
-            faceCentered->parallelForEachUIndex(
+            // Reads the old values from the face arrays directly instead of
+            // sampling; the other components are averaged from the four
+            // neighboring faces.
+            Size3 begin, end;
+            sourceIndexRange(faceCentered->uOrigin(), h, faceCentered->uSize(),
+                             &begin, &end);
+            parallelFor(
+                begin.x, end.x, begin.y, end.y, begin.z, end.z,
                 [&](size_t i, size_t j, size_t k) {
                     Vector3D gx = uPos(i, j, k);
                     double sdf = sourceRegion()->signedDistance(gx);
-                    Vector3D oldVal = faceCentered->sample(gx);
-                    Vector3D newVal = mapper(sdf, gx, oldVal);
-                    faceCentered->u(i, j, k) = newVal.x;
+                    if (isInsideSdf(sdf)) {
+                        const ssize_t si = static_cast<ssize_t>(i);
+                        const ssize_t sj = static_cast<ssize_t>(j);
+                        const ssize_t sk = static_cast<ssize_t>(k);
+                        Vector3D oldVal(
+                            u(i, j, k),
+                            averageFaceValues(v, si - 1, sj, sk, 1, 1, 0),
+                            averageFaceValues(w, si - 1, sj, sk, 1, 0, 1));
+                        faceCentered->u(i, j, k) = mapper(sdf, gx, oldVal).x;
+                    }
                 });
-            faceCentered->parallelForEachVIndex(
+
+            sourceIndexRange(faceCentered->vOrigin(), h, faceCentered->vSize(),
+                             &begin, &end);
+            parallelFor(
+                begin.x, end.x, begin.y, end.y, begin.z, end.z,
                 [&](size_t i, size_t j, size_t k) {
                     Vector3D gx = vPos(i, j, k);
                     double sdf = sourceRegion()->signedDistance(gx);
-                    Vector3D oldVal = faceCentered->sample(gx);
-                    Vector3D newVal = mapper(sdf, gx, oldVal);
-                    faceCentered->v(i, j, k) = newVal.y;
+                    if (isInsideSdf(sdf)) {
+                        const ssize_t si = static_cast<ssize_t>(i);
+                        const ssize_t sj = static_cast<ssize_t>(j);
+                        const ssize_t sk = static_cast<ssize_t>(k);
+                        Vector3D oldVal(
+                            averageFaceValues(u, si, sj - 1, sk, 1, 1, 0),
+                            v(i, j, k),
+                            averageFaceValues(w, si, sj - 1, sk, 0, 1, 1));
+                        faceCentered->v(i, j, k) = mapper(sdf, gx, oldVal).y;
+                    }
                 });
-            faceCentered->parallelForEachWIndex(
+
+            sourceIndexRange(faceCentered->wOrigin(), h, faceCentered->wSize(),
+                             &begin, &end);
+            parallelFor(
+                begin.x, end.x, begin.y, end.y, begin.z, end.z,
                 [&](size_t i, size_t j, size_t k) {
                     Vector3D gx = wPos(i, j, k);
                     double sdf = sourceRegion()->signedDistance(gx);
-                    Vector3D oldVal = faceCentered->sample(gx);
-                    Vector3D newVal = mapper(sdf, gx, oldVal);
-                    faceCentered->w(i, j, k) = newVal.z;
+                    if (isInsideSdf(sdf)) {
+                        const ssize_t si = static_cast<ssize_t>(i);
+                        const ssize_t sj = static_cast<ssize_t>(j);
+                        const ssize_t sk = static_cast<ssize_t>(k);
+                        Vector3D oldVal(
+                            averageFaceValues(u, si, sj, sk - 1, 1, 0, 1),
+                            averageFaceValues(v, si, sj, sk - 1, 0, 1, 1),
+                            w(i, j, k));
+                        faceCentered->w(i, j, k) = mapper(sdf, gx, oldVal).z;
+                    }
                 });
             continue;
         }
@@ -0,0 +1,55 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "fdm_schwarz_pcg_solver.h"
+#include "pybind11_utils.h"
+
+#include <jet/fdm_schwarz_pcg_solver3.h>
+
+namespace py = pybind11;
+using namespace jet;
+
+void addFdmSchwarzPcgSolver3(py::module& m) {
+    py::class_<FdmSchwarzPcgSolver3, FdmSchwarzPcgSolver3Ptr,
+               FdmLinearSystemSolver3>(m, "FdmSchwarzPcgSolver3",
+                                       R"pbdoc(
+        3-D finite difference-type linear system solver using conjugate gradient
+        with domain-decomposed additive Schwarz preconditioner.
+        )pbdoc")
+        .def(py::init<uint32_t, double, uint32_t, uint32_t>(),
+             py::arg("maxNumberOfIterations"), py::arg("tolerance"),
+             py::arg("numberOfSubdomains") = 0,
+             py::arg("numberOfGhostLayers") = 2)
+        .def_property_readonly("maxNumberOfIterations",
+                               &FdmSchwarzPcgSolver3::maxNumberOfIterations,
+                               R"pbdoc(
+            Max number of CG iterations.
+            )pbdoc")
+        .def_property_readonly("lastNumberOfIterations",
+                               &FdmSchwarzPcgSolver3::lastNumberOfIterations,
+                               R"pbdoc(
+            The last number of CG iterations the solver made.
+            )pbdoc")
+        .def_property_readonly("tolerance", &FdmSchwarzPcgSolver3::tolerance,
+                               R"pbdoc(
+            The max residual tolerance for the CG method.
+            )pbdoc")
+        .def_property_readonly("lastResidual",
+                               &FdmSchwarzPcgSolver3::lastResidual,
+                               R"pbdoc(
+            The last residual after the CG iterations.
+            )pbdoc")
+        .def_property_readonly("numberOfSubdomains",
+                               &FdmSchwarzPcgSolver3::numberOfSubdomains,
+                               R"pbdoc(
+            The number of subdomains. Zero means the max number of threads.
+            )pbdoc")
+        .def_property_readonly("numberOfGhostLayers",
+                               &FdmSchwarzPcgSolver3::numberOfGhostLayers,
+                               R"pbdoc(
+            The number of overlapping layers of each subdomain.
+            )pbdoc");
+}
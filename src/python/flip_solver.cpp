@@ -114,5 +114,21 @@ void addFlipSolver3(py::module& m) {
              results when transferring velocity from grids to particles in order to
              reduce the noise. The factor can be a value between 0 and 1, where 0
              means no blending and 1 means full PIC. Default is 0.
+             )pbdoc")
+        .def_property("isUsingNarrowBand", &FlipSolver3::isUsingNarrowBand,
+                      &FlipSolver3::setIsUsingNarrowBand,
+                      R"pbdoc(
+             True if the solver is using narrow-band FLIP.
+
+             When enabled, particles are kept only within a narrow band below the
+             liquid surface while the deep interior is represented by a grid level
+             set and grid velocities. Default is False.
+             )pbdoc")
+        .def_property("narrowBandWidth", &FlipSolver3::narrowBandWidth,
+                      &FlipSolver3::setNarrowBandWidth,
+                      R"pbdoc(
+             The width of the particle band in number of grid cells.
+
+             The width will be clamped to be at least 2. Default is 3.
              )pbdoc");
 }
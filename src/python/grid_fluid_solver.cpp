@@ -150,6 +150,11 @@ void addGridFluidSolver2(py::module& m) {
 }
 
 void addGridFluidSolver3(py::module& m) {
+    py::enum_<ExtrapolationType>(m, "ExtrapolationType")
+        .value("PROPAGATION", ExtrapolationType::kPropagation)
+        .value("CLOSEST_POINT", ExtrapolationType::kClosestPoint)
+        .export_values();
+
     py::class_<GridFluidSolver3, GridFluidSolver3Ptr, PhysicsAnimation>(
         m, "GridFluidSolver3", R"pbdoc(
         Abstract base class for grid-based 3-D fluid solver.
@@ -189,6 +194,14 @@ void addGridFluidSolver3(py::module& m) {
             &GridFluidSolver3::useCompressedLinearSystem,
             &GridFluidSolver3::setUseCompressedLinearSystem,
             R"pbdoc(True if the solver is using compressed linear system.)pbdoc")
+        .def_property("extrapolationType", &GridFluidSolver3::extrapolationType,
+                      &GridFluidSolver3::setExtrapolationType,
+                      R"pbdoc(
+            The extrapolation type for the collider and air regions.
+
+            CLOSEST_POINT samples the fields at the closest points of the
+            interface instead of propagating them front by front.
+            )pbdoc")
         .def_property("advectionSolver", &GridFluidSolver3::advectionSolver,
                       &GridFluidSolver3::setAdvectionSolver,
                       R"pbdoc(The advection solver.)pbdoc")
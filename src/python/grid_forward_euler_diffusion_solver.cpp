@@ -109,6 +109,15 @@ void addGridForwardEulerDiffusionSolver3(py::module& m) {
         interval, respectively.
         )pbdoc")
         .def(py::init<>())
+        .def_property("numberOfSubSteps",
+                      &GridForwardEulerDiffusionSolver3::numberOfSubSteps,
+                      &GridForwardEulerDiffusionSolver3::setNumberOfSubSteps,
+                      R"pbdoc(
+            The number of sub-steps per solve.
+
+            Splitting the time interval into multiple sub-steps relaxes the
+            stability limit of the diffusion coefficient by the same factor.
+            )pbdoc")
         .def("solver",
              [](GridForwardEulerDiffusionSolver3& instance, Grid3Ptr source,
                 double diffusionCoefficient, double timeIntervalInSeconds,
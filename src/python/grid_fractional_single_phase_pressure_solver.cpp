@@ -86,5 +86,22 @@ void addGridFractionalSinglePhasePressureSolver3(py::module& m) {
             &GridFractionalSinglePhasePressureSolver3::setLinearSystemSolver,
             R"pbdoc(
             "The linear system solver."
+            )pbdoc")
+        .def_property(
+            "rebuildTolerance",
+            &GridFractionalSinglePhasePressureSolver3::rebuildTolerance,
+            &GridFractionalSinglePhasePressureSolver3::setRebuildTolerance,
+            R"pbdoc(
+            The tolerance of the SDF changes for rebuilding the system.
+
+            The weights and the matrix rows are kept from the previous solve
+            where the boundary and fluid SDFs have not changed beyond the
+            tolerance. Zero, which is the default, rebuilds every change.
+            )pbdoc")
+        .def_property_readonly(
+            "lastBuildTimeInSeconds",
+            &GridFractionalSinglePhasePressureSolver3::lastBuildTimeInSeconds,
+            R"pbdoc(
+            The time spent building the system in the last solve.
             )pbdoc");
 }
@@ -201,6 +201,16 @@ void addGridSmokeSolver3(py::module& m) {
                       In addition to the diffusion, the temperature also can fade-out over
                       time by setting the decay factor between 0 and 1.
                       )pbdoc")
+        .def_property("numberOfSubdomains",
+                      &GridSmokeSolver3::numberOfSubdomains,
+                      &GridSmokeSolver3::setNumberOfSubdomains,
+                      R"pbdoc(
+                      The number of subdomains for the domain-decomposed mode.
+
+                      With more than one subdomain, the grid is split into z-slabs which
+                      are owned by single threads and exchange ghost layers. The pressure
+                      and diffusion systems are solved by the Schwarz-preconditioned CG.
+                      )pbdoc")
         .def_property_readonly("smokeDensity", &GridSmokeSolver3::smokeDensity,
                                R"pbdoc(Returns smoke density field.)pbdoc")
         .def_property_readonly("temperature", &GridSmokeSolver3::temperature,
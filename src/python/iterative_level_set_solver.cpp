@@ -164,5 +164,18 @@ void addIterativeLevelSetSolver3(py::module& m) {
             py::arg("output"))
         .def_property("maxCfl", &IterativeLevelSetSolver3::maxCfl,
                       &IterativeLevelSetSolver3::setMaxCfl,
-                      R"pbdoc(The maximum CFL limit.)pbdoc");
+                      R"pbdoc(The maximum CFL limit.)pbdoc")
+        .def_property("residualTolerance",
+                      &IterativeLevelSetSolver3::residualTolerance,
+                      &IterativeLevelSetSolver3::setResidualTolerance,
+                      R"pbdoc(
+            The residual tolerance for the early termination of the
+            reinitialization.
+            )pbdoc")
+        .def_property("isTvdRungeKutta3Enabled",
+                      &IterativeLevelSetSolver3::isTvdRungeKutta3Enabled,
+                      &IterativeLevelSetSolver3::setTvdRungeKutta3Enabled,
+                      R"pbdoc(
+            True if the reinitialization uses 3rd-order TVD Runge-Kutta.
+            )pbdoc");
 }
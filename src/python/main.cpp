@@ -31,6 +31,7 @@
 #include "fdm_linear_system_solver.h"
 #include "fdm_mg_solver.h"
 #include "fdm_mgpcg_solver.h"
+#include "fdm_schwarz_pcg_solver.h"
 #include "field.h"
 #include "flip_solver.h"
 #include "fmm_level_set_solver.h"
@@ -92,6 +93,7 @@
 #include "vertex_centered_vector_grid.h"
 #include "volume_grid_emitter.h"
 #include "volume_particle_emitter.h"
+#include "weno_level_set_solver.h"
 #include "zhu_bridson_points_to_implicit.h"
 
 #include <pybind11/functional.h>
@@ -246,6 +248,7 @@ PYBIND11_PLUGIN(pyjet) {
     addFdmMgSolver3(m);
     addFdmMgpcgSolver2(m);
     addFdmMgpcgSolver3(m);
+    addFdmSchwarzPcgSolver3(m);
     addGridDiffusionSolver2(m);
     addGridDiffusionSolver3(m);
     addGridForwardEulerDiffusionSolver2(m);
@@ -272,6 +275,7 @@ PYBIND11_PLUGIN(pyjet) {
     addUpwindLevelSetSolver3(m);
     addEnoLevelSetSolver2(m);
     addEnoLevelSetSolver3(m);
+    addWenoLevelSetSolver3(m);
     addFmmLevelSetSolver2(m);
     addFmmLevelSetSolver3(m);
     addPointsToImplicit2(m);
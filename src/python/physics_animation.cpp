@@ -43,8 +43,10 @@ void addPhysicsAnimation(py::module& m) {
                       &PhysicsAnimation::numberOfFixedSubTimeSteps,
                       &PhysicsAnimation::setNumberOfFixedSubTimeSteps)
         .def("advanceSingleFrame", &PhysicsAnimation::advanceSingleFrame)
+        .def("initialize", &PhysicsAnimation::initialize)
         .def_property("currentFrame", &PhysicsAnimation::currentFrame,
                       &PhysicsAnimation::setCurrentFrame)
         .def_property_readonly("currentTimeInSeconds",
-                               &PhysicsAnimation::currentTimeInSeconds);
+                               &PhysicsAnimation::currentTimeInSeconds)
+        .def_property_readonly("problemSize", &PhysicsAnimation::problemSize);
 }
@@ -51,6 +51,12 @@ void addPicSolver2(py::module& m) {
 }
 
 void addPicSolver3(py::module& m) {
+    py::enum_<TransferKernelType>(m, "TransferKernelType")
+        .value("LINEAR", TransferKernelType::kLinear)
+        .value("QUADRATIC_BSPLINE", TransferKernelType::kQuadraticBSpline)
+        .value("CUBIC_BSPLINE", TransferKernelType::kCubicBSpline)
+        .export_values();
+
     py::class_<PicSolver3, PicSolver3Ptr, GridFluidSolver3>(m, "PicSolver3")
         .def("__init__",
              [](PicSolver3& instance, py::args args, py::kwargs kwargs) {
@@ -84,5 +90,37 @@ void addPicSolver3(py::module& m) {
                                R"pbdoc(Returns particleSystemData.)pbdoc")
         .def_property("particleEmitter", &PicSolver3::particleEmitter,
                       &PicSolver3::setParticleEmitter,
-                      R"pbdoc(Particle emitter property.)pbdoc");
+                      R"pbdoc(Particle emitter property.)pbdoc")
+        .def_property("particleReseedingInterval",
+                      &PicSolver3::particleReseedingInterval,
+                      &PicSolver3::setParticleReseedingInterval,
+                      R"pbdoc(
+             Particle reseeding interval in number of time-steps.
+
+             Zero disables reseeding, which is the default.
+             )pbdoc")
+        .def_property("minParticlesPerCell", &PicSolver3::minParticlesPerCell,
+                      &PicSolver3::setMinParticlesPerCell,
+                      R"pbdoc(Minimum number of particles per cell.)pbdoc")
+        .def_property("maxParticlesPerCell", &PicSolver3::maxParticlesPerCell,
+                      &PicSolver3::setMaxParticlesPerCell,
+                      R"pbdoc(Maximum number of particles per cell.)pbdoc")
+        .def_property("particleSortingInterval",
+                      &PicSolver3::particleSortingInterval,
+                      &PicSolver3::setParticleSortingInterval,
+                      R"pbdoc(
+            The particle sorting interval in number of time-steps.
+
+            The particles are reordered in memory by the grid cell they belong
+            to, which changes the particle indices. Setting zero disables
+            sorting, which is the default.
+            )pbdoc")
+        .def_property("transferKernelType", &PicSolver3::transferKernelType,
+                      &PicSolver3::setTransferKernelType,
+                      R"pbdoc(
+            The kernel type for the particle-grid transfers.
+
+            Quadratic and cubic B-spline kernels give smoother transfers than
+            the default linear kernel at the cost of more samples per particle.
+            )pbdoc");
 }
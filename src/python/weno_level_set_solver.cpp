@@ -0,0 +1,22 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "weno_level_set_solver.h"
+#include "pybind11_utils.h"
+
+#include <jet/weno_level_set_solver3.h>
+
+namespace py = pybind11;
+using namespace jet;
+
+void addWenoLevelSetSolver3(py::module& m) {
+    py::class_<WenoLevelSetSolver3, WenoLevelSetSolver3Ptr,
+               IterativeLevelSetSolver3>(m, "WenoLevelSetSolver3",
+                                         R"pbdoc(
+         3-D fifth-order WENO-based iterative level set solver with TVD
+         Runge-Kutta time integration.
+         )pbdoc");
+}
@@ -15,6 +15,8 @@ using jet::VectorND;
 class MatrixMxN : public ::benchmark::Fixture {
  protected:
     jet::MatrixMxND mat;
+    jet::MatrixMxND mat2;
+    jet::MatrixMxND result;
     VectorND x;
     VectorND y;
 
@@ -25,9 +27,13 @@ class MatrixMxN : public ::benchmark::Fixture {
         const auto n = static_cast<size_t>(state.range(0));
 
         mat.resize(n, n);
+        mat2.resize(n, n);
         x.resize(n);
         y.resize(n);
-        mat.forEachIndex([&](size_t i, size_t j) { mat(i, j) = d(rng); });
+        mat.forEachIndex([&](size_t i, size_t j) {
+            mat(i, j) = d(rng);
+            mat2(i, j) = d(rng);
+        });
         x.forEachIndex([&](size_t i) {
             x[i] = d(rng);
             y[i] = d(rng);
@@ -42,3 +48,11 @@ BENCHMARK_DEFINE_F(MatrixMxN, Mvm)(benchmark::State& state) {
 }
 
 BENCHMARK_REGISTER_F(MatrixMxN, Mvm)->Arg(1 << 8)->Arg(1 << 10)->Arg(1 << 12);
+
+BENCHMARK_DEFINE_F(MatrixMxN, Mmm)(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        result = mat * mat2;
+    }
+}
+
+BENCHMARK_REGISTER_F(MatrixMxN, Mmm)->Arg(1 << 6)->Arg(1 << 8)->Arg(1 << 10);
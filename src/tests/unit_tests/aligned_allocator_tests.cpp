@@ -0,0 +1,86 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/aligned_allocator.h>
+#include <jet/array1.h>
+#include <jet/array2.h>
+#include <jet/array3.h>
+#include <jet/vector3.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace jet;
+
+namespace {
+
+bool isAligned(const void* ptr, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+}
+
+}  // namespace
+
+TEST(AlignedAllocator, Allocate) {
+    for (size_t n : {1, 3, 17, 1000}) {
+        AlignedAllocator<double> allocator;
+        double* ptr = allocator.allocate(n);
+        EXPECT_TRUE(isAligned(ptr, kDefaultArrayAlignment));
+        for (size_t i = 0; i < n; ++i) {
+            ptr[i] = static_cast<double>(i);
+        }
+        allocator.deallocate(ptr, n);
+
+        AlignedAllocator<char, 256> allocator256;
+        char* ptr256 = allocator256.allocate(n);
+        EXPECT_TRUE(isAligned(ptr256, 256));
+        allocator256.deallocate(ptr256, n);
+    }
+
+    // Rebinding keeps the alignment
+    std::vector<bool, AlignedAllocator<bool>> flags(1000, true);
+    EXPECT_TRUE(flags[999]);
+
+    AlignedAllocator<float> a;
+    AlignedAllocator<int> b(a);
+    EXPECT_TRUE(a == b);
+    EXPECT_FALSE(a != b);
+}
+
+TEST(AlignedAllocator, HugePages) {
+    EXPECT_FALSE(isHugePagesEnabled());
+
+    setHugePagesEnabled(true);
+    EXPECT_TRUE(isHugePagesEnabled());
+
+    Array1<double> large(kHugePageSize / sizeof(double) + 1, 1.0);
+    EXPECT_TRUE(isAligned(large.data(), kHugePageSize));
+    EXPECT_EQ(1.0, large[large.size() - 1]);
+
+    Array1<double> small(100);
+    EXPECT_TRUE(isAligned(small.data(), kDefaultArrayAlignment));
+
+    setHugePagesEnabled(false);
+    EXPECT_FALSE(isHugePagesEnabled());
+}
+
+TEST(AlignedAllocator, Arrays) {
+    Array1<float> arr1(7, 1.f);
+    EXPECT_TRUE(isAligned(arr1.data(), kDefaultArrayAlignment));
+    arr1.append(2.f);
+    EXPECT_TRUE(isAligned(arr1.data(), kDefaultArrayAlignment));
+
+    Array2<double> arr2(5, 3);
+    EXPECT_TRUE(isAligned(arr2.data(), kDefaultArrayAlignment));
+
+    Array3<Vector3D> arr3(3, 4, 5);
+    EXPECT_TRUE(isAligned(arr3.data(), kDefaultArrayAlignment));
+    arr3.resize(7, 2, 9);
+    EXPECT_TRUE(isAligned(arr3.data(), kDefaultArrayAlignment));
+
+    Array3<Vector3D> arr3Copy(arr3);
+    EXPECT_TRUE(isAligned(arr3Copy.data(), kDefaultArrayAlignment));
+}
@@ -5,6 +5,9 @@
 // property of any third parties.
 
 #include <jet/apic_solver3.h>
+#include <jet/grid_point_generator3.h>
+#include <jet/plane3.h>
+#include <jet/volume_particle_emitter3.h>
 #include <gtest/gtest.h>
 
 using namespace jet;
@@ -16,3 +19,45 @@ TEST(ApicSolver3, UpdateEmpty) {
         solver.update(frame);
     }
 }
+
+TEST(ApicSolver3, TransferKernels) {
+    const TransferKernelType types[] = {TransferKernelType::kLinear,
+                                        TransferKernelType::kQuadraticBSpline,
+                                        TransferKernelType::kCubicBSpline};
+
+    for (TransferKernelType type : types) {
+        auto solver = ApicSolver3::builder()
+                          .withResolution({8, 8, 8})
+                          .withDomainSizeX(1.0)
+                          .makeShared();
+        EXPECT_EQ(TransferKernelType::kLinear, solver->transferKernelType());
+        solver->setTransferKernelType(type);
+        EXPECT_EQ(type, solver->transferKernelType());
+
+        const BoundingBox3D domain = solver->gridSystemData()->boundingBox();
+        auto plane = Plane3::builder()
+                         .withNormal({0, 1, 0})
+                         .withPoint({0, 0.5 * domain.height(), 0})
+                         .makeShared();
+        auto emitter = VolumeParticleEmitter3::builder()
+                           .withSurface(plane)
+                           .withSpacing(0.5 * solver->gridSpacing().x)
+                           .withMaxRegion(domain)
+                           .withIsOneShot(true)
+                           .makeShared();
+        emitter->setPointGenerator(std::make_shared<GridPointGenerator3>());
+        solver->setParticleEmitter(emitter);
+
+        for (Frame frame(0, 1.0 / 60.0); frame.index < 3; ++frame) {
+            solver->update(frame);
+        }
+
+        // Water at rest should stay at rest
+        const auto particles = solver->particleSystemData();
+        const auto velocities = particles->velocities();
+        EXPECT_LT(0u, particles->numberOfParticles());
+        for (size_t i = 0; i < particles->numberOfParticles(); ++i) {
+            EXPECT_GT(0.1, velocities[i].length());
+        }
+    }
+}
@@ -156,6 +156,13 @@ TEST(Array3, ResizeMethod) {
                 }
             }
         }
+
+        // Same size keeps the storage
+        const float* data = arr.data();
+        arr.resize(1, 9, 4, 5.f);
+        EXPECT_EQ(data, arr.data());
+        EXPECT_FLOAT_EQ(0.f, arr(0, 0, 0));
+        EXPECT_FLOAT_EQ(3.f, arr(0, 8, 3));
     }
 }
 
@@ -0,0 +1,88 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array3.h>
+#include <jet/closest_point_extrapolation3.h>
+#include <jet/custom_scalar_field3.h>
+#include <gtest/gtest.h>
+
+using namespace jet;
+
+TEST(ClosestPointExtrapolation3, Plane) {
+    const Size3 size(10, 8, 6);
+    const Vector3D gridSpacing(0.5, 0.5, 0.5);
+    const Vector3D origin(0.25, 0.25, 0.25);
+
+    // Valid for x < 2
+    CustomScalarField3 sdf([](const Vector3D& x) { return x.x - 2.0; },
+                           [](const Vector3D&) { return Vector3D(1, 0, 0); });
+
+    Array3<double> data(size);
+    Array3<char> valid(size);
+    data.forEachIndex([&](size_t i, size_t j, size_t k) {
+        const Vector3D x = origin + gridSpacing * Vector3D(i, j, k);
+        valid(i, j, k) = sdf.sample(x) < 0.0;
+        data(i, j, k) = valid(i, j, k) ? x.y + 2.0 * x.z : -1.0;
+    });
+
+    Array3<double> output(data);
+    extrapolateToClosestPoints(data.constAccessor(), valid.constAccessor(),
+                               gridSpacing, origin, sdf, 1.5,
+                               output.accessor());
+
+    data.forEachIndex([&](size_t i, size_t j, size_t k) {
+        const Vector3D x = origin + gridSpacing * Vector3D(i, j, k);
+        if (valid(i, j, k) || x.x - 2.0 > 1.5) {
+            EXPECT_EQ(data(i, j, k), output(i, j, k));
+        } else {
+            // Constant along the normal
+            EXPECT_NEAR(x.y + 2.0 * x.z, output(i, j, k), 1e-12)
+                << i << ", " << j << ", " << k;
+        }
+    });
+
+    // In-place extrapolation
+    extrapolateToClosestPoints(data.constAccessor(), valid.constAccessor(),
+                               gridSpacing, origin, sdf, 1.5, data.accessor());
+    data.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(output(i, j, k), data(i, j, k));
+    });
+}
+
+TEST(ClosestPointExtrapolation3, Sphere) {
+    const Size3 size(20, 20, 20);
+    const Vector3D gridSpacing(0.1, 0.1, 0.1);
+    const Vector3D origin;
+    const Vector3D center(1.0, 1.0, 1.0);
+
+    CustomScalarField3 sdf([&](const Vector3D& x) {
+        return (x - center).length() - 0.5;
+    });
+
+    Array3<Vector3D> data(size);
+    Array3<char> valid(size);
+    data.forEachIndex([&](size_t i, size_t j, size_t k) {
+        const Vector3D x = origin + gridSpacing * Vector3D(i, j, k);
+        valid(i, j, k) = sdf.sample(x) < 0.0;
+        data(i, j, k) = valid(i, j, k) ? Vector3D(1, 2, 3) : Vector3D();
+    });
+
+    extrapolateToClosestPoints(data.constAccessor(), valid.constAccessor(),
+                               gridSpacing, origin, sdf, 0.3, data.accessor());
+
+    data.forEachIndex([&](size_t i, size_t j, size_t k) {
+        const Vector3D x = origin + gridSpacing * Vector3D(i, j, k);
+        const double phi = sdf.sample(x);
+        if (phi < 0.29) {
+            EXPECT_NEAR(0.0, data(i, j, k).distanceTo(Vector3D(1, 2, 3)),
+                        1e-12)
+                << i << ", " << j << ", " << k;
+        } else if (phi > 0.31) {
+            EXPECT_EQ(Vector3D(), data(i, j, k))
+                << i << ", " << j << ", " << k;
+        }
+    });
+}
@@ -0,0 +1,169 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array_samplers3.h>
+#include <jet/face_centered_grid3.h>
+#include <jet/face_centered_stencil3.h>
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace jet;
+
+TEST(FaceCenteredStencil3, Sample) {
+    const Size3 res(5, 7, 4);
+    const Vector3D h(0.5, 0.25, 0.75);
+    const Vector3D origin(-1.0, 2.0, 0.5);
+    FaceCenteredGrid3 grid(res, h, origin);
+    grid.fill([](const Vector3D& x) {
+        return Vector3D(std::sin(x.x + x.y), x.y * x.z, std::cos(x.z - x.x));
+    });
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(-0.5, 1.5);
+    const BoundingBox3D bbox = grid.boundingBox();
+    const Vector3D invH = 1.0 / h;
+
+    for (int n = 0; n < 200; ++n) {
+        // Includes the points outside of the domain to test clamping
+        const Vector3D pt =
+            bbox.lowerCorner +
+            Vector3D(d(rng), d(rng), d(rng)) * (bbox.upperCorner -
+                                                bbox.lowerCorner);
+
+        FaceCenteredStencil3<LinearTransferKernel> stencil(pt, origin, invH,
+                                                           res);
+        Vector3D actual = stencil.sample(grid.uConstAccessor(),
+                                         grid.vConstAccessor(),
+                                         grid.wConstAccessor());
+        Vector3D expected = grid.sample(pt);
+        EXPECT_NEAR(expected.x, actual.x, 1e-12);
+        EXPECT_NEAR(expected.y, actual.y, 1e-12);
+        EXPECT_NEAR(expected.z, actual.z, 1e-12);
+    }
+}
+
+TEST(FaceCenteredStencil3, Gradient) {
+    const Size3 res(6, 5, 4);
+    const Vector3D h(0.5, 0.25, 0.75);
+    const Vector3D origin(0.0, -1.0, 1.0);
+    FaceCenteredGrid3 grid(res, h, origin);
+    grid.fill([](const Vector3D& x) {
+        return Vector3D(x.x * x.y, std::sin(x.z) + x.x, x.y - x.z * x.z);
+    });
+
+    auto u = grid.uConstAccessor();
+    auto v = grid.vConstAccessor();
+    auto w = grid.wConstAccessor();
+    LinearArraySampler3<double, double> uSampler(u, h, grid.uOrigin());
+    LinearArraySampler3<double, double> vSampler(v, h, grid.vOrigin());
+    LinearArraySampler3<double, double> wSampler(w, h, grid.wOrigin());
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(0.0, 1.0);
+    const BoundingBox3D bbox = grid.boundingBox();
+    const Vector3D invH = 1.0 / h;
+
+    auto expectedGradient = [](const LinearArraySampler3<double, double>& s,
+                               const ConstArrayAccessor3<double>& data,
+                               const Vector3D& pt) {
+        std::array<Point3UI, 8> indices;
+        std::array<Vector3D, 8> weights;
+        s.getCoordinatesAndGradientWeights(pt, &indices, &weights);
+        Vector3D result;
+        for (int j = 0; j < 8; ++j) {
+            result += weights[j] * data(indices[j]);
+        }
+        return result;
+    };
+
+    for (int n = 0; n < 200; ++n) {
+        const Vector3D pt =
+            bbox.lowerCorner +
+            Vector3D(d(rng), d(rng), d(rng)) * (bbox.upperCorner -
+                                                bbox.lowerCorner);
+
+        FaceCenteredStencil3<LinearTransferKernel> stencil(pt, origin, invH,
+                                                           res);
+
+        Vector3D actual = stencil.u.gradient(u, invH);
+        Vector3D expected = expectedGradient(uSampler, u, pt);
+        EXPECT_NEAR(expected.x, actual.x, 1e-10);
+        EXPECT_NEAR(expected.y, actual.y, 1e-10);
+        EXPECT_NEAR(expected.z, actual.z, 1e-10);
+
+        actual = stencil.v.gradient(v, invH);
+        expected = expectedGradient(vSampler, v, pt);
+        EXPECT_NEAR(expected.x, actual.x, 1e-10);
+        EXPECT_NEAR(expected.y, actual.y, 1e-10);
+        EXPECT_NEAR(expected.z, actual.z, 1e-10);
+
+        actual = stencil.w.gradient(w, invH);
+        expected = expectedGradient(wSampler, w, pt);
+        EXPECT_NEAR(expected.x, actual.x, 1e-10);
+        EXPECT_NEAR(expected.y, actual.y, 1e-10);
+        EXPECT_NEAR(expected.z, actual.z, 1e-10);
+    }
+}
+
+TEST(FaceCenteredStencil3, HigherOrderKernels) {
+    const Size3 res(8, 9, 10);
+    const Vector3D h(0.5, 0.25, 0.75);
+    const Vector3D origin(-1.0, 2.0, 0.5);
+    FaceCenteredGrid3 grid(res, h, origin);
+
+    // B-splines reproduce linear functions away from the boundary
+    const Vector3D a(0.3, -1.2, 2.5);
+    grid.fill([&](const Vector3D& x) {
+        return Vector3D(a.dot(x), 2.0 * a.dot(x) + 1.0, -a.dot(x));
+    });
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(0.3, 0.7);
+    const BoundingBox3D bbox = grid.boundingBox();
+    const Vector3D invH = 1.0 / h;
+
+    for (int n = 0; n < 100; ++n) {
+        const Vector3D pt =
+            bbox.lowerCorner +
+            Vector3D(d(rng), d(rng), d(rng)) * (bbox.upperCorner -
+                                                bbox.lowerCorner);
+        const double f = a.dot(pt);
+
+        FaceCenteredStencil3<QuadraticBSplineTransferKernel> quadratic(
+            pt, origin, invH, res);
+        Vector3D actual = quadratic.sample(grid.uConstAccessor(),
+                                           grid.vConstAccessor(),
+                                           grid.wConstAccessor());
+        EXPECT_NEAR(f, actual.x, 1e-10);
+        EXPECT_NEAR(2.0 * f + 1.0, actual.y, 1e-10);
+        EXPECT_NEAR(-f, actual.z, 1e-10);
+
+        Vector3D gradient = quadratic.u.gradient(grid.uConstAccessor(), invH);
+        EXPECT_NEAR(a.x, gradient.x, 1e-10);
+        EXPECT_NEAR(a.y, gradient.y, 1e-10);
+        EXPECT_NEAR(a.z, gradient.z, 1e-10);
+
+        FaceCenteredStencil3<CubicBSplineTransferKernel> cubic(
+            pt, origin, invH, res);
+        actual = cubic.sample(grid.uConstAccessor(), grid.vConstAccessor(),
+                              grid.wConstAccessor());
+        EXPECT_NEAR(f, actual.x, 1e-10);
+        EXPECT_NEAR(2.0 * f + 1.0, actual.y, 1e-10);
+        EXPECT_NEAR(-f, actual.z, 1e-10);
+
+        gradient = cubic.w.gradient(grid.wConstAccessor(), invH);
+        EXPECT_NEAR(-a.x, gradient.x, 1e-10);
+        EXPECT_NEAR(-a.y, gradient.y, 1e-10);
+        EXPECT_NEAR(-a.z, gradient.z, 1e-10);
+
+        double weightSum = 0.0;
+        cubic.v.forEachSample([&](size_t, size_t, size_t, double weight) {
+            weightSum += weight;
+        });
+        EXPECT_NEAR(1.0, weightSum, 1e-12);
+    }
+}
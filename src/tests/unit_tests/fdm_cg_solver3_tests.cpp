@@ -10,6 +10,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
 using namespace jet;
 
 TEST(FdmCgSolver3, Solve) {
@@ -32,3 +35,23 @@ TEST(FdmCgSolver3, SolveCompressed) {
 
     EXPECT_GT(solver.tolerance(), solver.lastResidual());
 }
+
+TEST(FdmCgSolver3, SolveMultiple) {
+    FdmMultiLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestMultiLinearSystem(
+        &system, {12, 13, 14}, 2);
+
+    FdmCgSolver3 solver(100, 1e-9);
+    EXPECT_TRUE(solver.solveMultiple(&system));
+
+    // Residuals of all the systems should be small
+    FdmMultiVector3 r;
+    r.resize(system.A.size(), 2);
+    FdmMultiBlas3::residual(system.A, system.x, system.b, &r);
+
+    std::vector<double> rr;
+    FdmMultiBlas3::dot(r, r, &rr);
+    EXPECT_EQ(2u, rr.size());
+    EXPECT_GT(1e-8, std::sqrt(rr[0]));
+    EXPECT_GT(1e-8, std::sqrt(rr[1]));
+}
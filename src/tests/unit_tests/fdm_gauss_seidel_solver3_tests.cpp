@@ -83,6 +83,52 @@ TEST(FdmGaussSeidelSolver3, RelaxRedBlack) {
     }
 }
 
+TEST(FdmGaussSeidelSolver3, RelaxRedBlackMultipleIterations) {
+    FdmLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system,
+                                                            {7, 6, 11});
+    const FdmMatrix3& A = system.A;
+    const FdmVector3& b = system.b;
+    const Size3 size = A.size();
+    const double sorFactor = 1.5;
+
+    // Reference red-black sweeps over the whole grid per color
+    auto relaxColor = [&](FdmVector3* x_, size_t color) {
+        FdmVector3& x = *x_;
+        x.forEachIndex([&](size_t i, size_t j, size_t k) {
+            if ((i + j + k) % 2 != color) {
+                return;
+            }
+
+            double r =
+                ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k) : 0.0) +
+                ((i + 1 < size.x) ? A(i, j, k).right * x(i + 1, j, k) : 0.0) +
+                ((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k) : 0.0) +
+                ((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k) : 0.0) +
+                ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1) : 0.0) +
+                ((k + 1 < size.z) ? A(i, j, k).front * x(i, j, k + 1) : 0.0);
+
+            x(i, j, k) = (1.0 - sorFactor) * x(i, j, k) +
+                         sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
+        });
+    };
+
+    for (unsigned int n : {1u, 2u, 5u}) {
+        FdmVector3 expected(size, 0.0);
+        for (unsigned int iter = 0; iter < n; ++iter) {
+            relaxColor(&expected, 0);
+            relaxColor(&expected, 1);
+        }
+
+        FdmVector3 actual(size, 0.0);
+        FdmGaussSeidelSolver3::relaxRedBlack(A, b, sorFactor, n, &actual);
+
+        actual.forEachIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_DOUBLE_EQ(expected(i, j, k), actual(i, j, k));
+        });
+    }
+}
+
 TEST(FdmGaussSeidelSolver3, SolveCompressedLowRes) {
     FdmCompressedLinearSystem3 system;
     FdmLinearSystemSolverTestHelper3::buildTestCompressedLinearSystem(
@@ -43,3 +43,105 @@ TEST(FdmIccgSolver3, SolveCompressed) {
 
     EXPECT_GT(solver.tolerance(), solver.lastResidual());
 }
+
+TEST(FdmIccgSolver3, SolveWithSameMatrix) {
+    FdmLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system,
+                                                            {16, 16, 16});
+
+    FdmIccgSolver3 solver(100, 1e-9);
+
+    // Falls back to the full solve without a preconditioner
+    EXPECT_TRUE(solver.solveWithSameMatrix(&system));
+    FdmVector3 x0(system.x);
+
+    system.b.forEachIndex([&](size_t i, size_t j, size_t k) {
+        system.b(i, j, k) *= 2.0;
+    });
+    EXPECT_TRUE(solver.solveWithSameMatrix(&system));
+
+    FdmLinearSystem3 other = system;
+    FdmIccgSolver3 otherSolver(100, 1e-9);
+    EXPECT_TRUE(otherSolver.solve(&other));
+
+    system.x.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(2.0 * x0(i, j, k), system.x(i, j, k), 1e-6);
+        EXPECT_DOUBLE_EQ(other.x(i, j, k), system.x(i, j, k));
+    });
+    EXPECT_EQ(otherSolver.lastNumberOfIterations(),
+              solver.lastNumberOfIterations());
+}
+
+TEST(FdmIccgSolver3, SolveMultiple) {
+    FdmMultiLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestMultiLinearSystem(
+        &system, {12, 13, 14}, 3);
+
+    FdmIccgSolver3 solver(100, 1e-9);
+    EXPECT_TRUE(solver.solveMultiple(&system));
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+
+    // Same as solving one by one
+    for (size_t n = 0; n < 3; ++n) {
+        FdmLinearSystem3 single;
+        single.A.set(system.A);
+        single.x.resize(system.A.size());
+        system.b.getVector(n, &single.b);
+
+        FdmIccgSolver3 singleSolver(100, 1e-9);
+        EXPECT_TRUE(singleSolver.solve(&single));
+
+        single.x.forEachIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_NEAR(single.x(i, j, k), system.x(i, j, k, n), 1e-8);
+        });
+    }
+}
+
+TEST(FdmIccgSolver3, SolveMultipleWithSameMatrix) {
+    FdmMultiLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestMultiLinearSystem(
+        &system, {12, 13, 14}, 3);
+
+    FdmIccgSolver3 solver(100, 1e-9);
+
+    // Falls back to the full solve without a preconditioner
+    EXPECT_TRUE(solver.solveMultipleWithSameMatrix(&system));
+    FdmMultiVector3 x0 = system.x;
+
+    EXPECT_TRUE(solver.solveMultipleWithSameMatrix(&system));
+    for (size_t n = 0; n < 3; ++n) {
+        system.A.forEachIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_DOUBLE_EQ(x0(i, j, k, n), system.x(i, j, k, n));
+        });
+    }
+
+    // The factorization is kept while the matrix array is the same, so an
+    // in-place change of the matrix is solved with the old preconditioner.
+    system.A.forEachIndex([&](size_t i, size_t j, size_t k) {
+        system.A(i, j, k).center += 1.0;
+    });
+
+    FdmMultiLinearSystem3 other = system;
+    FdmIccgSolver3 otherSolver(100, 1e-9);
+    EXPECT_TRUE(otherSolver.solveMultiple(&other));
+
+    EXPECT_TRUE(solver.solveMultipleWithSameMatrix(&system));
+    double maxDiff = 0.0;
+    for (size_t n = 0; n < 3; ++n) {
+        system.A.forEachIndex([&](size_t i, size_t j, size_t k) {
+            const double diff =
+                std::fabs(other.x(i, j, k, n) - system.x(i, j, k, n));
+            EXPECT_NEAR(0.0, diff, 1e-8);
+            maxDiff = std::max(maxDiff, diff);
+        });
+    }
+    EXPECT_LT(0.0, maxDiff);
+
+    // solveMultiple() always rebuilds the factorization
+    EXPECT_TRUE(solver.solveMultiple(&system));
+    for (size_t n = 0; n < 3; ++n) {
+        system.A.forEachIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_DOUBLE_EQ(other.x(i, j, k, n), system.x(i, j, k, n));
+        });
+    }
+}
@@ -32,3 +32,26 @@ TEST(FdmJacobiSolver3, SolveCompressed) {
 
     EXPECT_GT(solver.tolerance(), solver.lastResidual());
 }
+
+TEST(FdmJacobiSolver3, RelaxMultipleIterations) {
+    FdmLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system,
+                                                            {7, 6, 11});
+
+    // Fused iterations should match the single iterations exactly
+    for (unsigned int n : {1u, 2u, 5u, 13u}) {
+        FdmVector3 expected(system.x.size(), 0.0);
+        FdmVector3 temp(system.x.size(), 0.0);
+        for (unsigned int iter = 0; iter < n; ++iter) {
+            FdmJacobiSolver3::relax(system.A, system.b, &expected, &temp);
+            expected.swap(temp);
+        }
+
+        FdmVector3 actual(system.x.size(), 0.0);
+        FdmJacobiSolver3::relax(system.A, system.b, n, &actual, &temp);
+
+        actual.forEachIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_DOUBLE_EQ(expected(i, j, k), actual(i, j, k));
+        });
+    }
+}
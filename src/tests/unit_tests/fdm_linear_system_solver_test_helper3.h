@@ -6,6 +6,8 @@
 
 #include <jet/fdm_linear_system_solver3.h>
 
+#include <cmath>
+
 namespace jet {
 
 class FdmLinearSystemSolverTestHelper3 {
@@ -48,6 +50,28 @@ class FdmLinearSystemSolverTestHelper3 {
         });
     }
 
+    static void buildTestMultiLinearSystem(FdmMultiLinearSystem3* system,
+                                           const Size3& size,
+                                           size_t numberOfVectors) {
+        FdmLinearSystem3 single;
+        buildTestLinearSystem(&single, size);
+
+        // Makes the matrix non-singular like a diffusion system
+        single.A.forEachIndex([&](size_t i, size_t j, size_t k) {
+            single.A(i, j, k).center += 1.0;
+        });
+
+        system->resize(size, numberOfVectors);
+        system->A.set(single.A);
+        system->x.data.set(0.0);
+        for (size_t n = 0; n < numberOfVectors; ++n) {
+            single.b.forEachIndex([&](size_t i, size_t j, size_t k) {
+                system->b(i, j, k, n) = std::sin(static_cast<double>(
+                    (n + 1) * (i + 2 * j + 3 * k)));
+            });
+        }
+    }
+
     static void buildTestCompressedLinearSystem(
         FdmCompressedLinearSystem3* system, const Size3& size) {
         Array3<size_t> coordToIndex(size);
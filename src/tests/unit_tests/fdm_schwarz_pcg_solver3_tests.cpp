@@ -0,0 +1,77 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "fdm_linear_system_solver_test_helper3.h"
+
+#include <jet/fdm_cg_solver3.h>
+#include <jet/fdm_schwarz_pcg_solver3.h>
+
+#include <gtest/gtest.h>
+
+using namespace jet;
+
+namespace {
+
+double mean(const FdmVector3& x) {
+    double sum = 0.0;
+    x.forEachIndex([&](size_t i, size_t j, size_t k) { sum += x(i, j, k); });
+    return sum / static_cast<double>(x.width() * x.height() * x.depth());
+}
+
+}  // namespace
+
+TEST(FdmSchwarzPcgSolver3, SolveLowRes) {
+    FdmLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system, {3, 3, 3});
+
+    FdmSchwarzPcgSolver3 solver(100, 1e-9, 2, 1);
+    solver.solve(&system);
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+    EXPECT_EQ(2u, solver.numberOfSubdomains());
+    EXPECT_EQ(1u, solver.numberOfGhostLayers());
+}
+
+TEST(FdmSchwarzPcgSolver3, Solve) {
+    FdmLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system,
+                                                            {16, 16, 16});
+    FdmLinearSystem3 system2 = system;
+
+    FdmCgSolver3 cgSolver(1000, 1e-8);
+    EXPECT_TRUE(cgSolver.solve(&system2));
+
+    // The test system is pure Neumann, so the solutions are compared without
+    // the constant offset.
+    const double mean2 = mean(system2.x);
+
+    // Any decomposition should converge to the same solution
+    for (unsigned int numberOfSubdomains : {1u, 4u, 100u}) {
+        for (unsigned int numberOfGhostLayers : {0u, 2u}) {
+            FdmSchwarzPcgSolver3 solver(1000, 1e-8, numberOfSubdomains,
+                                        numberOfGhostLayers);
+            EXPECT_TRUE(solver.solve(&system));
+            EXPECT_GT(solver.tolerance(), solver.lastResidual());
+
+            const double mean1 = mean(system.x);
+            system.x.forEachIndex([&](size_t i, size_t j, size_t k) {
+                EXPECT_NEAR(system2.x(i, j, k) - mean2,
+                            system.x(i, j, k) - mean1, 1e-5);
+            });
+        }
+    }
+}
+
+TEST(FdmSchwarzPcgSolver3, SolveCompressed) {
+    FdmCompressedLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestCompressedLinearSystem(
+        &system, {3, 3, 3});
+
+    FdmSchwarzPcgSolver3 solver(100, 1e-4, 3);
+    solver.solveCompressed(&system);
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
@@ -5,10 +5,46 @@
 // property of any third parties.
 
 #include <jet/flip_solver3.h>
+#include <jet/grid_point_generator3.h>
+#include <jet/parallel.h>
+#include <jet/plane3.h>
+#include <jet/volume_particle_emitter3.h>
 #include <gtest/gtest.h>
 
 using namespace jet;
 
+namespace {
+
+FlipSolver3Ptr buildNarrowBandTestSolver(bool useNarrowBand) {
+    auto solver = FlipSolver3::builder()
+                      .withResolution({16, 16, 16})
+                      .withDomainSizeX(1.0)
+                      .makeShared();
+    solver->setIsUsingNarrowBand(useNarrowBand);
+
+    const BoundingBox3D domain = solver->gridSystemData()->boundingBox();
+    auto plane = Plane3::builder()
+                     .withNormal({0, 1, 0})
+                     .withPoint({0, 0.75 * domain.height(), 0})
+                     .makeShared();
+    auto emitter = VolumeParticleEmitter3::builder()
+                       .withSurface(plane)
+                       .withSpacing(0.5 * solver->gridSpacing().x)
+                       .withMaxRegion(domain)
+                       .withIsOneShot(true)
+                       .makeShared();
+    emitter->setPointGenerator(std::make_shared<GridPointGenerator3>());
+    solver->setParticleEmitter(emitter);
+
+    for (Frame frame; frame.index < 3; ++frame) {
+        solver->update(frame);
+    }
+
+    return solver;
+}
+
+}  // namespace
+
 TEST(FlipSolver3, UpdateEmpty) {
     FlipSolver3 solver;
 
@@ -29,3 +65,70 @@ TEST(FlipSolver3, PicBlendingFactor) {
     solver.setPicBlendingFactor(-0.9);
     EXPECT_EQ(0.0, solver.picBlendingFactor());
 }
+
+TEST(FlipSolver3, NarrowBandWidth) {
+    FlipSolver3 solver;
+    EXPECT_FALSE(solver.isUsingNarrowBand());
+    EXPECT_EQ(3.0, solver.narrowBandWidth());
+    EXPECT_EQ(nullptr, solver.narrowBandLevelSet());
+    const size_t numberOfScalarData =
+        solver.gridSystemData()->numberOfScalarData();
+
+    solver.setIsUsingNarrowBand(true);
+    EXPECT_TRUE(solver.isUsingNarrowBand());
+    EXPECT_NE(nullptr, solver.narrowBandLevelSet());
+    EXPECT_EQ(numberOfScalarData + 1,
+              solver.gridSystemData()->numberOfScalarData());
+
+    // The level set is added only once
+    solver.setIsUsingNarrowBand(false);
+    solver.setIsUsingNarrowBand(true);
+    EXPECT_EQ(numberOfScalarData + 1,
+              solver.gridSystemData()->numberOfScalarData());
+
+    solver.setNarrowBandWidth(4.5);
+    EXPECT_EQ(4.5, solver.narrowBandWidth());
+
+    solver.setNarrowBandWidth(0.5);
+    EXPECT_EQ(2.0, solver.narrowBandWidth());
+}
+
+TEST(FlipSolver3, NarrowBandRemovesInteriorParticles) {
+    auto fullSolver = buildNarrowBandTestSolver(false);
+    auto narrowBandSolver = buildNarrowBandTestSolver(true);
+
+    const size_t numberOfFullParticles =
+        fullSolver->particleSystemData()->numberOfParticles();
+    const size_t numberOfNarrowBandParticles =
+        narrowBandSolver->particleSystemData()->numberOfParticles();
+    EXPECT_GT(numberOfNarrowBandParticles, 0u);
+    EXPECT_LT(numberOfNarrowBandParticles, numberOfFullParticles / 2);
+
+    // The interior should still be liquid
+    const Vector3D interiorPt(0.5, 0.2, 0.5);
+    const double dx = narrowBandSolver->gridSpacing().x;
+    EXPECT_LT(narrowBandSolver->signedDistanceField()->sample(interiorPt), 0.0);
+    EXPECT_LT(narrowBandSolver->narrowBandLevelSet()->sample(interiorPt),
+              -narrowBandSolver->narrowBandWidth() * dx);
+}
+
+TEST(FlipSolver3, NarrowBandReseedingIsDeterministic) {
+    const unsigned int prevNumThreads = maxNumberOfThreads();
+
+    setMaxNumberOfThreads(1);
+    auto serialSolver = buildNarrowBandTestSolver(true);
+    setMaxNumberOfThreads(4);
+    auto parallelSolver = buildNarrowBandTestSolver(true);
+    setMaxNumberOfThreads(prevNumThreads);
+
+    auto serialParticles = serialSolver->particleSystemData();
+    auto parallelParticles = parallelSolver->particleSystemData();
+    ASSERT_EQ(serialParticles->numberOfParticles(),
+              parallelParticles->numberOfParticles());
+
+    auto serialPositions = serialParticles->positions();
+    auto parallelPositions = parallelParticles->positions();
+    for (size_t i = 0; i < serialParticles->numberOfParticles(); ++i) {
+        EXPECT_EQ(serialPositions[i], parallelPositions[i]);
+    }
+}
@@ -6,12 +6,18 @@
 
 #include <jet/cell_centered_scalar_grid3.h>
 #include <jet/cell_centered_vector_grid3.h>
+#include <jet/custom_implicit_surface3.h>
 #include <jet/custom_vector_field3.h>
+#include <jet/face_centered_grid3.h>
 #include <jet/level_set_utils.h>
+#include <jet/plane3.h>
 #include <jet/sphere3.h>
 #include <jet/volume_grid_emitter3.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+
 using namespace jet;
 
 TEST(VolumeGridEmitter3, Velocity) {
@@ -117,3 +123,133 @@ TEST(VolumeGridEmitter3, StepFunction) {
         EXPECT_NEAR(answer, acttual, 1e-6);
     });
 }
+
+TEST(VolumeGridEmitter3, BoundedSource) {
+    const Vector3D center(0.5, 0.75, 0.5);
+    const double radius = 0.1;
+    std::atomic<size_t> numQueries(0);
+    auto sdf = [&](const Vector3D& pt) {
+        ++numQueries;
+        return (pt - center).length() - radius;
+    };
+    auto source = std::make_shared<CustomImplicitSurface3>(
+        sdf, BoundingBox3D(center - Vector3D(radius, radius, radius),
+                           center + Vector3D(radius, radius, radius)));
+
+    auto emitter = VolumeGridEmitter3::builder()
+        .withSourceRegion(source)
+        .withIsOneShot(false)
+        .makeShared();
+
+    auto grid = CellCenteredScalarGrid3::builder()
+        .withResolution({32, 32, 32})
+        .withGridSpacing({1.0/32.0, 1.0/32.0, 1.0/32.0})
+        .makeShared();
+
+    emitter->addStepFunctionTarget(grid, 3.0, 7.0);
+    emitter->update(0.0, 0.01);
+
+    // Only the points around the box (12^3 at most) should be queried
+    EXPECT_GT(numQueries, 0u);
+    EXPECT_LE(numQueries, 12u * 12u * 12u);
+
+    auto pos = grid->dataPosition();
+    grid->forEachDataPointIndex([&] (size_t i, size_t j, size_t k) {
+        Vector3D gx = pos(i, j, k);
+        double answer = (center - gx).length() - radius;
+        answer = 4.0 * (1.0 - smearedHeavisideSdf(answer * 32.0)) + 3.0;
+        EXPECT_NEAR(answer, (*grid)(i, j, k), 1e-6);
+    });
+
+    // Only the points inside the box are queried if the old values are not
+    // larger than the distance to the box
+    auto sdfGrid = CellCenteredScalarGrid3::builder()
+        .withResolution({32, 32, 32})
+        .withGridSpacing({1.0/32.0, 1.0/32.0, 1.0/32.0})
+        .withInitialValue(0.0)
+        .makeShared();
+    auto emitter2 = VolumeGridEmitter3::builder()
+        .withSourceRegion(source)
+        .makeShared();
+    emitter2->addSignedDistanceTarget(sdfGrid);
+
+    numQueries = 0;
+    emitter2->update(0.0, 0.01);
+    EXPECT_GT(numQueries, 0u);
+    EXPECT_LE(numQueries, 8u * 8u * 8u);
+
+    sdfGrid->forEachDataPointIndex([&] (size_t i, size_t j, size_t k) {
+        Vector3D gx = pos(i, j, k);
+        double answer = std::min((center - gx).length() - radius, 0.0);
+        EXPECT_DOUBLE_EQ(answer, (*sdfGrid)(i, j, k));
+    });
+}
+
+TEST(VolumeGridEmitter3, FaceCenteredVelocity) {
+    auto sphere = Sphere3::builder()
+        .withCenter({0.5, 0.75, 0.5})
+        .withRadius(0.15)
+        .makeShared();
+
+    auto emitter = VolumeGridEmitter3::builder()
+        .withSourceRegion(sphere)
+        .makeShared();
+
+    auto grid = FaceCenteredGrid3::builder()
+        .withResolution({16, 16, 16})
+        .withGridSpacing({1.0/16.0, 1.0/16.0, 1.0/16.0})
+        .withInitialValue({1.0, 2.0, 3.0})
+        .makeShared();
+
+    auto mapper = [] (double, const Vector3D&, const Vector3D& oldVal) {
+        return oldVal + Vector3D(10.0, 20.0, 30.0);
+    };
+    emitter->addTarget(grid, mapper);
+
+    emitter->update(0.0, 0.01);
+
+    auto isInside = [&](const Vector3D& pt) {
+        return isInsideSdf((pt - sphere->center).length() - sphere->radius);
+    };
+    auto uPos = grid->uPosition();
+    grid->forEachUIndex([&] (size_t i, size_t j, size_t k) {
+        double answer = isInside(uPos(i, j, k)) ? 11.0 : 1.0;
+        EXPECT_DOUBLE_EQ(answer, grid->u(i, j, k));
+    });
+    auto vPos = grid->vPosition();
+    grid->forEachVIndex([&] (size_t i, size_t j, size_t k) {
+        double answer = isInside(vPos(i, j, k)) ? 22.0 : 2.0;
+        EXPECT_DOUBLE_EQ(answer, grid->v(i, j, k));
+    });
+    auto wPos = grid->wPosition();
+    grid->forEachWIndex([&] (size_t i, size_t j, size_t k) {
+        double answer = isInside(wPos(i, j, k)) ? 33.0 : 3.0;
+        EXPECT_DOUBLE_EQ(answer, grid->w(i, j, k));
+    });
+}
+
+TEST(VolumeGridEmitter3, UnboundedSource) {
+    auto plane = Plane3::builder()
+        .withNormal({0, 1, 0})
+        .withPoint({0, 0.5, 0})
+        .makeShared();
+
+    auto emitter = VolumeGridEmitter3::builder()
+        .withSourceRegion(plane)
+        .makeShared();
+
+    auto grid = CellCenteredScalarGrid3::builder()
+        .withResolution({16, 16, 16})
+        .withGridSpacing({1.0/16.0, 1.0/16.0, 1.0/16.0})
+        .withInitialValue(kMaxD)
+        .makeShared();
+
+    emitter->addSignedDistanceTarget(grid);
+
+    emitter->update(0.0, 0.01);
+
+    auto pos = grid->dataPosition();
+    grid->forEachDataPointIndex([&] (size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(pos(i, j, k).y - 0.5, (*grid)(i, j, k), 1e-12);
+    });
+}
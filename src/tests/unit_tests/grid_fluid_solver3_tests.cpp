@@ -21,6 +21,7 @@ TEST(GridFluidSolver3, Constructor) {
     EXPECT_GE(solver.viscosityCoefficient(), 0.0);
     EXPECT_GT(solver.maxCfl(), 0.0);
     EXPECT_EQ(kDirectionAll, solver.closedDomainBoundaryFlag());
+    EXPECT_EQ(ExtrapolationType::kPropagation, solver.extrapolationType());
 
     // Check grid system data
     EXPECT_TRUE(solver.gridSystemData() != nullptr);
@@ -95,3 +96,27 @@ TEST(GridFluidSolver3, GravityOnly) {
         EXPECT_NEAR(0.0, solver.velocity()->w(i, j, k), 1e-8);
     });
 }
+
+TEST(GridFluidSolver3, Cfl) {
+    GridFluidSolver3 solver;
+    solver.setGravity(Vector3D(0, -10, 0.0));
+    solver.resizeGrid(
+        Size3(5, 6, 7),
+        Vector3D(0.5, 0.25, 1.0),
+        Vector3D());
+
+    solver.velocity()->fill([](const Vector3D& x) {
+        return Vector3D(x.z, 2.0 * x.y, -x.x);
+    });
+
+    // Serial reference with the cell-center velocities
+    auto vel = solver.velocity();
+    double maxVel = 0.0;
+    vel->forEachCellIndex([&](size_t i, size_t j, size_t k) {
+        Vector3D v = vel->valueAtCellCenter(i, j, k)
+            + 0.1 * Vector3D(0, -10, 0.0);
+        maxVel = std::max(maxVel, max3(v.x, v.y, v.z));
+    });
+
+    EXPECT_DOUBLE_EQ(maxVel * 0.1 / 0.25, solver.cfl(0.1));
+}
@@ -5,6 +5,7 @@
 // property of any third parties.
 
 #include <jet/cell_centered_scalar_grid3.h>
+#include <jet/face_centered_grid3.h>
 #include <jet/grid_forward_euler_diffusion_solver3.h>
 #include <gtest/gtest.h>
 
@@ -27,3 +28,62 @@ TEST(GridForwardEulerDiffusionSolver3, Solve) {
     EXPECT_DOUBLE_EQ(1.0/12.0, dst(1, 1, 2));
     EXPECT_DOUBLE_EQ(1.0/2.0,  dst(1, 1, 1));
 }
+
+TEST(GridForwardEulerDiffusionSolver3, SolveWithSubSteps) {
+    const Size3 res(9, 7, 8);
+    const double coeff = 0.02;
+    const double dt = 1.0;
+    const unsigned int numberOfSubSteps = 5;
+
+    CellCenteredScalarGrid3 src(res, Vector3D(0.25, 0.25, 0.25));
+    src.fill([](const Vector3D& x) {
+        return std::sin(4.0 * x.x) * std::cos(3.0 * x.y) + x.z;
+    });
+
+    GridForwardEulerDiffusionSolver3 diffusionSolver;
+    EXPECT_EQ(1u, diffusionSolver.numberOfSubSteps());
+
+    // Reference is the repeated single step solves
+    CellCenteredScalarGrid3 expected(src), temp(src);
+    for (unsigned int n = 0; n < numberOfSubSteps; ++n) {
+        diffusionSolver.solve(expected, coeff, dt / numberOfSubSteps, &temp);
+        expected.swap(&temp);
+    }
+
+    diffusionSolver.setNumberOfSubSteps(numberOfSubSteps);
+    EXPECT_EQ(numberOfSubSteps, diffusionSolver.numberOfSubSteps());
+
+    CellCenteredScalarGrid3 actual(src);
+    diffusionSolver.solve(src, coeff, dt, &actual);
+
+    actual.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(expected(i, j, k), actual(i, j, k));
+    });
+
+    FaceCenteredGrid3 vsrc(res, Vector3D(0.25, 0.25, 0.25));
+    vsrc.fill([](const Vector3D& x) {
+        return Vector3D(std::sin(4.0 * x.y), x.x * x.z, std::cos(2.0 * x.x));
+    });
+
+    diffusionSolver.setNumberOfSubSteps(1);
+    FaceCenteredGrid3 vexpected(vsrc), vtemp(vsrc);
+    for (unsigned int n = 0; n < numberOfSubSteps; ++n) {
+        diffusionSolver.solve(vexpected, coeff, dt / numberOfSubSteps,
+                              &vtemp);
+        vexpected.swap(&vtemp);
+    }
+
+    diffusionSolver.setNumberOfSubSteps(numberOfSubSteps);
+    FaceCenteredGrid3 vactual(vsrc);
+    diffusionSolver.solve(vsrc, coeff, dt, &vactual);
+
+    vactual.forEachUIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(vexpected.u(i, j, k), vactual.u(i, j, k));
+    });
+    vactual.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(vexpected.v(i, j, k), vactual.v(i, j, k));
+    });
+    vactual.forEachWIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(vexpected.w(i, j, k), vactual.w(i, j, k));
+    });
+}
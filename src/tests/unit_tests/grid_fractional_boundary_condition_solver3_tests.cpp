@@ -89,3 +89,53 @@ TEST(GridFractionalBoundaryConditionSolver3, OpenDomain) {
         }
     });
 }
+
+TEST(GridFractionalBoundaryConditionSolver3, ColliderUpdate) {
+    Size3 gridSize(10, 10, 10);
+    Vector3D gridSpacing(1.0, 1.0, 1.0);
+    Vector3D gridOrigin(-5.0, -5.0, -5.0);
+
+    auto plane = std::make_shared<Plane3>(Vector3D(1, 0, 0), Vector3D());
+    auto collider = std::make_shared<RigidBodyCollider3>(plane);
+
+    GridFractionalBoundaryConditionSolver3 bndSolver;
+    bndSolver.updateCollider(collider, gridSize, gridSpacing, gridOrigin);
+
+    FaceCenteredGrid3 velocity(gridSize, gridSpacing, gridOrigin);
+    velocity.fill(Vector3D(1.0, 1.0, 1.0));
+    bndSolver.constrainVelocity(&velocity);
+
+    // Repeated calls should give the same result
+    FaceCenteredGrid3 velocity2(gridSize, gridSpacing, gridOrigin);
+    velocity2.fill(Vector3D(1.0, 1.0, 1.0));
+    bndSolver.constrainVelocity(&velocity2);
+
+    velocity.forEachUIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(velocity.u(i, j, k), velocity2.u(i, j, k));
+    });
+    EXPECT_DOUBLE_EQ(0.0, velocity.u(2, 5, 5));
+    EXPECT_DOUBLE_EQ(1.0, velocity.u(7, 5, 5));
+
+    // Moving the collider should invalidate the cached face states
+    plane->point = Vector3D(2.5, 0.0, 0.0);
+    bndSolver.updateCollider(collider, gridSize, gridSpacing, gridOrigin);
+
+    velocity.fill(Vector3D(1.0, 1.0, 1.0));
+    bndSolver.constrainVelocity(&velocity);
+
+    GridFractionalBoundaryConditionSolver3 freshSolver;
+    freshSolver.updateCollider(collider, gridSize, gridSpacing, gridOrigin);
+    velocity2.fill(Vector3D(1.0, 1.0, 1.0));
+    freshSolver.constrainVelocity(&velocity2);
+
+    velocity.forEachUIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(velocity2.u(i, j, k), velocity.u(i, j, k));
+    });
+    velocity.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(velocity2.v(i, j, k), velocity.v(i, j, k));
+    });
+    velocity.forEachWIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(velocity2.w(i, j, k), velocity.w(i, j, k));
+    });
+    EXPECT_DOUBLE_EQ(0.0, velocity.u(7, 5, 5));
+}
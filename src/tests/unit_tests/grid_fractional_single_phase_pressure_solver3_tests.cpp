@@ -5,6 +5,7 @@
 // property of any third parties.
 
 #include <jet/cell_centered_scalar_grid3.h>
+#include <jet/custom_scalar_field3.h>
 #include <jet/face_centered_grid3.h>
 #include <jet/fdm_iccg_solver3.h>
 #include <jet/fdm_mgpcg_solver3.h>
@@ -131,3 +132,157 @@ TEST(GridFractionalSinglePhasePressureSolver3, SolveFreeSurfaceCompressed) {
         }
     }
 }
+
+TEST(GridFractionalSinglePhasePressureSolver3, IncrementalRebuild) {
+    const double h = 1.0 / 12.0;
+    FaceCenteredGrid3 vel(12, 12, 12, h, h, h), temp(12, 12, 12, h, h, h);
+    vel.fill([](const Vector3D& x) {
+        return Vector3D(std::sin(4.0 * x.y), x.x * x.z, std::cos(3.0 * x.x));
+    });
+
+    // Collider and fluid surface which move between the solves
+    auto boundarySdf = [](double offset) {
+        return CustomScalarField3([offset](const Vector3D& x) {
+            return x.distanceTo(Vector3D(0.5 + offset, 0.3, 0.5)) - 0.2;
+        });
+    };
+    auto fluidSdf = [](double offset) {
+        return CustomScalarField3(
+            [offset](const Vector3D& x) { return x.y - 0.62 - offset; });
+    };
+    const ConstantVectorField3 boundaryVel({0.1, 0.0, 0.0});
+
+    for (bool useMg : {false, true}) {
+        auto makeSolver = [useMg]() -> FdmLinearSystemSolver3Ptr {
+            if (useMg) {
+                return std::make_shared<FdmMgpcgSolver3>(200, 3, 5, 5, 10, 10,
+                                                         1e-12);
+            }
+            return std::make_shared<FdmIccgSolver3>(500, 1e-12);
+        };
+
+        GridFractionalSinglePhasePressureSolver3 solver;
+        solver.setLinearSystemSolver(makeSolver());
+        for (double offset : {0.0, 0.01, 0.0101, 0.05}) {
+            solver.solve(vel, 1.0, &temp, boundarySdf(offset), boundaryVel,
+                         fluidSdf(offset));
+
+            // Fresh solver builds the system from scratch
+            FaceCenteredGrid3 ref(temp);
+            GridFractionalSinglePhasePressureSolver3 refSolver;
+            refSolver.setLinearSystemSolver(makeSolver());
+            refSolver.solve(vel, 1.0, &ref, boundarySdf(offset), boundaryVel,
+                            fluidSdf(offset));
+
+            temp.forEachUIndex([&](size_t i, size_t j, size_t k) {
+                EXPECT_NEAR(ref.u(i, j, k), temp.u(i, j, k), 1e-7);
+            });
+            temp.forEachVIndex([&](size_t i, size_t j, size_t k) {
+                EXPECT_NEAR(ref.v(i, j, k), temp.v(i, j, k), 1e-7);
+            });
+            temp.forEachWIndex([&](size_t i, size_t j, size_t k) {
+                EXPECT_NEAR(ref.w(i, j, k), temp.w(i, j, k), 1e-7);
+            });
+        }
+    }
+
+    // Tolerance larger than the motion keeps the previous system, which
+    // also holds for the compressed system.
+    for (bool useCompressed : {false, true}) {
+        for (double tolerance : {0.0, 0.1}) {
+            GridFractionalSinglePhasePressureSolver3 solver;
+            solver.setRebuildTolerance(tolerance);
+            EXPECT_EQ(tolerance, solver.rebuildTolerance());
+
+            FaceCenteredGrid3 temp2(temp);
+            solver.solve(vel, 1.0, &temp, boundarySdf(0.0), boundaryVel,
+                         fluidSdf(-0.02), useCompressed);
+            solver.solve(vel, 1.0, &temp2, boundarySdf(0.0), boundaryVel,
+                         fluidSdf(0.0), useCompressed);
+
+            double maxDiff = 0.0;
+            temp.forEachVIndex([&](size_t i, size_t j, size_t k) {
+                maxDiff = std::max(maxDiff, std::fabs(temp.v(i, j, k) -
+                                                      temp2.v(i, j, k)));
+            });
+            if (tolerance > 0.0) {
+                EXPECT_NEAR(0.0, maxDiff, 1e-7);
+            } else {
+                EXPECT_LT(1e-3, maxDiff);
+            }
+        }
+    }
+
+    // Uncompressed solve after the collider has moved in a compressed build.
+    // Without a linear solver, only the build runs and the dense system is
+    // kept as is.
+    {
+        auto iccg = std::make_shared<FdmIccgSolver3>(500, 1e-12);
+        GridFractionalSinglePhasePressureSolver3 solver;
+        solver.setLinearSystemSolver(iccg);
+        solver.solve(vel, 1.0, &temp, boundarySdf(0.0), boundaryVel,
+                     fluidSdf(0.0), false);
+        solver.setLinearSystemSolver(nullptr);
+        solver.solve(vel, 1.0, &temp, boundarySdf(0.05), boundaryVel,
+                     fluidSdf(0.0), true);
+        solver.setLinearSystemSolver(iccg);
+        solver.solve(vel, 1.0, &temp, boundarySdf(0.05), boundaryVel,
+                     fluidSdf(0.0), false);
+
+        FaceCenteredGrid3 ref(temp);
+        GridFractionalSinglePhasePressureSolver3 refSolver;
+        refSolver.setLinearSystemSolver(
+            std::make_shared<FdmIccgSolver3>(500, 1e-12));
+        refSolver.solve(vel, 1.0, &ref, boundarySdf(0.05), boundaryVel,
+                        fluidSdf(0.0), false);
+
+        temp.forEachUIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_NEAR(ref.u(i, j, k), temp.u(i, j, k), 1e-7);
+        });
+        temp.forEachVIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_NEAR(ref.v(i, j, k), temp.v(i, j, k), 1e-7);
+        });
+        temp.forEachWIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_NEAR(ref.w(i, j, k), temp.w(i, j, k), 1e-7);
+        });
+    }
+}
+
+TEST(GridFractionalSinglePhasePressureSolver3, MgHierarchyReuse) {
+    const double h = 1.0 / 16.0;
+    FaceCenteredGrid3 vel(16, 16, 16, h, h, h), temp(16, 16, 16, h, h, h);
+    vel.fill([](const Vector3D& x) {
+        return Vector3D(std::sin(4.0 * x.y), x.x * x.z, std::cos(3.0 * x.x));
+    });
+
+    GridFractionalSinglePhasePressureSolver3 solver;
+    solver.setLinearSystemSolver(
+        std::make_shared<FdmMgpcgSolver3>(200, 4, 5, 5, 10, 10, 1e-9));
+    EXPECT_EQ(0.0, solver.lastBuildTimeInSeconds());
+
+    CustomScalarField3 fluidSdf([](const Vector3D& x) { return x.y - 0.6; });
+    solver.solve(vel, 1.0, &temp, ConstantScalarField3(kMaxD),
+                 ConstantVectorField3({0, 0, 0}), fluidSdf);
+    EXPECT_LT(0.0, solver.lastBuildTimeInSeconds());
+
+    // The hierarchy is kept for the same resolution
+    const double* data = solver.pressure().data();
+    FaceCenteredGrid3 temp2(temp);
+    solver.solve(vel, 1.0, &temp2, ConstantScalarField3(kMaxD),
+                 ConstantVectorField3({0, 0, 0}), fluidSdf);
+    EXPECT_EQ(data, solver.pressure().data());
+    temp.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(temp.v(i, j, k), temp2.v(i, j, k), 1e-12);
+    });
+
+    // Same projection as the single-level solver
+    FaceCenteredGrid3 ref(temp);
+    GridFractionalSinglePhasePressureSolver3 refSolver;
+    refSolver.setLinearSystemSolver(
+        std::make_shared<FdmIccgSolver3>(500, 1e-12));
+    refSolver.solve(vel, 1.0, &ref, ConstantScalarField3(kMaxD),
+                    ConstantVectorField3({0, 0, 0}), fluidSdf);
+    temp.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(ref.v(i, j, k), temp.v(i, j, k), 1e-5);
+    });
+}
@@ -0,0 +1,123 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/grid_slab_decomposition3.h>
+#include <jet/parallel.h>
+#include <gtest/gtest.h>
+
+using namespace jet;
+
+TEST(GridSlabDecomposition3, Resize) {
+    GridSlabDecomposition3 slabs;
+    slabs.resize(Size3(4, 3, 10), Vector3D(0.5, 0.5, 0.5), Vector3D(1, 2, 3),
+                 3, 2, 1);
+
+    EXPECT_EQ(3u, slabs.numberOfSubdomains());
+    EXPECT_EQ(2u, slabs.numberOfGhostLayers());
+
+    const size_t ownedBegins[3] = {0, 3, 6};
+    const size_t ownedEnds[3] = {3, 6, 10};
+    const size_t begins[3] = {0, 1, 4};
+    const size_t ends[3] = {5, 8, 10};
+    for (size_t s = 0; s < 3; ++s) {
+        const auto& sub = slabs.subdomain(s);
+        EXPECT_EQ(ownedBegins[s], sub.ownedBegin);
+        EXPECT_EQ(ownedEnds[s], sub.ownedEnd);
+        EXPECT_EQ(begins[s], sub.begin);
+        EXPECT_EQ(ends[s], sub.end);
+
+        ASSERT_EQ(1u, sub.scalars.size());
+        EXPECT_EQ(Size3(4, 3, ends[s] - begins[s]),
+                  sub.scalars[0]->resolution());
+        EXPECT_EQ(Size3(4, 3, ends[s] - begins[s]),
+                  sub.velocity->resolution());
+        EXPECT_EQ(Vector3D(1, 2, 3 + 0.5 * begins[s]),
+                  sub.velocity->origin());
+    }
+
+    for (size_t k = 0; k < 10; ++k) {
+        EXPECT_EQ(k < 3 ? 0u : (k < 6 ? 1u : 2u), slabs.ownerOf(k));
+    }
+
+    // Same layout keeps the local grids
+    auto velocity = slabs.subdomain(1).velocity;
+    slabs.resize(Size3(4, 3, 10), Vector3D(0.5, 0.5, 0.5), Vector3D(1, 2, 3),
+                 3, 2, 1);
+    EXPECT_EQ(velocity, slabs.subdomain(1).velocity);
+
+    // Number of subdomains is clamped to the number of layers
+    slabs.resize(Size3(4, 3, 2), Vector3D(0.5, 0.5, 0.5), Vector3D(1, 2, 3),
+                 3, 2, 1);
+    EXPECT_EQ(2u, slabs.numberOfSubdomains());
+}
+
+TEST(GridSlabDecomposition3, LoadExchangeStore) {
+    const unsigned int prevNumThreads = maxNumberOfThreads();
+    setMaxNumberOfThreads(4);
+
+    const Size3 res(4, 3, 11);
+    auto scalar = std::make_shared<CellCenteredScalarGrid3>(
+        res, Vector3D(1, 1, 1), Vector3D());
+    FaceCenteredGrid3 velocity(res, Vector3D(1, 1, 1), Vector3D());
+    scalar->fill(
+        [](const Vector3D& pt) { return pt.x + 10 * pt.y + 100 * pt.z; });
+    velocity.fill([](const Vector3D& pt) {
+        return Vector3D(pt.x + pt.z, pt.y - pt.z, 2 * pt.z);
+    });
+
+    GridSlabDecomposition3 slabs;
+    slabs.resize(res, Vector3D(1, 1, 1), Vector3D(), 4, 2, 1);
+    slabs.load({scalar}, velocity);
+    slabs.exchangeGhostLayers();
+
+    // Every local layer matches the global grids
+    for (size_t s = 0; s < slabs.numberOfSubdomains(); ++s) {
+        const auto& sub = slabs.subdomain(s);
+        auto localScalar = sub.scalars[0]->constDataAccessor();
+        auto localU = sub.velocity->uConstAccessor();
+        auto localV = sub.velocity->vConstAccessor();
+        auto localW = sub.velocity->wConstAccessor();
+
+        localScalar.forEachIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_EQ((*scalar)(i, j, sub.begin + k), localScalar(i, j, k));
+        });
+        localU.forEachIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_EQ(velocity.u(i, j, sub.begin + k), localU(i, j, k));
+        });
+        localV.forEachIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_EQ(velocity.v(i, j, sub.begin + k), localV(i, j, k));
+        });
+        localW.forEachIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_EQ(velocity.w(i, j, sub.begin + k), localW(i, j, k));
+        });
+    }
+
+    // Only the owned layers are written back
+    slabs.forEachSubdomain([](GridSlabDecomposition3::Subdomain& sub) {
+        EXPECT_EQ(1u, maxNumberOfThreads());
+        sub.scalars[0]->fill(static_cast<double>(sub.ownedBegin));
+        sub.velocity->fill(Vector3D(1, 2, 3) *
+                           static_cast<double>(sub.ownedEnd));
+    });
+
+    slabs.store({scalar}, &velocity);
+
+    scalar->forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        const auto& sub = slabs.subdomain(slabs.ownerOf(k));
+        EXPECT_EQ(static_cast<double>(sub.ownedBegin), (*scalar)(i, j, k));
+    });
+    velocity.forEachUIndex([&](size_t i, size_t j, size_t k) {
+        const auto& sub = slabs.subdomain(slabs.ownerOf(k));
+        EXPECT_EQ(static_cast<double>(sub.ownedEnd), velocity.u(i, j, k));
+    });
+    velocity.forEachWIndex([&](size_t i, size_t j, size_t k) {
+        const size_t owner = slabs.ownerOf(std::min(k, res.z - 1));
+        const auto& sub = slabs.subdomain(owner);
+        EXPECT_EQ(3.0 * sub.ownedEnd, velocity.w(i, j, k));
+    });
+
+    setMaxNumberOfThreads(prevNumThreads);
+}
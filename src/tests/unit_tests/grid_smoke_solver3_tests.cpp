@@ -0,0 +1,174 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/fdm_cg_solver3.h>
+#include <jet/fdm_schwarz_pcg_solver3.h>
+#include <jet/grid_backward_euler_diffusion_solver3.h>
+#include <jet/grid_fractional_single_phase_pressure_solver3.h>
+#include <jet/grid_smoke_solver3.h>
+#include <jet/parallel.h>
+#include <gtest/gtest.h>
+
+using namespace jet;
+
+namespace {
+
+GridSmokeSolver3Ptr makeSmokeSolver() {
+    auto solver = GridSmokeSolver3::builder()
+                      .withResolution({8, 8, 16})
+                      .withDomainSizeX(1.0)
+                      .makeShared();
+
+    // Swirling flow which crosses the slab boundaries
+    solver->velocity()->fill([](const Vector3D& pt) {
+        return Vector3D(std::sin(kPiD * pt.z), std::cos(kPiD * pt.x),
+                        4.0 * std::sin(2.0 * kPiD * pt.x) + 1.0);
+    });
+    solver->smokeDensity()->fill([](const Vector3D& pt) {
+        return std::max(0.25 - pt.distanceTo(Vector3D(0.5, 0.5, 0.5)), 0.0);
+    });
+    solver->temperature()->fill(
+        [](const Vector3D& pt) { return pt.y * (2.0 - pt.z); });
+
+    return solver;
+}
+
+double maxDifference(const GridSmokeSolver3& a, const GridSmokeSolver3& b) {
+    double maxDiff = 0.0;
+    a.smokeDensity()->forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        maxDiff = std::max(maxDiff, std::fabs((*a.smokeDensity())(i, j, k) -
+                                              (*b.smokeDensity())(i, j, k)));
+        maxDiff = std::max(maxDiff, std::fabs((*a.temperature())(i, j, k) -
+                                              (*b.temperature())(i, j, k)));
+    });
+    a.velocity()->forEachUIndex([&](size_t i, size_t j, size_t k) {
+        maxDiff = std::max(maxDiff, std::fabs(a.velocity()->u(i, j, k) -
+                                              b.velocity()->u(i, j, k)));
+    });
+    a.velocity()->forEachVIndex([&](size_t i, size_t j, size_t k) {
+        maxDiff = std::max(maxDiff, std::fabs(a.velocity()->v(i, j, k) -
+                                              b.velocity()->v(i, j, k)));
+    });
+    a.velocity()->forEachWIndex([&](size_t i, size_t j, size_t k) {
+        maxDiff = std::max(maxDiff, std::fabs(a.velocity()->w(i, j, k) -
+                                              b.velocity()->w(i, j, k)));
+    });
+    return maxDiff;
+}
+
+}  // namespace
+
+TEST(GridSmokeSolver3, NumberOfSubdomains) {
+    GridSmokeSolver3 solver;
+    EXPECT_EQ(0u, solver.numberOfSubdomains());
+
+    auto pressureSolver =
+        std::dynamic_pointer_cast<GridFractionalSinglePhasePressureSolver3>(
+            solver.pressureSolver());
+    ASSERT_TRUE(pressureSolver != nullptr);
+
+    solver.setNumberOfSubdomains(3);
+    EXPECT_EQ(3u, solver.numberOfSubdomains());
+    auto schwarzSolver = std::dynamic_pointer_cast<FdmSchwarzPcgSolver3>(
+        pressureSolver->linearSystemSolver());
+    ASSERT_TRUE(schwarzSolver != nullptr);
+    EXPECT_EQ(3u, schwarzSolver->numberOfSubdomains());
+
+    solver.setNumberOfSubdomains(0);
+    EXPECT_TRUE(std::dynamic_pointer_cast<FdmSchwarzPcgSolver3>(
+                    pressureSolver->linearSystemSolver()) == nullptr);
+}
+
+TEST(GridSmokeSolver3, NumberOfSubdomainsKeepsLinearSystemSolvers) {
+    GridSmokeSolver3 solver;
+    auto pressureSolver =
+        std::dynamic_pointer_cast<GridFractionalSinglePhasePressureSolver3>(
+            solver.pressureSolver());
+    ASSERT_TRUE(pressureSolver != nullptr);
+    auto diffusionSolver =
+        std::dynamic_pointer_cast<GridBackwardEulerDiffusionSolver3>(
+            solver.diffusionSolver());
+    ASSERT_TRUE(diffusionSolver != nullptr);
+
+    auto pressureCgSolver = std::make_shared<FdmCgSolver3>(10, 1e-3);
+    auto diffusionCgSolver = std::make_shared<FdmCgSolver3>(10, 1e-3);
+    pressureSolver->setLinearSystemSolver(pressureCgSolver);
+    diffusionSolver->setLinearSystemSolver(diffusionCgSolver);
+
+    // Changing the number of subdomains keeps the installed Schwarz solvers
+    // up to date
+    solver.setNumberOfSubdomains(3);
+    solver.setNumberOfSubdomains(4);
+    auto schwarzSolver = std::dynamic_pointer_cast<FdmSchwarzPcgSolver3>(
+        diffusionSolver->linearSystemSolver());
+    ASSERT_TRUE(schwarzSolver != nullptr);
+    EXPECT_EQ(4u, schwarzSolver->numberOfSubdomains());
+
+    // Turning the mode off restores the previous solvers
+    solver.setNumberOfSubdomains(1);
+    EXPECT_EQ(pressureCgSolver, pressureSolver->linearSystemSolver());
+    EXPECT_EQ(diffusionCgSolver, diffusionSolver->linearSystemSolver());
+
+    // Turning it off again does nothing
+    solver.setNumberOfSubdomains(0);
+    EXPECT_EQ(pressureCgSolver, pressureSolver->linearSystemSolver());
+
+    // A solver set while the mode is on is kept
+    solver.setNumberOfSubdomains(2);
+    auto userSolver = std::make_shared<FdmCgSolver3>(20, 1e-4);
+    pressureSolver->setLinearSystemSolver(userSolver);
+    solver.setNumberOfSubdomains(3);
+    EXPECT_EQ(userSolver, pressureSolver->linearSystemSolver());
+    solver.setNumberOfSubdomains(0);
+    EXPECT_EQ(userSolver, pressureSolver->linearSystemSolver());
+    EXPECT_EQ(diffusionCgSolver, diffusionSolver->linearSystemSolver());
+}
+
+TEST(GridSmokeSolver3, DecomposedAdvection) {
+    const unsigned int prevNumThreads = maxNumberOfThreads();
+    setMaxNumberOfThreads(4);
+
+    auto solver = makeSmokeSolver();
+    auto decomposedSolver = makeSmokeSolver();
+    decomposedSolver->setNumberOfSubdomains(3);
+
+    // Without the pressure solve, the decomposed advection should reproduce
+    // the global one up to the round-off of the local grid origins.
+    solver->setPressureSolver(nullptr);
+    decomposedSolver->setPressureSolver(nullptr);
+
+    for (Frame frame(0, 1.0 / 60.0); frame.index < 5; ++frame) {
+        solver->update(frame);
+        decomposedSolver->update(frame);
+    }
+
+    EXPECT_LT(maxDifference(*solver, *decomposedSolver), 1e-12);
+
+    setMaxNumberOfThreads(prevNumThreads);
+}
+
+TEST(GridSmokeSolver3, DecomposedSolve) {
+    const unsigned int prevNumThreads = maxNumberOfThreads();
+    setMaxNumberOfThreads(4);
+
+    auto solver = makeSmokeSolver();
+    auto decomposedSolver = makeSmokeSolver();
+    solver->setSmokeDiffusionCoefficient(0.01);
+    solver->setTemperatureDiffusionCoefficient(0.01);
+    decomposedSolver->setSmokeDiffusionCoefficient(0.01);
+    decomposedSolver->setTemperatureDiffusionCoefficient(0.01);
+    decomposedSolver->setNumberOfSubdomains(3);
+
+    for (Frame frame(0, 1.0 / 60.0); frame.index < 5; ++frame) {
+        solver->update(frame);
+        decomposedSolver->update(frame);
+    }
+
+    // The linear systems are solved up to the same tolerance
+    EXPECT_LT(maxDifference(*solver, *decomposedSolver), 1e-4);
+
+    setMaxNumberOfThreads(prevNumThreads);
+}
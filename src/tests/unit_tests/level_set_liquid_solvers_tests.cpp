@@ -69,3 +69,38 @@ TEST(LevelSetLiquidSolver3, ComputeVolume) {
 
     EXPECT_NEAR(ans, volume, 0.001);
 }
+
+TEST(LevelSetLiquidSolver3, ClosestPointExtrapolation) {
+    const double dx = 1.0 / 16.0;
+    const double radius = 0.2;
+
+    LevelSetLiquidSolver3 solver0, solver1;
+    solver1.setExtrapolationType(ExtrapolationType::kClosestPoint);
+    for (LevelSetLiquidSolver3* solver : {&solver0, &solver1}) {
+        auto data = solver->gridSystemData();
+        data->resize(Size3(16, 16, 16), Vector3D(dx, dx, dx), Vector3D());
+
+        auto sdf = solver->signedDistanceField();
+        sdf->fill([&](const Vector3D& x) {
+            return x.distanceTo(Vector3D(0.5, 0.5, 0.5)) - radius;
+        });
+
+        for (Frame frame(0, 1.0 / 60.0); frame.index < 5; ++frame) {
+            solver->update(frame);
+        }
+    }
+
+    // Both extrapolations should give a similar free fall
+    const double volume0 = solver0.computeVolume();
+    const double volume1 = solver1.computeVolume();
+    EXPECT_NEAR(volume0, volume1, 0.02 * volume0);
+
+    auto sdf0 = solver0.signedDistanceField();
+    auto sdf1 = solver1.signedDistanceField();
+    sdf0->forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        if (std::fabs((*sdf0)(i, j, k)) < dx) {
+            EXPECT_NEAR((*sdf0)(i, j, k), (*sdf1)(i, j, k), 0.2 * dx)
+                << i << ", " << j << ", " << k;
+        }
+    });
+}
@@ -12,12 +12,94 @@
 #include <jet/fdm_utils.h>
 #include <jet/fmm_level_set_solver2.h>
 #include <jet/fmm_level_set_solver3.h>
+#include <jet/pde.h>
 #include <jet/upwind_level_set_solver2.h>
 #include <jet/upwind_level_set_solver3.h>
+#include <jet/weno_level_set_solver3.h>
 #include <gtest/gtest.h>
 
 using namespace jet;
 
+namespace {
+
+size_t clampIndex(ssize_t i, size_t n) {
+    return static_cast<size_t>(
+        std::min(std::max(i, ssize_t(0)), static_cast<ssize_t>(n) - 1));
+}
+
+// Level set solver which only provides the per-point derivatives of the given
+// kernel, so the iterations go through the default row derivatives.
+class PointwiseLevelSetSolver3 final : public IterativeLevelSetSolver3 {
+ public:
+    typedef std::array<double, 2> (*Kernel)(double* D0, double h);
+
+    PointwiseLevelSetSolver3(Kernel kernel, ssize_t halfWidth)
+        : _kernel(kernel), _halfWidth(halfWidth) {}
+
+ protected:
+    void getDerivatives(ConstArrayAccessor3<double> grid,
+                        const Vector3D& gridSpacing, size_t i, size_t j,
+                        size_t k, std::array<double, 2>* dx,
+                        std::array<double, 2>* dy,
+                        std::array<double, 2>* dz) const override {
+        const Size3 size = grid.size();
+        const ssize_t width = 2 * _halfWidth + 1;
+        double D0[7];
+        for (ssize_t m = 0; m < width; ++m) {
+            D0[m] = grid(clampIndex(i + m - _halfWidth, size.x), j, k);
+        }
+        *dx = _kernel(D0, gridSpacing.x);
+        for (ssize_t m = 0; m < width; ++m) {
+            D0[m] = grid(i, clampIndex(j + m - _halfWidth, size.y), k);
+        }
+        *dy = _kernel(D0, gridSpacing.y);
+        for (ssize_t m = 0; m < width; ++m) {
+            D0[m] = grid(i, j, clampIndex(k + m - _halfWidth, size.z));
+        }
+        *dz = _kernel(D0, gridSpacing.z);
+    }
+
+ private:
+    Kernel _kernel;
+    ssize_t _halfWidth;
+};
+
+// Expects the row derivatives of the solver to give the identical results as
+// the per-point derivatives of the reference solver.
+void expectSameAsPointwise(IterativeLevelSetSolver3* solver,
+                           PointwiseLevelSetSolver3* refSolver) {
+    CellCenteredScalarGrid3 sdf(17, 9, 12), temp0(17, 9, 12), temp1(17, 9, 12);
+
+    sdf.fill([](const Vector3D& x) {
+        return 2.0 * ((x - Vector3D(8, 4, 6)).length() - 3.0)
+            + std::sin(3.0 * x.x);
+    });
+
+    refSolver->setMaxCfl(solver->maxCfl());
+    refSolver->setTvdRungeKutta3Enabled(solver->isTvdRungeKutta3Enabled());
+
+    // Full band so that the ends of the rows are covered
+    solver->reinitialize(sdf, 20.0, &temp0);
+    refSolver->reinitialize(sdf, 20.0, &temp1);
+
+    temp0.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(temp1(i, j, k), temp0(i, j, k))
+            << i << ", " << j << ", " << k;
+    });
+
+    CellCenteredScalarGrid3 field(17, 9, 12);
+    field.fill([](const Vector3D& x) { return std::cos(x.y) * x.z; });
+    solver->extrapolate(field, sdf, 5.0, &temp0);
+    refSolver->extrapolate(field, sdf, 5.0, &temp1);
+
+    temp0.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(temp1(i, j, k), temp0(i, j, k))
+            << i << ", " << j << ", " << k;
+    });
+}
+
+}  // namespace
+
 TEST(UpwindLevelSetSolver2, Reinitialize) {
     CellCenteredScalarGrid2 sdf(40, 30), temp(40, 30);
 
@@ -74,6 +156,62 @@ TEST(UpwindLevelSetSolver3, Reinitialize) {
     }
 }
 
+TEST(UpwindLevelSetSolver3, ReinitializeDistorted) {
+    CellCenteredScalarGrid3 sdf(40, 30, 50), temp(40, 30, 50);
+
+    sdf.fill([](const Vector3D& x) {
+        return 2.0 * ((x - Vector3D(20, 20, 20)).length() - 8.0);
+    });
+
+    UpwindLevelSetSolver3 solver;
+    solver.reinitialize(sdf, 5.0, &temp);
+
+    auto pos = sdf.dataPosition();
+    temp.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        const double exact =
+            pos(i, j, k).distanceTo(Vector3D(20, 20, 20)) - 8.0;
+        if (std::fabs(exact) > 12.0) {
+            // Outside the band
+            EXPECT_EQ(sdf(i, j, k), temp(i, j, k));
+        } else if (std::fabs(exact) < 2.0) {
+            EXPECT_NEAR(exact, temp(i, j, k), 0.7)
+                << i << ", " << j << ", " << k;
+        } else if (std::fabs(exact) < 5.0) {
+            // Far side of the band, where the input is twice the distance
+            EXPECT_NEAR(exact, temp(i, j, k), 1.0)
+                << i << ", " << j << ", " << k;
+        }
+    });
+}
+
+TEST(UpwindLevelSetSolver3, ReinitializeEarlyTermination) {
+    CellCenteredScalarGrid3 sdf(20, 20, 20), temp(20, 20, 20);
+
+    // Already a signed-distance field
+    sdf.fill([](const Vector3D& x) { return x.x - 10.0; });
+
+    UpwindLevelSetSolver3 solver;
+    solver.reinitialize(sdf, kMaxD, &temp);
+
+    temp.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(sdf(i, j, k), temp(i, j, k), 1e-12);
+    });
+
+    // Large tolerance stops after the first iteration
+    sdf.fill([](const Vector3D& x) { return 2.0 * (x.x - 10.0); });
+    solver.setResidualTolerance(kMaxD);
+    solver.reinitialize(sdf, 5.0, &temp);
+
+    const double dtau = solver.maxCfl();
+    temp.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        if (std::fabs(sdf(i, j, k)) < 4.0 && i > 0 && i < 19) {
+            double s = sdf(i, j, k)
+                / std::sqrt(square(sdf(i, j, k)) + 1.0);
+            EXPECT_NEAR(sdf(i, j, k) - dtau * s, temp(i, j, k), 1e-12);
+        }
+    });
+}
+
 TEST(UpwindLevelSetSolver3, Extrapolate) {
     CellCenteredScalarGrid3 sdf(40, 30, 50), temp(40, 30, 50);
     CellCenteredScalarGrid3 field(40, 30, 50);
@@ -97,6 +235,13 @@ TEST(UpwindLevelSetSolver3, Extrapolate) {
 }
 
 
+TEST(UpwindLevelSetSolver3, RowDerivatives) {
+    UpwindLevelSetSolver3 solver;
+    PointwiseLevelSetSolver3 refSolver(
+        [](double* D0, double h) { return upwind1(D0, h); }, 1);
+    expectSameAsPointwise(&solver, &refSolver);
+}
+
 TEST(EnoLevelSetSolver2, Reinitialize) {
     CellCenteredScalarGrid2 sdf(40, 30), temp(40, 30);
 
@@ -153,6 +298,69 @@ TEST(EnoLevelSetSolver3, Reinitialize) {
     }
 }
 
+TEST(EnoLevelSetSolver3, ReinitializeDistorted) {
+    CellCenteredScalarGrid3 sdf(40, 30, 50), temp(40, 30, 50);
+
+    sdf.fill([](const Vector3D& x) {
+        return 2.0 * ((x - Vector3D(20, 20, 20)).length() - 8.0);
+    });
+
+    EnoLevelSetSolver3 solver;
+    solver.reinitialize(sdf, 5.0, &temp);
+
+    auto pos = sdf.dataPosition();
+    temp.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        const double exact =
+            pos(i, j, k).distanceTo(Vector3D(20, 20, 20)) - 8.0;
+        if (std::fabs(exact) > 12.0) {
+            // Outside the band
+            EXPECT_EQ(sdf(i, j, k), temp(i, j, k));
+        } else if (std::fabs(exact) < 2.0) {
+            EXPECT_NEAR(exact, temp(i, j, k), 0.7)
+                << i << ", " << j << ", " << k;
+        } else if (std::fabs(exact) < 5.0) {
+            // Far side of the band, where the input is twice the distance
+            EXPECT_NEAR(exact, temp(i, j, k), 1.0)
+                << i << ", " << j << ", " << k;
+        }
+    });
+}
+
+TEST(EnoLevelSetSolver3, ReinitializeEarlyTermination) {
+    CellCenteredScalarGrid3 sdf(20, 20, 20), temp(20, 20, 20);
+
+    // Already a signed-distance field
+    sdf.fill([](const Vector3D& x) { return x.x - 10.0; });
+
+    EnoLevelSetSolver3 solver;
+    solver.reinitialize(sdf, kMaxD, &temp);
+
+    temp.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(sdf(i, j, k), temp(i, j, k), 1e-12);
+    });
+
+    // Large tolerance stops after the first iteration
+    sdf.fill([](const Vector3D& x) { return 2.0 * (x.x - 10.0); });
+    solver.setResidualTolerance(kMaxD);
+    solver.reinitialize(sdf, 5.0, &temp);
+
+    const double dtau = solver.maxCfl();
+    temp.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        if (std::fabs(sdf(i, j, k)) < 4.0 && i > 0 && i < 19) {
+            double s = sdf(i, j, k)
+                / std::sqrt(square(sdf(i, j, k)) + 1.0);
+            EXPECT_NEAR(sdf(i, j, k) - dtau * s, temp(i, j, k), 1e-12);
+        }
+    });
+}
+
+TEST(EnoLevelSetSolver3, RowDerivatives) {
+    EnoLevelSetSolver3 solver;
+    PointwiseLevelSetSolver3 refSolver(
+        [](double* D0, double h) { return eno3(D0, h); }, 3);
+    expectSameAsPointwise(&solver, &refSolver);
+}
+
 TEST(EnoLevelSetSolver3, Extrapolate) {
     CellCenteredScalarGrid3 sdf(40, 30, 50), temp(40, 30, 50);
     CellCenteredScalarGrid3 field(40, 30, 50);
@@ -176,6 +384,88 @@ TEST(EnoLevelSetSolver3, Extrapolate) {
 }
 
 
+TEST(WenoLevelSetSolver3, Reinitialize) {
+    CellCenteredScalarGrid3 sdf(40, 30, 50), temp(40, 30, 50);
+
+    sdf.fill([](const Vector3D& x) {
+        return (x - Vector3D(20, 20, 20)).length() - 8.0;
+    });
+
+    WenoLevelSetSolver3 solver;
+    EXPECT_TRUE(solver.isTvdRungeKutta3Enabled());
+    solver.reinitialize(sdf, 5.0, &temp);
+
+    for (size_t k = 0; k < 50; ++k) {
+        for (size_t j = 0; j < 30; ++j) {
+            for (size_t i = 0; i < 40; ++i) {
+                EXPECT_NEAR(sdf(i, j, k), temp(i, j, k), 0.5)
+                    << i << ", " << j << ", " << k;
+            }
+        }
+    }
+}
+
+TEST(WenoLevelSetSolver3, ReinitializeDistorted) {
+    CellCenteredScalarGrid3 sdf(40, 30, 50), temp0(40, 30, 50),
+        temp1(40, 30, 50);
+
+    sdf.fill([](const Vector3D& x) {
+        return 2.0 * ((x - Vector3D(20, 20, 20)).length() - 8.0);
+    });
+
+    WenoLevelSetSolver3 solver;
+    EnoLevelSetSolver3 enoSolver;
+    solver.reinitialize(sdf, 5.0, &temp0);
+    enoSolver.reinitialize(sdf, 5.0, &temp1);
+
+    // Compares the errors near the interface against the ENO solver
+    double wenoError = 0.0;
+    double enoError = 0.0;
+    auto pos = sdf.dataPosition();
+    temp0.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        const double exact =
+            pos(i, j, k).distanceTo(Vector3D(20, 20, 20)) - 8.0;
+        if (std::fabs(exact) > 12.0) {
+            // Outside the band
+            EXPECT_EQ(sdf(i, j, k), temp0(i, j, k));
+        } else if (std::fabs(exact) >= 3.0 && std::fabs(exact) < 5.0) {
+            // Far side of the band, where the input is twice the distance
+            EXPECT_NEAR(exact, temp0(i, j, k), 0.6)
+                << i << ", " << j << ", " << k;
+        } else if (std::fabs(sdf(i, j, k)) < 2.0) {
+            EXPECT_NEAR(exact, temp0(i, j, k), 0.2)
+                << i << ", " << j << ", " << k;
+            wenoError = std::max(wenoError, std::fabs(exact - temp0(i, j, k)));
+            enoError = std::max(enoError, std::fabs(exact - temp1(i, j, k)));
+        }
+    });
+    EXPECT_LE(wenoError, enoError);
+}
+
+TEST(WenoLevelSetSolver3, Extrapolate) {
+    CellCenteredScalarGrid3 sdf(40, 30, 50), temp(40, 30, 50);
+    CellCenteredScalarGrid3 field(40, 30, 50);
+
+    sdf.fill([](const Vector3D& x) {
+        return (x - Vector3D(20, 20, 20)).length() - 8.0;
+    });
+    field.fill(5.0);
+
+    WenoLevelSetSolver3 solver;
+    solver.extrapolate(field, sdf, 5.0, &temp);
+
+    temp.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(5.0, temp(i, j, k)) << i << ", " << j << ", " << k;
+    });
+}
+
+TEST(WenoLevelSetSolver3, RowDerivatives) {
+    WenoLevelSetSolver3 solver;
+    PointwiseLevelSetSolver3 refSolver(
+        [](double* D0, double h) { return weno5(D0, h); }, 3);
+    expectSameAsPointwise(&solver, &refSolver);
+}
+
 TEST(FmmLevelSetSolver2, Reinitialize) {
     CellCenteredScalarGrid2 sdf(40, 30), temp(40, 30);
 
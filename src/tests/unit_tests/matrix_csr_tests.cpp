@@ -10,8 +10,39 @@
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 using namespace jet;
 
+namespace {
+
+MatrixMxND makeRandomSparseMatrix(size_t m, size_t n, double density,
+                                  unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<> d(0.0, 1.0);
+    MatrixMxND mat(m, n);
+    mat.forEachIndex([&](size_t i, size_t j) {
+        mat(i, j) = (d(rng) < density) ? d(rng) - 0.5 : 0.0;
+    });
+    return mat;
+}
+
+void expectSimilarToDense(const MatrixCsrD& mat, const MatrixMxND& ans) {
+    ASSERT_EQ(ans.rows(), mat.rows());
+    ASSERT_EQ(ans.cols(), mat.cols());
+    for (size_t i = 0; i < mat.rows(); ++i) {
+        for (size_t jj = mat.rowPointer(i) + 1; jj < mat.rowPointer(i + 1);
+             ++jj) {
+            EXPECT_LT(mat.columnIndex(jj - 1), mat.columnIndex(jj));
+        }
+        for (size_t j = 0; j < mat.cols(); ++j) {
+            EXPECT_NEAR(ans(i, j), mat(i, j), 1e-12);
+        }
+    }
+}
+
+}  // namespace
+
 TEST(MatrixCsr, Constructors) {
     const MatrixCsrD emptyMat;
 
@@ -306,6 +337,41 @@ TEST(MatrixCsr, BinaryOperatorMethods) {
     }
 }
 
+TEST(MatrixCsr, SparseMatrixMultiplication) {
+    // Small enough to run serially, then large enough to run in parallel
+    for (size_t n : {7, 180}) {
+        const MatrixMxND denseA = makeRandomSparseMatrix(n, n + 3, 0.3, 0);
+        const MatrixMxND denseB = makeRandomSparseMatrix(n + 3, n / 2, 0.3, 1);
+        const MatrixCsrD matA(denseA, 0.0);
+        const MatrixCsrD matB(denseB, 0.0);
+
+        const MatrixMxND ans = denseA * denseB;
+        expectSimilarToDense(matA.mul(matB), ans);
+        expectSimilarToDense(matA * matB, ans);
+
+        MatrixCsrD mat = matA;
+        mat.imul(matB);
+        expectSimilarToDense(mat, ans);
+    }
+}
+
+TEST(MatrixCsr, LargeBinaryOperators) {
+    const MatrixMxND denseA = makeRandomSparseMatrix(200, 300, 0.2, 2);
+    const MatrixMxND denseB = makeRandomSparseMatrix(200, 300, 0.2, 3);
+    const MatrixCsrD matA(denseA, 0.0);
+    const MatrixCsrD matB(denseB, 0.0);
+    ASSERT_LT(kMinParallelSize, matA.numberOfNonZeros() * 2);
+
+    const MatrixMxND sum = denseA + denseB;
+    const MatrixMxND diff = denseA - denseB;
+    expectSimilarToDense(matA + matB, sum);
+    expectSimilarToDense(matA - matB, diff);
+
+    MatrixCsrD mat = matA;
+    mat += matB;
+    expectSimilarToDense(mat, sum);
+}
+
 TEST(MatrixCsr, AugmentedMethods) {
     const MatrixCsrD matA = {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
     const MatrixCsrD matB = {{3.0, -1.0, 2.0}, {9.0, 2.0, 8.0}};
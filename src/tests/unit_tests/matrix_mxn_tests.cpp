@@ -259,6 +259,51 @@ TEST(MatrixMxN, AugmentedOperatorMethod) {
     }
 }
 
+TEST(MatrixMxN, BlockedMultiplication) {
+    // Sizes with the remainders of the tiles and the cache blocks
+    const size_t m = 37, p = 130, n = 261;
+    MatrixMxND matA(m, p), matB(p, n);
+    matA.forEachIndex([&](size_t i, size_t j) {
+        matA(i, j) = static_cast<double>((i * 7 + j * 3) % 5) - 2.0;
+    });
+    matB.forEachIndex([&](size_t i, size_t j) {
+        matB(i, j) = static_cast<double>((i * 5 + j * 11) % 7) - 3.0;
+    });
+
+    MatrixMxND ans(m, n);
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            double sum = 0.0;
+            for (size_t k = 0; k < p; ++k) {
+                sum += matA(i, k) * matB(k, j);
+            }
+            ans(i, j) = sum;
+        }
+    }
+
+    MatrixMxND mat = matA * matB;
+    EXPECT_EQ(ans, mat);
+
+    mat.set(2.0);
+    mat = matA * matB;
+    EXPECT_EQ(ans, mat);
+
+    // Expression operand
+    mat = (matA + matA) * matB;
+    const MatrixMxND ans2 = 2.0 * ans;
+    EXPECT_EQ(ans2, mat);
+
+    // Destination as an operand
+    MatrixMxND matI = MatrixMxND::makeIdentity(n);
+    mat = ans;
+    mat = mat * matI;
+    EXPECT_EQ(ans, mat);
+
+    mat = matA;
+    mat *= matB;
+    EXPECT_EQ(ans, mat);
+}
+
 TEST(MatrixMxN, ComplexGetters) {
     const MatrixMxND matA = {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
 
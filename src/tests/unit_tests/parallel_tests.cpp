@@ -9,6 +9,7 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <numeric>
 #include <random>
 
@@ -192,6 +193,43 @@ TEST(Parallel, Sort) {
     }
 }
 
+TEST(Parallel, RadixSort) {
+    std::mt19937 rng;
+
+    for (size_t N : {size_t(0), size_t(1), size_t(20), size_t(10000)}) {
+        for (size_t maxKey : {size_t(0), size_t(200), size_t(1) << 40}) {
+            std::uniform_int_distribution<size_t> d(0, maxKey);
+
+            std::vector<size_t> keys(N);
+            std::vector<size_t> values(N);
+            for (size_t i = 0; i < N; ++i) {
+                keys[i] = d(rng);
+                values[i] = i;
+            }
+
+            // Stable sort is the reference since radix sort is stable
+            std::vector<size_t> expected = values;
+            std::stable_sort(expected.begin(), expected.end(),
+                             [&](size_t i1, size_t i2) {
+                                 return keys[i1] < keys[i2];
+                             });
+
+            for (auto policy :
+                 {ExecutionPolicy::kParallel, ExecutionPolicy::kSerial}) {
+                std::vector<size_t> sortedKeys = keys;
+                std::vector<size_t> sortedValues = values;
+                parallelRadixSort(sortedKeys.begin(), sortedKeys.end(),
+                                  sortedValues.begin(), policy);
+
+                for (size_t i = 0; i < N; ++i) {
+                    EXPECT_EQ(expected[i], sortedValues[i]) << i;
+                    EXPECT_EQ(keys[expected[i]], sortedKeys[i]) << i;
+                }
+            }
+        }
+    }
+}
+
 TEST(Parallel, Reduce) {
     size_t N = std::max(20u, (3 * sNumCores) / 2);
     std::vector<int> a(N);
@@ -154,6 +154,99 @@ TEST(ParticleSystemData3, AddParticlesException) {
     EXPECT_EQ(12u, particleSystem.numberOfParticles());
 }
 
+TEST(ParticleSystemData3, RemoveParticles) {
+    ParticleSystemData3 particleSystem;
+    size_t a0 = particleSystem.addScalarData(0.0);
+
+    particleSystem.addParticles(
+        Array1<Vector3D>({Vector3D(1.0, 2.0, 3.0), Vector3D(4.0, 5.0, 6.0),
+                          Vector3D(7.0, 8.0, 9.0), Vector3D(3.0, 2.0, 1.0)})
+            .accessor(),
+        Array1<Vector3D>({Vector3D(7.0, 8.0, 9.0), Vector3D(8.0, 7.0, 6.0),
+                          Vector3D(5.0, 4.0, 3.0), Vector3D(2.0, 1.0, 0.0)})
+            .accessor());
+
+    auto s = particleSystem.scalarDataAt(a0);
+    for (size_t i = 0; i < 4; ++i) {
+        s[i] = static_cast<double>(i);
+    }
+
+    Array1<char> markers({1, 0, 1, 0});
+    particleSystem.removeParticles(markers.constAccessor());
+
+    EXPECT_EQ(2u, particleSystem.numberOfParticles());
+    auto p = particleSystem.positions();
+    auto v = particleSystem.velocities();
+    s = particleSystem.scalarDataAt(a0);
+
+    EXPECT_EQ(Vector3D(4.0, 5.0, 6.0), p[0]);
+    EXPECT_EQ(Vector3D(3.0, 2.0, 1.0), p[1]);
+    EXPECT_EQ(Vector3D(8.0, 7.0, 6.0), v[0]);
+    EXPECT_EQ(Vector3D(2.0, 1.0, 0.0), v[1]);
+    EXPECT_DOUBLE_EQ(1.0, s[0]);
+    EXPECT_DOUBLE_EQ(3.0, s[1]);
+}
+
+TEST(ParticleSystemData3, ReorderParticles) {
+    ParticleSystemData3 particleSystem;
+    size_t a0 = particleSystem.addScalarData(0.0);
+
+    particleSystem.addParticles(
+        Array1<Vector3D>({Vector3D(1.0, 2.0, 3.0), Vector3D(4.0, 5.0, 6.0),
+                          Vector3D(7.0, 8.0, 9.0)})
+            .accessor(),
+        Array1<Vector3D>({Vector3D(7.0, 8.0, 9.0), Vector3D(8.0, 7.0, 6.0),
+                          Vector3D(5.0, 4.0, 3.0)})
+            .accessor());
+
+    auto s = particleSystem.scalarDataAt(a0);
+    for (size_t i = 0; i < 3; ++i) {
+        s[i] = static_cast<double>(i);
+    }
+
+    Array1<size_t> newOrder({2, 0, 1});
+    particleSystem.reorderParticles(newOrder.constAccessor());
+
+    EXPECT_EQ(3u, particleSystem.numberOfParticles());
+    auto p = particleSystem.positions();
+    auto v = particleSystem.velocities();
+    s = particleSystem.scalarDataAt(a0);
+
+    EXPECT_EQ(Vector3D(7.0, 8.0, 9.0), p[0]);
+    EXPECT_EQ(Vector3D(1.0, 2.0, 3.0), p[1]);
+    EXPECT_EQ(Vector3D(4.0, 5.0, 6.0), p[2]);
+    EXPECT_EQ(Vector3D(5.0, 4.0, 3.0), v[0]);
+    EXPECT_EQ(Vector3D(7.0, 8.0, 9.0), v[1]);
+    EXPECT_EQ(Vector3D(8.0, 7.0, 6.0), v[2]);
+    EXPECT_DOUBLE_EQ(2.0, s[0]);
+    EXPECT_DOUBLE_EQ(0.0, s[1]);
+    EXPECT_DOUBLE_EQ(1.0, s[2]);
+}
+
+TEST(ParticleSystemData3, ForcesRevision) {
+    ParticleSystemData3 particleSystem(3);
+    const ParticleSystemData3& constParticleSystem = particleSystem;
+
+    // Reading does not change the revision
+    size_t revision = particleSystem.forcesRevision();
+    constParticleSystem.forces();
+    particleSystem.positions();
+    particleSystem.velocities();
+    EXPECT_EQ(revision, particleSystem.forcesRevision());
+
+    particleSystem.forces()[0] = Vector3D(1.0, 2.0, 3.0);
+    EXPECT_LT(revision, particleSystem.forcesRevision());
+
+    revision = particleSystem.forcesRevision();
+    particleSystem.reorderParticles(
+        Array1<size_t>({2, 0, 1}).constAccessor());
+    EXPECT_LT(revision, particleSystem.forcesRevision());
+
+    revision = particleSystem.forcesRevision();
+    particleSystem.addParticle(Vector3D(1.0, 2.0, 3.0));
+    EXPECT_LT(revision, particleSystem.forcesRevision());
+}
+
 TEST(ParticleSystemData3, BuildNeighborSearcher) {
     ParticleSystemData3 particleSystem;
     ParticleSystemData3::VectorData positions = {
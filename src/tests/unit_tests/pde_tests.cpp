@@ -7,6 +7,9 @@
 #include <jet/pde.h>
 #include <gtest/gtest.h>
 
+#include <random>
+#include <vector>
+
 using namespace jet;
 
 TEST(Pde, Upwind1)
@@ -79,3 +82,51 @@ TEST(Pde, Weno5)
 	EXPECT_LE(0.0, result1[0]);
 	EXPECT_LE(std::fabs(result1[1]), 1e-10);
 }
+
+TEST(Pde, RowKernels) {
+    const size_t n = 37;
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(-1.0, 1.0);
+
+    // Rows of a field with kinks and plateaus
+    std::vector<double> data(7 * n);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = (i % 5 == 0) ? 0.0 : std::fabs(d(rng)) - 0.5;
+    }
+    const double* rows[7];
+    for (size_t m = 0; m < 7; ++m) {
+        rows[m] = data.data() + m * n;
+    }
+
+    std::vector<double> dfxm(n), dfxp(n);
+
+    upwind1Row(rows + 2, n, 0.3, dfxm.data(), dfxp.data());
+    for (size_t i = 0; i < n; ++i) {
+        double D0[3] = {rows[2][i], rows[3][i], rows[4][i]};
+        auto expected = upwind1(D0, 0.3);
+        EXPECT_EQ(expected[0], dfxm[i]);
+        EXPECT_EQ(expected[1], dfxp[i]);
+    }
+
+    eno3Row(rows, n, 0.3, dfxm.data(), dfxp.data());
+    for (size_t i = 0; i < n; ++i) {
+        double D0[7];
+        for (size_t m = 0; m < 7; ++m) {
+            D0[m] = rows[m][i];
+        }
+        auto expected = eno3(D0, 0.3);
+        EXPECT_EQ(expected[0], dfxm[i]);
+        EXPECT_EQ(expected[1], dfxp[i]);
+    }
+
+    weno5Row(rows, n, 0.3, dfxm.data(), dfxp.data());
+    for (size_t i = 0; i < n; ++i) {
+        double D0[7];
+        for (size_t m = 0; m < 7; ++m) {
+            D0[m] = rows[m][i];
+        }
+        auto expected = weno5(D0, 0.3);
+        EXPECT_EQ(expected[0], dfxm[i]);
+        EXPECT_EQ(expected[1], dfxp[i]);
+    }
+}
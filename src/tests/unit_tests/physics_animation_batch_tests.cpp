@@ -0,0 +1,217 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/parallel.h>
+#include <jet/physics_animation_batch.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace jet;
+
+namespace {
+
+class SizedPhysicsAnimation : public PhysicsAnimation {
+ public:
+    explicit SizedPhysicsAnimation(size_t size) : _size(size) {}
+
+    size_t problemSize() const override { return _size; }
+
+    unsigned int numberOfSteps = 0;
+    unsigned int maxThreadsSeen = 0;
+
+ protected:
+    void onAdvanceTimeStep(double timeIntervalInSeconds) override {
+        (void)timeIntervalInSeconds;
+        ++numberOfSteps;
+        maxThreadsSeen = std::max(maxThreadsSeen, maxNumberOfThreads());
+    }
+
+ private:
+    size_t _size;
+};
+
+// Counts the iterations of the nested loops which leave the stepping thread.
+class NestedPhysicsAnimation : public PhysicsAnimation {
+ public:
+    std::atomic<int> numberOfForeignIterations{0};
+
+ protected:
+    void onAdvanceTimeStep(double timeIntervalInSeconds) override {
+        (void)timeIntervalInSeconds;
+        const std::thread::id id = std::this_thread::get_id();
+        parallelFor(kZeroSize, kMinParallelSize, [&](size_t) {
+            if (std::this_thread::get_id() != id) {
+                ++numberOfForeignIterations;
+            }
+        });
+    }
+};
+
+// Problem size is set on initialization and changes at a given step, like a
+// particle solver with emitters.
+class EmittingPhysicsAnimation : public PhysicsAnimation {
+ public:
+    EmittingPhysicsAnimation(size_t initialSize, size_t laterSize,
+                             unsigned int changeStep)
+        : _initialSize(initialSize),
+          _laterSize(laterSize),
+          _changeStep(changeStep) {}
+
+    size_t problemSize() const override { return _size; }
+
+    std::vector<unsigned int> threadsPerStep;
+
+ protected:
+    void onInitialize() override { _size = _initialSize; }
+
+    void onAdvanceTimeStep(double timeIntervalInSeconds) override {
+        (void)timeIntervalInSeconds;
+        threadsPerStep.push_back(maxNumberOfThreads());
+        if (threadsPerStep.size() == _changeStep) {
+            _size = _laterSize;
+        }
+    }
+
+ private:
+    size_t _size = 0;
+    size_t _initialSize;
+    size_t _laterSize;
+    unsigned int _changeStep;
+};
+
+}  // namespace
+
+TEST(PhysicsAnimationBatch, Properties) {
+    PhysicsAnimationBatch batch;
+    EXPECT_EQ(0u, batch.numberOfAnimations());
+
+    batch.setIntraParallelismThreshold(100);
+    EXPECT_EQ(100u, batch.intraParallelismThreshold());
+
+    auto anim = std::make_shared<SizedPhysicsAnimation>(10);
+    EXPECT_EQ(0u, batch.addAnimation(anim));
+    EXPECT_EQ(1u, batch.numberOfAnimations());
+    EXPECT_EQ(anim, batch.animationAt(0));
+
+    EXPECT_THROW(batch.addAnimation(nullptr), std::invalid_argument);
+}
+
+TEST(PhysicsAnimationBatch, Advance) {
+    PhysicsAnimationBatch batch;
+    batch.setIntraParallelismThreshold(100);
+
+    std::vector<std::shared_ptr<SizedPhysicsAnimation>> anims;
+    std::vector<std::atomic<int>> numberOfCallbacks(20);
+    for (size_t i = 0; i < 20; ++i) {
+        // Every fifth animation is large
+        anims.push_back(
+            std::make_shared<SizedPhysicsAnimation>(i % 5 == 0 ? 1000 : 10));
+        anims.back()->setNumberOfFixedSubTimeSteps(2);
+        numberOfCallbacks[i] = 0;
+
+        batch.addAnimation(
+            anims.back(),
+            [i, &anims, &numberOfCallbacks](const PhysicsAnimationPtr& anim,
+                                            const Frame& frame) {
+                EXPECT_EQ(anims[i], anim);
+                EXPECT_EQ(numberOfCallbacks[i].load(), frame.index);
+                ++numberOfCallbacks[i];
+            });
+    }
+
+    batch.advance(3);
+    batch.advance(2);
+
+    for (size_t i = 0; i < 20; ++i) {
+        EXPECT_EQ(5, numberOfCallbacks[i].load());
+        EXPECT_EQ(4, anims[i]->currentFrame().index);
+        EXPECT_EQ(10u, anims[i]->numberOfSteps);
+
+        if (i % 5 != 0) {
+            EXPECT_EQ(1u, anims[i]->maxThreadsSeen);
+        } else {
+            EXPECT_EQ(maxNumberOfThreads(), anims[i]->maxThreadsSeen);
+        }
+    }
+}
+
+TEST(PhysicsAnimationBatch, CurrentThreadLimit) {
+    const unsigned int prevNumThreads = maxNumberOfThreads();
+    setMaxNumberOfThreads(4);
+
+    setMaxNumberOfThreadsForCurrentThread(1);
+    EXPECT_EQ(1u, maxNumberOfThreadsForCurrentThread());
+
+    // The limit only applies to the C++11 thread backend, where the loops
+    // then stay on the calling thread
+#ifdef JET_TASKING_CPP11THREADS
+    const std::thread::id id = std::this_thread::get_id();
+    std::atomic<int> numberOfForeignIterations(0);
+    parallelFor(kZeroSize, kMinParallelSize, [&](size_t) {
+        parallelFor(kZeroSize, size_t(4), [&](size_t) {
+            if (std::this_thread::get_id() != id) {
+                ++numberOfForeignIterations;
+            }
+        });
+    });
+    parallelRangeFor(kZeroSize, kMinParallelSize, [&](size_t, size_t) {
+        if (std::this_thread::get_id() != id) {
+            ++numberOfForeignIterations;
+        }
+    });
+    EXPECT_EQ(0, numberOfForeignIterations.load());
+#endif
+
+    // Small animations step on their workers and the caller's limit is kept
+    PhysicsAnimationBatch batch;
+    std::vector<std::shared_ptr<NestedPhysicsAnimation>> anims;
+    for (size_t i = 0; i < 3; ++i) {
+        anims.push_back(std::make_shared<NestedPhysicsAnimation>());
+        batch.addAnimation(anims.back());
+    }
+
+    for (unsigned int limit : {3u, 1u}) {
+        setMaxNumberOfThreadsForCurrentThread(limit);
+        batch.advance(2);
+        EXPECT_EQ(limit, maxNumberOfThreadsForCurrentThread());
+    }
+#ifdef JET_TASKING_CPP11THREADS
+    for (const auto& anim : anims) {
+        EXPECT_EQ(0, anim->numberOfForeignIterations.load());
+    }
+#endif
+
+    setMaxNumberOfThreadsForCurrentThread(0);
+    setMaxNumberOfThreads(prevNumThreads);
+}
+
+TEST(PhysicsAnimationBatch, ProblemSizeChanges) {
+    const unsigned int prevNumThreads = maxNumberOfThreads();
+    setMaxNumberOfThreads(4);
+
+    PhysicsAnimationBatch batch;
+    batch.setIntraParallelismThreshold(100);
+
+    // Large from the initialization, then small after the second step
+    auto shrinking = std::make_shared<EmittingPhysicsAnimation>(1000, 10, 2);
+    // Small from the initialization, then large after the second step
+    auto growing = std::make_shared<EmittingPhysicsAnimation>(10, 1000, 2);
+    batch.addAnimation(shrinking);
+    batch.addAnimation(growing);
+
+    batch.advance(4);
+
+    EXPECT_EQ(std::vector<unsigned int>({4, 4, 1, 1}),
+              shrinking->threadsPerStep);
+    EXPECT_EQ(std::vector<unsigned int>({1, 1, 4, 4}),
+              growing->threadsPerStep);
+
+    setMaxNumberOfThreads(prevNumThreads);
+}
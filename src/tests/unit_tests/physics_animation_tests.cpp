@@ -4,10 +4,14 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <jet/array1.h>
+#include <jet/array3.h>
 #include <jet/physics_animation.h>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 using namespace jet;
 
 class CustomPhysicsAnimation : public PhysicsAnimation {
@@ -56,4 +60,41 @@ TEST(PhysicsAnimation, Updates) {
 
     EXPECT_DOUBLE_EQ(pa2.currentFrame().timeIntervalInSeconds * 15.0,
                      pa2.currentTimeInSeconds());
-}
\ No newline at end of file
+}
+
+class ArenaPhysicsAnimation : public PhysicsAnimation {
+ public:
+    size_t maxBytesUsedInStep = 0;
+    size_t maxNumberOfBlocks = 0;
+
+ protected:
+    void onAdvanceTimeStep(double timeIntervalInSeconds) override {
+        (void)timeIntervalInSeconds;
+
+        // The arena should be empty at the beginning of each step
+        EXPECT_EQ(0u, stepArena()->bytesUsed());
+
+        Array1<double> temp(100000, 1.0, stepArena());
+        Array3<char> marker(Size3(64, 32, 16), 0, stepArena());
+        EXPECT_EQ(1.0, temp[99999]);
+
+        maxBytesUsedInStep =
+            std::max(maxBytesUsedInStep, stepArena()->bytesUsed());
+        maxNumberOfBlocks =
+            std::max(maxNumberOfBlocks, stepArena()->numberOfBlocks());
+    }
+};
+
+TEST(PhysicsAnimation, StepArena) {
+    ArenaPhysicsAnimation pa;
+    pa.setNumberOfFixedSubTimeSteps(3);
+
+    for (Frame frame(0, 0.1); frame.index <= 5; ++frame) {
+        pa.update(frame);
+    }
+
+    EXPECT_EQ(100000 * sizeof(double) + 64 * 32 * 16, pa.maxBytesUsedInStep);
+
+    // The blocks are coalesced after the first step
+    EXPECT_LE(pa.maxNumberOfBlocks, 2u);
+}
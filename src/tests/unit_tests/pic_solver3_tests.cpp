@@ -4,9 +4,14 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <jet/grid_point_generator3.h>
 #include <jet/pic_solver3.h>
+#include <jet/plane3.h>
+#include <jet/volume_particle_emitter3.h>
 #include <gtest/gtest.h>
 
+#include <random>
+
 using namespace jet;
 
 TEST(PicSolver3, UpdateEmpty) {
@@ -16,3 +21,124 @@ TEST(PicSolver3, UpdateEmpty) {
         solver.update(frame);
     }
 }
+
+TEST(PicSolver3, ParticlesPerCell) {
+    PicSolver3 solver;
+    EXPECT_EQ(0u, solver.particleReseedingInterval());
+    EXPECT_EQ(4u, solver.minParticlesPerCell());
+    EXPECT_EQ(16u, solver.maxParticlesPerCell());
+
+    solver.setParticleReseedingInterval(5);
+    EXPECT_EQ(5u, solver.particleReseedingInterval());
+
+    solver.setMinParticlesPerCell(2);
+    EXPECT_EQ(2u, solver.minParticlesPerCell());
+
+    solver.setMaxParticlesPerCell(0);
+    EXPECT_EQ(1u, solver.maxParticlesPerCell());
+}
+
+TEST(PicSolver3, SortParticles) {
+    auto solver = PicSolver3::builder()
+                      .withResolution({4, 4, 4})
+                      .withDomainSizeX(1.0)
+                      .makeShared();
+    EXPECT_EQ(0u, solver->particleSortingInterval());
+    solver->setGravity({0, 0, 0});
+
+    auto particles = solver->particleSystemData();
+    Array1<Vector3D> positions;
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(0.0, 1.0);
+    for (int i = 0; i < 500; ++i) {
+        positions.append({d(rng), d(rng), d(rng)});
+    }
+    particles->addParticles(positions.constAccessor());
+
+    // Sorting is off by default, so the particles keep their indices
+    solver->update(Frame(0, 0.01));
+    EXPECT_EQ(500u, particles->numberOfParticles());
+    auto x = particles->positions();
+    for (size_t i = 0; i < x.size(); ++i) {
+        EXPECT_EQ(positions[i], x[i]);
+    }
+
+    solver->setParticleSortingInterval(1);
+    EXPECT_EQ(1u, solver->particleSortingInterval());
+    solver->update(Frame(1, 0.01));
+
+    // With zero velocity, the particles should stay and be grouped by cell
+    EXPECT_EQ(500u, particles->numberOfParticles());
+    x = particles->positions();
+    size_t prevKey = 0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        const size_t key = static_cast<size_t>(4 * x[i].x) +
+                           4 * (static_cast<size_t>(4 * x[i].y) +
+                                4 * static_cast<size_t>(4 * x[i].z));
+        EXPECT_LE(prevKey, key);
+        prevKey = key;
+    }
+
+    solver->setParticleSortingInterval(0);
+    EXPECT_EQ(0u, solver->particleSortingInterval());
+}
+
+TEST(PicSolver3, ReseedParticles) {
+    auto solver = PicSolver3::builder()
+                      .withResolution({8, 8, 8})
+                      .withDomainSizeX(1.0)
+                      .makeShared();
+    solver->setGravity({0, 0, 0});
+    solver->setParticleReseedingInterval(1);
+    solver->setMinParticlesPerCell(12);
+    solver->setMaxParticlesPerCell(12);
+
+    const BoundingBox3D domain = solver->gridSystemData()->boundingBox();
+    auto plane = Plane3::builder()
+                     .withNormal({0, 1, 0})
+                     .withPoint({0, 0.5 * domain.height(), 0})
+                     .makeShared();
+
+    // Emits 8 particles per cell
+    auto emitter = VolumeParticleEmitter3::builder()
+                       .withSurface(plane)
+                       .withSpacing(0.5 * solver->gridSpacing().x)
+                       .withMaxRegion(domain)
+                       .withIsOneShot(true)
+                       .makeShared();
+    emitter->setPointGenerator(std::make_shared<GridPointGenerator3>());
+    solver->setParticleEmitter(emitter);
+
+    Frame frame(0, 1e-3);
+    solver->update(frame);
+
+    // Interior cells should have been topped up to 12 particles
+    const auto particles = solver->particleSystemData();
+    const auto positions = particles->positions();
+    size_t numberOfParticlesInCell = 0;
+    for (size_t i = 0; i < particles->numberOfParticles(); ++i) {
+        const Vector3D x = positions[i] * 8.0;
+        if (x.x >= 3.0 && x.x < 4.0 && x.y >= 1.0 && x.y < 2.0 &&
+            x.z >= 3.0 && x.z < 4.0) {
+            ++numberOfParticlesInCell;
+        }
+    }
+    EXPECT_EQ(12u, numberOfParticlesInCell);
+
+    // Over-populated cells should be trimmed
+    solver->setMinParticlesPerCell(2);
+    solver->setMaxParticlesPerCell(2);
+    ++frame;
+    solver->update(frame);
+
+    size_t numberOfParticlesInCell2 = 0;
+    const auto positions2 = particles->positions();
+    for (size_t i = 0; i < particles->numberOfParticles(); ++i) {
+        const Vector3D x = positions2[i] * 8.0;
+        if (x.x >= 3.0 && x.x < 4.0 && x.y >= 1.0 && x.y < 2.0 &&
+            x.z >= 3.0 && x.z < 4.0) {
+            ++numberOfParticlesInCell2;
+        }
+    }
+    EXPECT_EQ(2u, numberOfParticlesInCell2);
+}
@@ -0,0 +1,97 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array1.h>
+#include <jet/array3.h>
+#include <jet/step_arena.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <utility>
+
+using namespace jet;
+
+namespace {
+
+bool isAligned(const void* ptr, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+}
+
+}  // namespace
+
+TEST(StepArena, Allocate) {
+    StepArena arena;
+    EXPECT_EQ(0u, arena.bytesUsed());
+    EXPECT_EQ(0u, arena.capacity());
+    EXPECT_EQ(0u, arena.numberOfBlocks());
+
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(100, 64);
+    void* c = arena.allocate(8, 256);
+    EXPECT_TRUE(isAligned(b, 64));
+    EXPECT_TRUE(isAligned(c, 256));
+    EXPECT_LT(static_cast<char*>(a) + 3, static_cast<char*>(b) + 1);
+    EXPECT_LE(static_cast<char*>(b) + 100, static_cast<char*>(c));
+    EXPECT_EQ(111u, arena.bytesUsed());
+    EXPECT_EQ(1u, arena.numberOfBlocks());
+
+    // Overflows the first block
+    void* d = arena.allocate(arena.capacity(), 64);
+    EXPECT_TRUE(isAligned(d, 64));
+    EXPECT_EQ(2u, arena.numberOfBlocks());
+    const size_t capacity = arena.capacity();
+
+    // Coalesces the blocks
+    arena.reset();
+    EXPECT_EQ(0u, arena.bytesUsed());
+    EXPECT_EQ(1u, arena.numberOfBlocks());
+    EXPECT_EQ(capacity, arena.capacity());
+
+    // Reuses the memory
+    void* e = arena.allocate(capacity / 2, 64);
+    arena.reset();
+    void* f = arena.allocate(capacity / 2, 64);
+    EXPECT_EQ(e, f);
+    EXPECT_EQ(1u, arena.numberOfBlocks());
+}
+
+TEST(StepArena, Arrays) {
+    StepArena arena;
+
+    Array1<double> arr1(10, 2.0, &arena);
+    EXPECT_EQ(10u, arr1.size());
+    EXPECT_EQ(2.0, arr1[9]);
+    EXPECT_EQ(10 * sizeof(double), arena.bytesUsed());
+
+    Array3<int> arr3(Size3(4, 3, 2), 7, &arena);
+    arr3(3, 2, 1) = 42;
+    EXPECT_EQ(10 * sizeof(double) + 24 * sizeof(int), arena.bytesUsed());
+
+    // Resizing keeps the array in the arena while preserving the data
+    arr3.resize(Size3(5, 3, 2), 1);
+    EXPECT_EQ(42, arr3(3, 2, 1));
+    EXPECT_EQ(1, arr3(4, 2, 1));
+    EXPECT_EQ(10 * sizeof(double) + 54 * sizeof(int), arena.bytesUsed());
+
+    // Copying or moving to a heap array copies the data to the heap
+    Array3<int> copied(arr3);
+    Array3<int> moved;
+    moved = std::move(arr3);
+    const size_t bytesUsed = arena.bytesUsed();
+
+    Array1<double> heap1;
+    heap1 = std::move(arr1);
+    EXPECT_EQ(bytesUsed, arena.bytesUsed());
+
+    arena.reset();
+    Array1<double> overwrite(100, -1.0, &arena);
+
+    EXPECT_EQ(10u, heap1.size());
+    EXPECT_EQ(2.0, heap1[9]);
+    EXPECT_EQ(42, copied(3, 2, 1));
+    EXPECT_EQ(42, moved(3, 2, 1));
+    EXPECT_EQ(1, moved(4, 2, 1));
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/task_graph.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+using namespace jet;
+
+TEST(TaskGraph, Execute) {
+    for (auto policy : {ExecutionPolicy::kParallel, ExecutionPolicy::kSerial}) {
+        std::vector<std::atomic<int>> done(5);
+        for (auto& d : done) {
+            d = 0;
+        }
+        std::atomic<int> violations(0);
+
+        TaskGraph tasks;
+        EXPECT_EQ(0u, tasks.numberOfTasks());
+        tasks.execute(policy);
+
+        size_t a = tasks.addTask([&]() { done[0] = 1; });
+        size_t b = tasks.addTask([&]() { done[1] = 1; });
+        size_t c = tasks.addTask(
+            [&]() {
+                if (!done[0] || !done[1]) {
+                    ++violations;
+                }
+                done[2] = 1;
+            },
+            {a, b});
+        tasks.addTask(
+            [&]() {
+                if (!done[2]) {
+                    ++violations;
+                }
+                done[3] = 1;
+            },
+            {c});
+        tasks.addTask([&]() { done[4] = 1; }, {a});
+        EXPECT_EQ(5u, tasks.numberOfTasks());
+
+        tasks.execute(policy);
+
+        EXPECT_EQ(0, violations.load());
+        for (auto& d : done) {
+            EXPECT_EQ(1, d.load());
+        }
+
+        tasks.clear();
+        EXPECT_EQ(0u, tasks.numberOfTasks());
+    }
+}
+
+TEST(TaskGraph, InvalidDependency) {
+    TaskGraph tasks;
+    size_t a = tasks.addTask([]() {});
+    EXPECT_THROW(tasks.addTask([]() {}, {a + 1}), std::invalid_argument);
+    EXPECT_EQ(1u, tasks.numberOfTasks());
+}
+
+TEST(TaskGraph, ThreadShare) {
+    const unsigned int prevNumThreads = maxNumberOfThreads();
+    setMaxNumberOfThreads(4);
+
+    // Concurrent tasks split the threads and a single task gets all of them
+    std::vector<unsigned int> shares(4, 0);
+    TaskGraph tasks;
+    size_t first = tasks.addTask([&]() { shares[0] = maxNumberOfThreads(); });
+    tasks.addTask([&]() { shares[1] = maxNumberOfThreads(); });
+    tasks.addTask([&]() { shares[2] = maxNumberOfThreads(); });
+    tasks.addTask([&]() { shares[3] = maxNumberOfThreads(); }, {first});
+    tasks.execute();
+
+#ifdef JET_TASKING_OPENMP
+    // Fewer tasks than the threads run one by one with all the threads
+    EXPECT_EQ(4u, shares[0]);
+    EXPECT_EQ(4u, shares[1]);
+    EXPECT_EQ(4u, shares[2]);
+#else
+    EXPECT_EQ(2u, shares[0]);
+    EXPECT_EQ(1u, shares[1]);
+    EXPECT_EQ(1u, shares[2]);
+#endif
+    EXPECT_EQ(4u, shares[3]);
+    EXPECT_EQ(4u, maxNumberOfThreads());
+
+    setMaxNumberOfThreads(prevNumThreads);
+}
@@ -0,0 +1,141 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array1.h>
+#include <jet/temporal_blocking.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <random>
+
+using namespace jet;
+
+TEST(TemporalBlocking, Order) {
+    // The wavefront runs on a single thread
+    const unsigned int prevNumThreads = maxNumberOfThreads();
+    setMaxNumberOfThreads(1);
+
+    const size_t numberOfPlanes = 9;
+    const unsigned int numberOfSteps = 7;
+
+    // Records the last step which updated each plane
+    std::vector<int> lastSteps(numberOfPlanes, -1);
+    size_t numberOfCalls = 0;
+
+    temporallyBlockedSweep(
+        numberOfPlanes, numberOfSteps, 3, [&](unsigned int step, size_t p) {
+            const int s = static_cast<int>(step);
+
+            // Neighbors should have finished the previous step, but not the
+            // next one.
+            EXPECT_EQ(s - 1, lastSteps[p]);
+            if (p > 0) {
+                EXPECT_EQ(s, lastSteps[p - 1]);
+            }
+            if (p + 1 < numberOfPlanes) {
+                EXPECT_GE(lastSteps[p + 1], s - 1);
+                EXPECT_LE(lastSteps[p + 1], s);
+            }
+
+            lastSteps[p] = s;
+            ++numberOfCalls;
+        });
+
+    EXPECT_EQ(numberOfPlanes * numberOfSteps, numberOfCalls);
+    for (int s : lastSteps) {
+        EXPECT_EQ(static_cast<int>(numberOfSteps) - 1, s);
+    }
+
+    setMaxNumberOfThreads(prevNumThreads);
+}
+
+TEST(TemporalBlocking, ParallelDependencies) {
+    const unsigned int prevNumThreads = maxNumberOfThreads();
+    setMaxNumberOfThreads(4);
+
+    const size_t numberOfPlanes = 50;
+    const unsigned int numberOfSteps = 11;
+
+    // A plane at a step runs after its neighbors at the previous step, and
+    // before the neighbors at the next step overwrite what it reads.
+    std::vector<std::atomic<int>> numberOfCalls(numberOfSteps *
+                                                numberOfPlanes);
+    for (auto& n : numberOfCalls) {
+        n = 0;
+    }
+    auto calls = [&](unsigned int step, size_t plane) -> std::atomic<int>& {
+        return numberOfCalls[step * numberOfPlanes + plane];
+    };
+
+    temporallyBlockedSweep(
+        numberOfPlanes, numberOfSteps, 3, [&](unsigned int step, size_t p) {
+            const size_t begin = (p > 0) ? p - 1 : p;
+            const size_t end = std::min(p + 2, numberOfPlanes);
+            for (size_t q = begin; q < end; ++q) {
+                if (step > 0) {
+                    EXPECT_EQ(1, calls(step - 1, q).load());
+                }
+                if (step + 1 < numberOfSteps) {
+                    EXPECT_EQ(0, calls(step + 1, q).load());
+                }
+            }
+            ++calls(step, p);
+        });
+
+    for (auto& n : numberOfCalls) {
+        EXPECT_EQ(1, n.load());
+    }
+
+    setMaxNumberOfThreads(prevNumThreads);
+}
+
+TEST(TemporalBlocking, PingPong) {
+    const size_t n = 37;
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(0.0, 1.0);
+
+    Array1<double> data(n);
+    for (size_t i = 0; i < n; ++i) {
+        data[i] = d(rng);
+    }
+
+    auto smooth = [n](const Array1<double>& in, size_t i) {
+        return 0.25 * in[(i > 0) ? i - 1 : i] + 0.5 * in[i] +
+               0.25 * in[(i + 1 < n) ? i + 1 : i];
+    };
+
+    // Both the serial and the parallel wavefronts
+    const unsigned int prevNumThreads = maxNumberOfThreads();
+    for (unsigned int numThreads : {1u, 4u}) {
+        setMaxNumberOfThreads(numThreads);
+
+        for (unsigned int numberOfSteps : {0u, 1u, 4u, 11u}) {
+            for (unsigned int blockDepth : {1u, 3u, 8u, 32u}) {
+                Array1<double> expected = data;
+                Array1<double> temp(n);
+                for (unsigned int s = 0; s < numberOfSteps; ++s) {
+                    for (size_t i = 0; i < n; ++i) {
+                        temp[i] = smooth(expected, i);
+                    }
+                    expected.swap(temp);
+                }
+
+                Array1<double> buffers[2] = {data, Array1<double>(n)};
+                temporallyBlockedSweep(n, numberOfSteps, blockDepth,
+                                       [&](unsigned int step, size_t i) {
+                                           buffers[(step + 1) % 2][i] =
+                                               smooth(buffers[step % 2], i);
+                                       });
+
+                const Array1<double>& actual = buffers[numberOfSteps % 2];
+                for (size_t i = 0; i < n; ++i) {
+                    EXPECT_DOUBLE_EQ(expected[i], actual[i]);
+                }
+            }
+        }
+    }
+    setMaxNumberOfThreads(prevNumThreads);
+}
@@ -0,0 +1,140 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/transfer_kernels.h>
+#include <gtest/gtest.h>
+
+using namespace jet;
+
+namespace {
+
+template <typename Kernel>
+void testPartitionOfUnity(size_t size) {
+    for (int n = 0; n <= 100; ++n) {
+        const double x = (size - 1.0) * n / 100.0;
+        AxisStencil<Kernel> stencil(x, size);
+
+        double weightSum = 0.0;
+        double derivativeSum = 0.0;
+        for (size_t a = 0; a < Kernel::kWidth; ++a) {
+            EXPECT_GE(stencil.weights[a], 0.0);
+            EXPECT_LT(stencil.indices[a], size);
+            weightSum += stencil.weights[a];
+            derivativeSum += stencil.derivatives[a];
+        }
+        EXPECT_NEAR(1.0, weightSum, 1e-12);
+        EXPECT_NEAR(0.0, derivativeSum, 1e-12);
+    }
+}
+
+template <typename Kernel>
+void testDerivatives(double x) {
+    const double dx = 1e-6;
+    AxisStencil<Kernel> s0(x - dx, 100);
+    AxisStencil<Kernel> s1(x + dx, 100);
+    AxisStencil<Kernel> s(x, 100);
+
+    for (size_t a = 0; a < Kernel::kWidth; ++a) {
+        EXPECT_EQ(s0.indices[a], s1.indices[a]);
+        EXPECT_NEAR((s1.weights[a] - s0.weights[a]) / (2.0 * dx),
+                    s.derivatives[a], 1e-6);
+    }
+}
+
+}  // namespace
+
+TEST(LinearTransferKernel, Weights) {
+    AxisStencil<LinearTransferKernel> s0;
+    EXPECT_DOUBLE_EQ(0.0, s0.coordinate);
+    EXPECT_EQ(0u, s0.indices[0]);
+    EXPECT_EQ(0u, s0.indices[1]);
+
+    AxisStencil<LinearTransferKernel> s1(2.25, 5);
+    EXPECT_EQ(2u, s1.indices[0]);
+    EXPECT_EQ(3u, s1.indices[1]);
+    EXPECT_DOUBLE_EQ(0.75, s1.weights[0]);
+    EXPECT_DOUBLE_EQ(0.25, s1.weights[1]);
+
+    // Clamped to the lower end
+    AxisStencil<LinearTransferKernel> s2(-1.5, 5);
+    EXPECT_DOUBLE_EQ(0.0, s2.coordinate);
+    EXPECT_EQ(0u, s2.indices[0]);
+    EXPECT_EQ(1u, s2.indices[1]);
+    EXPECT_DOUBLE_EQ(1.0, s2.weights[0]);
+
+    // Clamped to the upper end
+    AxisStencil<LinearTransferKernel> s3(7.0, 5);
+    EXPECT_DOUBLE_EQ(4.0, s3.coordinate);
+    EXPECT_EQ(3u, s3.indices[0]);
+    EXPECT_EQ(4u, s3.indices[1]);
+    EXPECT_DOUBLE_EQ(1.0, s3.weights[1]);
+
+    // Single sample
+    AxisStencil<LinearTransferKernel> s4(0.3, 1);
+    EXPECT_EQ(0u, s4.indices[0]);
+    EXPECT_EQ(0u, s4.indices[1]);
+    EXPECT_DOUBLE_EQ(1.0, s4.weights[0] + s4.weights[1]);
+
+    testPartitionOfUnity<LinearTransferKernel>(7);
+    testDerivatives<LinearTransferKernel>(3.3);
+}
+
+TEST(QuadraticBSplineTransferKernel, Weights) {
+    AxisStencil<QuadraticBSplineTransferKernel> s1(3.0, 8);
+    EXPECT_EQ(2u, s1.indices[0]);
+    EXPECT_EQ(3u, s1.indices[1]);
+    EXPECT_EQ(4u, s1.indices[2]);
+    EXPECT_DOUBLE_EQ(0.125, s1.weights[0]);
+    EXPECT_DOUBLE_EQ(0.75, s1.weights[1]);
+    EXPECT_DOUBLE_EQ(0.125, s1.weights[2]);
+
+    AxisStencil<QuadraticBSplineTransferKernel> s2(3.5, 8);
+    EXPECT_EQ(3u, s2.indices[0]);
+    EXPECT_DOUBLE_EQ(0.5, s2.weights[0]);
+    EXPECT_DOUBLE_EQ(0.5, s2.weights[1]);
+    EXPECT_DOUBLE_EQ(0.0, s2.weights[2]);
+
+    // Indices are clamped at the boundary
+    AxisStencil<QuadraticBSplineTransferKernel> s3(0.2, 8);
+    EXPECT_EQ(0u, s3.indices[0]);
+    EXPECT_EQ(0u, s3.indices[1]);
+    EXPECT_EQ(1u, s3.indices[2]);
+
+    testPartitionOfUnity<QuadraticBSplineTransferKernel>(7);
+    testPartitionOfUnity<QuadraticBSplineTransferKernel>(1);
+    testDerivatives<QuadraticBSplineTransferKernel>(3.3);
+    testDerivatives<QuadraticBSplineTransferKernel>(7.8);
+}
+
+TEST(CubicBSplineTransferKernel, Weights) {
+    AxisStencil<CubicBSplineTransferKernel> s1(3.0, 8);
+    EXPECT_EQ(2u, s1.indices[0]);
+    EXPECT_EQ(3u, s1.indices[1]);
+    EXPECT_EQ(4u, s1.indices[2]);
+    EXPECT_EQ(5u, s1.indices[3]);
+    EXPECT_DOUBLE_EQ(1.0 / 6.0, s1.weights[0]);
+    EXPECT_DOUBLE_EQ(2.0 / 3.0, s1.weights[1]);
+    EXPECT_DOUBLE_EQ(1.0 / 6.0, s1.weights[2]);
+    EXPECT_DOUBLE_EQ(0.0, s1.weights[3]);
+
+    AxisStencil<CubicBSplineTransferKernel> s2(3.5, 8);
+    EXPECT_DOUBLE_EQ(1.0 / 48.0, s2.weights[0]);
+    EXPECT_DOUBLE_EQ(23.0 / 48.0, s2.weights[1]);
+    EXPECT_DOUBLE_EQ(23.0 / 48.0, s2.weights[2]);
+    EXPECT_DOUBLE_EQ(1.0 / 48.0, s2.weights[3]);
+
+    // Indices are clamped at the boundary
+    AxisStencil<CubicBSplineTransferKernel> s3(6.5, 8);
+    EXPECT_EQ(5u, s3.indices[0]);
+    EXPECT_EQ(6u, s3.indices[1]);
+    EXPECT_EQ(7u, s3.indices[2]);
+    EXPECT_EQ(7u, s3.indices[3]);
+
+    testPartitionOfUnity<CubicBSplineTransferKernel>(7);
+    testPartitionOfUnity<CubicBSplineTransferKernel>(1);
+    testDerivatives<CubicBSplineTransferKernel>(3.3);
+    testDerivatives<CubicBSplineTransferKernel>(5.6);
+}
@@ -0,0 +1,163 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array1.h>
+#include <jet/vector3_packet.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+
+using namespace jet;
+
+namespace {
+
+Array1<Vector3D> randomVectors(size_t n, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<> d(-2.0, 2.0);
+    Array1<Vector3D> result(n);
+    for (size_t i = 0; i < n; ++i) {
+        result[i] = Vector3D(d(rng), d(rng), d(rng));
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(ScalarPacket, BasicOperations) {
+    ScalarPacket4D a;
+    ScalarPacket4D b(2.0);
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(0.0, a[i]);
+        EXPECT_EQ(2.0, b[i]);
+        a[i] = static_cast<double>(i) + 1.0;
+    }
+
+    auto c = a + b;
+    auto d = a - b;
+    auto e = a * b;
+    auto f = a / b;
+    auto g = 3.0 * a;
+    auto h = sqrt(a);
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(a[i] + 2.0, c[i]);
+        EXPECT_EQ(a[i] - 2.0, d[i]);
+        EXPECT_EQ(a[i] * 2.0, e[i]);
+        EXPECT_EQ(a[i] / 2.0, f[i]);
+        EXPECT_EQ(3.0 * a[i], g[i]);
+        EXPECT_EQ(std::sqrt(a[i]), h[i]);
+        EXPECT_EQ(std::min(a[i], 2.0), min(a, b)[i]);
+        EXPECT_EQ(std::max(a[i], 2.0), max(a, b)[i]);
+        EXPECT_EQ(a[i], abs(-1.0 * a)[i]);
+        EXPECT_EQ((a[i] < 2.0) ? a[i] : -a[i],
+                  selectLess(a, b, a, ScalarPacket4D() - a)[i]);
+    }
+
+    EXPECT_EQ(10.0, a.sum());
+    EXPECT_EQ(3.0, a.sum(2));
+    EXPECT_EQ(4.0, a.max());
+    EXPECT_EQ(2.0, a.max(2));
+
+    ScalarPacket8F p(1.5f);
+    EXPECT_EQ(12.f, p.sum());
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(&p.lanes) % (8 * sizeof(float)));
+}
+
+TEST(ScalarPacket, LoadAndStore) {
+    // Unaligned source and destination
+    double src[5] = {0.0, 1.0, 2.0, 3.0, 4.0};
+    double dst[5] = {};
+    ScalarPacket4D p = ScalarPacket4D::load(src + 1);
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(src[i + 1], p[i]);
+    }
+
+    (p + ScalarPacket4D(1.0)).store(dst + 1);
+    EXPECT_EQ(0.0, dst[0]);
+    for (size_t i = 1; i < 5; ++i) {
+        EXPECT_EQ(src[i] + 1.0, dst[i]);
+    }
+}
+
+TEST(Vector3Packet, LoadAndStore) {
+    const auto src = randomVectors(11, 0);
+
+    // Full and partial packets from the accessor
+    for (size_t begin = 0; begin < src.size(); begin += 4) {
+        Vector3x4D p = Vector3x4D::load(src.constAccessor(), begin);
+        for (size_t i = 0; i < 4; ++i) {
+            if (begin + i < src.size()) {
+                EXPECT_EQ(src[begin + i], p.lane(i));
+            } else {
+                EXPECT_EQ(Vector3D(), p.lane(i));
+            }
+        }
+    }
+
+    Array1<Vector3D> dst(src.size(), Vector3D(7.0, 7.0, 7.0));
+    for (size_t begin = 0; begin < src.size(); begin += 4) {
+        Vector3x4D::load(src.constAccessor(), begin)
+            .store(dst.accessor(), begin);
+    }
+    for (size_t i = 0; i < src.size(); ++i) {
+        EXPECT_EQ(src[i], dst[i]);
+    }
+
+    // Partial store leaves the rest untouched
+    Vector3x4D p(Vector3D(1.0, 2.0, 3.0));
+    p.setLane(1, Vector3D(4.0, 5.0, 6.0));
+    Vector3D raw[4];
+    p.store(raw, 2);
+    EXPECT_EQ(Vector3D(1.0, 2.0, 3.0), raw[0]);
+    EXPECT_EQ(Vector3D(4.0, 5.0, 6.0), raw[1]);
+    EXPECT_EQ(Vector3D(), raw[2]);
+}
+
+TEST(Vector3Packet, Arithmetic) {
+    const auto a = randomVectors(8, 1);
+    const auto b = randomVectors(8, 2);
+    const Matrix3x3D m(1.0, 2.0, -0.5, 0.3, -1.2, 4.0, 2.5, 0.0, 1.0);
+
+    for (size_t begin = 0; begin < 8; begin += 4) {
+        const Vector3x4D pa = Vector3x4D::load(a.data() + begin);
+        const Vector3x4D pb = Vector3x4D::load(b.data() + begin);
+        const ScalarPacket4D s = pa.x;
+
+        const Vector3x4D sum = pa + pb;
+        const Vector3x4D diff = pa - pb;
+        const Vector3x4D neg = -pa;
+        const Vector3x4D scaled = 2.0 * pa / 3.0;
+        const Vector3x4D laneScaled = pa * s / s;
+        const Vector3x4D cross = pa.cross(pb);
+        const Vector3x4D transformed = m * pa;
+        const ScalarPacket4D dot = pa.dot(pb);
+        const ScalarPacket4D length = pa.length();
+        const ScalarPacket4D lengthSquared = pa.lengthSquared();
+
+        for (size_t i = 0; i < 4; ++i) {
+            const Vector3D& va = a[begin + i];
+            const Vector3D& vb = b[begin + i];
+            EXPECT_EQ(va + vb, sum.lane(i));
+            EXPECT_EQ(va - vb, diff.lane(i));
+            EXPECT_EQ(-va, neg.lane(i));
+            EXPECT_EQ(2.0 * va / 3.0, scaled.lane(i));
+            EXPECT_EQ(va * va.x / va.x, laneScaled.lane(i));
+            EXPECT_EQ(va.cross(vb), cross.lane(i));
+            EXPECT_EQ(m * va, transformed.lane(i));
+            EXPECT_EQ(va.dot(vb), dot[i]);
+            EXPECT_EQ(va.length(), length[i]);
+            EXPECT_EQ(va.lengthSquared(), lengthSquared[i]);
+        }
+    }
+
+    Vector3x8F pf(Vector3F(1.f, 2.f, 3.f));
+    pf += Vector3x8F(Vector3F(1.f, 1.f, 1.f));
+    pf -= Vector3x8F(Vector3F(0.5f, 0.5f, 0.5f));
+    pf *= ScalarPacket8F(2.f);
+    for (size_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(Vector3F(3.f, 5.f, 7.f), pf.lane(i));
+    }
+}